@@ -0,0 +1,65 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// 간단한 벤치마크 하네스 - 케이스는 WM_BENCH 로 등록하고 wm_bench 가 순서대로 실행한다.
+struct BenchCase {
+    const char* name;
+    void (*fn)();
+};
+
+std::vector<BenchCase>& benchRegistry();
+
+struct BenchRegistrar {
+    BenchRegistrar(const char* name, void (*fn)()) { benchRegistry().push_back({name, fn}); }
+};
+
+#define WM_BENCH(name)                                          \
+    static void name();                                         \
+    static BenchRegistrar name##_registrar(#name, name);        \
+    static void name()
+
+// 결과 검증 실패를 기록 (wm_bench 종료 코드에 반영)
+void benchCheck(bool condition, const char* what);
+
+// 측정 결과 한 줄 출력
+void benchReport(const char* name, double nsPerOp, std::uint64_t ops, const char* note = "");
+
+// 입력 기록 파일을 재생하고 결과를 출력 (bench_input_trace.cpp)
+int replayInputTrace(const char* path);
+
+// 컴파일러가 결과를 지우지 못하게 한다
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+using BenchClock = std::chrono::steady_clock;
+
+// fn 을 iterations 번 실행하고 1회당 나노초를 돌려준다
+template <typename F>
+double measureNsPerOp(std::uint64_t iterations, F&& fn) {
+    auto start = BenchClock::now();
+    for (std::uint64_t i = 0; i < iterations; ++i) fn(i);
+    auto elapsed = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    return iterations ? elapsed / static_cast<double>(iterations) : 0.0;
+}
+
+// 재현 가능한 의사 난수 (xorshift)
+struct BenchRng {
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    std::uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+    int range(int lo, int hi) { return lo + static_cast<int>(next() % static_cast<std::uint64_t>(hi - lo)); }
+};
@@ -0,0 +1,124 @@
+#include "bench.h"
+#include "async_move_executor.h"
+#include <thread>
+
+static const std::int64_t kMs = 1'000'000;
+
+static Rect slotRect(int i) {
+    return {i * 10, i * 5, i * 10 + 400, i * 5 + 300};
+}
+
+WM_BENCH(async_move_executor_isolation) {
+    SlowWindowMoveBackend backend;
+    const WindowId hungWindow = 1;
+    backend.addWindow(hungWindow, {0, 0, 100, 100});
+    for (WindowId w = 2; w <= 21; ++w) {
+        backend.addWindow(w, {0, 0, 100, 100});
+        backend.setDelay(w, kMs);
+    }
+    backend.setHung(hungWindow, true);
+
+    AsyncMoveExecutor executor(backend, 2, 50 * kMs, 4);
+
+    // 응답 없는 창의 첫 이동이 스레드 하나를 붙잡는 동안 같은 창에 100번 더 요청
+    executor.submit(hungWindow, slotRect(0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    for (int i = 1; i <= 100; ++i) executor.submit(hungWindow, slotRect(i));
+
+    // 다른 창의 이동은 영향을 받지 않아야 한다
+    auto start = BenchClock::now();
+    for (WindowId w = 2; w <= 21; ++w) executor.submit(w, slotRect(static_cast<int>(w)));
+    benchCheck(executor.waitIdle(2000 * kMs), "responsive windows finish while one window hangs");
+    double othersNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+
+    bool othersMoved = true;
+    for (WindowId w = 2; w <= 21; ++w) {
+        Rect r;
+        othersMoved = othersMoved && backend.rectOf(w, r) && r == slotRect(static_cast<int>(w));
+    }
+    benchCheck(othersMoved, "every responsive window reached its target");
+
+    // 감시 스레드가 시간 초과를 표시할 때까지 대기
+    for (int i = 0; i < 200 && !executor.isHung(hungWindow); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    benchCheck(executor.isHung(hungWindow), "blocked window is flagged as hung");
+    AsyncMoveStats stats = executor.stats();
+    benchCheck(stats.timeouts == 1 && stats.hungWindows == 1, "one timeout recorded");
+    benchCheck(stats.workers == 3, "a replacement worker keeps two responsive workers");
+    benchCheck(stats.coalesced == 99, "queued moves for the hung window are coalesced");
+    benchCheck(backend.callsFor(hungWindow) == 1, "hung window holds only one call");
+
+    // 응답이 돌아오면 최신 목표만 한 번 더 적용
+    backend.setHung(hungWindow, false);
+    benchCheck(executor.waitIdle(2000 * kMs), "recovered window drains");
+    for (int i = 0; i < 200 && executor.stats().workers != 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    stats = executor.stats();
+    Rect finalRect;
+    backend.rectOf(hungWindow, finalRect);
+    benchCheck(finalRect == slotRect(100), "latest request wins after recovery");
+    benchCheck(backend.callsFor(hungWindow) == 2, "recovered window is moved exactly once more");
+    benchCheck(stats.recovered == 1 && stats.hungWindows == 0 && !executor.isHung(hungWindow), "hang cleared");
+    benchCheck(stats.workers == 2, "extra worker retires after recovery");
+    benchCheck(stats.queueDepth == 0 && stats.inFlight == 0, "queue drained");
+
+    char note[96];
+    std::snprintf(note, sizeof(note), "20 windows x 1 ms on 2 workers while 1 hangs: %.1f ms total", othersNs / 1e6);
+    benchReport("async_move_executor.isolated_move", othersNs / 20, 20, note);
+
+    // 소멸 시 응답 없는 호출을 기다리지 않는다
+    auto* hungBackend = new SlowWindowMoveBackend();
+    hungBackend->addWindow(1, {0, 0, 10, 10});
+    hungBackend->setHung(1, true);
+    start = BenchClock::now();
+    {
+        AsyncMoveExecutor shortLived(*hungBackend, 1, 20 * kMs);
+        shortLived.submit(1, {5, 5, 15, 15});
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        benchCheck(shortLived.isHung(1), "hung before shutdown");
+    }
+    double shutdownMs = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+    benchCheck(shutdownMs < 1000, "destructor does not wait for hung calls");
+    // 분리된 스레드가 풀려나 스스로 종료하도록 한다 (백엔드는 의도적으로 해제하지 않음)
+    hungBackend->setHung(1, false);
+}
+
+WM_BENCH(async_move_executor_throughput) {
+    SlowWindowMoveBackend backend;
+    const int windows = 1000;
+    for (int w = 1; w <= windows; ++w) backend.addWindow(static_cast<WindowId>(w), {0, 0, 100, 100});
+
+    AsyncMoveExecutor executor(backend, 2);
+    const int rounds = 20;
+    size_t maxDepth = 0;
+    auto start = BenchClock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (int w = 1; w <= windows; ++w) {
+            executor.submit(static_cast<WindowId>(w), slotRect(round * 7 + w % 50));
+        }
+        maxDepth = std::max(maxDepth, executor.stats().queueDepth);
+    }
+    benchCheck(executor.waitIdle(10000 * kMs), "throughput run drains");
+    double elapsedNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+
+    const AsyncMoveStats stats = executor.stats();
+    const std::uint64_t requests = static_cast<std::uint64_t>(rounds) * windows;
+    benchCheck(stats.submitted == requests, "every request counted");
+    benchCheck(stats.completed + stats.skipped + stats.coalesced == requests, "every request accounted for");
+    benchCheck(stats.failed == 0 && stats.timeouts == 0, "no failures without hangs");
+
+    bool latest = true;
+    for (int w = 1; w <= windows; ++w) {
+        Rect r;
+        latest = latest && backend.rectOf(static_cast<WindowId>(w), r) && r == slotRect((rounds - 1) * 7 + w % 50);
+    }
+    benchCheck(latest, "each window ends at its latest target");
+
+    char note[128];
+    std::snprintf(note, sizeof(note), "%.0f req/s, %llu moves, %llu coalesced, max queue %zu",
+                  requests / (elapsedNs / 1e9), static_cast<unsigned long long>(stats.completed),
+                  static_cast<unsigned long long>(stats.coalesced), maxDepth);
+    benchReport("async_move_executor.submit_drain", elapsedNs / requests, requests, note);
+}
@@ -0,0 +1,323 @@
+#include "bench.h"
+#include "command_server.h"
+#include "layout_transaction.h"
+#include <condition_variable>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// 메시지 루프 대신: pending 콜백이 깨우면 쌓인 배치를 실행
+struct BenchMessageLoop {
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool pending = false;
+    bool quit = false;
+
+    static void post(void* context) {
+        auto* self = static_cast<BenchMessageLoop*>(context);
+        {
+            std::lock_guard<std::mutex> lock(self->mutex);
+            self->pending = true;
+        }
+        self->wake.notify_one();
+    }
+
+    void run(CommandServer& server, CommandHandler& handler) {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this] { return pending || quit; });
+            if (quit) break;
+            pending = false;
+            lock.unlock();
+            server.processPending(handler);
+            lock.lock();
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        wake.notify_one();
+    }
+};
+
+// 가짜 창 위에서 WindowManager::execute 와 같은 방식으로 실행 (배치마다 커밋 한 번)
+class BenchCommandHandler : public CommandHandler {
+public:
+    BenchCommandHandler() : m_transaction(os) {}
+
+    void execute(CommandBatch& batch) override {
+        for (const Command& command : batch.commands) {
+            Rect current;
+            switch (command.op) {
+                case CommandOp::Snap:
+                case CommandOp::Move:
+                    if (!os.getWindowRect(command.window, current)) {
+                        batch.addResult(CommandStatus::UnknownWindow);
+                        break;
+                    }
+                    m_transaction.move(command.window, command.op == CommandOp::Snap
+                                                           ? calculateSnapRect(workArea, command.position)
+                                                           : command.rect);
+                    batch.addResult(CommandStatus::Ok);
+                    break;
+                case CommandOp::ApplyLayout: {
+                    auto it = layouts.find(command.name);
+                    if (it == layouts.end()) {
+                        batch.addResult(CommandStatus::UnknownLayout);
+                        break;
+                    }
+                    for (const WindowMove& move : it->second) m_transaction.move(move.window, move.target);
+                    batch.addResult(CommandStatus::Ok);
+                    break;
+                }
+                case CommandOp::Query:
+                    if (!os.getWindowRect(command.window, current)) {
+                        batch.addResult(CommandStatus::UnknownWindow);
+                        break;
+                    }
+                    batch.results.push_back({CommandStatus::Ok, static_cast<std::uint32_t>(batch.states.size()), 1});
+                    batch.states.push_back({command.window, current, os.isVisible(command.window)});
+                    break;
+                default:
+                    batch.addResult(CommandStatus::Invalid);
+                    break;
+            }
+        }
+        if (!m_transaction.empty()) {
+            m_transaction.commit();
+            ++commits;
+        }
+    }
+
+    FakeWindowMoveBackend os;
+    Rect workArea = {0, 0, 1920, 1040};
+    std::map<std::string, std::vector<WindowMove>> layouts;
+    size_t commits = 0;
+
+private:
+    LayoutTransaction m_transaction;
+};
+
+static Command snapCommand(WindowId window, WindowPosition position) {
+    Command command;
+    command.op = CommandOp::Snap;
+    command.window = window;
+    command.position = position;
+    return command;
+}
+
+static Command moveCommand(WindowId window, const Rect& rect) {
+    Command command;
+    command.op = CommandOp::Move;
+    command.window = window;
+    command.rect = rect;
+    return command;
+}
+
+static Command layoutCommand(const char* name) {
+    Command command;
+    command.op = CommandOp::ApplyLayout;
+    command.name = name;
+    return command;
+}
+
+static Command queryCommand(WindowId window) {
+    Command command;
+    command.op = CommandOp::Query;
+    command.window = window;
+    return command;
+}
+
+static CommandDecoder::Result decodeAll(const std::string& bytes, CommandBatch& out) {
+    CommandDecoder decoder;
+    decoder.append(bytes.data(), bytes.size());
+    return decoder.next(out);
+}
+
+WM_BENCH(command_server) {
+    const Rect half = {0, 0, 960, 1040};
+    const Rect other = {960, 0, 1920, 1040};
+
+    // 이진 프레임: 한 바이트씩 나눠 와도 마지막 바이트에서 배치 하나
+    {
+        const Command commands[] = {snapCommand(0x1234, WindowPosition::CenterLeft),
+                                    moveCommand(0x5678, {-10, 20, 900, 1000}), layoutCommand("trading"),
+                                    queryCommand(0)};
+        std::string frame;
+        encodeCommands(commands, 4, frame);
+        CommandDecoder decoder;
+        CommandBatch batch;
+        bool early = false;
+        for (size_t i = 0; i + 1 < frame.size(); ++i) {
+            decoder.append(&frame[i], 1);
+            early |= decoder.next(batch) != CommandDecoder::Result::NeedMore;
+        }
+        decoder.append(&frame.back(), 1);
+        const bool complete = decoder.next(batch) == CommandDecoder::Result::Batch;
+        benchCheck(!early && complete && batch.commands.size() == 4 && !batch.text, "binary frame split byte by byte");
+        benchCheck(complete && batch.commands[0].window == 0x1234 &&
+                       batch.commands[0].position == WindowPosition::CenterLeft &&
+                       batch.commands[1].rect == Rect{-10, 20, 900, 1000} && batch.commands[2].name == "trading" &&
+                       batch.commands[3].op == CommandOp::Query && decoder.buffered() == 0,
+                   "binary frame round trip");
+
+        // 한 번에 두 프레임
+        std::string two = frame + frame;
+        decoder.append(two.data(), two.size());
+        const bool first = decoder.next(batch) == CommandDecoder::Result::Batch;
+        const bool second = decoder.next(batch) == CommandDecoder::Result::Batch;
+        benchCheck(first && second && decoder.next(batch) == CommandDecoder::Result::NeedMore,
+                   "pipelined frames decode separately");
+
+        // 잘못된 입력
+        std::string bad = frame;
+        bad[1] = 9;
+        benchCheck(decodeAll(bad, batch) == CommandDecoder::Result::Error, "unknown version rejected");
+        bad = frame;
+        bad[command_format::kHeaderSize] = 42;
+        benchCheck(decodeAll(bad, batch) == CommandDecoder::Result::Error, "unknown op rejected");
+        bad = frame;
+        bad[2] = 5;  // 명령 수가 본문과 맞지 않는다
+        benchCheck(decodeAll(bad, batch) == CommandDecoder::Result::Error, "count/length mismatch rejected");
+        bad = frame;
+        bad[4] = bad[5] = bad[6] = bad[7] = '\x7f';
+        benchCheck(decodeAll(bad, batch) == CommandDecoder::Result::Error, "oversized frame rejected");
+    }
+
+    // 텍스트 모드
+    {
+        CommandBatch batch;
+        const bool parsed = decodeAll("snap 0x10 left ; move 16 0 0 960 1040;layout trading desk ; query\r\n", batch) ==
+                            CommandDecoder::Result::Batch;
+        benchCheck(parsed && batch.text && batch.commands.size() == 4 && batch.commands[0].window == 16 &&
+                       batch.commands[0].position == WindowPosition::CenterLeft && batch.commands[1].rect == half &&
+                       batch.commands[2].name == "trading desk" && batch.commands[3].window == 0,
+                   "text line parses");
+        benchCheck(decodeAll("snap 0x10 sideways\n", batch) == CommandDecoder::Result::Error &&
+                       decodeAll("move 16 0 0 960\n", batch) == CommandDecoder::Result::Error &&
+                       decodeAll("resize 16\n", batch) == CommandDecoder::Result::Error,
+                   "bad text command rejected");
+        benchCheck(decodeAll(std::string(command_format::kMaxTextLine + 1, 'q'), batch) == CommandDecoder::Result::Error,
+                   "overlong text line rejected");
+
+        parseCommandText("snap 16 left ; move 16 0 0 960 1040 ; layout trading ; query", batch);
+        batch.results = {{CommandStatus::Ok, 0, 0}, {CommandStatus::Ok, 0, 0}, {CommandStatus::UnknownLayout, 0, 0},
+                         {CommandStatus::Ok, 0, 2}};
+        batch.states = {{0x10, half, true}, {0x20, other, false}};
+        std::string reply;
+        encodeReply(batch, reply);
+        benchCheck(reply == "ok ; ok ; unknown-layout ; 0x10 0 0 960 1040 visible, 0x20 960 0 1920 1040 hidden\n",
+                   "text reply");
+
+        batch.text = false;
+        reply.clear();
+        encodeReply(batch, reply);
+        CommandBatch decoded;
+        const long long consumed = decodeReply(reply.data(), reply.size(), decoded);
+        benchCheck(consumed == static_cast<long long>(reply.size()) && decoded.results.size() == 4 &&
+                       decoded.results[2].status == CommandStatus::UnknownLayout && decoded.results[3].stateCount == 2 &&
+                       decoded.states[1].rect == other && !decoded.states[1].visible,
+                   "binary reply round trip");
+        benchCheck(decodeReply(reply.data(), reply.size() - 1, decoded) == 0, "partial reply needs more");
+    }
+
+    // 로컬 소켓 서버 + 메시지 루프 스레드
+    BenchCommandHandler handler;
+    constexpr int kWindows = 64;
+    for (WindowId w = 1; w <= kWindows; ++w) handler.os.addWindow(w, {100, 100, 900, 700});
+    handler.layouts["trading"] = {{1, half}, {2, other}};
+
+    const std::string suffix = std::to_string(BenchClock::now().time_since_epoch().count());
+#ifdef _WIN32
+    const std::string endpoint = "\\\\.\\pipe\\wm_bench_" + suffix;
+#else
+    const std::string endpoint = "/tmp/wm_bench_" + suffix + ".sock";
+#endif
+    BenchMessageLoop loop;
+    CommandServer server;
+    benchCheck(server.start(endpoint, BenchMessageLoop::post, &loop), "server starts");
+    std::thread ui([&] { loop.run(server, handler); });
+
+    CommandClient client;
+    benchCheck(client.connect(endpoint), "client connects");
+
+    // 질의는 같은 배치의 이동 전 상태, 이동은 커밋 한 번
+    {
+        const Command commands[] = {queryCommand(1), snapCommand(1, WindowPosition::CenterRight), layoutCommand("trading"),
+                                    moveCommand(3, half), layoutCommand("missing"), snapCommand(999, WindowPosition::Center)};
+        CommandBatch reply;
+        const bool ok = client.call(commands, 6, reply);
+        benchCheck(ok && reply.results.size() == 6 && reply.results[0].stateCount == 1 &&
+                       reply.states[0].rect == Rect{100, 100, 900, 700} && reply.results[1].status == CommandStatus::Ok &&
+                       reply.results[4].status == CommandStatus::UnknownLayout &&
+                       reply.results[5].status == CommandStatus::UnknownWindow,
+                   "batch results");
+        // 같은 창의 snap 뒤에 레이아웃이 오면 레이아웃 위치가 마지막 목표
+        benchCheck(handler.os.batchCalls == 1 && handler.commits == 1 && *handler.os.rectOf(1) == half &&
+                       *handler.os.rectOf(2) == other && *handler.os.rectOf(3) == half,
+                   "one layout commit per batch");
+
+        std::string line;
+        const bool text = client.callText("move 0x4 960 0 1920 1040 ; query 4 ; query 0x7777", line);
+        benchCheck(text && line == "ok ; 0x4 100 100 900 700 visible ; unknown-window", "text mode over the socket");
+        benchCheck(handler.commits == 2 && *handler.os.rectOf(4) == other, "text batch commits once");
+    }
+
+    // 잘못된 프레임을 보낸 연결은 끊고 서버는 계속 동작
+    {
+        CommandClient broken;
+        const char garbage[] = {'\xB7', 1, 1, 0, 1, 0, 0, 0, 42};
+        char byte;
+        const bool closed = broken.connect(endpoint) && broken.send(garbage, sizeof(garbage)) &&
+                            broken.receive(&byte, 1) <= 0;
+        benchCheck(closed, "malformed frame closes the connection");
+        CommandBatch reply;
+        const Command query = queryCommand(1);
+        benchCheck(client.call(&query, 1, reply) && reply.states.size() == 1, "server survives bad clients");
+    }
+
+    // 처리량: 64 명령 배치 (배치마다 커밋 한 번)
+    std::vector<Command> commands;
+    for (WindowId w = 1; w <= kWindows; ++w) commands.push_back(moveCommand(w, half));
+    CommandBatch reply;
+    const size_t commitsBefore = handler.commits;
+    const size_t batchCallsBefore = handler.os.batchCalls;
+    constexpr int kBatches = 2'000;
+    bool allOk = true;
+    const double batchNs = measureNsPerOp(kBatches, [&](std::uint64_t i) {
+        for (Command& command : commands) command.rect = (i & 1) ? half : other;
+        allOk &= client.call(commands.data(), commands.size(), reply) && reply.results.size() == commands.size();
+    });
+    benchCheck(allOk, "throughput batches succeed");
+    benchCheck(handler.commits - commitsBefore == kBatches && handler.os.batchCalls - batchCallsBefore == kBatches,
+               "throughput: one commit per batch");
+
+    char note[128];
+    std::snprintf(note, sizeof(note), "%.0f commands/s, 64 moves per batch, one commit each",
+                  1e9 * kWindows / batchNs);
+    benchReport("command.batch64", batchNs / kWindows, static_cast<std::uint64_t>(kBatches) * kWindows, note);
+    benchCheck(1e9 * kWindows / batchNs > 10'000, "thousands of commands per second");
+
+    // 명령 하나짜리 배치의 왕복 (연결 스레드 -> 메시지 루프 -> 응답)
+    const Command single = snapCommand(5, WindowPosition::CenterLeft);
+    const double roundTripNs = measureNsPerOp(2'000, [&](std::uint64_t) { client.call(&single, 1, reply); });
+    std::snprintf(note, sizeof(note), "%.0f round trips/s", 1e9 / roundTripNs);
+    benchReport("command.round_trip", roundTripNs, 2'000, note);
+
+    const CommandServerStats stats = server.stats();
+    benchCheck(stats.connections == 2 && stats.errors == 1 && stats.batches == 2 + 1 + kBatches + 2'000,
+               "server stats");
+
+    client.close();
+    server.stop();
+    loop.stop();
+    ui.join();
+#ifndef _WIN32
+    benchCheck(!std::filesystem::exists(endpoint), "socket file removed on stop");
+#endif
+}
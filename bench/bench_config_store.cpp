@@ -0,0 +1,273 @@
+#include "bench.h"
+#include "config_store.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+static const std::vector<ConfigActionName> kActions = {
+    {"snap_left", 1}, {"snap_right", 2}, {"snap_center", 9}, {"toggle_grid", 10},
+};
+
+static bool writeText(const std::filesystem::path& path, const std::string& text) {
+    // 편집기처럼 임시 파일에 쓴 뒤 교체
+    const std::filesystem::path temp = path.string() + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file << text;
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    return !ec;
+}
+
+WM_BENCH(config_parse) {
+    const char* text =
+        "# 그리드\n"
+        "grid = 16 8\n"
+        "opacity = 0.35   # 반투명\n"
+        "grid_visible = 1\r\n"
+        "animation_ms = 120\n"
+        "\n"
+        "bind snap_left = win+left\n"
+        "bind snap_center = win+shift+num5 x2\n"
+        "bind toggle_grid = alt+g, alt+h\n"
+        "bind snap_left = ctrl+alt+f3\n";
+    ConfigSnapshot base, parsed;
+    ConfigError error;
+    const bool ok = parseConfigText(text, kActions, base, parsed, error);
+    benchCheck(ok && parsed.rows == 16 && parsed.cols == 8 && parsed.opacity == 0.35f && parsed.gridVisible &&
+               parsed.animationMs == 120, "grid settings parse");
+    benchCheck(ok && parsed.bindings.size() == 3, "bindings parse, later line wins");
+    if (ok && parsed.bindings.size() == 3) {
+        const KeyBinding& left = parsed.bindings[0];
+        const KeyBinding& center = parsed.bindings[1];
+        const KeyBinding& grid = parsed.bindings[2];
+        benchCheck(left.id == 1 && left.first.modifiers == (KeyModControl | KeyModAlt) && left.first.vk == 0x72,
+                   "ctrl+alt+f3");
+        benchCheck(center.taps == 2 && center.first.vk == 0x65 && center.first.modifiers == (KeyModWin | KeyModShift),
+                   "double tap on numpad 5");
+        benchCheck(grid.second.vk == 'H' && grid.second.modifiers == KeyModAlt, "chord second stroke");
+    }
+
+    ConfigSnapshot untouched;
+    benchCheck(!parseConfigText("grid = 12 12\ngrid = 0 4\n", kActions, base, untouched, error) && error.line == 2,
+               "grid range error names line 2");
+    benchCheck(!parseConfigText("opacity = 2\n", kActions, base, untouched, error), "opacity above 1 rejected");
+    benchCheck(!parseConfigText("animation_ms = -5\n", kActions, base, untouched, error), "negative animation rejected");
+    benchCheck(!parseConfigText("bind jump = win+j\n", kActions, base, untouched, error), "unknown action rejected");
+    benchCheck(!parseConfigText("bind snap_left = win+left+right\n", kActions, base, untouched, error),
+               "two keys in one stroke rejected");
+    benchCheck(!parseConfigText("bind snap_left = win+left x2, win+up\n", kActions, base, untouched, error),
+               "taps with chord rejected");
+    benchCheck(!parseConfigText("colour = red\n", kActions, base, untouched, error), "unknown key rejected");
+    {
+        ConfigSnapshot zoned;
+        const bool zonesOk = parseConfigText("zone = 0 0 500 1000\nzone = 500 0 1000 1000\nzone = monitor=1; 0 0 1000 500\n"
+                                             "zone = merge=0 1\nzone_gap = 6\nzone_span = 0\n",
+                                             kActions, base, zoned, error);
+        benchCheck(zonesOk && zoned.zones.size() == 4 && zoned.zones[2].monitor == 1 && zoned.zones[3].merge.size() == 2 &&
+                       zoned.zoneGap == 6 && zoned.zoneSpan == 0,
+                   "zones parse");
+    }
+    benchCheck(!parseConfigText("zone = 0 0 1200 1000\n", kActions, base, untouched, error), "zone outside work area rejected");
+    benchCheck(!parseConfigText("zone = 0 0 500 1000\nzone = monitor=1; merge=0 1\n", kActions, base, untouched, error),
+               "merge of another monitor's zones rejected");
+    {
+        ConfigSnapshot tiled;
+        const bool tilingOk = parseConfigText("tiling = bsp; gap=8\ntiling = monitor=1; master; master=0.6; masters=2\n"
+                                              "tiling = monitor=1; columns\n",
+                                              kActions, base, tiled, error);
+        benchCheck(tilingOk && tiled.tiling.size() == 2 && tiled.tiling[0].monitor == 0 &&
+                       tiled.tiling[0].options.mode == TilingMode::Bsp && tiled.tiling[0].options.gap == 8 &&
+                       tiled.tiling[1].monitor == 1 && tiled.tiling[1].options.mode == TilingMode::Columns,
+                   "tiling parses, later entry for a monitor wins");
+    }
+    benchCheck(!parseConfigText("tiling = monitor=0\n", kActions, base, untouched, error) &&
+                   !parseConfigText("tiling = spiral\n", kActions, base, untouched, error) &&
+                   !parseConfigText("tiling = master; master=1.5\n", kActions, base, untouched, error) &&
+                   !parseConfigText("tiling = bsp; columns\n", kActions, base, untouched, error),
+               "bad tiling rejected");
+    {
+        ConfigSnapshot grids;
+        const bool gridsOk = parseConfigText("grid = 8 8\ngrid = monitor=1; 4 6\ngrid = monitor=2; 3 3\n"
+                                             "grid = monitor=1; 2 5\n",
+                                             kActions, base, grids, error);
+        benchCheck(gridsOk && grids.rows == 8 && grids.cols == 8 && grids.monitorGrids.size() == 2 &&
+                       grids.monitorGrids[0].monitorIndex == 1 && grids.monitorGrids[0].rows == 2 &&
+                       grids.monitorGrids[0].cols == 5 && grids.monitorGrids[1].monitorIndex == 2,
+                   "per-monitor grid parses, later entry for a monitor wins");
+    }
+    benchCheck(!parseConfigText("grid = monitor=1; 0 4\n", kActions, base, untouched, error) &&
+                   !parseConfigText("grid = monitor=1; 4 65\n", kActions, base, untouched, error) &&
+                   !parseConfigText("grid = monitor=-1; 4 4\n", kActions, base, untouched, error) &&
+                   !parseConfigText("grid = monitor=1\n", kActions, base, untouched, error) &&
+                   !parseConfigText("grid = monitor=1; monitor=2; 4 4\n", kActions, base, untouched, error),
+               "bad per-monitor grid rejected");
+    benchCheck(parseConfigText("", kActions, base, untouched, error) && untouched.rows == base.rows,
+               "empty file yields defaults");
+
+    const std::string_view view(text);
+    double ns = measureNsPerOp(200'000, [&](std::uint64_t) {
+        ConfigSnapshot out;
+        doNotOptimize(parseConfigText(view, kActions, base, out, error));
+        doNotOptimize(out);
+    });
+    benchReport("config.parse", ns, 200'000, "9-line settings.conf");
+}
+
+WM_BENCH(config_store) {
+    ConfigStore store;
+    store.setActions(kActions);
+
+    const std::uint64_t initial = store.version();
+    benchCheck(store.reload("grid = 10 10\nopacity = 0.25\n") && store.version() == initial + 1, "reload publishes");
+    benchCheck(!store.reload("grid = 10\n") && store.version() == initial + 1, "bad reload keeps the old snapshot");
+    benchCheck(store.lastError().line == 1 && store.failedReloads() == 1, "bad reload reports the error");
+    {
+        ConfigReader config(store);
+        benchCheck(config->rows == 10 && config->opacity == 0.25f, "reader sees the last good config");
+    }
+    store.modify([](ConfigSnapshot& config) { config.gridVisible = true; });
+    {
+        ConfigReader config(store);
+        benchCheck(config->gridVisible && config->rows == 10, "modify keeps other fields");
+    }
+    store.reclaim();
+    benchCheck(store.retiredCount() == 0, "retired snapshots reclaimed");
+
+    // 읽기 비용 (핫키/드래그 경로에서 한 번씩)
+    double ns = measureNsPerOp(20'000'000, [&](std::uint64_t) {
+        ConfigReader config(store);
+        doNotOptimize(config->rows);
+    });
+    benchReport("config.read", ns, 20'000'000, "epoch counter + atomic pointer load");
+
+    // 한 스레드가 계속 읽는 동안 다른 스레드가 게시/해제 - 읽은 스냅샷은 항상 한 번에 쓴 값이어야 한다
+    std::atomic<bool> done{false};
+    std::atomic<std::uint64_t> torn{0}, reads{0};
+    std::thread reader([&] {
+        std::uint64_t count = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            ConfigReader config(store);
+            if (config->cols != config->rows * 2 || config->bindings.size() != static_cast<size_t>(config->rows % 4)) {
+                torn.fetch_add(1, std::memory_order_relaxed);
+            }
+            if ((++count & 255) == 0) std::this_thread::yield();
+        }
+        reads.store(count, std::memory_order_relaxed);
+    });
+    const int kPublishes = 2000;
+    auto start = BenchClock::now();
+    for (int i = 0; i < kPublishes; ++i) {
+        ConfigSnapshot next;
+        next.rows = 1 + i % 32;
+        next.cols = next.rows * 2;
+        next.bindings.resize(next.rows % 4);
+        store.publish(next);
+        if ((i & 7) == 7) store.reclaim();
+        if ((i & 63) == 0) std::this_thread::yield();
+    }
+    store.reclaim();
+    const double publishNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    done.store(true, std::memory_order_release);
+    reader.join();
+    char note[96];
+    std::snprintf(note, sizeof(note), "with a concurrent reader (%llu reads)",
+                  static_cast<unsigned long long>(reads.load()));
+    benchReport("config.publish_reclaim", publishNs / kPublishes, kPublishes, note);
+    benchCheck(torn.load() == 0, "readers never see a half-published snapshot");
+    benchCheck(store.retiredCount() == 0, "every retired snapshot freed");
+}
+
+static bool waitForVersion(const ConfigStore& store, std::uint64_t version, int timeoutMs) {
+    for (int waited = 0; waited < timeoutMs; waited += 5) {
+        if (store.version() >= version) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return store.version() >= version;
+}
+
+static bool waitForFailures(const ConfigStore& store, std::uint64_t failures, int timeoutMs) {
+    for (int waited = 0; waited < timeoutMs; waited += 5) {
+        if (store.failedReloads() >= failures) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return false;
+}
+
+WM_BENCH(config_hot_reload) {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "wm_bench_config";
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    const std::filesystem::path path = dir / "settings.conf";
+    writeText(path, "grid = 12 12\n");
+
+    ConfigStore store;
+    store.setActions(kActions);
+    benchCheck(store.reloadFile(path), "initial load");
+
+    ConfigReloader reloader;
+    std::atomic<int> callbacks{0};
+    const bool watching = reloader.start(
+        store, path, [](bool, void* context) { static_cast<std::atomic<int>*>(context)->fetch_add(1); }, &callbacks);
+#ifdef __linux__
+    benchCheck(watching, "inotify watch starts");
+#endif
+    if (!watching) {
+        std::filesystem::remove_all(dir, ec);
+        return;
+    }
+
+    // 쓰기 -> 게시까지 걸린 시간 (디바운스 30ms 포함)
+    std::uint64_t version = store.version();
+    auto start = BenchClock::now();
+    writeText(path, "grid = 20 10\nopacity = 0.8\nbind snap_left = ctrl+left\n");
+    const bool reloaded = waitForVersion(store, version + 1, 3000);
+    const double latencyNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    benchCheck(reloaded, "file change is picked up");
+    {
+        ConfigReader config(store);
+        benchCheck(config->rows == 20 && config->cols == 10 && config->bindings.size() == 1,
+                   "reloaded snapshot has the new values");
+    }
+    benchReport("config.hot_reload", latencyNs, 1, "write -> published (inotify + debounce)");
+
+    // 깨진 파일: 이전 스냅샷 유지, 오류 보고
+    version = store.version();
+    writeText(path, "grid = 20 10\nbind snap_left = ctrl+nokey\n");
+    benchCheck(waitForFailures(store, 1, 3000), "broken file reported");
+    benchCheck(store.version() == version && store.lastError().line == 2, "broken file keeps the old snapshot");
+
+    // 다른 파일은 무시
+    writeText(dir / "other.conf", "grid = 1 1\n");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    benchCheck(store.version() == version, "unrelated files ignored");
+
+    reloader.stop();
+    benchCheck(callbacks.load() >= 2, "callback runs after every reload");
+
+    // 시작 모드: 파일이 바뀌지 않아도 작업 스레드에서 먼저 한 번 읽는다
+    {
+        writeText(path, "grid = 16 9\n");
+        ConfigStore coldStore;
+        coldStore.setActions(kActions);
+        const std::uint64_t coldVersion = coldStore.version();
+        ConfigReloader coldReloader;
+        std::atomic<int> coldCallbacks{0};
+        start = BenchClock::now();
+        coldReloader.start(
+            coldStore, path, [](bool, void* context) { static_cast<std::atomic<int>*>(context)->fetch_add(1); },
+            &coldCallbacks, true);
+        const bool loaded = waitForVersion(coldStore, coldVersion + 1, 3000);
+        const double loadNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+        coldReloader.stop();
+        benchCheck(loaded && coldCallbacks.load() == 1, "loadNow parses the file once on the worker");
+        ConfigReader config(coldStore);
+        benchCheck(config->rows == 16 && config->cols == 9, "loadNow publishes the file's values");
+        benchReport("config.load_on_worker", loadNs, 1, "start -> published");
+    }
+    std::filesystem::remove_all(dir, ec);
+}
@@ -0,0 +1,162 @@
+#include "bench.h"
+#include "drag_snapper.h"
+#include <algorithm>
+#include <cstdlib>
+
+// 이전 snapWindowToGrid 방식: 정수 나눗셈 셀 + 샘플마다 SetWindowPos
+static int legacySnap(int value, int origin, int cell) {
+    return ((value - origin + cell / 2) / cell) * cell + origin;
+}
+
+static MonitorTopology makeTopology(SimulatedMonitorBackend& backend, unsigned hz) {
+    std::vector<MonitorInfo> monitors(2);
+    monitors[0].bounds = {0, 0, 2560, 1440};
+    monitors[0].workArea = {0, 0, 2560, 1400};
+    monitors[0].refreshHz = hz;
+    monitors[0].primary = true;
+    monitors[1].bounds = {2560, 0, 4480, 1080};
+    monitors[1].workArea = {2560, 0, 4480, 1050};
+    monitors[1].refreshHz = 60;
+    backend.setMonitors(monitors);
+    MonitorTopology topology;
+    topology.rebuild(backend);
+    return topology;
+}
+
+WM_BENCH(drag_snapper) {
+    SimulatedMonitorBackend backend;
+
+    // 나머지 픽셀 분배: 1400 / 12 는 나누어떨어지지 않지만 마지막 선은 작업 영역 끝
+    {
+        GridLines lines;
+        lines.build({0, 0, 2560, 1400}, 12, 12);
+        benchCheck(lines.ys().back() == 1400 && lines.xs().back() == 2560, "last grid line hits the edge");
+        int minCell = 1 << 30, maxCell = 0;
+        for (size_t i = 1; i < lines.ys().size(); ++i) {
+            int cell = lines.ys()[i] - lines.ys()[i - 1];
+            minCell = cell < minCell ? cell : minCell;
+            maxCell = cell > maxCell ? cell : maxCell;
+        }
+        benchCheck(maxCell - minCell <= 1, "remainder spread across cells");
+        benchCheck(lines.snapX(100) == 0 && lines.snapX(110) == 213 && lines.snapX(-50) == 0 && lines.snapX(9999) == 2560,
+                   "nearest line lookup");
+
+        // 이진 탐색은 전체 선을 훑은 답과 같다 (같은 거리면 뒤 선, 칸이 1픽셀보다 작은 영역 포함)
+        BenchRng rng;
+        int mismatches = 0;
+        for (int round = 0; round < 2000; ++round) {
+            const int left = rng.range(-8000, 8000), cells = rng.range(1, 64);
+            const int width = round % 10 == 0 ? rng.range(0, cells) : rng.range(cells, 8000);
+            lines.build({left, 0, left + width, 100}, 1, cells);
+            for (int k = 0; k < 64; ++k) {
+                const int x = rng.range(left - 50, left + width + 50);
+                int best = lines.xs()[0];
+                for (int line : lines.xs()) {
+                    if (std::abs(line - x) <= std::abs(best - x)) best = line;
+                }
+                if (lines.snapX(x) != best) ++mismatches;
+            }
+        }
+        benchCheck(mismatches == 0, "binary search matches a full scan");
+    }
+
+    // 모니터별 그리드가 바뀌면 선 표를 다시 만들고, 적지 않은 모니터는 공통 크기
+    {
+        MonitorTopology topology = makeTopology(backend, 60);
+        DragSnapper snapper;
+        snapper.configure(topology, 12, 12);
+        snapper.configure(topology, 12, 12, {{topology.key(), 1, 2, 3}});
+        benchCheck(snapper.linesFor(0)->ys().size() == 13 && snapper.linesFor(1)->ys().size() == 3 &&
+                       snapper.linesFor(1)->xs().size() == 4,
+                   "per-monitor grid size");
+    }
+
+    // 1000Hz 마우스로 2초 동안 드래그
+    for (unsigned hz : {60u, 144u}) {
+        MonitorTopology topology = makeTopology(backend, hz);
+        DragSnapper snapper;
+        snapper.configure(topology, 12, 12);
+
+        const Rect window = {100, 100, 900, 700};
+        const std::int64_t sampleNs = 1'000'000;
+        const int kSamples = 2000;
+        std::int64_t now = 0;
+        snapper.begin(1, window, {120, 120}, now);
+
+        int legacyMoves = 1;
+        auto start = BenchClock::now();
+        for (int i = 1; i < kSamples; ++i) {
+            now += sampleNs;
+            Point pt = {120 + i, 120 + i / 3};
+            snapper.addSample(pt, now);
+            ++legacyMoves;
+        }
+        Rect target;
+        bool moved = snapper.end(target);
+        double ns = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count() / kSamples;
+        const DragStats& stats = snapper.stats();
+
+        benchCheck(moved && stats.moves == 1, "drag applies exactly one move on release");
+        benchCheck(stats.frames <= static_cast<std::uint64_t>(2 * hz + 2), "at most one frame per refresh");
+        Rect expected;
+        snapper.snapRect(window, {120 + kSamples - 1, 120 + (kSamples - 1) / 3}, expected);
+        benchCheck(target == expected, "release uses the newest sample");
+
+        char note[128];
+        std::snprintf(note, sizeof(note), "%d Hz: %llu samples -> %llu frames, %llu previews, moves %d -> %llu",
+                      hz, static_cast<unsigned long long>(stats.samples),
+                      static_cast<unsigned long long>(stats.frames),
+                      static_cast<unsigned long long>(stats.previewUpdates), legacyMoves,
+                      static_cast<unsigned long long>(stats.moves));
+        benchReport(hz == 60 ? "drag_snapper.drag_2s_60hz" : "drag_snapper.drag_2s_144hz", ns, kSamples, note);
+    }
+
+    // 스냅 계산 비용: snapRect (zone 확인, 호출 포함) vs 이전 나눗셈
+    {
+        MonitorTopology topology = makeTopology(backend, 60);
+        DragSnapper snapper;
+        snapper.configure(topology, 12, 12);
+        BenchRng rng;
+        std::vector<Point> points(4096);
+        for (auto& pt : points) pt = {rng.range(0, 4480), rng.range(0, 1400)};
+
+        const std::uint64_t iterations = 4'000'000;
+        const Rect window = {0, 0, 800, 600};
+        long long sink = 0;
+        double ns = measureNsPerOp(iterations, [&](std::uint64_t i) {
+            Rect r;
+            snapper.snapRect(window, points[i & 4095], r);
+            sink += r.left + r.top;
+        });
+        doNotOptimize(sink);
+        benchReport("drag_snapper.snap_rect.grid_table", ns, iterations, "zone check + call");
+
+        ns = measureNsPerOp(iterations, [&](std::uint64_t i) {
+            const Point& pt = points[i & 4095];
+            const Rect& work = topology.monitor(topology.monitorFromPoint(pt)).workArea;
+            sink += legacySnap(pt.x, work.left, work.width() / 12) + legacySnap(pt.y, work.top, work.height() / 12);
+        });
+        doNotOptimize(sink);
+        benchReport("drag_snapper.snap_rect.legacy_division", ns, iterations);
+
+        // 선 조회만 (같은 모니터 찾기 뒤에 이진 탐색 vs 나눗셈). 비교는 보고만 한다 (기계마다 흔들림)
+        double searchNs = 0, divisionNs = 0;
+        for (int round = 0; round < 5; ++round) {
+            const double search = measureNsPerOp(iterations, [&](std::uint64_t i) {
+                const Point& pt = points[i & 4095];
+                const GridLines* lines = snapper.linesFor(topology.monitorFromPoint(pt));
+                sink += lines->snapX(pt.x) + lines->snapY(pt.y);
+            });
+            const double division = measureNsPerOp(iterations, [&](std::uint64_t i) {
+                const Point& pt = points[i & 4095];
+                const Rect& work = topology.monitor(topology.monitorFromPoint(pt)).workArea;
+                sink += legacySnap(pt.x, work.left, work.width() / 12) + legacySnap(pt.y, work.top, work.height() / 12);
+            });
+            searchNs = round == 0 ? search : std::min(searchNs, search);
+            divisionNs = round == 0 ? division : std::min(divisionNs, division);
+        }
+        doNotOptimize(sink);
+        benchReport("drag_snapper.grid_lines.binary_search", searchNs, iterations, "best of 5");
+        benchReport("drag_snapper.grid_lines.legacy_division", divisionNs, iterations, "best of 5");
+    }
+}
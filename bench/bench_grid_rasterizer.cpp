@@ -0,0 +1,129 @@
+#include "bench.h"
+#include "drag_snapper.h"
+#include "grid_rasterizer.h"
+#include <cstring>
+
+static std::uint32_t referenceBlend(std::uint32_t dst, std::uint32_t src) {
+    std::uint32_t inv = 255 - (src >> 24);
+    std::uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        std::uint32_t d = (dst >> shift) & 0xFF;
+        std::uint32_t s = (src >> shift) & 0xFF;
+        // 정확한 반올림 나눗셈 기준값
+        std::uint32_t c = s + (d * inv + 127) / 255;
+        out |= (c > 255 ? 255 : c) << shift;
+    }
+    return out;
+}
+
+static const SimdLevel kLevels[] = {SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2};
+
+WM_BENCH(grid_rasterizer_exact) {
+    const SimdLevel original = activeSimdLevel();
+
+    benchCheck(premultiply(255, 255, 255, 255) == 0xFFFFFFFFu, "opaque white premultiplies to itself");
+    benchCheck(premultiply(200, 100, 0, 128) == 0x80643200u, "premultiply rounds to nearest");
+    benchCheck(premultiply(90, 90, 90, 0) == 0, "transparent premultiplies to zero");
+
+    // 모든 구현이 기준값과 비트 단위로 같은지 (길이 0..67 로 꼬리 처리까지)
+    BenchRng rng;
+    std::vector<std::uint32_t> source(67), expected(67), actual(67);
+    for (int round = 0; round < 200; ++round) {
+        for (auto& px : source) {
+            std::uint8_t a = static_cast<std::uint8_t>(rng.next());
+            px = premultiply(static_cast<std::uint8_t>(rng.next()), static_cast<std::uint8_t>(rng.next()),
+                             static_cast<std::uint8_t>(rng.next()), a);
+        }
+        std::uint8_t a = static_cast<std::uint8_t>(round == 0 ? 255 : rng.next());
+        std::uint32_t color = premultiply(static_cast<std::uint8_t>(rng.next()), 40, 220, a);
+        int count = round % 68;
+        for (int i = 0; i < count; ++i) expected[i] = referenceBlend(source[i], color);
+
+        for (SimdLevel level : kLevels) {
+            if (!setSimdLevel(level)) continue;
+            actual = source;
+            blendSpan(actual.data(), count, color);
+            bool same = true;
+            for (int i = 0; i < count; ++i) same = same && actual[i] == expected[i];
+            benchCheck(same, "blendSpan matches exact reference");
+            benchCheck(actual[count] == source[count] || count == 67, "blendSpan stays inside the span");
+        }
+    }
+
+    // 작은 그리드의 픽셀 확인 (10x10, 2x2 셀, 선 두께 1)
+    GridStyle style;
+    style.background = premultiply(0, 0, 0, 0);
+    style.lineColor = premultiply(100, 100, 100, 128);
+    style.highlightColor = premultiply(0, 120, 215, 64);
+    const Rect highlight = {0, 0, 5, 6};
+    const std::uint32_t line = style.lineColor;
+    const std::uint32_t lineOverHighlight = referenceBlend(style.highlightColor, line);
+
+    for (SimdLevel level : kLevels) {
+        if (!setSimdLevel(level)) continue;
+        ArgbBuffer buffer;
+        buffer.resize(10, 10);
+        GridLines lines;
+        lines.build({0, 0, 10, 10}, 2, 2);
+        rasterizeGrid(buffer, lines.xs(), lines.ys(), style, &highlight, 1);
+
+        benchCheck(buffer.pixel(9, 9) == 0, "background stays transparent");
+        benchCheck(buffer.pixel(2, 2) == style.highlightColor, "highlight cell is filled");
+        benchCheck(buffer.pixel(5, 8) == line && buffer.pixel(8, 5) == line, "lines use line color");
+        benchCheck(buffer.pixel(5, 5) == line, "line intersection is blended once");
+        benchCheck(buffer.pixel(2, 5) == lineOverHighlight, "line blends over highlight");
+        benchCheck(buffer.pixel(0, 0) == style.highlightColor && buffer.pixel(9, 0) == 0, "outer edges not drawn");
+    }
+
+    setSimdLevel(original);
+}
+
+WM_BENCH(grid_rasterizer_throughput) {
+    const SimdLevel original = activeSimdLevel();
+    GridStyle style;
+    style.lineColor = premultiply(100, 100, 100, 77);
+    style.highlightColor = premultiply(0, 120, 215, 64);
+
+    struct Resolution { const char* name; int width; int height; };
+    const Resolution resolutions[] = {{"4k", 3840, 2160}, {"8k", 7680, 4320}};
+
+    for (const auto& res : resolutions) {
+        ArgbBuffer buffer;
+        buffer.resize(res.width, res.height);
+        GridLines lines;
+        lines.build({0, 0, res.width, res.height}, 12, 12);
+        const Rect highlights[] = {
+            {lines.xs()[2], lines.ys()[2], lines.xs()[6], lines.ys()[6]},
+            {lines.xs()[6], lines.ys()[0], lines.xs()[12], lines.ys()[12]},
+        };
+
+        std::uint32_t reference = 0;
+        double levelNs[3] = {0, 0, 0};
+        for (SimdLevel level : kLevels) {
+            if (!setSimdLevel(level)) continue;
+            const std::uint64_t iterations = res.width > 4000 ? 10 : 40;
+            double ns = measureNsPerOp(iterations, [&](std::uint64_t) {
+                rasterizeGrid(buffer, lines.xs(), lines.ys(), style, highlights, 2);
+            });
+
+            std::uint32_t hash = 2166136261u;
+            for (int i = 0; i < res.width * res.height; i += 97) hash = (hash ^ buffer.data()[i]) * 16777619u;
+            if (level == SimdLevel::Scalar) reference = hash;
+            levelNs[static_cast<int>(level)] = ns;
+            benchCheck(hash == reference, "SIMD output matches scalar output");
+
+            char name[64], note[96];
+            std::snprintf(name, sizeof(name), "grid_rasterizer.%s.%s", res.name, simdLevelName(level));
+            double mpix = static_cast<double>(res.width) * res.height / (ns / 1e9) / 1e6;
+            std::snprintf(note, sizeof(note), "%.0f Mpix/s, %.2f ms/frame", mpix, ns / 1e6);
+            // 기본으로 고르는 AVX2 와 SSE2 비교는 보고만 한다 (256비트를 둘로 나눠 실행하는 CPU 도 있다)
+            const double sse2Ns = levelNs[static_cast<int>(SimdLevel::Sse2)];
+            if (level == SimdLevel::Avx2 && sse2Ns > 0) {
+                const size_t used = std::strlen(note);
+                std::snprintf(note + used, sizeof(note) - used, ", %.2fx sse2 time", ns / sse2Ns);
+            }
+            benchReport(name, ns, iterations, note);
+        }
+    }
+    setSimdLevel(original);
+}
@@ -0,0 +1,191 @@
+#include "bench.h"
+#include "input_trace.h"
+#include <filesystem>
+#include <string>
+
+// 두 앱의 단축키 id 를 함께 연결한다 (겹치지 않음)
+// - WindowManager/HotkeyManager: 1~9 = 9방향 위치
+// - simple_manager: 1001~1005 = 좌/우(비율 순환), 위/아래 절반, 전체
+static void bindDefaultHotkeys(InputReplayer& replayer) {
+    const WindowPosition positions[] = {
+        WindowPosition::CenterLeft, WindowPosition::CenterRight, WindowPosition::TopCenter,
+        WindowPosition::BottomCenter, WindowPosition::TopLeft, WindowPosition::TopRight,
+        WindowPosition::BottomLeft, WindowPosition::BottomRight, WindowPosition::Center,
+    };
+    for (int i = 0; i < 9; ++i) {
+        replayer.bindHotkey(i + 1, {HotkeyAction::Position, static_cast<int>(positions[i])});
+    }
+    replayer.bindHotkey(1001, {HotkeyAction::Side, 1});
+    replayer.bindHotkey(1002, {HotkeyAction::Side, 0});
+    replayer.bindHotkey(1003, {HotkeyAction::Half, 1});
+    replayer.bindHotkey(1004, {HotkeyAction::Half, 0});
+    replayer.bindHotkey(1005, {HotkeyAction::Maximize, 0});
+}
+
+// wm_bench --replay <파일>: 실제 기록을 재생하고 처리 속도와 최종 창 위치를 출력
+int replayInputTrace(const char* path) {
+    InputTraceReader reader;
+    if (!reader.open(path)) {
+        std::fprintf(stderr, "cannot open input trace: %s\n", path);
+        return 1;
+    }
+    InputReplayer replayer;
+    bindDefaultHotkeys(replayer);
+    const ReplayStats stats = replayer.run(reader);
+
+    std::printf("events %llu (hotkeys %llu, drag samples %llu, display changes %llu), moves %llu\n",
+                static_cast<unsigned long long>(stats.events), static_cast<unsigned long long>(stats.hotkeys),
+                static_cast<unsigned long long>(stats.dragMoves),
+                static_cast<unsigned long long>(stats.displayChanges), static_cast<unsigned long long>(stats.moves));
+    std::printf("%.0f events/s, %.3f ms%s\n", stats.eventsPerSecond, stats.elapsedNs / 1e6,
+                stats.truncated ? " (truncated)" : "");
+
+    std::vector<WindowMove> geometry;
+    replayer.finalGeometry(geometry);
+    for (const auto& move : geometry) {
+        std::printf("%016llx %d %d %d %d\n", static_cast<unsigned long long>(move.window), move.target.left,
+                    move.target.top, move.target.right, move.target.bottom);
+    }
+    std::printf("geometry hash %016llx\n", static_cast<unsigned long long>(replayer.geometryHash()));
+    return stats.truncated ? 1 : 0;
+}
+
+static std::vector<MonitorInfo> simulatedMonitors(int count) {
+    std::vector<MonitorInfo> monitors(4);
+    monitors[0].bounds = {0, 0, 3840, 2160};
+    monitors[0].workArea = {0, 0, 3840, 2100};
+    monitors[0].primary = true;
+    monitors[1].bounds = {-2560, 0, 0, 1440};
+    monitors[1].workArea = {-2560, 0, 0, 1400};
+    monitors[2].bounds = {3840, 0, 6400, 1440};
+    monitors[2].workArea = {3840, 0, 6400, 1400};
+    monitors[3].bounds = {6400, -300, 7480, 1620};
+    monitors[3].workArea = {6400, -300, 7480, 1580};
+    for (size_t i = 0; i < monitors.size(); ++i) monitors[i].handle = 0x1000 + i;
+    monitors.resize(count);
+    return monitors;
+}
+
+// 가상 세션 기록: 창 열거 후 단축키/포그라운드 변경/드래그가 섞이고 가끔 모니터가 빠졌다 돌아온다
+static size_t recordSession(InputRecorder& recorder, int windows, int events) {
+    BenchRng rng;
+    SimulatedMonitorBackend backend;
+    MonitorTopology topology;
+    std::int64_t t = 1'000'000;
+
+    backend.setMonitors(simulatedMonitors(4));
+    topology.rebuild(backend);
+    recorder.start(t);
+    recorder.displayChange(topology, t);
+    recorder.gridSize(12, 12, t);
+
+    std::vector<WindowId> ids(windows);
+    for (int i = 0; i < windows; ++i) {
+        ids[i] = static_cast<WindowId>(0x30000 + i * 4);
+        const Rect& work = topology.monitor(i % topology.size()).workArea;
+        const int x = rng.range(work.left, work.right - 300), y = rng.range(work.top, work.bottom - 200);
+        recorder.windowRect(ids[i], {x, y, x + 300 + rng.range(0, 700), y + 200 + rng.range(0, 500)}, t);
+    }
+    WindowId foreground = ids[0];
+    recorder.foreground(foreground, t);
+
+    const int hotkeys[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 1001, 1002, 1003, 1004, 1005};
+    int monitorCount = 4;
+    int written = 0;
+    int nextHotplug = 25'000;
+    while (written < events) {
+        const unsigned kind = static_cast<unsigned>(rng.next() % 100);
+        if (written >= nextHotplug) {
+            // 모니터 연결/해제
+            monitorCount = monitorCount == 4 ? 3 : 4;
+            backend.setMonitors(simulatedMonitors(monitorCount));
+            topology.rebuild(backend);
+            recorder.displayChange(topology, t += 500'000);
+            nextHotplug += 25'000;
+            ++written;
+        } else if (kind < 10) {
+            foreground = ids[rng.next() % ids.size()];
+            recorder.foreground(foreground, t += 200'000);
+            ++written;
+        } else if (kind < 60) {
+            // 같은 단축키 연타 (비율 순환 포함)
+            const int id = hotkeys[rng.next() % (sizeof(hotkeys) / sizeof(hotkeys[0]))];
+            const int repeat = 1 + rng.range(0, 4);
+            for (int r = 0; r < repeat; ++r) recorder.hotkey(id, t += 120'000);
+            written += repeat;
+        } else {
+            // 포인터 샘플 1ms 간격, 60Hz 프레임보다 훨씬 촘촘하다
+            const WindowId window = ids[rng.next() % ids.size()];
+            const Rect& work = topology.monitor(static_cast<int>(rng.next() % topology.size())).workArea;
+            int x = rng.range(work.left, work.right), y = rng.range(work.top, work.bottom);
+            const int samples = 20 + rng.range(0, 60);
+            for (int s = 0; s < samples; ++s) {
+                x += rng.range(-12, 13);
+                y += rng.range(-8, 9);
+                recorder.dragMove(window, {x, y}, t += 1'000);
+            }
+            recorder.dragEnd(window, t += 1'000);
+            written += samples + 1;
+        }
+    }
+    recorder.stop();
+    return recorder.eventCount();
+}
+
+WM_BENCH(input_trace) {
+    const int kWindows = 1500;
+    const int kEvents = 300'000;
+
+    InputRecorder recorder;
+    auto start = BenchClock::now();
+    const size_t recorded = recordSession(recorder, kWindows, kEvents);
+    const double recordNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    const std::vector<unsigned char>& data = recorder.data();
+    char note[128];
+    std::snprintf(note, sizeof(note), "%.1f bytes/event, %zu KB", static_cast<double>(data.size()) / recorded,
+                  data.size() / 1024);
+    benchReport("input_trace.record", recordNs / recorded, recorded, note);
+
+    InputTraceReader reader;
+    benchCheck(reader.attach(data.data(), data.size()), "recording attaches");
+    size_t parsed = 0;
+    InputEvent event;
+    while (reader.next(event)) ++parsed;
+    benchCheck(parsed == recorded && !reader.truncated(), "every recorded event parses back");
+
+    // 최대 속도 재생
+    reader.rewind();
+    InputReplayer first;
+    bindDefaultHotkeys(first);
+    const ReplayStats stats = first.run(reader);
+    std::snprintf(note, sizeof(note), "%.2f M events/s, %llu moves, %llu display changes",
+                  stats.eventsPerSecond / 1e6, static_cast<unsigned long long>(stats.moves),
+                  static_cast<unsigned long long>(stats.displayChanges));
+    benchReport("input_trace.replay", stats.elapsedNs / stats.events, stats.events, note);
+    benchCheck(stats.events == recorded && stats.moves > 0 && stats.displayChanges > 1, "replay applies the session");
+
+    // 파일로 저장 후 매핑해서 재생해도 결과가 같아야 한다
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "wm_bench_input_trace.wmit";
+    benchCheck(recorder.save(path), "recording saves");
+    InputTraceReader fileReader;
+    InputReplayer second;
+    bindDefaultHotkeys(second);
+    const bool opened = fileReader.open(path);
+    benchCheck(opened, "recording opens from disk");
+    if (opened) second.run(fileReader);
+    benchCheck(first.geometryHash() == second.geometryHash(), "replay is deterministic across runs");
+    std::vector<WindowMove> geometry;
+    second.finalGeometry(geometry);
+    benchCheck(geometry.size() == static_cast<size_t>(kWindows), "final geometry covers every window");
+    std::filesystem::remove(path);
+
+    // 잘리거나 손상된 기록
+    InputTraceReader truncated;
+    benchCheck(truncated.attach(data.data(), data.size() - 5), "truncated recording still attaches");
+    InputReplayer partial;
+    const ReplayStats partialStats = partial.run(truncated);
+    benchCheck(partialStats.truncated && partialStats.events < recorded, "truncated tail is detected");
+    std::vector<unsigned char> corrupt(data.begin(), data.begin() + 64);
+    corrupt[0] ^= 0xFF;
+    benchCheck(!truncated.attach(corrupt.data(), corrupt.size()), "bad magic rejected");
+}
@@ -0,0 +1,233 @@
+#include "bench.h"
+#include "key_input.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+static const std::uint8_t kLeftWin = 0x5B;
+static const std::uint8_t kLeftShift = 0xA0;
+static const std::uint8_t kRightShift = 0xA1;
+static const std::uint8_t kLeftControl = 0xA2;
+static const std::uint8_t kLeft = 0x25;
+
+static std::vector<KeyBinding> makeBindings() {
+    std::vector<KeyBinding> bindings(4);
+    bindings[0].id = 1;
+    bindings[0].first = {KeyModWin, kLeft};
+    bindings[1].id = 2;
+    bindings[1].first = {KeyModAlt, 'G'};
+    bindings[1].taps = 2;
+    bindings[2].id = 3;
+    bindings[2].first = {KeyModAlt, 'G'};
+    bindings[3].id = 4;
+    bindings[3].first = {KeyModControl, 'K'};
+    bindings[3].second = {KeyModControl, 'L'};
+    return bindings;
+}
+
+static double percentile(std::vector<double>& samples, double p) {
+    std::sort(samples.begin(), samples.end());
+    return samples[static_cast<size_t>(p * (samples.size() - 1))];
+}
+
+WM_BENCH(key_input_matching) {
+    KeyFilter filter;
+    filter.build(makeBindings());
+    KeyEvent event;
+
+    benchCheck(filter.filter('A', true, event) == KeyFilterPass, "unbound key passes");
+    benchCheck(filter.filter(kLeft, true, event) == KeyFilterPass, "bound key without modifiers passes");
+    filter.filter(kLeft, false, event);
+
+    benchCheck(filter.filter(kLeftWin, true, event) == KeyFilterPass, "modifier keys pass");
+    unsigned r = filter.filter(kLeft, true, event);
+    benchCheck(r == (KeyFilterPush | KeyFilterSwallow | KeyFilterMaskMenu), "Win+Left is pushed, swallowed, menu masked");
+    benchCheck(event.vk == kLeft && event.modifiers == KeyModWin, "event carries stroke");
+    benchCheck(filter.filter(kLeft, true, event) == KeyFilterSwallow, "auto-repeat is swallowed but not pushed");
+    benchCheck(filter.filter(kLeft, false, event) == KeyFilterSwallow, "key up of swallowed key is swallowed");
+    filter.filter(kLeftWin, false, event);
+    benchCheck(filter.modifiers() == 0, "modifier released");
+
+    filter.filter(kLeftShift, true, event);
+    filter.filter(kRightShift, true, event);
+    filter.filter(kLeftShift, false, event);
+    benchCheck(filter.modifiers() == KeyModShift, "shift stays down while the other side is held");
+    filter.filter(kRightShift, false, event);
+    benchCheck(filter.modifiers() == 0, "shift released when both sides are up");
+
+    filter.filter(kLeftControl, true, event);
+    benchCheck(filter.filter('L', true, event) == KeyFilterPass, "chord second key passes when not armed");
+    filter.filter('L', false, event);
+    filter.setChordArmed(true);
+    benchCheck(filter.filter('L', true, event) == (KeyFilterPush | KeyFilterSwallow), "armed chord key is swallowed");
+    filter.filter('L', false, event);
+    filter.filter(kLeftControl, false, event);
+
+    KeyBindingResolver resolver;
+    resolver.build(makeBindings(), 300);
+    std::vector<int> out;
+    auto press = [&](std::uint8_t modifiers, std::uint8_t vk, std::uint32_t t) {
+        KeyEvent e;
+        e.timeMs = t;
+        e.vk = vk;
+        e.modifiers = modifiers;
+        resolver.feed(e, out);
+    };
+
+    press(KeyModWin, kLeft, 1000);
+    benchCheck(out.size() == 1 && out[0] == 1, "single binding resolves immediately");
+    out.clear();
+
+    press(KeyModAlt, 'G', 2000);
+    benchCheck(out.empty(), "tap waits for a possible double tap");
+    std::uint32_t deadline = 0;
+    benchCheck(resolver.nextDeadline(deadline) && deadline == 2300, "deadline is tap time plus timeout");
+    resolver.poll(2299, out);
+    benchCheck(out.empty(), "not resolved before timeout");
+    resolver.poll(2300, out);
+    benchCheck(out.size() == 1 && out[0] == 3, "single tap resolves at timeout");
+    out.clear();
+
+    press(KeyModAlt, 'G', 3000);
+    press(KeyModAlt, 'G', 3150);
+    benchCheck(out.size() == 1 && out[0] == 2, "double tap resolves immediately");
+    out.clear();
+
+    press(KeyModAlt, 'G', 4000);
+    press(KeyModAlt, 'G', 4400);
+    benchCheck(out.size() == 1 && out[0] == 3, "slow second tap flushes the first as a single tap");
+    out.clear();
+    resolver.poll(5000, out);
+    benchCheck(out.size() == 1 && out[0] == 3, "slow second tap starts a new sequence");
+    out.clear();
+
+    press(KeyModControl, 'K', 6000);
+    benchCheck(resolver.chordArmed(), "chord prefix arms the filter");
+    press(KeyModControl, 'L', 6100);
+    benchCheck(out.size() == 1 && out[0] == 4, "chord resolves on second key");
+    benchCheck(!resolver.chordArmed(), "chord disarms after completion");
+    out.clear();
+
+    press(KeyModControl, 'K', 7000);
+    press(KeyModWin, kLeft, 7050);
+    benchCheck(out.size() == 1 && out[0] == 1, "other binding cancels a pending chord");
+    out.clear();
+    press(KeyModControl, 'L', 7100);
+    resolver.poll(8000, out);
+    benchCheck(out.empty(), "second key alone does nothing");
+
+    // 훅 쪽 조회 비용 (푸시 없는 경로 / 푸시 경로)
+    const std::uint64_t iterations = 2000000;
+    double passNs = measureNsPerOp(iterations, [&](std::uint64_t i) {
+        doNotOptimize(filter.filter(static_cast<std::uint8_t>('A' + (i & 7)), (i & 1) == 0, event));
+    });
+    benchReport("key_input.filter_pass", passNs, iterations);
+
+    filter.filter(kLeftWin, true, event);
+    double matchNs = measureNsPerOp(iterations, [&](std::uint64_t i) {
+        doNotOptimize(filter.filter(kLeft, (i & 1) == 0, event));
+    });
+    filter.filter(kLeftWin, false, event);
+    benchReport("key_input.filter_match", matchNs, iterations);
+}
+
+WM_BENCH(key_input_spsc_ring) {
+    SpscRing<std::uint64_t, 256> ring;
+    for (std::uint64_t i = 0; i < 256; ++i) benchCheck(ring.tryPush(i), "ring accepts up to capacity");
+    benchCheck(!ring.tryPush(999), "full ring rejects push");
+    std::uint64_t value = 0;
+    bool ordered = true;
+    for (std::uint64_t i = 0; i < 256; ++i) ordered = ordered && ring.tryPop(value) && value == i;
+    benchCheck(ordered, "ring pops in FIFO order");
+    benchCheck(!ring.tryPop(value), "empty ring rejects pop");
+
+    // 두 스레드 처리량과 순서 검증
+    // 코어가 하나뿐인 환경도 있으므로 실패하면 양보한다
+    const std::uint64_t count = 5000000;
+    std::atomic<bool> inOrder{true};
+    auto start = BenchClock::now();
+    std::thread consumer([&] {
+        std::uint64_t expected = 0, v = 0;
+        while (expected < count) {
+            if (ring.tryPop(v)) {
+                if (v != expected) inOrder.store(false, std::memory_order_relaxed);
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (std::uint64_t i = 0; i < count;) {
+        if (ring.tryPush(i)) {
+            ++i;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    double ns = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count() / count;
+    benchCheck(inOrder.load(), "concurrent pops see every push in order");
+
+    char note[64];
+    std::snprintf(note, sizeof(note), "%.1f M events/s", 1e3 / ns);
+    benchReport("key_input.spsc_throughput", ns, count, note);
+}
+
+struct LatencyProbe {
+    std::atomic<std::uint64_t> resolved{0};
+    std::atomic<std::int64_t> lastNs{0};
+};
+
+static void onProbeBinding(int, void* context) {
+    auto* probe = static_cast<LatencyProbe*>(context);
+    probe->lastNs.store(BenchClock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    probe->resolved.fetch_add(1, std::memory_order_release);
+}
+
+WM_BENCH(key_input_pipeline_latency) {
+    LatencyProbe probe;
+    KeyInputPipeline pipeline;
+    pipeline.start(makeBindings(), onProbeBinding, &probe);
+
+    // 훅 콜백 한 번에 걸리는 시간과, 작업 스레드가 바인딩을 확정할 때까지의 지연
+    const int rounds = 2000;
+    std::vector<double> hookNs, endToEndNs;
+    hookNs.reserve(rounds);
+    endToEndNs.reserve(rounds);
+    pipeline.onKey(kLeftWin, true);
+    for (int i = 0; i < rounds; ++i) {
+        const std::uint64_t before = probe.resolved.load(std::memory_order_acquire);
+        auto sent = BenchClock::now();
+        unsigned result = pipeline.onKey(kLeft, true);
+        auto returned = BenchClock::now();
+        pipeline.onKey(kLeft, false);
+        benchCheck(result & KeyFilterSwallow, "bound key is swallowed by the pipeline");
+
+        while (probe.resolved.load(std::memory_order_acquire) == before) std::this_thread::yield();
+        hookNs.push_back(std::chrono::duration<double, std::nano>(returned - sent).count());
+        endToEndNs.push_back(static_cast<double>(probe.lastNs.load() - sent.time_since_epoch().count()));
+    }
+    pipeline.onKey(kLeftWin, false);
+
+    // 바인딩되지 않은 키는 링을 거치지 않는다
+    const std::uint64_t passIterations = 1000000;
+    double passNs = measureNsPerOp(passIterations, [&](std::uint64_t i) {
+        doNotOptimize(pipeline.onKey('A', (i & 1) == 0));
+    });
+    pipeline.stop();
+
+    const KeyInputStats stats = pipeline.stats();
+    benchCheck(stats.resolved == static_cast<std::uint64_t>(rounds), "every press resolves exactly once");
+    benchCheck(stats.dropped == 0, "no events dropped");
+
+    char note[96];
+    const double hookP50 = percentile(hookNs, 0.5), hookP99 = percentile(hookNs, 0.99);
+    std::snprintf(note, sizeof(note), "p50 %.0f ns, p99 %.0f ns (worker asleep)", hookP50, hookP99);
+    benchReport("key_input.hook_callback", hookP50, rounds, note);
+    benchCheck(hookP99 < 1e6, "hook callback stays well under the hook timeout");
+
+    const double e2eP50 = percentile(endToEndNs, 0.5), e2eP99 = percentile(endToEndNs, 0.99);
+    std::snprintf(note, sizeof(note), "p50 %.1f us, p99 %.1f us", e2eP50 / 1e3, e2eP99 / 1e3);
+    benchReport("key_input.hook_to_worker", e2eP50, rounds, note);
+    benchReport("key_input.hook_unbound", passNs, passIterations);
+}
@@ -0,0 +1,136 @@
+#include "bench.h"
+#include "latency_trace.h"
+#include "async_move_executor.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+WM_BENCH(latency_histogram_accuracy) {
+    BenchRng rng;
+    bool bounded = true;
+    for (int i = 0; i < 100'000; ++i) {
+        const std::uint64_t v = rng.next() >> (rng.next() & 63);
+        const int bucket = LatencyHistogram::bucketOf(v);
+        bounded = bounded && bucket < LatencyHistogram::kBuckets &&
+                  LatencyHistogram::bucketLow(bucket) <= v && v <= LatencyHistogram::bucketHigh(bucket);
+    }
+    benchCheck(bounded, "every value falls inside its bucket bounds");
+
+    // 100ns ~ 10ms 로그 분포
+    auto histogram = std::make_unique<LatencyHistogram>();
+    std::vector<std::uint64_t> values(200'000);
+    for (auto& v : values) {
+        const double exponent = 2.0 + 5.0 * static_cast<double>(rng.next() % 1'000'000) / 1'000'000.0;
+        v = static_cast<std::uint64_t>(std::pow(10.0, exponent));
+        histogram->record(v);
+    }
+    std::sort(values.begin(), values.end());
+
+    bool accurate = true;
+    for (double p : {1.0, 50.0, 90.0, 99.0, 99.9}) {
+        const std::uint64_t exact = values[static_cast<size_t>(p / 100.0 * values.size() + 0.5) - 1];
+        const double error = std::fabs(static_cast<double>(histogram->percentile(p)) - exact) / exact;
+        accurate = accurate && error <= 1.0 / LatencyHistogram::kSubBuckets;
+    }
+    benchCheck(accurate, "percentiles within one sub-bucket of exact");
+    benchCheck(histogram->count() == values.size() && histogram->min() == values.front() &&
+               histogram->max() == values.back(), "count/min/max are exact");
+    benchCheck(histogram->percentile(100) == values.back(), "p100 is the maximum");
+
+    std::uint64_t sink = 0;
+    double ns = measureNsPerOp(5'000'000, [&](std::uint64_t i) { histogram->record(i & 0xFFFFF); });
+    sink += histogram->count();
+    doNotOptimize(sink);
+    benchReport("latency_trace.histogram_record", ns, 5'000'000);
+}
+
+WM_BENCH(latency_trace_ring) {
+    auto tracer = std::make_unique<LatencyTracer>();
+
+    // 단축키 하나의 전체 구간: 시작 + 4단계
+    const std::uint64_t spans = 1'000'000;
+    double ns = measureNsPerOp(spans, [&](std::uint64_t) {
+        const std::uint32_t span = tracer->beginSpan();
+        tracer->mark(span, TraceStage::ForegroundLookup);
+        tracer->mark(span, TraceStage::GeometryComputed);
+        tracer->mark(span, TraceStage::MoveReturned);
+        tracer->mark(span, TraceStage::TargetReached);
+    });
+    const double perEvent = ns / 5;
+    benchCheck(perEvent < 1000.0, "tracing costs under 1 us per event");
+    benchCheck(tracer->total().count() == spans, "every span reaches the total histogram");
+    benchCheck(tracer->histogram(TraceStage::MoveReturned).count() == spans, "every stage is recorded");
+    benchCheck(tracer->recorded() == spans * 5, "every event goes into the ring");
+    char note[64];
+    std::snprintf(note, sizeof(note), "%.1f ns per event", perEvent);
+    benchReport("latency_trace.span_5_events", ns, spans, note);
+
+    tracer->setEnabled(false);
+    ns = measureNsPerOp(spans, [&](std::uint64_t) {
+        tracer->mark(tracer->beginSpan(), TraceStage::ForegroundLookup);
+    });
+    benchCheck(tracer->recorded() == spans * 5, "disabled tracer records nothing");
+    benchReport("latency_trace.disabled_span", ns, spans);
+    tracer->setEnabled(true);
+
+    // 링은 최근 이벤트만 순서대로 보관
+    std::vector<TraceEvent> events(LatencyTracer::kRingSize);
+    const size_t count = tracer->snapshot(events.data(), events.size());
+    bool ordered = count == LatencyTracer::kRingSize;
+    for (size_t i = 0; ordered && i < count; ++i) {
+        ordered = static_cast<int>(events[i].stage) == static_cast<int>((spans * 5 - count + i) % 5) &&
+                  (i == 0 || events[i].startNs >= events[i - 1].startNs);
+    }
+    benchCheck(ordered, "snapshot returns the newest kRingSize events in order");
+    benchCheck(count > 0 && events[count - 1].span == (spans & 0xFFFFFF), "last event belongs to the last span");
+
+    std::string json;
+    ns = measureNsPerOp(20, [&](std::uint64_t) { tracer->exportChromeTrace(json); });
+    size_t complete = 0;
+    for (size_t at = json.find("\"ph\":\"X\""); at != std::string::npos; at = json.find("\"ph\":\"X\"", at + 1)) ++complete;
+    benchCheck(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[{", 0) == 0, "chrome trace header");
+    const size_t instants = static_cast<size_t>(std::count_if(events.begin(), events.begin() + count,
+        [](const TraceEvent& e) { return e.stage == TraceStage::HotkeyReceived; }));
+    benchCheck(complete == count - instants, "one complete event per stage after the hotkey instant");
+    benchCheck(json.find("\"otherData\":{\"foreground\":\"count=1000000") != std::string::npos, "histogram summary exported");
+    benchCheck(json.size() > 2 && json.compare(json.size() - 3, 3, "}}\n") == 0, "json closed");
+    benchReport("latency_trace.export_chrome_4096", ns, 20);
+
+    // 작업 스레드와 UI 스레드가 동시에 기록해도 깨진 이벤트가 없어야 한다
+    tracer->reset();
+    std::thread worker([&] {
+        for (int i = 0; i < 200'000; ++i) tracer->mark(tracer->beginSpan(), TraceStage::MoveReturned);
+    });
+    for (int i = 0; i < 200'000; ++i) tracer->mark(tracer->beginSpan(), TraceStage::ForegroundLookup);
+    worker.join();
+    const size_t mixed = tracer->snapshot(events.data(), events.size());
+    bool intact = mixed == LatencyTracer::kRingSize;
+    for (size_t i = 0; i < mixed; ++i) {
+        intact = intact && events[i].span != 0 && static_cast<int>(events[i].stage) < static_cast<int>(TraceStage::Count);
+    }
+    benchCheck(intact, "concurrent writers leave no torn events");
+}
+
+WM_BENCH(latency_trace_async_moves) {
+    auto tracer = std::make_unique<LatencyTracer>();
+    SlowWindowMoveBackend backend;
+    for (WindowId w = 1; w <= 32; ++w) backend.addWindow(w, {0, 0, 100, 100});
+    AsyncMoveExecutor executor(backend, 2);
+    executor.setTracer(tracer.get());
+
+    for (WindowId w = 1; w <= 32; ++w) {
+        const std::uint32_t span = tracer->beginSpan();
+        tracer->mark(span, TraceStage::ForegroundLookup);
+        tracer->mark(span, TraceStage::GeometryComputed);
+        executor.submit(w, {static_cast<int>(w), 0, static_cast<int>(w) + 200, 150}, span);
+    }
+    benchCheck(executor.waitIdle(2'000'000'000), "traced moves drain");
+    benchCheck(tracer->histogram(TraceStage::MoveReturned).count() == 32, "worker records move returned");
+    benchCheck(tracer->total().count() == 32, "worker records target reached");
+
+    char note[96];
+    std::snprintf(note, sizeof(note), "hotkey->settled p50 %.1f us, p99 %.1f us",
+                  tracer->total().percentile(50) / 1000.0, tracer->total().percentile(99) / 1000.0);
+    benchReport("latency_trace.async_total", tracer->total().mean(), 32, note);
+}
@@ -0,0 +1,159 @@
+#include "bench.h"
+#include "layout_store.h"
+#include <cstring>
+#include <string>
+
+using namespace layout_format;
+
+static std::filesystem::path benchFile(const char* name) {
+    return std::filesystem::temp_directory_path() / name;
+}
+
+static LayoutSnapshotWriter makeWriter(int layoutCount, int windowsPerLayout) {
+    LayoutSnapshotWriter writer;
+    writer.setGrid(8, 6, 0.25f, true);
+
+    std::vector<StoredWindowLayout> windows(windowsPerLayout);
+    std::vector<std::uint64_t> titles(windowsPerLayout);
+    for (int l = 0; l < layoutCount; ++l) {
+        for (int w = 0; w < windowsPerLayout; ++w) {
+            windows[w] = {static_cast<std::uint64_t>(l) * 1000 + w, {w * 10, l, w * 10 + 800, l + 600}, w % 3,
+                          w == 0 ? static_cast<std::uint32_t>(WindowMaximized) : 0u};
+            titles[w] = static_cast<std::uint64_t>(l) * 1000 + w + 500;
+        }
+        writer.addLayout("layout-" + std::to_string(l), windows, titles);
+    }
+
+    WindowRuleConfig rule;
+    rule.className = "Chrome_WidgetWin_1";
+    rule.titlePattern = "*Trading*";
+    rule.executable = "chrome.exe";
+    rule.action = 2;
+    rule.slot = 4;
+    rule.minWidth = 640;
+    writer.addRule(rule);
+    writer.addMonitorConfig({0xABCDEF, 1, 4, 3});
+    return writer;
+}
+
+WM_BENCH(layout_store_roundtrip) {
+    const auto path = benchFile("wm_bench_roundtrip.layout");
+    LayoutSnapshotWriter writer = makeWriter(50, 12);
+    benchCheck(writer.writeAtomic(path), "atomic write succeeds");
+
+    LayoutSnapshot snapshot;
+    benchCheck(snapshot.open(path), "snapshot opens");
+    if (!snapshot.isOpen()) return;
+
+    benchCheck(snapshot.grid()->rows == 8 && snapshot.grid()->cols == 6 && snapshot.grid()->visible == 1,
+               "grid round-trips");
+    benchCheck(snapshot.layoutCount() == 50, "layout count round-trips");
+
+    LayoutSnapshot::LayoutView view;
+    benchCheck(snapshot.findLayout("layout-37", view), "layout found by name");
+    benchCheck(view.windowCount == 12 && view.windows[3].windowKey == 37003 &&
+               view.windows[3].position.left == 30 && view.windows[0].flags == WindowMaximized,
+               "window records round-trip");
+    benchCheck(view.titleHashes && view.titleHashes[3] == 37503, "window title hashes round-trip");
+    benchCheck(!snapshot.findLayout("layout-999", view), "missing layout is not found");
+
+    benchCheck(snapshot.ruleCount() == 1, "rule count round-trips");
+    WindowRuleConfig rule = snapshot.ruleConfig(0);
+    benchCheck(rule.className == "Chrome_WidgetWin_1" && rule.titlePattern == "*Trading*" &&
+               rule.executable == "chrome.exe" && rule.slot == 4 && rule.minWidth == 640,
+               "rule round-trips");
+    benchCheck(snapshot.monitorConfigCount() == 1 && snapshot.monitorConfig(0).topologyKey == 0xABCDEF &&
+               snapshot.monitorConfig(0).rows == 4, "monitor config round-trips");
+    {
+        const MonitorGridConfig stored = {0xABCDEF, 1, 4, 3};
+        benchCheck(stored.valid() && !MonitorGridConfig{0, 0, 0, 4}.valid() &&
+                       !MonitorGridConfig{0, 0, 4, 65}.valid() && !MonitorGridConfig{0, -1, 4, 4}.valid(),
+                   "monitor grid range check");
+        int rows = 12, cols = 12;
+        monitorGridSize({stored}, 0, rows, cols);
+        const bool otherKept = rows == 12 && cols == 12;
+        monitorGridSize({stored}, 1, rows, cols);
+        benchCheck(otherKept && rows == 4 && cols == 3, "monitor grid overrides only its monitor");
+    }
+    snapshot.close();
+
+    // 손상 검출: 모든 손상은 열기 실패로 끝나야 한다
+    std::vector<unsigned char> image = writer.serialize();
+    LayoutSnapshot probe;
+    benchCheck(probe.attach(image.data(), image.size()), "pristine image attaches");
+
+    for (size_t offset : {size_t(0), size_t(9), size_t(40), size_t(100), image.size() / 2, image.size() - 9}) {
+        std::vector<unsigned char> corrupt = image;
+        corrupt[offset] ^= 0x5A;
+        benchCheck(!probe.attach(corrupt.data(), corrupt.size()), "flipped byte is rejected");
+    }
+    for (size_t length : {size_t(0), size_t(16), image.size() / 3, image.size() - 1}) {
+        benchCheck(!probe.attach(image.data(), length), "truncated image is rejected");
+    }
+    {
+        std::vector<unsigned char> future = image;
+        FileHeader header;
+        std::memcpy(&header, future.data(), sizeof(header));
+        header.version = kVersion + 1;
+        std::memcpy(future.data(), &header, sizeof(header));
+        benchCheck(!probe.attach(future.data(), future.size()), "unknown version is rejected");
+    }
+    {
+        // 체크섬까지 맞춘 잘못된 윈도우 범위도 거부
+        std::vector<unsigned char> bad = image;
+        SectionEntry layouts;
+        std::memcpy(&layouts, bad.data() + sizeof(FileHeader) + sizeof(SectionEntry), sizeof(layouts));
+        StoredLayout first;
+        std::memcpy(&first, bad.data() + layouts.offset, sizeof(first));
+        first.windowCount = 100000;
+        std::memcpy(bad.data() + layouts.offset, &first, sizeof(first));
+        FileHeader header;
+        std::memcpy(&header, bad.data(), sizeof(header));
+        header.checksum = checksum(bad.data() + sizeof(FileHeader), bad.size() - sizeof(FileHeader));
+        std::memcpy(bad.data(), &header, sizeof(header));
+        benchCheck(!probe.attach(bad.data(), bad.size()), "out-of-range window span is rejected");
+    }
+    {
+        // 체크섬이 맞는 파일이라도 범위를 벗어난 그리드 값은 거부
+        LayoutSnapshotWriter huge;
+        huge.setGrid(0x7fffffff, 12, 0.5f, true);
+        const std::vector<unsigned char> rows = huge.serialize();
+        LayoutSnapshotWriter opaque;
+        opaque.setGrid(12, 12, 2.0f, true);
+        const std::vector<unsigned char> opacity = opaque.serialize();
+        benchCheck(!probe.attach(rows.data(), rows.size()) && !probe.attach(opacity.data(), opacity.size()),
+                   "out-of-range grid is rejected");
+    }
+
+    // 쓰기 도중 실패해도 기존 파일 유지: 임시 파일이 남지 않아야 한다
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    benchCheck(!std::filesystem::exists(temp), "temp file is renamed away");
+    std::filesystem::remove(path);
+}
+
+WM_BENCH(layout_store_load) {
+    const auto path = benchFile("wm_bench_load.layout");
+    const int kLayouts = 5000;
+    LayoutSnapshotWriter writer = makeWriter(kLayouts, 8);
+
+    auto writeStart = BenchClock::now();
+    benchCheck(writer.writeAtomic(path), "large snapshot written");
+    double writeMs = std::chrono::duration<double, std::milli>(BenchClock::now() - writeStart).count();
+    char note[96];
+    std::snprintf(note, sizeof(note), "%d layouts, %.2f ms write, %llu bytes", kLayouts, writeMs,
+                  static_cast<unsigned long long>(std::filesystem::file_size(path)));
+
+    const std::uint64_t iterations = 200;
+    size_t found = 0;
+    double ns = measureNsPerOp(iterations, [&](std::uint64_t i) {
+        LayoutSnapshot snapshot;
+        if (!snapshot.open(path)) return;
+        LayoutSnapshot::LayoutView view;
+        std::string name = "layout-" + std::to_string((i * 37) % kLayouts);
+        found += snapshot.findLayout(name, view) ? view.windowCount : 0;
+    });
+    benchCheck(found == iterations * 8, "every load finds its layout");
+    benchReport("layout_store.open_and_find_5000", ns, iterations, note);
+    std::filesystem::remove(path);
+}
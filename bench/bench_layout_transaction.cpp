@@ -0,0 +1,64 @@
+#include "bench.h"
+#include "layout_transaction.h"
+
+static Rect cellRect(int i, int offset) {
+    int col = i % 8, row = i / 8;
+    return {col * 480 + offset, row * 400, col * 480 + 480 + offset, row * 400 + 400};
+}
+
+WM_BENCH(layout_transaction_commit) {
+    // 40창 레이아웃 복원: 10개는 이미 제자리, 1개는 중복 요청
+    {
+        FakeWindowMoveBackend backend;
+        LayoutTransaction transaction(backend);
+        for (int i = 0; i < 40; ++i) backend.addWindow(i + 1, cellRect(i, i < 10 ? 0 : 7));
+        for (int i = 0; i < 40; ++i) transaction.move(i + 1, cellRect(i, 0));
+        transaction.move(40, cellRect(39, 3));
+        transaction.move(40, cellRect(39, 0));
+
+        LayoutCommitStats stats = transaction.commit();
+        benchCheck(stats.requested == 40, "duplicate moves collapse to one");
+        benchCheck(stats.issued == 30 && stats.skipped == 10, "no-op moves are skipped");
+        benchCheck(stats.batches == 1 && backend.batchCalls == 1 && backend.singleCalls == 0,
+                   "moves commit in a single batch");
+        benchCheck(*backend.rectOf(40) == cellRect(39, 0), "last request for a window wins");
+        benchCheck(transaction.empty(), "commit clears the transaction");
+
+        stats = transaction.commit();
+        benchCheck(stats.issued == 0 && backend.batchCalls == 1, "empty commit issues nothing");
+    }
+
+    // 배치 중 한 창이 실패하면 개별 이동으로 대체
+    {
+        FakeWindowMoveBackend backend;
+        LayoutTransaction transaction(backend);
+        for (int i = 0; i < 40; ++i) backend.addWindow(i + 1, cellRect(i, 5));
+        backend.setFailing(17);
+        backend.removeWindow(23);
+        for (int i = 0; i < 40; ++i) transaction.move(i + 1, cellRect(i, 0));
+
+        LayoutCommitStats stats = transaction.commit();
+        benchCheck(stats.fellBack, "failed batch falls back");
+        benchCheck(stats.issued == 38 && stats.failed == 2, "fallback moves the healthy windows");
+        benchCheck(backend.singleCalls == 39, "fallback issues one move per window");
+    }
+
+    for (int count : {40, 1000}) {
+        FakeWindowMoveBackend backend;
+        LayoutTransaction transaction(backend);
+        for (int i = 0; i < count; ++i) backend.addWindow(i + 1, cellRect(i, 0));
+
+        const std::uint64_t iterations = count == 40 ? 100'000 : 5'000;
+        size_t issued = 0;
+        double ns = measureNsPerOp(iterations, [&](std::uint64_t iter) {
+            int offset = static_cast<int>(iter & 1);
+            for (int i = 0; i < count; ++i) transaction.move(i + 1, cellRect(i, offset));
+            issued += transaction.commit().issued;
+        });
+        doNotOptimize(issued);
+        char note[64];
+        std::snprintf(note, sizeof(note), "%d windows, %zu batch calls", count, backend.batchCalls);
+        benchReport(count == 40 ? "layout_transaction.commit_40" : "layout_transaction.commit_1000",
+                    ns, iterations, note);
+    }
+}
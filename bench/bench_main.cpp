@@ -0,0 +1,97 @@
+#include "bench.h"
+#include <cstring>
+
+std::vector<BenchCase>& benchRegistry() {
+    static std::vector<BenchCase> registry;
+    return registry;
+}
+
+enum class BenchFormat { Text, Json, Csv };
+
+static int g_failures = 0;
+static BenchFormat g_format = BenchFormat::Text;
+static const char* g_currentCase = "";
+
+void benchCheck(bool condition, const char* what) {
+    if (condition) return;
+    ++g_failures;
+    std::fprintf(stderr, "CHECK FAILED: %s\n", what);
+}
+
+// JSON/CSV 문자열 값 출력 (따옴표/역슬래시/제어 문자만 이스케이프)
+static void printQuoted(const char* text, bool json) {
+    std::putchar('"');
+    for (const char* p = text; *p; ++p) {
+        if (*p == '"') {
+            std::fputs(json ? "\\\"" : "\"\"", stdout);
+        } else if (json && *p == '\\') {
+            std::fputs("\\\\", stdout);
+        } else if (static_cast<unsigned char>(*p) < 0x20) {
+            std::putchar(' ');
+        } else {
+            std::putchar(*p);
+        }
+    }
+    std::putchar('"');
+}
+
+void benchReport(const char* name, double nsPerOp, std::uint64_t ops, const char* note) {
+    const unsigned long long count = static_cast<unsigned long long>(ops);
+    switch (g_format) {
+        case BenchFormat::Text:
+            std::printf("%-48s %12.2f ns/op %12llu ops  %s\n", name, nsPerOp, count, note);
+            break;
+        case BenchFormat::Json:
+            // 한 줄에 결과 하나 (JSON Lines) - 릴리스 간 비교 스크립트용
+            std::fputs("{\"case\":", stdout);
+            printQuoted(g_currentCase, true);
+            std::fputs(",\"name\":", stdout);
+            printQuoted(name, true);
+            std::printf(",\"ns_per_op\":%.3f,\"ops\":%llu,\"note\":", nsPerOp, count);
+            printQuoted(note, true);
+            std::fputs("}\n", stdout);
+            break;
+        case BenchFormat::Csv:
+            printQuoted(g_currentCase, false);
+            std::putchar(',');
+            printQuoted(name, false);
+            std::printf(",%.3f,%llu,", nsPerOp, count);
+            printQuoted(note, false);
+            std::putchar('\n');
+            break;
+    }
+}
+
+// 사용법: wm_bench [--json | --csv] [--list] [이름 필터]
+//         wm_bench --replay <입력 기록 파일>
+int main(int argc, char** argv) {
+    const char* filter = nullptr;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            g_format = BenchFormat::Json;
+        } else if (std::strcmp(argv[i], "--csv") == 0) {
+            g_format = BenchFormat::Csv;
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            return replayInputTrace(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            list = true;
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    if (g_format == BenchFormat::Csv && !list) std::puts("case,name,ns_per_op,ops,note");
+    for (const auto& bench : benchRegistry()) {
+        if (filter && !std::strstr(bench.name, filter)) continue;
+        if (list) {
+            std::puts(bench.name);
+            continue;
+        }
+        g_currentCase = bench.name;
+        bench.fn();
+        std::fflush(stdout);
+    }
+    if (g_failures) std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,106 @@
+#include "bench.h"
+#include "monitor_topology.h"
+#include <algorithm>
+
+// 4K + QHD 2대 + 세로 FHD 구성 (일부러 열거 순서를 섞어둠)
+static std::vector<MonitorInfo> simulatedLayout() {
+    std::vector<MonitorInfo> monitors(4);
+    monitors[0].bounds = {0, 0, 3840, 2160};
+    monitors[0].workArea = {0, 0, 3840, 2100};
+    monitors[0].dpi = 144;
+    monitors[0].primary = true;
+    monitors[1].bounds = {-2560, 0, 0, 1440};
+    monitors[1].workArea = {-2560, 0, 0, 1400};
+    monitors[2].bounds = {3840, 0, 6400, 1440};
+    monitors[2].workArea = {3840, 0, 6400, 1400};
+    monitors[3].bounds = {6400, -300, 7480, 1620};
+    monitors[3].workArea = {6400, -300, 7480, 1580};
+    for (size_t i = 0; i < monitors.size(); ++i) monitors[i].handle = 0x1000 + i;
+    return monitors;
+}
+
+// MonitorInfo 배열을 조기 종료 없이 전부 훑는 기준 구현 (MonitorFromPoint 대체 비교용)
+static int bruteForceFromPoint(const std::vector<MonitorInfo>& monitors, Point pt) {
+    int nearest = -1;
+    long long best = -1;
+    for (const auto& m : monitors) {
+        long long d = distanceSquared(m.bounds, pt);
+        if (best < 0 || d < best) {
+            best = d;
+            nearest = m.index;
+        }
+    }
+    return nearest;
+}
+
+WM_BENCH(monitor_topology_lookup) {
+    SimulatedMonitorBackend backend;
+    backend.setMonitors(simulatedLayout());
+    MonitorTopology topology;
+    topology.rebuild(backend);
+
+    benchCheck(topology.size() == 4, "topology has 4 monitors");
+    benchCheck(topology.monitor(0).bounds.left == -2560, "monitors sorted by position");
+    benchCheck(topology.primaryIndex() == 1, "primary index follows sort");
+    {
+        // 열거 순서가 바뀌어도 같은 배치면 같은 키, 모니터 하나가 옮겨지면 다른 키
+        std::vector<MonitorInfo> monitors = simulatedLayout();
+        std::reverse(monitors.begin(), monitors.end());
+        SimulatedMonitorBackend reordered;
+        reordered.setMonitors(monitors);
+        MonitorTopology other;
+        other.rebuild(reordered);
+        const std::uint64_t sameKey = other.key();
+        monitors[0].bounds.left -= 10;
+        reordered.setMonitors(monitors);
+        other.rebuild(reordered);
+        benchCheck(sameKey == topology.key() && other.key() != topology.key(), "topology key follows the arrangement");
+    }
+
+    BenchRng rng;
+    const int kPoints = 4096;
+    std::vector<Point> points(kPoints);
+    for (auto& pt : points) pt = {rng.range(-3000, 8000), rng.range(-500, 2500)};
+
+    for (const auto& pt : points) {
+        benchCheck(topology.monitorFromPoint(pt) == bruteForceFromPoint(topology.monitors(), pt),
+                   "monitorFromPoint matches brute force");
+    }
+
+    const std::uint64_t iterations = 4'000'000;
+    int sink = 0;
+    double ns = measureNsPerOp(iterations, [&](std::uint64_t i) {
+        sink += topology.monitorFromPoint(points[i & (kPoints - 1)]);
+    });
+    doNotOptimize(sink);
+    benchReport("monitor_topology.from_point.random", ns, iterations);
+
+    ns = measureNsPerOp(iterations, [&](std::uint64_t i) {
+        sink += bruteForceFromPoint(topology.monitors(), points[i & (kPoints - 1)]);
+    });
+    doNotOptimize(sink);
+    benchReport("monitor_topology.from_point.brute_force", ns, iterations);
+
+    // 스냅 경로처럼 같은 모니터의 창을 연속으로 조회
+    Rect window = {100, 100, 1300, 900};
+    ns = measureNsPerOp(iterations, [&](std::uint64_t i) {
+        Rect r = window;
+        r.left += static_cast<int>(i & 255);
+        r.right += static_cast<int>(i & 255);
+        sink += topology.monitorFromRect(r);
+    });
+    doNotOptimize(sink);
+    benchReport("monitor_topology.from_rect.same_monitor", ns, iterations);
+
+    ns = measureNsPerOp(iterations, [&](std::uint64_t i) {
+        const Point& pt = points[i & (kPoints - 1)];
+        Rect r = {pt.x, pt.y, pt.x + 800, pt.y + 600};
+        sink += topology.monitorFromRect(r);
+    });
+    doNotOptimize(sink);
+    benchReport("monitor_topology.from_rect.random", ns, iterations);
+
+    const std::uint64_t rebuilds = 200'000;
+    ns = measureNsPerOp(rebuilds, [&](std::uint64_t) { topology.rebuild(backend); });
+    benchReport("monitor_topology.rebuild", ns, rebuilds);
+}
@@ -0,0 +1,186 @@
+#include "bench.h"
+#include "overlay_surfaces.h"
+#include <cstring>
+
+static std::vector<MonitorInfo> makeMonitors() {
+    std::vector<MonitorInfo> monitors(2);
+    monitors[0].handle = 1;
+    monitors[0].bounds = {0, 0, 3840, 2160};
+    monitors[0].workArea = {0, 0, 3840, 2100};
+    monitors[0].dpi = 144;
+    monitors[0].primary = true;
+    monitors[1].handle = 2;
+    monitors[1].bounds = {3840, 0, 5760, 1080};
+    monitors[1].workArea = {3840, 0, 5760, 1040};
+    return monitors;
+}
+
+static bool sameBuffer(const ArgbBuffer& a, const ArgbBuffer& b) {
+    return a.width() == b.width() && a.height() == b.height() &&
+           std::memcmp(a.data(), b.data(), a.byteSize()) == 0;
+}
+
+// 같은 상태를 처음부터 그린 결과
+static void renderReference(const MonitorTopology& topology, const OverlayStyle& style, int monitorIndex,
+                            const Rect* highlight, ArgbBuffer& out) {
+    OverlaySurfaceSet fresh;
+    fresh.sync(topology, style);
+    if (highlight) fresh.setHighlight(monitorIndex, *highlight);
+    Rect updated;
+    fresh.render(monitorIndex, updated);
+    out = fresh.surface(monitorIndex).buffer();
+}
+
+WM_BENCH(overlay_surfaces_invalidation) {
+    DirtyRegion region;
+    region.add({0, 0, 10, 10});
+    region.add({10, 0, 20, 10});
+    benchCheck(region.count() == 1 && region.rect(0) == Rect{0, 0, 20, 10}, "touching dirty rects merge");
+    region.add({100, 100, 110, 110});
+    benchCheck(region.count() == 2, "separate dirty rects stay separate");
+    for (int i = 0; i < 20; ++i) region.add({i * 50, 500, i * 50 + 10, 510});
+    benchCheck(region.count() <= DirtyRegion::kMaxRects, "dirty region is bounded");
+    benchCheck(region.bounds() == Rect{0, 0, 960, 510}, "collapsed region covers everything");
+
+    SimulatedMonitorBackend backend;
+    auto monitors = makeMonitors();
+    backend.setMonitors(monitors);
+    MonitorTopology topology;
+    topology.rebuild(backend);
+
+    OverlayStyle style;
+    style.visible = true;
+    OverlaySurfaceSet surfaces;
+    surfaces.sync(topology, style);
+    Rect updated;
+    benchCheck(surfaces.render(0, updated) && surfaces.render(1, updated), "first sync renders every monitor");
+    benchCheck(surfaces.stats().fullRenders == 2, "one full render per monitor");
+    benchCheck(surfaces.surface(0).bounds() == monitors[0].bounds, "surface covers the monitor");
+
+    // 설정이 같으면 다시 그리지 않는다 (토글/토폴로지 재구성 포함)
+    topology.rebuild(backend);
+    surfaces.sync(topology, style);
+    benchCheck(!surfaces.needsRender(0) && !surfaces.needsRender(1), "unchanged sync does not re-render");
+
+    // 한 모니터의 작업 영역/DPI 만 바뀌면 그 모니터만 다시 그린다
+    monitors[1].workArea.bottom = 1000;
+    backend.setMonitors(monitors);
+    topology.rebuild(backend);
+    surfaces.sync(topology, style);
+    benchCheck(!surfaces.needsRender(0) && surfaces.needsRender(1), "work area change invalidates one monitor");
+    surfaces.render(1, updated);
+    benchCheck(updated == Rect{0, 0, 1920, 1080}, "work area change re-renders the full surface");
+
+    monitors[0].dpi = 192;
+    backend.setMonitors(monitors);
+    topology.rebuild(backend);
+    surfaces.sync(topology, style);
+    benchCheck(surfaces.needsRender(0) && !surfaces.needsRender(1), "dpi change invalidates one monitor");
+    surfaces.render(0, updated);
+
+    style.rows = 6;
+    surfaces.sync(topology, style);
+    benchCheck(surfaces.needsRender(0) && surfaces.needsRender(1), "grid size change invalidates every monitor");
+    surfaces.render(0, updated);
+    surfaces.render(1, updated);
+
+    // 모니터별 그리드는 그 모니터만 다시 그린다
+    style.monitorGrids = {{topology.key(), 1, 3, 4}};
+    surfaces.sync(topology, style);
+    benchCheck(!surfaces.needsRender(0) && surfaces.needsRender(1) && surfaces.surface(1).lines().ys().size() == 4 &&
+                   surfaces.surface(1).lines().xs().size() == 5,
+               "per-monitor grid invalidates only its monitor");
+    style.monitorGrids.clear();
+    surfaces.sync(topology, style);
+    surfaces.render(1, updated);
+
+    // 강조 이동은 이전/새 영역만 다시 그리고, 결과는 전체 다시 그리기와 같아야 한다
+    const GridLines& lines = surfaces.surface(0).lines();
+    const Rect cellA = {lines.xs()[1], lines.ys()[1], lines.xs()[3], lines.ys()[2]};
+    const Rect cellB = {lines.xs()[4], lines.ys()[3], lines.xs()[6], lines.ys()[5]};
+    const std::uint64_t pixelsBefore = surfaces.stats().pixelsRendered;
+    const std::uint64_t fullBefore = surfaces.stats().fullRenders;
+
+    surfaces.setHighlight(0, cellA);
+    benchCheck(surfaces.needsRender(0) && !surfaces.needsRender(1), "highlight dirties only its monitor");
+    surfaces.render(0, updated);
+    benchCheck(updated == cellA, "highlight renders only the cell");
+
+    ArgbBuffer reference;
+    renderReference(topology, style, 0, &cellA, reference);
+    benchCheck(sameBuffer(surfaces.surface(0).buffer(), reference), "partial render equals full render");
+
+    surfaces.setHighlight(0, cellB);
+    surfaces.render(0, updated);
+    renderReference(topology, style, 0, &cellB, reference);
+    benchCheck(sameBuffer(surfaces.surface(0).buffer(), reference), "moved highlight equals full render");
+
+    surfaces.setHighlight(0, cellB);
+    benchCheck(!surfaces.needsRender(0), "same highlight is not redrawn");
+
+    surfaces.clearHighlights();
+    surfaces.render(0, updated);
+    renderReference(topology, style, 0, nullptr, reference);
+    benchCheck(sameBuffer(surfaces.surface(0).buffer(), reference), "cleared highlight equals full render");
+
+    benchCheck(surfaces.stats().fullRenders == fullBefore, "highlight changes never re-render fully");
+    const std::uint64_t partialPixels = surfaces.stats().pixelsRendered - pixelsBefore;
+    benchCheck(partialPixels < static_cast<std::uint64_t>(3840) * 2160, "highlight changes touch less than a frame");
+
+    // 화면 밖으로 걸친 강조도 버퍼 안으로 잘린다
+    surfaces.setHighlight(0, {3700, 2000, 4000, 2300});
+    surfaces.render(0, updated);
+    benchCheck(updated == Rect{3700, 2000, 3840, 2160}, "dirty rect is clipped to the surface");
+}
+
+WM_BENCH(overlay_surfaces_throughput) {
+    SimulatedMonitorBackend backend;
+    backend.setMonitors(makeMonitors());
+    MonitorTopology topology;
+    topology.rebuild(backend);
+
+    OverlayStyle style;
+    style.visible = true;
+    OverlaySurfaceSet surfaces;
+    surfaces.sync(topology, style);
+    Rect updated;
+    surfaces.render(0, updated);
+    surfaces.render(1, updated);
+
+    // 기준: 4K 모니터 전체 다시 그리기 (예전 InvalidateRect(NULL) 경로)
+    const std::uint64_t fullIterations = 30;
+    double fullNs = measureNsPerOp(fullIterations, [&](std::uint64_t i) {
+        style.opacity = (i & 1) ? 0.5f : 0.51f;
+        surfaces.sync(topology, style);
+        surfaces.render(0, updated);
+    });
+    char note[64];
+    std::snprintf(note, sizeof(note), "%.2f ms/frame", fullNs / 1e6);
+    benchReport("overlay_surfaces.full_render_4k", fullNs, fullIterations, note);
+
+    // 토글: 설정이 그대로면 sync 만 하고 다시 그리지 않는다
+    surfaces.render(1, updated);
+    const std::uint64_t toggleIterations = 100000;
+    const std::uint64_t fullRendersBefore = surfaces.stats().fullRenders;
+    double toggleNs = measureNsPerOp(toggleIterations, [&](std::uint64_t) {
+        surfaces.sync(topology, style);
+        for (int m = 0; m < surfaces.size(); ++m) {
+            if (surfaces.needsRender(m)) surfaces.render(m, updated);
+        }
+    });
+    benchCheck(surfaces.stats().fullRenders == fullRendersBefore, "toggle does not re-render");
+    benchReport("overlay_surfaces.toggle", toggleNs, toggleIterations);
+
+    // 드래그 중 강조 셀 이동 (이전 셀 + 새 셀만 다시 그리기)
+    const GridLines& lines = surfaces.surface(0).lines();
+    const std::uint64_t dragIterations = 2000;
+    double dragNs = measureNsPerOp(dragIterations, [&](std::uint64_t i) {
+        const int c = static_cast<int>(i % 11);
+        const int r = static_cast<int>((i / 11) % 11);
+        surfaces.setHighlight(0, {lines.xs()[c], lines.ys()[r], lines.xs()[c + 1], lines.ys()[r + 1]});
+        surfaces.render(0, updated);
+    });
+    std::snprintf(note, sizeof(note), "%.1fx faster than full render", fullNs / dragNs);
+    benchReport("overlay_surfaces.highlight_move", dragNs, dragIterations, note);
+    benchCheck(dragNs < fullNs, "highlight move is cheaper than a full render");
+}
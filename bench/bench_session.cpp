@@ -0,0 +1,157 @@
+#include "bench.h"
+#include "layout_store.h"
+#include "layout_transaction.h"
+#include "monitor_topology.h"
+#include "snap_geometry.h"
+#include "tiling_engine.h"
+#include "window_registry.h"
+#include "window_state_table.h"
+
+// 매크로 벤치마크: 가상 모니터 4대와 창 4000개로 한 세션의 주요 경로를 순서대로 돌린다
+// (시작 열거 -> 이벤트 폭주 -> 단축키 스냅 -> 상태 저장 -> 레이아웃 저장/읽기 -> 자동 타일링)
+
+static MonitorTopology simulatedTopology() {
+    std::vector<MonitorInfo> monitors(4);
+    monitors[0].bounds = {0, 0, 3840, 2160};
+    monitors[0].workArea = {0, 0, 3840, 2100};
+    monitors[0].primary = true;
+    monitors[1].bounds = {-2560, 0, 0, 1440};
+    monitors[1].workArea = {-2560, 0, 0, 1400};
+    monitors[2].bounds = {3840, 0, 6400, 1440};
+    monitors[2].workArea = {3840, 0, 6400, 1400};
+    monitors[3].bounds = {6400, -300, 7480, 1620};
+    monitors[3].workArea = {6400, -300, 7480, 1580};
+    for (size_t i = 0; i < monitors.size(); ++i) monitors[i].handle = 0x1000 + i;
+
+    SimulatedMonitorBackend backend;
+    backend.setMonitors(monitors);
+    MonitorTopology topology;
+    topology.rebuild(backend);
+    return topology;
+}
+
+static double elapsedNs(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+}
+
+WM_BENCH(session_macro) {
+    const int kWindows = 4000;
+    const MonitorTopology topology = simulatedTopology();
+    BenchRng rng;
+
+    SimulatedWindowInfoSource source;
+    FakeWindowMoveBackend moveBackend;
+    std::vector<WindowId> ids(kWindows);
+    for (int i = 0; i < kWindows; ++i) {
+        ids[i] = static_cast<WindowId>(0x20000 + i * 8);
+        const Rect& work = topology.monitor(i % topology.size()).workArea;
+        const int x = rng.range(work.left, work.right - 200), y = rng.range(work.top, work.bottom - 150);
+        WindowSnapshot snapshot;
+        snapshot.rect = {x, y, x + 200 + rng.range(0, 800), y + 150 + rng.range(0, 600)};
+        snapshot.visible = snapshot.manageable = true;
+        source.set(ids[i], snapshot);
+        moveBackend.addWindow(ids[i], snapshot.rect);
+    }
+    auto sessionStart = BenchClock::now();
+
+    // 1. 시작 시 열거
+    WindowRegistry registry;
+    auto start = BenchClock::now();
+    for (WindowId id : ids) registry.seed(id, source);
+    benchReport("session.seed", elapsedNs(start) / kWindows, kWindows, "4000 windows");
+    benchCheck(registry.size() == static_cast<size_t>(kWindows), "every window seeded");
+
+    // 2. 이벤트 폭주: 위치 변경 위주, 일부 숨김/표시
+    WindowEventQueue queue;
+    std::vector<WindowUpdate> updates;
+    const int kEvents = 400'000;
+    start = BenchClock::now();
+    for (int i = 0; i < kEvents; ++i) {
+        const WindowId id = ids[rng.next() % kWindows];
+        const unsigned kind = static_cast<unsigned>(rng.next() % 100);
+        queue.push(id, kind < 90 ? WindowEventType::LocationChanged
+                       : kind < 95 ? WindowEventType::Hidden : WindowEventType::Shown);
+        if ((i & 4095) == 4095) {
+            queue.drain(updates);
+            registry.apply(updates, source);
+        }
+    }
+    queue.drain(updates);
+    registry.apply(updates, source);
+    char note[96];
+    std::snprintf(note, sizeof(note), "%llu queries for %d events",
+                  static_cast<unsigned long long>(source.queries), kEvents);
+    benchReport("session.event_storm", elapsedNs(start) / kEvents, kEvents, note);
+
+    // 3. 모든 창을 단축키 위치로 스냅하고 한 번에 커밋
+    LayoutTransaction transaction(moveBackend);
+    RatioCycler cycler;
+    start = BenchClock::now();
+    for (int i = 0; i < kWindows; ++i) {
+        const WindowRecord* record = registry.find(ids[i]);
+        if (!record) continue;
+        const Rect& work = topology.monitor(topology.monitorFromRect(record->state.rect)).workArea;
+        const Rect target = (i & 1) ? calculateSnapRect(work, static_cast<WindowPosition>(i % 9))
+                                    : sideSnapRect(work, (i & 2) != 0, cycler.advance(i & 2, i));
+        transaction.move(ids[i], target);
+    }
+    LayoutCommitStats commit = transaction.commit();
+    benchReport("session.snap_commit", elapsedNs(start) / kWindows, kWindows, "lookup + geometry + batch commit");
+    benchCheck(commit.issued + commit.skipped == static_cast<size_t>(kWindows) && commit.failed == 0,
+               "every window snapped once");
+
+    // 4. 창 상태 저장/조회
+    WindowStateTable<Rect> states(kWindows);
+    start = BenchClock::now();
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < kWindows; ++i) {
+            const Rect* rect = moveBackend.rectOf(ids[i]);
+            if (Rect* saved = states.find(ids[i], 1)) {
+                *saved = *rect;
+            } else {
+                states.insert(ids[i], 1, *rect);
+            }
+        }
+    }
+    benchReport("session.state_store", elapsedNs(start) / (10.0 * kWindows), 10ull * kWindows);
+    benchCheck(states.size() == static_cast<size_t>(kWindows), "state table holds every window");
+
+    // 5. 레이아웃 저장 후 메모리 이미지에서 다시 읽기
+    start = BenchClock::now();
+    LayoutSnapshotWriter writer;
+    writer.setGrid(12, 12, 0.5f, false);
+    for (int l = 0; l < 8; ++l) {
+        std::vector<layout_format::StoredWindowLayout> stored(kWindows);
+        for (int i = 0; i < kWindows; ++i) {
+            stored[i] = {static_cast<std::uint64_t>(ids[i]), *moveBackend.rectOf(ids[i]), i % 4, 0};
+        }
+        writer.addLayout("layout-" + std::to_string(l), stored);
+    }
+    const std::vector<unsigned char> image = writer.serialize();
+    LayoutSnapshot snapshot;
+    const bool attached = snapshot.attach(image.data(), image.size());
+    LayoutSnapshot::LayoutView view;
+    const bool found = attached && snapshot.findLayout("layout-5", view);
+    std::snprintf(note, sizeof(note), "8 layouts x 4000 windows, %zu KB", image.size() / 1024);
+    benchReport("session.layout_save_load", elapsedNs(start), 1, note);
+    benchCheck(found && view.windowCount == static_cast<size_t>(kWindows), "saved layout reads back");
+
+    // 6. 모든 모니터에서 자동 타일링을 켜고 한 번에 배치
+    TilingEngine tiling;
+    tiling.syncTopology(topology);
+    TilingOptions options;
+    options.mode = TilingMode::Bsp;
+    options.gap = 4;
+    for (int m = 0; m < topology.size(); ++m) tiling.setOptions(m, options);
+    start = BenchClock::now();
+    for (const auto& record : registry.windows()) {
+        if (record.state.visible) tiling.addWindow(record.window, topology.monitorFromRect(record.state.rect));
+    }
+    const size_t tiled = tiling.flush(transaction);
+    commit = transaction.commit();
+    benchReport("session.tile_all", elapsedNs(start) / static_cast<double>(tiled ? tiled : 1), tiled,
+                "bsp on 4 monitors, one commit");
+    benchCheck(tiled == tiling.windowCount() && commit.failed == 0, "every visible window tiled");
+
+    benchReport("session.total", elapsedNs(sessionStart), 1, "4000 windows, 4 monitors");
+}
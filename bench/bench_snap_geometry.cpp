@@ -0,0 +1,197 @@
+#include "bench.h"
+#include "snap_geometry.h"
+#include "monitor_topology.h"
+#include "layout_store.h"
+
+static MonitorTopology simulatedTopology() {
+    std::vector<MonitorInfo> monitors(4);
+    monitors[0].bounds = {0, 0, 3840, 2160};
+    monitors[0].workArea = {0, 0, 3840, 2100};
+    monitors[0].primary = true;
+    monitors[1].bounds = {-2560, 0, 0, 1440};
+    monitors[1].workArea = {-2560, 0, 0, 1400};
+    monitors[2].bounds = {3840, 0, 6400, 1440};
+    monitors[2].workArea = {3840, 0, 6400, 1400};
+    monitors[3].bounds = {6400, -300, 7480, 1620};
+    monitors[3].workArea = {6400, -300, 7480, 1580};
+    for (size_t i = 0; i < monitors.size(); ++i) monitors[i].handle = 0x1000 + i;
+
+    SimulatedMonitorBackend backend;
+    backend.setMonitors(monitors);
+    MonitorTopology topology;
+    topology.rebuild(backend);
+    return topology;
+}
+
+WM_BENCH(snap_geometry) {
+    const MonitorTopology topology = simulatedTopology();
+
+    bool inside = true;
+    for (const auto& monitor : topology.monitors()) {
+        const Rect& work = monitor.workArea;
+        for (int p = 0; p <= static_cast<int>(WindowPosition::BottomRight); ++p) {
+            const Rect r = calculateSnapRect(work, static_cast<WindowPosition>(p));
+            const int dw = r.width() - work.width() / 2, dh = r.height() - work.height() / 2;
+            inside = inside && dw >= 0 && dw <= 1 && dh >= 0 && dh <= 1 &&
+                     intersectionArea(r, work) == static_cast<long long>(r.width()) * r.height();
+        }
+        const Rect topLeft = calculateSnapRect(work, WindowPosition::TopLeft);
+        const Rect bottomRight = calculateSnapRect(work, WindowPosition::BottomRight);
+        inside = inside && topLeft.left == work.left && topLeft.top == work.top &&
+                 bottomRight.right == work.right && bottomRight.bottom == work.bottom;
+    }
+    benchCheck(inside, "9 snap positions are half-size and inside the work area");
+
+    // 성질 검사: 임의의 (홀수/소수 크기 포함) 작업 영역에서 이웃 슬롯이 틈/겹침 없이 맞닿는다
+    {
+        BenchRng rng;
+        int quadrantFailures = 0, centerFailures = 0, sideFailures = 0;
+        for (int i = 0; i < 100'000; ++i) {
+            const int x = rng.range(-8000, 8000), y = rng.range(-3000, 3000);
+            const Rect work = {x, y, x + rng.range(1, 8000), y + rng.range(1, 5000)};
+            const long long area = static_cast<long long>(work.width()) * work.height();
+
+            const Rect quadrants[4] = {calculateSnapRect(work, WindowPosition::TopLeft),
+                                       calculateSnapRect(work, WindowPosition::TopRight),
+                                       calculateSnapRect(work, WindowPosition::BottomLeft),
+                                       calculateSnapRect(work, WindowPosition::BottomRight)};
+            long long covered = 0, overlap = 0;
+            for (int a = 0; a < 4; ++a) {
+                covered += intersectionArea(quadrants[a], work);
+                for (int b = a + 1; b < 4; ++b) overlap += intersectionArea(quadrants[a], quadrants[b]);
+            }
+            if (covered != area || overlap != 0 || quadrants[0].right != quadrants[1].left ||
+                quadrants[0].bottom != quadrants[2].top) {
+                ++quadrantFailures;
+            }
+
+            // 가운데 줄/열은 모서리 슬롯의 1/4, 3/4 선과 같은 픽셀
+            const Rect center = calculateSnapRect(work, WindowPosition::Center);
+            const Rect topCenter = calculateSnapRect(work, WindowPosition::TopCenter);
+            const Rect centerLeft = calculateSnapRect(work, WindowPosition::CenterLeft);
+            if (center.left != topCenter.left || center.right != topCenter.right || center.top != centerLeft.top ||
+                center.bottom != centerLeft.bottom) {
+                ++centerFailures;
+            }
+
+            // 1/2 | 1/2, 1/4 | 3/4, 3/4 | 1/4 그리고 위/아래 절반
+            const int pairs[3][2] = {{0, 0}, {2, 3}, {3, 2}};
+            for (const auto& pair : pairs) {
+                const Rect left = sideSnapRect(work, true, pair[0]);
+                const Rect right = sideSnapRect(work, false, pair[1]);
+                if (left.right != right.left || left.width() + right.width() != work.width() ||
+                    left.left != work.left || right.right != work.right) {
+                    ++sideFailures;
+                }
+            }
+            if (halfSnapRect(work, true).bottom != halfSnapRect(work, false).top) ++sideFailures;
+            // 1/3 + 2/3 분할 (이전에는 0.33f 라 폭에 따라 틈이 생겼다)
+            const Rect third = sideSnapRect(work, true, 1);
+            if (third.right != slotEdge(work.left, work.width(), 4) ||
+                slotEdge(work.left, work.width(), 4) - work.left != work.width() / 3) {
+                ++sideFailures;
+            }
+        }
+        benchCheck(quadrantFailures == 0, "quadrants tile the work area exactly");
+        benchCheck(centerFailures == 0, "center slots share the quarter lines");
+        benchCheck(sideFailures == 0, "complementary side ratios meet without gaps");
+    }
+
+    // 1/2 -> 1/3 -> 1/4 -> 3/4 순환, 제한 시간이 지나면 처음으로
+    RatioCycler cycler(500);
+    int steps[6];
+    steps[0] = cycler.advance(1, 1000);
+    steps[1] = cycler.advance(1, 1100);
+    steps[2] = cycler.advance(1, 1200);
+    steps[3] = cycler.advance(1, 1300);
+    steps[4] = cycler.advance(1, 1400);
+    steps[5] = cycler.advance(2, 1450);
+    benchCheck(steps[0] == 0 && steps[1] == 1 && steps[2] == 2 && steps[3] == 3 && steps[4] == 0,
+               "ratio steps cycle within the timeout");
+    benchCheck(steps[5] == 0, "keys cycle independently");
+    benchCheck(cycler.advance(1, 2000) == 0 && cycler.advance(2, 1900) == 1, "timeout restarts the cycle");
+
+    const Rect work = topology.monitor(0).workArea;
+    const Rect third = sideSnapRect(work, true, 1);
+    const Rect quarter = sideSnapRect(work, false, 2);
+    benchCheck(third.left == work.left && third.width() == work.width() / 3, "left third");
+    benchCheck(quarter.right == work.right && quarter.width() == work.width() / 4, "right quarter");
+    benchCheck(halfSnapRect(work, true).bottom == halfSnapRect(work, false).top, "top/bottom halves meet");
+
+    // 단축키 경로: 모니터 조회 + 비율 순환 + 위치 계산
+    BenchRng rng;
+    const int kWindows = 4096;
+    std::vector<Rect> windows(kWindows);
+    for (auto& w : windows) {
+        const int x = rng.range(-2500, 7300), y = rng.range(-200, 1900);
+        w = {x, y, x + rng.range(200, 1600), y + rng.range(150, 1000)};
+    }
+    std::int64_t clock = 0;
+    double ns = measureNsPerOp(4'000'000, [&](std::uint64_t i) {
+        const Rect& window = windows[i & (kWindows - 1)];
+        const int monitor = topology.monitorFromRect(window);
+        const int step = cycler.advance(static_cast<int>(i & 1), clock += 100);
+        doNotOptimize(sideSnapRect(topology.monitor(monitor).workArea, (i & 1) != 0, step));
+    });
+    benchReport("snap_geometry.ratio_snap", ns, 4'000'000, "monitor lookup + ratio cycle + rect");
+
+    ns = measureNsPerOp(4'000'000, [&](std::uint64_t i) {
+        const Rect& window = windows[i & (kWindows - 1)];
+        const int monitor = topology.monitorFromRect(window);
+        doNotOptimize(calculateSnapRect(topology.monitor(monitor).workArea, static_cast<WindowPosition>(i % 9)));
+    });
+    benchReport("snap_geometry.position_snap", ns, 4'000'000, "monitor lookup + 9-way position");
+
+    // 일괄 계산: 배열 구조체 커널 vs 창마다 slotRect
+    {
+        SlotBatch batch;
+        batch.resize(kWindows);
+        std::vector<Rect> areas(kWindows);
+        std::vector<int> slots(kWindows);
+        for (int i = 0; i < kWindows; ++i) {
+            areas[i] = topology.monitor(topology.monitorFromRect(windows[i])).workArea;
+            slots[i] = rng.range(0, kSnapSlotCount - 1);
+            batch.set(i, areas[i], slots[i]);
+        }
+        computeSlotRects(batch);
+        int mismatches = 0;
+        for (int i = 0; i < kWindows; ++i) {
+            if (batch.rect(i) != slotRect(areas[i], slots[i])) ++mismatches;
+        }
+        benchCheck(mismatches == 0, "batch kernel matches the scalar slot rect");
+
+        const std::uint64_t rounds = 2000;
+        ns = measureNsPerOp(rounds, [&](std::uint64_t) {
+            computeSlotRects(batch);
+            doNotOptimize(batch.left.data());
+        });
+        benchReport("snap_geometry.batch_soa", ns / kWindows, rounds * kWindows, "per window, 4096 per batch");
+
+        std::vector<Rect> out(kWindows);
+        ns = measureNsPerOp(rounds, [&](std::uint64_t) {
+            for (int i = 0; i < kWindows; ++i) out[i] = slotRect(areas[i], slots[i]);
+            doNotOptimize(out.data());
+        });
+        benchReport("snap_geometry.batch_scalar", ns / kWindows, rounds * kWindows, "per window, slotRect loop");
+    }
+}
+
+WM_BENCH(legacy_config_parse) {
+    LegacyGridConfig config;
+    benchCheck(parseLegacyGridConfig("12 8 0.35\n", config) && config.rows == 12 && config.cols == 8 &&
+               config.opacity == 0.35f, "valid legacy config");
+    LegacyGridConfig untouched = config;
+    benchCheck(!parseLegacyGridConfig("12 8", untouched) && untouched.rows == 12, "missing field rejected");
+    benchCheck(!parseLegacyGridConfig("0 8 0.5", untouched), "zero rows rejected");
+    benchCheck(!parseLegacyGridConfig("12 8 1.5", untouched), "opacity above 1 rejected");
+    benchCheck(!parseLegacyGridConfig("12x 8 0.5", untouched), "garbage rejected");
+    benchCheck(!parseLegacyGridConfig("", untouched) && untouched.cols == 8, "empty file keeps previous values");
+
+    const char text[] = "  16\t16 0.5\r\n";
+    double ns = measureNsPerOp(2'000'000, [&](std::uint64_t) {
+        LegacyGridConfig parsed;
+        doNotOptimize(parseLegacyGridConfig(text, parsed));
+        doNotOptimize(parsed);
+    });
+    benchReport("legacy_config.parse", ns, 2'000'000);
+}
@@ -0,0 +1,72 @@
+#include "bench.h"
+#include "startup_profiler.h"
+#include <thread>
+#include <vector>
+
+WM_BENCH(startup_profiler) {
+    // 원점 기준 오프셋, 처음 도달한 시각만 남는다
+    {
+        StartupTimeline timeline(1'000'000);
+        benchCheck(!timeline.reached(StartupStage::HotkeysLive) && timeline.offsetUs(StartupStage::Idle) == -1,
+                   "stages start unreached");
+        timeline.markAt(StartupStage::MainEntered, 1'000'500);
+        timeline.markAt(StartupStage::HotkeysLive, 1'002'000);
+        timeline.markAt(StartupStage::HotkeysLive, 1'009'000);
+        timeline.markAt(StartupStage::WindowCreated, 900'000);
+        benchCheck(timeline.offsetUs(StartupStage::MainEntered) == 500, "offset is relative to the origin");
+        benchCheck(timeline.timeToFirstHotkeyUs() == 2000, "first mark wins");
+        benchCheck(timeline.offsetUs(StartupStage::WindowCreated) == 0, "marks before the origin clamp to zero");
+
+        std::string report;
+        timeline.format(report);
+        benchCheck(report.find("hotkeys_live") != std::string::npos &&
+                       report.find("time to first hotkey: 2.000 ms") != std::string::npos,
+                   "report lists stages and time to first hotkey");
+        benchCheck(report.find("idle resident memory") == std::string::npos, "no memory line before idle");
+    }
+
+    // 기본 원점은 프로세스 생성 시점 (/proc 값은 10ms 단위라 막 뜬 프로세스는 0 일 수 있다)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        const std::int64_t uptime = processUptimeUs();
+        StartupTimeline timeline;
+        timeline.mark(StartupStage::MainEntered);
+        timeline.markIdle();
+#ifdef __linux__
+        benchCheck(uptime > 0, "process uptime from /proc");
+        benchCheck(residentMemoryBytes() > 0 && timeline.idleResidentBytes() > 0, "idle resident memory sampled");
+#endif
+        benchCheck(timeline.offsetUs(StartupStage::MainEntered) + 20'000 >= uptime, "default origin is process start");
+        std::string report;
+        timeline.format(report);
+        benchCheck(report.find("idle resident memory") != std::string::npos, "report shows idle memory");
+    }
+
+    // 여러 스레드가 같은 단계를 찍어도 하나만 남는다 (설정 작업 스레드 + UI 스레드)
+    {
+        StartupTimeline timeline(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&timeline, t] {
+                for (int i = 0; i < 1000; ++i) timeline.markAt(StartupStage::ConfigLoaded, 100 + t * 1000 + i);
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        const std::int64_t offset = timeline.offsetUs(StartupStage::ConfigLoaded);
+        benchCheck(offset >= 100 && offset % 1000 == 100, "concurrent marks keep one first value");
+    }
+
+    // 단축키마다 FirstHotkey 를 찍는 비용 (이미 도달했으면 읽기 한 번)
+    const int kIterations = 10'000'000;
+    StartupTimeline timeline;
+    timeline.mark(StartupStage::FirstHotkey);
+    double ns = measureNsPerOp(kIterations, [&](std::uint64_t) {
+        timeline.mark(StartupStage::FirstHotkey);
+        doNotOptimize(timeline);
+    });
+    benchReport("startup.mark_reached", ns, kIterations, "per hotkey after the first");
+
+    StartupTimeline fresh;
+    ns = measureNsPerOp(1, [&](std::uint64_t) { fresh.markIdle(); });
+    benchReport("startup.mark_idle", ns, 1, "includes resident memory query");
+}
@@ -0,0 +1,197 @@
+#include "bench.h"
+#include "alloc_counter.h"
+#include "async_move_executor.h"
+#include "drag_snapper.h"
+#include "event_arena.h"
+#include "key_input.h"
+#include "latency_trace.h"
+#include "snap_geometry.h"
+#include "window_animator.h"
+#include "window_spatial_index.h"
+
+// 준비(warm-up) 뒤 반복 구간의 할당 수. 0 이 아니면 실패
+template <typename F>
+static std::uint64_t steadyAllocations(int warmup, int iterations, F&& body) {
+    for (int i = 0; i < warmup; ++i) body(i);
+    AllocationScope scope;
+    for (int i = 0; i < iterations; ++i) body(warmup + i);
+    return scope.total();
+}
+
+WM_BENCH(event_arena) {
+    {
+        EventArena arena(256);
+        auto* a = arena.allocateArray<std::uint8_t>(3);
+        auto* b = arena.allocateArray<std::uint64_t>(4);
+        benchCheck(a && reinterpret_cast<std::uintptr_t>(b) % alignof(std::uint64_t) == 0, "arena aligns allocations");
+        {
+            EventArena::Scope scope(arena);
+            arena.allocateArray<std::uint32_t>(16);
+            benchCheck(arena.used() > 40, "scope allocates from the block");
+        }
+        benchCheck(arena.used() == 40 && arena.overflows() == 0, "scope rewinds to its mark");
+        arena.reset();
+        benchCheck(arena.used() == 0, "reset empties the arena");
+    }
+
+    // 넘치면 따로 빌리고, 비울 때 최대 사용량만큼 커져서 다음부터는 넘치지 않는다
+    {
+        EventArena arena(64);
+        for (int event = 0; event < 3; ++event) {
+            EventArena::Scope scope(arena);
+            auto* items = arena.allocateArray<int>(1000);
+            for (int i = 0; i < 1000; ++i) items[i] = i;
+            doNotOptimize(items);
+        }
+        benchCheck(arena.overflows() == 1 && arena.capacity() >= 4000, "arena grows to its peak after one overflow");
+    }
+
+    const int kIterations = 4'000'000;
+    EventArena arena;
+    double ns = measureNsPerOp(kIterations, [&](std::uint64_t i) {
+        EventArena::Scope scope(arena);
+        auto* scratch = arena.allocateArray<std::uint32_t>(8 + (i & 7));
+        scratch[0] = static_cast<std::uint32_t>(i);
+        doNotOptimize(scratch);
+    });
+    benchReport("event_arena.scope_alloc", ns, kIterations, "scope + one array");
+}
+
+WM_BENCH(steady_state_allocations) {
+    if (!allocationCountingEnabled()) {
+        benchReport("steady_state.skipped", 0, 0, "built without WM_COUNT_ALLOCATIONS");
+        return;
+    }
+    {
+        AllocationScope scope;
+        auto* probe = new int(7);
+        doNotOptimize(probe);
+        delete probe;
+        benchCheck(scope.thread() == 1 && scope.total() == 1, "allocation counter sees operator new");
+    }
+
+    const int kWarmup = 200;
+    const int kIterations = 5000;
+
+    std::vector<MonitorInfo> monitors(2);
+    monitors[0].bounds = {0, 0, 2560, 1440};
+    monitors[0].workArea = {0, 0, 2560, 1400};
+    monitors[0].dpi = 144;
+    monitors[0].primary = true;
+    monitors[1].bounds = {2560, 0, 4480, 1080};
+    monitors[1].workArea = {2560, 0, 4480, 1050};
+    SimulatedMonitorBackend monitorBackend;
+    monitorBackend.setMonitors(monitors);
+    MonitorTopology topology;
+    topology.rebuild(monitorBackend);
+
+    FakeWindowMoveBackend os;
+    const int kWindows = 64;
+    for (int i = 1; i <= kWindows; ++i) {
+        const int x = (i % 8) * 300, y = (i / 8) * 160;
+        os.addWindow(i, {x, y, x + 280, y + 150});
+    }
+
+    // 단축키: 훅 필터 -> 바인딩 해석 -> 비율 순환 + 슬롯 계산 -> 추적 -> 이동 실행기
+    {
+        std::vector<KeyBinding> bindings(2);
+        bindings[0].id = 1;
+        bindings[0].first = {KeyModWin, 0x25};
+        bindings[1].id = 2;
+        bindings[1].first = {KeyModWin, 0x27};
+        KeyFilter filter;
+        filter.build(bindings);
+        KeyBindingResolver resolver;
+        resolver.build(bindings, 300);
+        std::vector<int> resolved;
+        resolved.reserve(64);
+        RatioCycler cycler(500);
+        LatencyTracer tracer;
+        AsyncMoveExecutor executor(os);
+        executor.setTracer(&tracer);
+
+        std::uint32_t timeMs = 0;
+        const std::uint64_t allocations = steadyAllocations(kWarmup, kIterations, [&](int i) {
+            KeyEvent event;
+            filter.filter(0x5B, true, event);
+            const std::uint8_t vk = (i & 1) ? 0x25 : 0x27;
+            if (filter.filter(vk, true, event) & KeyFilterPush) {
+                event.timeMs = timeMs += 100;
+                resolver.feed(event, resolved);
+            }
+            filter.filter(vk, false, event);
+            filter.filter(0x5B, false, event);
+            for (int id : resolved) {
+                const std::uint32_t span = tracer.beginSpan();
+                const WindowId window = 1 + static_cast<WindowId>(i % kWindows);
+                const Rect& work = topology.monitor(topology.monitorFromRect(*os.rectOf(window))).workArea;
+                const Rect target = sideSnapRect(work, id == 1, cycler.advance(id, timeMs));
+                tracer.mark(span, TraceStage::GeometryComputed);
+                executor.submit(window, target, span);
+            }
+            resolved.clear();
+            if ((i & 63) == 63) executor.waitIdle(1'000'000'000);
+        });
+        executor.waitIdle(1'000'000'000);
+        benchCheck(allocations == 0, "hotkey path makes no allocations after warm-up");
+    }
+
+    // 스냅: 방향 이웃 찾기 + 두 창 교환 커밋 (임시 메모리는 이벤트 arena)
+    {
+        WindowSpatialIndex index;
+        std::vector<Rect> areas;
+        for (const auto& monitor : topology.monitors()) areas.push_back(monitor.workArea);
+        index.setMonitors(areas);
+        for (int i = 1; i <= kWindows; ++i) index.update(i, *os.rectOf(i));
+        EventArena arena;
+        LayoutTransaction transaction(os, &arena);
+
+        const std::uint64_t allocations = steadyAllocations(kWarmup, kIterations, [&](int i) {
+            EventArena::Scope scope(arena);
+            const WindowId window = 1 + static_cast<WindowId>(i % kWindows);
+            const Rect from = *os.rectOf(window);
+            const WindowId neighbor = index.nearest(from, static_cast<Direction>(i & 3), window);
+            if (!neighbor) return;
+            const Rect to = *os.rectOf(neighbor);
+            transaction.move(window, to);
+            transaction.move(neighbor, from);
+            transaction.commit();
+            index.update(window, to);
+            index.update(neighbor, from);
+        });
+        benchCheck(allocations == 0, "snap/swap path makes no allocations after warm-up");
+        benchCheck(arena.overflows() == 0, "swap fits in the event arena");
+    }
+
+    // 드래그: 64 zone 레이아웃 위에서 1000Hz 샘플, 놓을 때 애니메이션
+    {
+        std::vector<ZoneConfig> zones;
+        for (int r = 0; r < 8; ++r) {
+            for (int c = 0; c < 8; ++c) {
+                ZoneConfig zone;
+                zone.rect = {c * 125, r * 125, (c + 1) * 125, (r + 1) * 125};
+                zones.push_back(zone);
+            }
+        }
+        DragSnapper snapper;
+        AnimationSet animations;
+        std::int64_t now = 0;
+
+        const std::uint64_t allocations = steadyAllocations(kWarmup, kIterations / 10, [&](int i) {
+            const WindowId window = 1 + static_cast<WindowId>(i % kWindows);
+            snapper.configure(topology, 12, 12);
+            snapper.configureZones(zones, 8, 24, 1);
+            snapper.begin(window, *os.rectOf(window), {100, 100}, now);
+            for (int s = 0; s < 50; ++s) {
+                now += 1'000'000;
+                snapper.addSample({100 + s * 40 + i % 7, 100 + s * 25}, now);
+            }
+            snapper.flush(now);
+            Rect target;
+            if (snapper.end(target)) animations.animate(window, *os.rectOf(window), target, 100'000'000, now);
+            for (int f = 0; f < 8; ++f) animations.step(now += 16'666'667, 16'666'667, os);
+        });
+        benchCheck(allocations == 0, "drag path makes no allocations after warm-up");
+        benchCheck(snapper.stats().zoneHits > 0, "drag path exercised zones");
+    }
+}
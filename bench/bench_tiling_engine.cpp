@@ -0,0 +1,190 @@
+#include "bench.h"
+#include "tiling_engine.h"
+
+// 4K + QHD 2대 + 세로 FHD 구성
+static MonitorTopology simulatedTopology() {
+    std::vector<MonitorInfo> monitors(4);
+    monitors[0].workArea = monitors[0].bounds = {0, 0, 3840, 2160};
+    monitors[0].workArea.bottom = 2100;
+    monitors[0].primary = true;
+    monitors[1].workArea = monitors[1].bounds = {-2560, 0, 0, 1440};
+    monitors[1].workArea.bottom = 1400;
+    monitors[2].workArea = monitors[2].bounds = {3840, 0, 6400, 1440};
+    monitors[2].workArea.bottom = 1400;
+    monitors[3].workArea = monitors[3].bounds = {6400, -300, 7480, 1620};
+    monitors[3].workArea.bottom = 1580;
+    for (size_t i = 0; i < monitors.size(); ++i) monitors[i].handle = 0x1000 + i;
+
+    SimulatedMonitorBackend backend;
+    backend.setMonitors(monitors);
+    MonitorTopology topology;
+    topology.rebuild(backend);
+    return topology;
+}
+
+static const int kWindows = 200;
+
+static WindowId windowAt(int i) {
+    return static_cast<WindowId>(0x10000 + i * 16);
+}
+
+// 모니터마다 타일이 작업 영역 안에 있고 서로 겹치지 않는지, gap 이 0 이면 빈틈 없이 덮는지
+static bool tilesValid(const TilingEngine& engine, const MonitorTopology& topology, int windowCount) {
+    for (int m = 0; m < topology.size(); ++m) {
+        const Rect& work = topology.monitor(m).workArea;
+        std::vector<Rect> tiles;
+        for (int i = 0; i < windowCount; ++i) {
+            Rect r;
+            if (engine.monitorOf(windowAt(i)) != m || !engine.targetOf(windowAt(i), r)) continue;
+            if (r.empty() || intersectionArea(r, work) != static_cast<long long>(r.width()) * r.height()) return false;
+            tiles.push_back(r);
+        }
+        long long covered = 0;
+        for (size_t a = 0; a < tiles.size(); ++a) {
+            covered += static_cast<long long>(tiles[a].width()) * tiles[a].height();
+            for (size_t b = a + 1; b < tiles.size(); ++b) {
+                if (intersectionArea(tiles[a], tiles[b]) != 0) return false;
+            }
+        }
+        if (engine.options(m).gap == 0 && !tiles.empty() &&
+            covered != static_cast<long long>(work.width()) * work.height()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void fill(TilingEngine& engine, const MonitorTopology& topology, TilingMode mode, int gap) {
+    engine.syncTopology(topology);
+    for (int m = 0; m < topology.size(); ++m) {
+        TilingOptions options;
+        options.mode = mode;
+        options.gap = gap;
+        engine.setOptions(m, options);
+    }
+    for (int i = 0; i < kWindows; ++i) engine.addWindow(windowAt(i), i % topology.size());
+}
+
+WM_BENCH(tiling_engine_layouts) {
+    const MonitorTopology topology = simulatedTopology();
+    const TilingMode modes[] = {TilingMode::Bsp, TilingMode::MasterStack, TilingMode::Columns};
+    const char* names[] = {"bsp", "master_stack", "columns"};
+
+    for (int k = 0; k < 3; ++k) {
+        for (int gap : {0, 8}) {
+            TilingEngine engine;
+            fill(engine, topology, modes[k], gap);
+            std::vector<WindowMove> moves;
+            benchCheck(engine.flush(moves) == kWindows, "first flush places every window");
+            benchCheck(tilesValid(engine, topology, kWindows), "tiles are inside the work area, disjoint and gap-free");
+            moves.clear();
+            benchCheck(engine.flush(moves) == 0, "unchanged flush emits no moves");
+        }
+
+        // 처음부터 전체 배치 (200창 / 4모니터)
+        TilingEngine engine;
+        fill(engine, topology, modes[k], 8);
+        std::vector<WindowMove> moves;
+        engine.flush(moves);
+        int gap = 8;
+        double ns = measureNsPerOp(2'000, [&](std::uint64_t) {
+            gap ^= 2;
+            for (int m = 0; m < topology.size(); ++m) {
+                TilingOptions options = engine.options(m);
+                options.gap = gap;
+                engine.setOptions(m, options);
+            }
+            moves.clear();
+            doNotOptimize(engine.flush(moves));
+        });
+        benchCheck(moves.size() == kWindows, "gap change moves every window");
+        char name[64];
+        std::snprintf(name, sizeof(name), "tiling_engine.%s_full_relayout", names[k]);
+        benchReport(name, ns, 2'000, "200 windows on 4 monitors");
+    }
+}
+
+WM_BENCH(tiling_engine_incremental) {
+    const MonitorTopology topology = simulatedTopology();
+    TilingEngine engine;
+    fill(engine, topology, TilingMode::Bsp, 8);
+    std::vector<WindowMove> moves;
+    engine.flush(moves);
+
+    // 창 하나 추가: 나눠진 타일의 창과 새 창만 움직인다
+    const WindowId extra = windowAt(kWindows);
+    engine.resetStats();
+    engine.addWindow(extra, 0);
+    moves.clear();
+    benchCheck(engine.flush(moves) == 2, "bsp insert moves only the split window and the new one");
+    benchCheck(engine.stats().nodesVisited == 3, "bsp insert recomputes only the split subtree");
+    benchCheck(tilesValid(engine, topology, kWindows + 1), "tiles stay valid after insert");
+
+    // 방금 넣은 창 제거: 형제 하나만 원래 타일로 돌아간다
+    engine.removeWindow(extra);
+    moves.clear();
+    benchCheck(engine.flush(moves) == 1, "bsp remove moves only the sibling");
+    benchCheck(tilesValid(engine, topology, kWindows), "tiles stay valid after remove");
+
+    // 사용자가 오른쪽 변을 끌어 넓힘: 맞닿은 분할 비율만 바뀐다
+    Rect before;
+    engine.targetOf(windowAt(0), before);
+    Rect widened = before;
+    widened.right += 100;
+    engine.resetStats();
+    engine.resizeWindow(windowAt(0), widened);
+    moves.clear();
+    engine.flush(moves);
+    Rect after;
+    engine.targetOf(windowAt(0), after);
+    benchCheck(after.right >= widened.right - 1 && after.right <= widened.right + 1, "split ratio follows the dragged edge");
+    benchCheck(moves.size() < kWindows / 4, "resize moves only the neighbouring subtree");
+    benchCheck(tilesValid(engine, topology, kWindows), "tiles stay valid after resize");
+
+    // 추가+제거 왕복 비용과 이동 수
+    engine.resetStats();
+    const std::uint64_t rounds = 100'000;
+    double ns = measureNsPerOp(rounds, [&](std::uint64_t i) {
+        const int monitor = static_cast<int>(i & 3);
+        engine.addWindow(extra, monitor);
+        moves.clear();
+        engine.flush(moves);
+        engine.removeWindow(extra);
+        moves.clear();
+        doNotOptimize(engine.flush(moves));
+    });
+    char note[96];
+    std::snprintf(note, sizeof(note), "200 windows, %.1f moves / %.1f nodes per open+close",
+                  static_cast<double>(engine.stats().movesEmitted) / rounds,
+                  static_cast<double>(engine.stats().nodesVisited) / rounds);
+    benchReport("tiling_engine.bsp_open_close", ns, rounds, note);
+
+    // 같은 작업을 MasterStack 에서 (모니터 단위로 다시 계산하되 바뀐 창만 이동)
+    TilingEngine stack;
+    fill(stack, topology, TilingMode::MasterStack, 8);
+    stack.flush(moves);
+    stack.resetStats();
+    ns = measureNsPerOp(rounds, [&](std::uint64_t i) {
+        stack.addWindow(extra, static_cast<int>(i & 3));
+        moves.clear();
+        stack.flush(moves);
+        stack.removeWindow(extra);
+        moves.clear();
+        doNotOptimize(stack.flush(moves));
+    });
+    std::snprintf(note, sizeof(note), "200 windows, %.1f moves per open+close",
+                  static_cast<double>(stack.stats().movesEmitted) / rounds);
+    benchReport("tiling_engine.master_stack_open_close", ns, rounds, note);
+
+    // 모드 전환과 트랜잭션 커밋
+    FakeWindowMoveBackend backend;
+    for (int i = 0; i < kWindows; ++i) backend.addWindow(windowAt(i), {0, 0, 100, 100});
+    LayoutTransaction transaction(backend);
+    TilingOptions columns;
+    columns.mode = TilingMode::Columns;
+    engine.setOptions(2, columns);
+    const size_t emitted = engine.flush(transaction);
+    benchCheck(emitted == kWindows / 4, "switching one monitor to columns moves only its windows");
+    benchCheck(transaction.commit().issued == emitted, "tiling moves commit in one transaction");
+    benchCheck(tilesValid(engine, topology, kWindows), "tiles stay valid after mode switch");
+}
@@ -0,0 +1,171 @@
+#include "bench.h"
+#include "async_move_executor.h"
+#include "window_animator.h"
+#include <chrono>
+#include <thread>
+
+static constexpr std::int64_t kMs = 1'000'000;
+static constexpr std::int64_t kFrame = 16'666'667;
+
+// 다시 그리기가 느린 창 - 보낸 위치는 settle() 할 때 반영된다
+class LaggingWindowBackend : public WindowMoveBackend {
+public:
+    explicit LaggingWindowBackend(FakeWindowMoveBackend& inner) : m_inner(inner) {}
+
+    void settle() {
+        if (m_hasPending) m_inner.applyOne(m_pending);
+        m_hasPending = false;
+    }
+
+    bool getWindowRect(WindowId window, Rect& out) override { return m_inner.getWindowRect(window, out); }
+    bool applyBatch(const WindowMove* moves, size_t count) override { return m_inner.applyBatch(moves, count); }
+    bool applyOne(const WindowMove& move) override {
+        m_pending = move;
+        m_hasPending = true;
+        return true;
+    }
+
+private:
+    FakeWindowMoveBackend& m_inner;
+    WindowMove m_pending;
+    bool m_hasPending = false;
+};
+
+WM_BENCH(window_animator) {
+    const Rect a = {0, 0, 800, 600};
+    const Rect b = {960, 0, 1920, 1040};
+    const Rect c = {0, 520, 960, 1040};
+
+    benchCheck(interpolateRect(a, b, 0.0) == a && interpolateRect(a, b, 1.0) == b &&
+               easeOutCubic(0.5) > 0.5 && easeOutCubic(1.5) == 1.0, "easing endpoints");
+
+    // 프레임마다 한 번씩 목표 쪽으로, 끝에서는 정확히 목표
+    {
+        FakeWindowMoveBackend os;
+        os.addWindow(1, a);
+        AnimationSet set;
+        set.animate(1, a, b, 100 * kMs, 0);
+        bool monotonic = true;
+        int lastLeft = a.left;
+        for (std::int64_t now = kFrame; !set.empty() && now < 1'000 * kMs; now += kFrame) {
+            set.step(now, kFrame, os);
+            monotonic &= os.rectOf(1)->left >= lastLeft;
+            lastLeft = os.rectOf(1)->left;
+        }
+        const AnimationStats& stats = set.stats();
+        benchCheck(set.empty() && *os.rectOf(1) == b && stats.completed == 1 && monotonic,
+                   "animation ends exactly on target");
+        benchCheck(stats.frames == 6 && stats.steps == 6 && stats.droppedSteps == 0, "one step per frame");
+    }
+
+    // 진행 중에 새 목표: 대기열에 쌓지 않고 현재 위치에서 다시 시작
+    {
+        FakeWindowMoveBackend os;
+        os.addWindow(1, a);
+        AnimationSet set;
+        set.animate(1, a, b, 100 * kMs, 0);
+        set.step(kFrame, kFrame, os);
+        set.step(2 * kFrame, kFrame, os);
+        const Rect midway = *os.rectOf(1);
+        set.animate(1, midway, c, 100 * kMs, 2 * kFrame);
+        set.animate(1, midway, c, 100 * kMs, 3 * kFrame);  // 같은 목표는 다시 시작하지 않는다
+        set.step(3 * kFrame, kFrame, os);
+        const Rect next = *os.rectOf(1);
+        const bool continuous = next.left <= midway.left && next.top >= midway.top;
+        for (std::int64_t now = 4 * kFrame; !set.empty(); now += kFrame) set.step(now, kFrame, os);
+        benchCheck(set.size() == 0 && set.stats().started == 1 && set.stats().retargeted == 1 && *os.rectOf(1) == c,
+                   "retarget replaces the running animation");
+        benchCheck(continuous, "retarget continues from the visible position");
+    }
+
+    // 지난 위치를 아직 그리지 못한 창은 프레임을 건너뛰고, 너무 느리면 목표로 바로 보낸다
+    {
+        FakeWindowMoveBackend os;
+        os.addWindow(1, a);
+        LaggingWindowBackend laggy(os);
+        AnimationOptions options;
+        options.maxLagFrames = 2;
+        AnimationSet set(options);
+        set.animate(1, a, b, 500 * kMs, 0);
+        set.step(kFrame, kFrame, laggy);      // 첫 단계
+        set.step(2 * kFrame, kFrame, laggy);  // 아직 안 그림 - 건너뜀
+        laggy.settle();
+        set.step(3 * kFrame, kFrame, laggy);  // 따라옴 - 다음 단계
+        benchCheck(set.stats().steps == 2 && set.stats().droppedSteps == 1, "slow window drops a frame");
+
+        for (int i = 4; i < 8; ++i) set.step(i * kFrame, kFrame, laggy);
+        laggy.settle();
+        benchCheck(set.empty() && set.stats().finishedEarly == 1 && *os.rectOf(1) == b,
+                   "window that never catches up is sent to the target");
+    }
+
+    // 한 프레임의 이동 호출이 예산을 넘기면 남은 창은 건너뛰고 다음 프레임에 모두 끝낸다
+    {
+        SlowWindowMoveBackend os;
+        AnimationSet set;
+        for (WindowId w = 1; w <= 3; ++w) {
+            os.addWindow(w, a);
+            os.setDelay(w, 3 * kMs);
+            set.animate(w, a, b, 200 * kMs, 0);
+        }
+        set.step(kFrame, 4 * kMs, os);  // 예산 2ms, 창 하나가 3ms
+        const AnimationStats first = set.stats();
+        set.step(2 * kFrame, 4 * kMs, os);
+        bool done = true;
+        for (WindowId w = 1; w <= 3; ++w) {
+            Rect r;
+            done &= os.rectOf(w, r) && r == b;
+        }
+        benchCheck(first.overBudgetFrames == 1 && first.steps == 1 && first.droppedSteps == 2,
+                   "over-budget frame skips the remaining windows");
+        benchCheck(set.empty() && done && set.stats().finishedEarly == 3, "next frame finishes early");
+    }
+
+    // 스케줄러 스레드: 60Hz 로 진행, 끝나면 잠든다
+    SlowWindowMoveBackend os;
+    SteadyFrameClock clock;
+    WindowAnimator animator(os, clock);
+    constexpr int kWindows = 8;
+    for (WindowId w = 1; w <= kWindows; ++w) {
+        os.addWindow(w, a);
+        animator.animate(w, b, 150 * kMs);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    for (WindowId w = 1; w <= kWindows; ++w) animator.animate(w, c, 150 * kMs);
+    const bool idle = animator.waitIdle(3'000 * kMs);
+    bool landed = true;
+    for (WindowId w = 1; w <= kWindows; ++w) {
+        Rect r;
+        landed &= os.rectOf(w, r) && r == c;
+    }
+    const AnimationStats stats = animator.stats();
+    benchCheck(idle && landed && stats.retargeted == kWindows && stats.started == kWindows,
+               "scheduler retargets and lands every window");
+    benchCheck(stats.frames >= 5 && stats.frames <= 60, "scheduler steps once per frame");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    benchCheck(animator.stats().frames == stats.frames, "scheduler sleeps when idle");
+
+    const LatencyHistogram& frames = animator.frameTimes();
+    char note[128];
+    std::snprintf(note, sizeof(note), "p50 %.1f ms, p99 %.1f ms, %llu frames, step p99 %.1f us",
+                  frames.percentile(50) / 1e6, frames.percentile(99) / 1e6,
+                  static_cast<unsigned long long>(stats.frames), animator.stepTimes().percentile(99) / 1e3);
+    benchReport("animator.frame_interval", frames.mean(), frames.count(), note);
+
+    // 비용: 64 창을 프레임마다 한 단계씩
+    FakeWindowMoveBackend fake;
+    AnimationSet set;
+    constexpr int kAnimated = 64;
+    for (WindowId w = 1; w <= kAnimated; ++w) fake.addWindow(w, a);
+    std::int64_t now = 0;
+    bool toB = true;
+    const double ns = measureNsPerOp(20'000, [&](std::uint64_t) {
+        if (set.empty()) {
+            for (WindowId w = 1; w <= kAnimated; ++w) set.animate(w, *fake.rectOf(w), toB ? b : a, 150 * kMs, now);
+            toB = !toB;
+        }
+        now += kFrame;
+        set.step(now, kFrame, fake);
+    });
+    benchReport("animator.step", ns / kAnimated, 20'000ull * kAnimated, "per window per frame, 64 animating");
+}
@@ -0,0 +1,101 @@
+#include "bench.h"
+#include "window_registry.h"
+
+static WindowSnapshot snapshotAt(int x) {
+    WindowSnapshot snapshot;
+    snapshot.rect = {x, 0, x + 800, 600};
+    snapshot.visible = true;
+    snapshot.manageable = true;
+    return snapshot;
+}
+
+WM_BENCH(window_event_coalescing) {
+    WindowEventQueue queue;
+    WindowRegistry registry;
+    SimulatedWindowInfoSource source;
+    std::vector<WindowUpdate> updates;
+    size_t removed = 0;
+    registry.setRemovedCallback([&removed](WindowId) { ++removed; });
+
+    // 한 창의 위치 변경 500번 -> 업데이트 1개, 조회 1번
+    source.set(10, snapshotAt(0));
+    queue.push(10, WindowEventType::Created);
+    queue.push(10, WindowEventType::Shown);
+    for (int i = 0; i < 500; ++i) queue.push(10, WindowEventType::LocationChanged);
+    queue.push(10, WindowEventType::Foreground);
+    queue.drain(updates);
+    benchCheck(updates.size() == 1, "location burst collapses into one update");
+    benchCheck(updates[0].flags == (ChangeCreated | ChangeVisibility | ChangeLocation) && updates[0].visible,
+               "update carries every change kind");
+    registry.apply(updates, source);
+    WindowId foreground = 0;
+    benchCheck(queue.takeForeground(foreground) && foreground == 10, "foreground is reported once");
+    benchCheck(!queue.takeForeground(foreground), "foreground is consumed");
+    benchCheck(source.queries == 1 && registry.size() == 1, "registry queries once per update");
+
+    // 배치 안에서 생성 후 파괴된 창은 전달되지 않음
+    queue.push(20, WindowEventType::Created);
+    queue.push(20, WindowEventType::LocationChanged);
+    queue.push(20, WindowEventType::Destroyed);
+    queue.drain(updates);
+    benchCheck(updates.empty(), "create+destroy in one batch cancels out");
+
+    // 파괴 후 같은 핸들 재사용
+    source.set(10, snapshotAt(50));
+    queue.push(10, WindowEventType::Destroyed);
+    queue.push(10, WindowEventType::Created);
+    queue.drain(updates);
+    registry.apply(updates, source);
+    benchCheck(removed == 1 && registry.find(10) && registry.find(10)->state.rect.left == 50,
+               "recycled handle is removed then re-added");
+
+    // 숨김/표시가 반복되면 마지막 상태만
+    queue.push(10, WindowEventType::Hidden);
+    queue.push(10, WindowEventType::Shown);
+    queue.push(10, WindowEventType::Hidden);
+    queue.push(10, WindowEventType::Cloaked);
+    queue.drain(updates);
+    benchCheck(updates.size() == 1 && !updates[0].visible && updates[0].cloaked, "last visibility wins");
+
+    queue.push(10, WindowEventType::Destroyed);
+    queue.drain(updates);
+    source.remove(10);
+    registry.apply(updates, source);
+    benchCheck(registry.size() == 0 && removed == 2, "destroy removes from registry");
+
+    // 스트레스: 2000개 창에 대한 무작위 이벤트 1,000,000개
+    const int kWindows = 2000;
+    for (int i = 1; i <= kWindows; ++i) {
+        source.set(i, snapshotAt(i));
+        registry.seed(i, source);
+    }
+    source.queries = 0;
+
+    BenchRng rng;
+    const std::uint64_t kEvents = 1'000'000;
+    const std::uint64_t kBurst = 5000;  // 타이머 한 번 사이에 쌓이는 이벤트 수
+    size_t delivered = 0;
+    auto start = BenchClock::now();
+    for (std::uint64_t i = 0; i < kEvents; ++i) {
+        WindowId window = 1 + rng.next() % kWindows;
+        std::uint64_t r = rng.next() % 100;
+        WindowEventType type = r < 90 ? WindowEventType::LocationChanged
+                             : r < 95 ? WindowEventType::MoveSizeEnd
+                             : r < 98 ? WindowEventType::Foreground
+                                      : WindowEventType::Shown;
+        queue.push(window, type);
+        if ((i + 1) % kBurst == 0) {
+            queue.drain(updates);
+            registry.apply(updates, source);
+            delivered += updates.size();
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count() / kEvents;
+
+    char note[96];
+    std::snprintf(note, sizeof(note), "%zu updates, %zu queries (%.1fx fewer)", delivered, source.queries,
+                  static_cast<double>(kEvents) / static_cast<double>(source.queries ? source.queries : 1));
+    benchReport("window_events.push_drain_apply", ns, kEvents, note);
+    benchCheck(registry.size() == kWindows, "stress keeps every window registered");
+    benchCheck(source.queries == delivered, "one query per coalesced update");
+}
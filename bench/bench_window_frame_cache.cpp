@@ -0,0 +1,141 @@
+#include "bench.h"
+#include "async_move_executor.h"
+#include "snap_geometry.h"
+#include "window_frame_cache.h"
+#include <chrono>
+#include <thread>
+
+// Win10 기본 테마 (100%): 좌/우/아래에 7px 의 보이지 않는 테두리
+static const FrameInsets kWin10Insets = {7, 0, 7, 7};
+
+static WindowFrameInfo frameInfo(const FrameInsets& insets, std::uint32_t dpi = 96) {
+    WindowFrameInfo info;
+    info.insets = insets;
+    info.dpi = dpi;
+    info.manageable = true;
+    return info;
+}
+
+WM_BENCH(window_frame_cache) {
+    const Rect workArea = {0, 0, 1920, 1040};
+
+    // 조회는 창마다 한 번, 무효화/핸들 재사용/가림 이벤트 처리
+    {
+        SimulatedWindowFrameSource source;
+        WindowFrameCache cache(source);
+        source.set(1, 11, frameInfo(kWin10Insets));
+
+        WindowFrameInfo info;
+        bool ok = true;
+        for (int i = 0; i < 1000; ++i) ok &= cache.get(1, info);
+        benchCheck(ok && source.queries == 1 && info.insets.left == 7, "1000 lookups, one query");
+
+        cache.setCloaked(1, true);
+        benchCheck(cache.get(1, info) && info.cloaked && source.queries == 1, "cloak event updates without a query");
+
+        cache.invalidate(1);
+        benchCheck(cache.get(1, info) && !info.cloaked && source.queries == 2, "invalidate forces one re-query");
+
+        // 같은 핸들에 다른 창 (스탬프가 바뀜)
+        source.set(1, 12, frameInfo({}));
+        benchCheck(cache.get(1, info) && info.insets.left == 0 && source.queries == 3, "reused handle is re-queried");
+
+        source.remove(1);
+        benchCheck(!cache.get(1, info) && source.queries == 3, "destroyed window fails without a query");
+
+        for (WindowId w = 100; w < 110; ++w) {
+            source.set(w, static_cast<std::uint32_t>(w), frameInfo(kWin10Insets));
+            cache.get(w, info);
+        }
+        const size_t before = source.queries;
+        cache.invalidateAll();
+        for (WindowId w = 100; w < 110; ++w) cache.get(w, info);
+        benchCheck(source.queries == before + 10 && cache.stats().invalidations >= 10, "DPI change invalidates all");
+    }
+
+    // 보이는 프레임 기준 배치: 한 번에 맞고, 다시 커밋하면 건너뛴다
+    {
+        SimulatedWindowFrameSource source;
+        WindowFrameCache cache(source);
+        FakeWindowMoveBackend os;  // 바깥 사각형을 보관하는 가짜 창 관리자
+        FramedWindowMoveBackend backend(os, cache);
+
+        const FrameInsets insets150 = {11, 0, 11, 11};  // 150% 배율
+        source.set(1, 1, frameInfo(kWin10Insets));
+        source.set(2, 2, frameInfo(insets150, 144));
+        source.set(3, 3, frameInfo({}));  // 테두리 없는 창
+        os.addWindow(1, {300, 200, 900, 700});
+        os.addWindow(2, {400, 300, 1000, 800});
+        os.addWindow(3, {500, 400, 1100, 900});
+
+        LayoutTransaction transaction(backend);
+        const Rect left = calculateSnapRect(workArea, WindowPosition::CenterLeft);
+        const Rect right = calculateSnapRect(workArea, WindowPosition::CenterRight);
+        const Rect top = calculateSnapRect(workArea, WindowPosition::TopCenter);
+        transaction.move(1, left);
+        transaction.move(2, right);
+        transaction.move(3, top);
+        const LayoutCommitStats stats = transaction.commit();
+
+        Rect visible;
+        bool exact = true;
+        exact &= backend.getWindowRect(1, visible) && visible == left;
+        exact &= backend.getWindowRect(2, visible) && visible == right;
+        exact &= backend.getWindowRect(3, visible) && visible == top;
+        benchCheck(stats.issued == 3 && exact, "visible frames land exactly on the snap rects");
+        benchCheck(*os.rectOf(1) == outerFromVisible(left, kWin10Insets) && os.batchCalls == 1 && os.singleCalls == 0,
+                   "outer rect includes invisible borders, one batch");
+        // 왼쪽/오른쪽 반쪽이 틈 없이 맞닿는다
+        Rect a, b;
+        backend.getWindowRect(1, a);
+        backend.getWindowRect(2, b);
+        benchCheck(a.right == b.left && a.left == workArea.left && b.right == workArea.right, "halves meet with no gap");
+
+        transaction.move(1, left);
+        transaction.move(2, right);
+        const LayoutCommitStats again = transaction.commit();
+        benchCheck(again.issued == 0 && again.skipped == 2, "no correction pass: second commit skips");
+        benchCheck(source.queries == 3, "frame attributes queried once per window");
+
+        // 비동기 단일 이동도 같은 백엔드로 한 번에 맞는다
+        AsyncMoveExecutor executor(backend);
+        const Rect corner = calculateSnapRect(workArea, WindowPosition::BottomRight);
+        executor.submit(2, corner);
+        bool moved = false;
+        for (int i = 0; i < 2000 && !moved; ++i) {
+            moved = backend.getWindowRect(2, visible) && visible == corner;
+            if (!moved) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        benchCheck(moved && source.queries == 3, "async snap is pixel-exact from cached insets");
+    }
+
+    // 비용: 캐시 조회, 간격을 더하는 커밋
+    SimulatedWindowFrameSource source;
+    WindowFrameCache cache(source);
+    constexpr int kWindows = 256;
+    for (WindowId w = 1; w <= kWindows; ++w) source.set(w, static_cast<std::uint32_t>(w), frameInfo(kWin10Insets));
+
+    WindowFrameInfo info;
+    WindowId next = 1;
+    double ns = measureNsPerOp(1'000'000, [&](std::uint64_t) {
+        doNotOptimize(cache.get(next, info));
+        if (++next > kWindows) next = 1;
+    });
+    char note[96];
+    std::snprintf(note, sizeof(note), "%d windows, %zu queries", kWindows, source.queries);
+    benchReport("frame_cache.get", ns, 1'000'000, note);
+
+    FakeWindowMoveBackend os;
+    FramedWindowMoveBackend framed(os, cache);
+    for (WindowId w = 1; w <= kWindows; ++w) os.addWindow(w, {0, 0, 100, 100});
+    LayoutTransaction transaction(framed);
+    BenchRng rng;
+    ns = measureNsPerOp(2'000, [&](std::uint64_t) {
+        for (WindowId w = 1; w <= kWindows; ++w) {
+            const int x = rng.range(0, 1600);
+            transaction.move(w, {x, 0, x + 300, 400});
+        }
+        doNotOptimize(transaction.commit());
+    });
+    benchReport("frame_cache.framed_commit", ns / kWindows, 2'000 * kWindows, "per window, 256-window batch");
+}
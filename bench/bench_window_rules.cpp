@@ -0,0 +1,285 @@
+#include "bench.h"
+#include "config_store.h"
+#include "snap_geometry.h"
+#include "window_rules.h"
+#include <chrono>
+#include <regex>
+#include <string>
+
+// 규칙 500 개: 실행 파일/클래스 정확 일치, 제목 부분 문자열, 여러 조각 glob, 클래스 glob, 조합
+static std::vector<WindowRuleConfig> makeRules(BenchRng& rng) {
+    std::vector<WindowRuleConfig> rules;
+    for (int i = 0; i < 500; ++i) {
+        WindowRuleConfig rule;
+        switch (i % 6) {
+        case 0: rule.executable = "app" + std::to_string(i) + ".exe"; break;
+        case 1: rule.className = "WndClass" + std::to_string(i % 200); break;
+        case 2: rule.titlePattern = "*word" + std::to_string(i) + "*"; break;
+        case 3: rule.titlePattern = "*Doc" + std::to_string(i % 97) + "*- editor"; break;
+        case 4: rule.className = "Chrome_*" + std::to_string(i % 50); break;
+        default:
+            rule.executable = "APP" + std::to_string(i % 300) + ".EXE";
+            rule.titlePattern = "*word" + std::to_string(i % 400) + "*";
+            break;
+        }
+        const int kind = rng.range(0, 8);
+        if (kind == 0) rule.action = RuleIgnore;
+        if (kind == 1 || kind == 2) rule.action = RuleFloat;
+        if (kind == 3) rule.slot = rng.range(0, 9);
+        if (kind == 4) rule.monitor = rng.range(0, 2);
+        if (kind == 5) {
+            rule.minWidth = 600 + rng.range(0, 800);
+            rule.minHeight = 400 + rng.range(0, 500);
+        }
+        if (kind >= 6) rule.slot = rng.range(0, 9);
+        rules.push_back(rule);
+    }
+    return rules;
+}
+
+struct OwnedDescriptor {
+    std::string className;
+    std::string title;
+    std::string executable;
+
+    WindowDescriptor view() const { return {className, title, executable}; }
+};
+
+static std::vector<OwnedDescriptor> makeWindows(BenchRng& rng, size_t count) {
+    static const char* kSuffixes[] = {" - Editor", " - Mozilla Firefox", " — 메모장", "", " (응답 없음)"};
+    std::vector<OwnedDescriptor> windows(count);
+    for (auto& window : windows) {
+        window.executable = (rng.range(0, 2) ? "app" : "App") + std::to_string(rng.range(0, 600)) + ".exe";
+        window.className = rng.range(0, 3) ? "WndClass" + std::to_string(rng.range(0, 400))
+                                        : "Chrome_WidgetWin_" + std::to_string(rng.range(0, 100));
+        const int words = rng.range(1, 7);
+        for (int w = 0; w < words; ++w) {
+            if (w) window.title += ' ';
+            window.title += rng.range(0, 4) ? "Word" + std::to_string(rng.range(0, 1000))
+                                         : "doc" + std::to_string(rng.range(0, 200));
+        }
+        window.title += kSuffixes[rng.range(0, 5)];
+    }
+    return windows;
+}
+
+static bool sameResult(const WindowRuleResult& a, const WindowRuleResult& b) {
+    return a.rule == b.rule && a.action == b.action && a.slot == b.slot && a.monitor == b.monitor &&
+           a.minWidth == b.minWidth && a.minHeight == b.minHeight;
+}
+
+// 기존 방식이라면 규칙마다 정규식을 돌린다 (비교 기준)
+static std::regex globToRegex(const std::string& pattern) {
+    std::string expression;
+    for (char c : pattern) {
+        if (c == '*') {
+            expression += ".*";
+        } else {
+            if (std::string("\\^$.|?+()[]{}").find(c) != std::string::npos) expression += '\\';
+            expression += c;
+        }
+    }
+    return std::regex(expression, std::regex::icase | std::regex::optimize);
+}
+
+WM_BENCH(window_rules) {
+    // glob 자체
+    benchCheck(globMatch("*trading*", "My TRADING desk"), "glob substring, case-insensitive");
+    benchCheck(globMatch("a*b*c", "aXbYc") && !globMatch("a*b*c", "aXbYcd"), "glob anchored at both ends");
+    benchCheck(globMatch("*", "") && globMatch("**x**", "x") && !globMatch("", "x"), "glob edge cases");
+    benchCheck(globMatch("*aab", "aaaab") && !globMatch("*aab", "aaaba"), "glob backtracks to last star");
+
+    // 설정 파일 문법
+    {
+        ConfigSnapshot base, parsed;
+        ConfigError error;
+        WindowRuleConfig layoutRule;
+        layoutRule.titlePattern = "*Trading*";
+        layoutRule.action = RuleFloat;
+        base.rules.push_back(layoutRule);
+        const bool ok = parseConfigText(
+            "rule = exe=steam.exe; title=*friends*; float\n"
+            "rule = class=Chrome_WidgetWin_1; slot=2; monitor=1; min=800x600\n"
+            "rule = title=*password*; ignore\n",
+            {}, base, parsed, error);
+        benchCheck(ok && parsed.rules.size() == 4 && !parsed.ruleMatcher, "rule lines append after layout rules");
+        if (ok && parsed.rules.size() == 4) {
+            const WindowRuleConfig& chrome = parsed.rules[2];
+            benchCheck(chrome.className == "Chrome_WidgetWin_1" && chrome.slot == 2 && chrome.monitor == 1 &&
+                           chrome.minWidth == 800 && chrome.minHeight == 600 && chrome.action == 0,
+                       "rule fields parse");
+            benchCheck(parsed.rules[1].action == RuleFloat && parsed.rules[3].action == RuleIgnore, "rule actions");
+        }
+        benchCheck(!parseConfigText("rule = float\n", {}, base, parsed, error), "rule without match rejected");
+        benchCheck(!parseConfigText("rule = exe=a.exe\n", {}, base, parsed, error), "rule without action rejected");
+        benchCheck(!parseConfigText("rule = exe=a.exe; slot=9\n", {}, base, parsed, error), "slot out of range");
+        benchCheck(!parseConfigText("rule = exe=a.exe; min=800\n", {}, base, parsed, error), "min needs WxH");
+
+        // 게시할 때 한 번 컴파일하고, 다른 항목만 고치면 그대로 쓴다
+        ConfigStore store;
+        store.setDefaults(base);
+        store.reload("rule = title=*password*; ignore\n");
+        const void* compiled;
+        {
+            ConfigReader config(store);
+            compiled = config->ruleMatcher.get();
+            RuleMatchScratch scratch;
+            benchCheck(config->ruleMatcher && config->ruleMatcher->ruleCount() == 2 &&
+                           config->ruleMatcher->match({"", "Enter Password", ""}, scratch).action == RuleIgnore &&
+                           config->ruleMatcher->match({"", "trading view", ""}, scratch).action == RuleFloat,
+                       "published snapshot carries compiled matcher");
+        }
+        store.modify([](ConfigSnapshot& next) { next.rows = 4; });
+        {
+            ConfigReader config(store);
+            benchCheck(config->ruleMatcher.get() == compiled, "grid change keeps compiled matcher");
+        }
+        store.reclaim();
+    }
+
+    // 합치는 순서: 동작은 OR, 슬롯/모니터는 먼저 적힌 규칙, 최소 크기는 큰 값
+    {
+        std::vector<WindowRuleConfig> rules(3);
+        rules[0].executable = "code.exe";
+        rules[0].slot = 3;
+        rules[0].minWidth = 900;
+        rules[1].titlePattern = "*visual studio code";
+        rules[1].action = RuleFloat;
+        rules[1].slot = 5;
+        rules[1].minWidth = 700;
+        rules[1].minHeight = 800;
+        rules[2].className = "Chrome_*";
+        rules[2].monitor = 1;
+        CompiledWindowRules compiled;
+        compiled.compile(rules);
+        RuleMatchScratch scratch;
+        const WindowRuleResult result = compiled.match({"Chrome_WidgetWin_1", "main.cpp - Visual Studio Code", "Code.exe"}, scratch);
+        benchCheck(result.rule == 0 && result.action == RuleFloat && result.slot == 3 && result.monitor == 1 &&
+                       result.minWidth == 900 && result.minHeight == 800,
+                   "rule combination order");
+        benchCheck(!compiled.match({"Notepad", "a.txt", "notepad.exe"}, scratch).matched(), "no rule, no match");
+    }
+
+    // 규칙 위치: 슬롯, 다른 모니터, 최소 크기
+    {
+        SimulatedMonitorBackend backend;
+        std::vector<MonitorInfo> monitors(2);
+        monitors[0].bounds = monitors[0].workArea = {0, 0, 1920, 1040};
+        monitors[0].primary = true;
+        monitors[1].bounds = monitors[1].workArea = {1920, 0, 3840, 1040};
+        backend.setMonitors(monitors);
+        MonitorTopology topology;
+        topology.rebuild(backend);
+
+        WindowRuleResult rule;
+        Rect target;
+        benchCheck(!windowRuleTarget(rule, topology, {100, 100, 500, 400}, target), "no placement rule, no move");
+        rule.slot = static_cast<int>(WindowPosition::CenterRight);
+        rule.monitor = 1;
+        benchCheck(windowRuleTarget(rule, topology, {100, 100, 500, 400}, target) && target.left >= 1920 &&
+                       target.right == 3840,
+                   "slot on the rule's monitor");
+        rule.slot = -1;
+        benchCheck(windowRuleTarget(rule, topology, {100, 100, 500, 400}, target) && target.left == 2020 &&
+                       target.width() == 400,
+                   "monitor move keeps relative position");
+        rule.monitor = -1;
+        rule.minWidth = 1200;
+        rule.minHeight = 2000;
+        benchCheck(windowRuleTarget(rule, topology, {1500, 100, 1800, 400}, target) && target.width() == 1200 &&
+                       target.height() == 1040 && target.right <= 1920 && target.top == 0,
+                   "min size grows inside work area");
+
+        // 한 묶음 계산은 창마다 windowRuleTarget 과 같다 (슬롯/모니터/최소 크기 섞어서)
+        BenchRng rng;
+        std::vector<RulePlacement> placements(500);
+        for (size_t i = 0; i < placements.size(); ++i) {
+            RulePlacement& placement = placements[i];
+            placement.window = 0x100 + i;
+            placement.rule.rule = 0;
+            placement.rule.slot = rng.range(-3, static_cast<int>(WindowPosition::BottomRight));
+            placement.rule.monitor = rng.range(-1, 2);
+            placement.rule.minWidth = rng.range(0, 1) ? rng.range(0, 2500) : 0;
+            const int x = rng.range(-200, 3800), y = rng.range(-100, 1000);
+            placement.current = {x, y, x + rng.range(50, 1500), y + rng.range(50, 900)};
+        }
+        std::vector<RulePlacement> batched = placements;
+        SlotBatch batch;
+        windowRuleTargets(batched, topology, batch);
+        int mismatches = 0, moved = 0;
+        for (size_t i = 0; i < placements.size(); ++i) {
+            Rect expected;
+            const bool move = windowRuleTarget(placements[i].rule, topology, placements[i].current, expected);
+            if (move != batched[i].move || (move && expected != batched[i].target)) ++mismatches;
+            moved += move;
+        }
+        benchCheck(mismatches == 0 && moved > 0, "batched rule targets match windowRuleTarget");
+    }
+
+    BenchRng rng;
+    const std::vector<WindowRuleConfig> rules = makeRules(rng);
+    const std::vector<OwnedDescriptor> windows = makeWindows(rng, 10'000);
+
+    CompiledWindowRules compiled;
+    const auto compileStart = std::chrono::steady_clock::now();
+    compiled.compile(rules);
+    const double compileNs = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - compileStart).count());
+
+    // 컴파일한 결과가 규칙을 하나씩 비교한 결과와 창마다 같아야 한다
+    RuleMatchScratch scratch;
+    size_t mismatches = 0, matched = 0;
+    for (const auto& window : windows) {
+        const WindowRuleResult fast = compiled.match(window.view(), scratch);
+        const WindowRuleResult slow = matchWindowRulesLinear(rules, window.view());
+        if (!sameResult(fast, slow)) ++mismatches;
+        if (fast.matched()) ++matched;
+    }
+    benchCheck(mismatches == 0, "compiled matcher equals linear matcher on 10k windows");
+    benchCheck(matched > windows.size() / 4 && matched < windows.size(), "workload mixes matches and misses");
+
+    // 처음 한 번 커진 뒤에는 작업 공간이 자라지 않는다
+    const size_t scratchCapacity = scratch.matched.capacity();
+    for (const auto& window : windows) doNotOptimize(compiled.match(window.view(), scratch));
+    benchCheck(scratch.matched.capacity() == scratchCapacity, "scratch does not grow in steady state");
+
+    char note[128];
+    std::snprintf(note, sizeof(note), "500 rules, %zu states, %zu KiB", compiled.automatonStates(),
+                  compiled.memoryBytes() / 1024);
+    benchReport("rules.compile", compileNs, 1, note);
+
+    size_t next = 0;
+    double ns = measureNsPerOp(200'000, [&](std::uint64_t) {
+        doNotOptimize(compiled.match(windows[next].view(), scratch));
+        if (++next == windows.size()) next = 0;
+    });
+    benchReport("rules.match.compiled", ns, 200'000, "per window, 500 rules");
+
+    next = 0;
+    ns = measureNsPerOp(10'000, [&](std::uint64_t) {
+        doNotOptimize(matchWindowRulesLinear(rules, windows[next].view()));
+        if (++next == windows.size()) next = 0;
+    });
+    benchReport("rules.match.linear_glob", ns, 10'000, "per window, 500 rules");
+
+    // 정규식은 느려서 창 200 개만
+    std::vector<std::regex> classes, titles, executables;
+    for (const auto& rule : rules) {
+        classes.push_back(globToRegex(rule.className.empty() ? "*" : rule.className));
+        titles.push_back(globToRegex(rule.titlePattern.empty() ? "*" : rule.titlePattern));
+        executables.push_back(globToRegex(rule.executable.empty() ? "*" : rule.executable));
+    }
+    next = 0;
+    ns = measureNsPerOp(200, [&](std::uint64_t) {
+        const OwnedDescriptor& window = windows[next++];
+        int first = -1;
+        for (size_t i = 0; i < rules.size(); ++i) {
+            if (std::regex_match(window.className, classes[i]) && std::regex_match(window.title, titles[i]) &&
+                std::regex_match(window.executable, executables[i])) {
+                if (first < 0) first = static_cast<int>(i);
+            }
+        }
+        doNotOptimize(first);
+    });
+    benchReport("rules.match.linear_regex", ns, 200, "per window, 500 rules");
+}
@@ -0,0 +1,217 @@
+#include "bench.h"
+#include "window_spatial_index.h"
+
+struct SpatialWindow {
+    WindowId window;
+    Rect rect;
+};
+
+// 비교용: 모든 창을 훑는다
+static WindowId bruteForceNearest(const std::vector<SpatialWindow>& windows, const Rect& from, Direction direction,
+                                  WindowId exclude) {
+    WindowId best = 0;
+    Rect bestRect;
+    std::int64_t bestScore = 0;
+    for (const SpatialWindow& candidate : windows) {
+        if (candidate.window == exclude) continue;
+        const std::int64_t score = directionalScore(from, candidate.rect, direction);
+        if (score < 0) continue;
+        if (directionalBetter(from, score, candidate.rect, candidate.window, bestScore, bestRect, best, direction)) {
+            best = candidate.window;
+            bestRect = candidate.rect;
+            bestScore = score;
+        }
+    }
+    return best;
+}
+
+// 비교용: 수직 방향으로 겹치고 앞에 있는 창 중 가까운 모서리가 가장 가까운 창
+static WindowId bruteForceBlocking(const std::vector<SpatialWindow>& windows, const Rect& from, Direction direction,
+                                   WindowId exclude) {
+    WindowId best = 0;
+    std::int64_t bestLead = 0;
+    for (const SpatialWindow& candidate : windows) {
+        if (candidate.window == exclude) continue;
+        const Rect& r = candidate.rect;
+        const bool horizontal = direction == Direction::Left || direction == Direction::Right;
+        if (horizontal ? (r.top >= from.bottom || r.bottom <= from.top) : (r.left >= from.right || r.right <= from.left)) {
+            continue;
+        }
+        const std::int64_t lead = direction == Direction::Right ? r.left - from.right
+                                  : direction == Direction::Left ? from.left - r.right
+                                  : direction == Direction::Down ? r.top - from.bottom
+                                                                 : from.top - r.bottom;
+        if (lead < 0) continue;
+        if (!best || lead < bestLead || (lead == bestLead && candidate.window < best)) {
+            best = candidate.window;
+            bestLead = lead;
+        }
+    }
+    return best;
+}
+
+static Rect randomWindowRect(BenchRng& rng) {
+    // 대부분은 두 모니터 안, 일부는 모니터 밖 (최소화 위치나 꺼진 모니터에 남은 창)
+    const int x = rng.next() % 16 == 0 ? rng.range(-5000, -1000) : rng.range(-200, 4400);
+    const int y = rng.range(-100, 1400);
+    return {x, y, x + rng.range(200, 1400), y + rng.range(150, 900)};
+}
+
+static const Direction kDirections[] = {Direction::Left, Direction::Right, Direction::Up, Direction::Down};
+
+WM_BENCH(window_spatial_index) {
+    const std::vector<Rect> monitors = {{0, 0, 1920, 1040}, {1920, 0, 4480, 1400}};
+
+    // 한 줄에 놓인 창 세 개와 위아래 창
+    {
+        WindowSpatialIndex index;
+        index.setMonitors(monitors);
+        index.update(1, {0, 0, 600, 500});
+        index.update(2, {640, 0, 1240, 500});
+        index.update(3, {1280, 0, 1880, 500});
+        index.update(4, {640, 540, 1240, 1000});
+        index.update(5, {2400, 900, 3000, 1300});  // 오른쪽 모니터, 아래쪽
+        const Rect middle = *index.rectOf(2);
+        benchCheck(index.nearest(middle, Direction::Right, 2) == 3 && index.nearest(middle, Direction::Left, 2) == 1 &&
+                       index.nearest(middle, Direction::Down, 2) == 4 && index.nearest(middle, Direction::Up, 2) == 0,
+                   "nearest in each direction");
+        // 같은 줄의 창이 대각선 창보다 먼저
+        benchCheck(index.nearest(*index.rectOf(3), Direction::Right, 3) == 5, "crosses to the next monitor");
+        benchCheck(index.nearest(*index.rectOf(4), Direction::Right, 4) == 3, "aligned window beats diagonal one");
+
+        index.update(3, {2000, 0, 2600, 500});  // 다른 모니터로 이동
+        index.remove(1);
+        benchCheck(index.size() == 4 && !index.contains(1) && index.nearest(middle, Direction::Left, 2) == 0 &&
+                       index.nearest(middle, Direction::Right, 2) == 3,
+                   "update and remove");
+    }
+
+    // 밀기: 가로막는 창이나 작업 영역 끝까지
+    {
+        const Rect area = {0, 0, 1920, 1040};
+        const Rect window = {100, 100, 700, 600};
+        const Rect wall = {1000, 300, 1500, 900};
+        const Rect offside = {1000, 700, 1500, 900};
+        benchCheck(pushRect(window, Direction::Right, &wall, area) == Rect{400, 100, 1000, 600} &&
+                       pushRect(window, Direction::Right, &offside, area) == Rect{1320, 100, 1920, 600} &&
+                       pushRect(window, Direction::Up, nullptr, area) == Rect{100, 0, 700, 500} &&
+                       pushRect({0, 0, 600, 500}, Direction::Left, nullptr, area) == Rect{0, 0, 600, 500},
+                   "push stops at obstacle or work area");
+
+        // 점수가 더 좋은 옆줄 창(B)이 아니라 실제로 가로막는 창(C) 앞에서 멈춘다
+        WindowSpatialIndex index;
+        index.setMonitors({area});
+        const Rect mover = {0, 0, 100, 100};
+        index.update(1, mover);
+        index.update(2, {150, 200, 250, 300});
+        index.update(3, {800, 0, 900, 100});
+        benchCheck(index.nearest(mover, Direction::Right, 1) == 2, "diagonal window scores best");
+        const WindowId obstacle = index.blocking(mover, Direction::Right, 1);
+        benchCheck(obstacle == 3 && pushRect(mover, Direction::Right, index.rectOf(obstacle), area) ==
+                                        Rect{700, 0, 800, 100},
+                   "push stops at the overlapping window, not the best-scored one");
+        benchCheck(index.blocking(mover, Direction::Down, 1) == 0 && index.blocking(mover, Direction::Left, 1) == 0,
+                   "no blocker slides to the work area edge");
+    }
+
+    // 무작위 배치에서 전수 탐색과 같은 결과 (이동/삭제 후에도)
+    constexpr int kWindows = 400;
+    BenchRng rng;
+    WindowSpatialIndex index;
+    index.setMonitors(monitors);
+    std::vector<SpatialWindow> windows;
+    for (int i = 0; i < kWindows; ++i) {
+        windows.push_back({static_cast<WindowId>(0x1000 + i * 4), randomWindowRect(rng)});
+        index.update(windows.back().window, windows.back().rect);
+    }
+
+    bool same = true;
+    auto compareAll = [&](int queries) {
+        for (int q = 0; q < queries; ++q) {
+            const SpatialWindow& from = windows[rng.range(0, static_cast<int>(windows.size()))];
+            for (Direction direction : kDirections) {
+                same &= index.nearest(from.rect, direction, from.window) ==
+                        bruteForceNearest(windows, from.rect, direction, from.window);
+                same &= index.blocking(from.rect, direction, from.window) ==
+                        bruteForceBlocking(windows, from.rect, direction, from.window);
+            }
+        }
+    };
+    compareAll(500);
+    for (int i = 0; i < 2'000; ++i) {
+        SpatialWindow& moved = windows[rng.range(0, kWindows)];
+        moved.rect = randomWindowRect(rng);
+        index.update(moved.window, moved.rect);
+    }
+    for (int i = 0; i < 50; ++i) {
+        const size_t victim = rng.range(0, static_cast<int>(windows.size()));
+        index.remove(windows[victim].window);
+        windows[victim] = windows.back();
+        windows.pop_back();
+    }
+    compareAll(500);
+    // 모니터 구성이 바뀌어도 같은 답
+    index.setMonitors({{0, 0, 2560, 1400}});
+    compareAll(200);
+    index.setMonitors(monitors);
+    benchCheck(same && index.size() == windows.size(), "index matches brute force");
+
+    // 비용: 질의 (색인 vs 전수), 창 하나 이동
+    std::vector<size_t> sources(1024);
+    for (size_t& source : sources) source = rng.range(0, static_cast<int>(windows.size()));
+    SpatialQueryStats stats;
+    const double indexNs = measureNsPerOp(200'000, [&](std::uint64_t i) {
+        const SpatialWindow& from = windows[sources[i & 1023]];
+        doNotOptimize(index.nearest(from.rect, kDirections[i & 3], from.window, &stats));
+    });
+    const double bruteNs = measureNsPerOp(200'000, [&](std::uint64_t i) {
+        const SpatialWindow& from = windows[sources[i & 1023]];
+        doNotOptimize(bruteForceNearest(windows, from.rect, kDirections[i & 3], from.window));
+    });
+    char note[128];
+    std::snprintf(note, sizeof(note), "%zu windows, %.1f scored/query (brute force %.0f ns)", windows.size(),
+                  static_cast<double>(stats.candidatesScored) / 200'000, bruteNs);
+    benchReport("spatial.nearest", indexNs, 200'000, note);
+    benchReport("spatial.nearest_brute_force", bruteNs, 200'000, "every window scored");
+    benchCheck(indexNs < 100'000, "directional query well under a millisecond");
+
+    // 모니터를 작은 창으로 빽빽하게 채운 경우 (거래/모니터링 데스크)
+    WindowSpatialIndex tiled;
+    tiled.setMonitors(monitors);
+    std::vector<SpatialWindow> tiles;
+    for (int row = 0; row < 20; ++row) {
+        for (int col = 0; col < 24; ++col) {
+            const Rect rect = {col * 186, row * 52, col * 186 + 180, row * 52 + 48};
+            tiles.push_back({static_cast<WindowId>(0x9000 + tiles.size() * 4), rect});
+            tiled.update(tiles.back().window, rect);
+        }
+    }
+    bool tiledSame = true;
+    for (int q = 0; q < 200; ++q) {
+        const SpatialWindow& from = tiles[rng.range(0, static_cast<int>(tiles.size()))];
+        for (Direction direction : kDirections) {
+            tiledSame &= tiled.nearest(from.rect, direction, from.window) ==
+                         bruteForceNearest(tiles, from.rect, direction, from.window);
+        }
+    }
+    benchCheck(tiledSame, "tiled desk matches brute force");
+    SpatialQueryStats tiledStats;
+    const double tiledNs = measureNsPerOp(200'000, [&](std::uint64_t i) {
+        const SpatialWindow& from = tiles[sources[i & 1023] % tiles.size()];
+        doNotOptimize(tiled.nearest(from.rect, kDirections[i & 3], from.window, &tiledStats));
+    });
+    const double tiledBruteNs = measureNsPerOp(50'000, [&](std::uint64_t i) {
+        const SpatialWindow& from = tiles[sources[i & 1023] % tiles.size()];
+        doNotOptimize(bruteForceNearest(tiles, from.rect, kDirections[i & 3], from.window));
+    });
+    std::snprintf(note, sizeof(note), "%zu tiled windows, %.1f scored/query (brute force %.0f ns)", tiles.size(),
+                  static_cast<double>(tiledStats.candidatesScored) / 200'000, tiledBruteNs);
+    benchReport("spatial.nearest_tiled", tiledNs, 200'000, note);
+
+    const double updateNs = measureNsPerOp(200'000, [&](std::uint64_t i) {
+        SpatialWindow& moved = windows[i % windows.size()];
+        moved.rect = randomWindowRect(rng);
+        index.update(moved.window, moved.rect);
+    });
+    benchReport("spatial.update", updateNs, 200'000, "one window moved");
+}
@@ -0,0 +1,98 @@
+#include "bench.h"
+#include "window_state_table.h"
+#include <map>
+
+// WindowLayout 과 같은 크기의 이식 가능한 상태
+struct BenchLayout {
+    WindowId window = 0;
+    Rect position;
+    bool isMaximized = false;
+    int monitorIndex = 0;
+};
+
+// 실제 HWND 처럼 4의 배수이고 드문드문한 핸들 값
+static WindowId handleFor(std::uint64_t n) { return 0x10000 + n * 0x1A4; }
+
+WM_BENCH(window_state_table) {
+    // 기본 동작 검증
+    {
+        WindowStateTable<BenchLayout> table(64);
+        BenchLayout layout;
+        layout.monitorIndex = 3;
+        table.insert(handleFor(1), 7, layout);
+        benchCheck(table.find(handleFor(1), 7) && table.find(handleFor(1), 7)->monitorIndex == 3,
+                   "find returns stored state");
+        benchCheck(table.find(handleFor(1), 8) == nullptr, "recycled handle does not inherit state");
+        benchCheck(table.size() == 0 && table.staleEvictions() == 1, "stale entry is evicted");
+
+        for (int i = 0; i < 1000; ++i) table.insert(handleFor(i), 1, layout);
+        benchCheck(table.size() == 64, "table stays bounded");
+        size_t found = 0;
+        for (int i = 0; i < 1000; ++i) found += table.find(handleFor(i), 1) != nullptr;
+        benchCheck(found == 64, "every live entry is still reachable after evictions");
+        for (int i = 0; i < 1000; ++i) table.erase(handleFor(i));
+        benchCheck(table.size() == 0, "erase removes entries");
+    }
+
+    const size_t kLive = 512;
+    const std::uint64_t iterations = 4'000'000;
+    BenchLayout layout;
+
+    // 핫키 경로: 살아있는 창 조회
+    {
+        WindowStateTable<BenchLayout> table(4096);
+        std::map<WindowId, BenchLayout> map;
+        for (size_t i = 0; i < kLive; ++i) {
+            table.insert(handleFor(i), 1, layout);
+            map[handleFor(i)] = layout;
+        }
+
+        BenchRng rng;
+        std::vector<WindowId> keys(4096);
+        for (auto& key : keys) key = handleFor(rng.next() % kLive);
+
+        size_t hits = 0;
+        double ns = measureNsPerOp(iterations, [&](std::uint64_t i) {
+            hits += table.find(keys[i & 4095], 1) != nullptr;
+        });
+        doNotOptimize(hits);
+        benchReport("window_state.lookup.flat_table", ns, iterations);
+
+        ns = measureNsPerOp(iterations, [&](std::uint64_t i) {
+            hits += map.find(keys[i & 4095]) != map.end();
+        });
+        doNotOptimize(hits);
+        benchReport("window_state.lookup.std_map", ns, iterations);
+    }
+
+    // 창 생성/파괴 churn: 새 핸들 삽입 + 오래된 핸들 제거
+    {
+        WindowStateTable<BenchLayout> table(4096);
+        std::map<WindowId, BenchLayout> map;
+        double ns = measureNsPerOp(iterations, [&](std::uint64_t i) {
+            table.insert(handleFor(i), 1, layout);
+            if (i >= kLive) table.erase(handleFor(i - kLive));
+        });
+        char note[96];
+        std::snprintf(note, sizeof(note), "%zu live, %zu bytes fixed", table.size(), table.memoryBytes());
+        benchReport("window_state.churn.flat_table", ns, iterations, note);
+
+        ns = measureNsPerOp(iterations, [&](std::uint64_t i) {
+            map[handleFor(i)] = layout;
+            if (i >= kLive) map.erase(handleFor(i - kLive));
+        });
+        // 노드 = 값 + 키 + 레드블랙 트리 헤더(포인터 3개 + 색)
+        size_t nodeBytes = sizeof(BenchLayout) + sizeof(WindowId) + 4 * sizeof(void*);
+        std::snprintf(note, sizeof(note), "%zu live, ~%zu bytes in nodes", map.size(), map.size() * nodeBytes);
+        benchReport("window_state.churn.std_map", ns, iterations, note);
+    }
+
+    // 파괴 알림 없이 churn 이 계속돼도 메모리가 고정되는지 확인
+    {
+        WindowStateTable<BenchLayout> table(4096);
+        size_t before = table.memoryBytes();
+        for (std::uint64_t i = 0; i < 1'000'000; ++i) table.insert(handleFor(i), 1, layout);
+        benchCheck(table.memoryBytes() == before && table.size() == 4096,
+                   "leaked handles are evicted at capacity");
+    }
+}
@@ -0,0 +1,181 @@
+#include "bench.h"
+#include "workspace.h"
+#include <string>
+
+// 두 작업 공간 x 150 창. 같은 앱의 창이 여러 개 (식별은 제목으로 구분)
+static const char* const kApps[][2] = {
+    {"chrome.exe", "Chrome_WidgetWin_1"}, {"Code.exe", "Chrome_WidgetWin_1"},
+    {"WindowsTerminal.exe", "CASCADIA_HOSTING_WINDOW_CLASS"}, {"explorer.exe", "CabinetWClass"},
+    {"notepad.exe", "Notepad"}, {"EXCEL.EXE", "XLMAIN"}, {"slack.exe", "Chrome_WidgetWin_1"},
+    {"devenv.exe", "HwndWrapper[DefaultDomain;;]"},
+};
+static constexpr int kAppCount = sizeof(kApps) / sizeof(kApps[0]);
+
+struct WorkspaceFixture {
+    static constexpr int kPerWorkspace = 150;
+    FakeWindowMoveBackend os;
+    std::vector<WindowId> windows;
+    std::vector<WindowIdentity> identities;  // windows 와 같은 순서
+    std::vector<WorkspaceWindow> a, b;
+
+    WorkspaceFixture() {
+        for (int i = 0; i < 2 * kPerWorkspace; ++i) {
+            const WindowId window = 0x10000 + i * 4;
+            const auto& app = kApps[i % kAppCount];
+            windows.push_back(window);
+            identities.push_back(makeWindowIdentity(app[0], app[1], "document " + std::to_string(i)));
+            os.addWindow(window, {i, i, i + 640, i + 480});
+
+            WorkspaceWindow saved;
+            saved.identity = identities.back();
+            const int slot = i % kPerWorkspace;
+            saved.position = {(slot % 15) * 128, (slot / 15) * 104, (slot % 15) * 128 + 128, (slot / 15) * 104 + 104};
+            (i < kPerWorkspace ? a : b).push_back(saved);
+        }
+    }
+
+    // WindowManager::switchWorkspace 와 같은 후보 목록 (보이는 창 + 전환으로 숨긴 창)
+    void candidates(const WorkspaceSwitcher& switcher, std::vector<WorkspaceCandidate>& out) const {
+        out.clear();
+        for (size_t i = 0; i < windows.size(); ++i) {
+            out.push_back({windows[i], identities[i], !switcher.isHidden(windows[i]), false});
+        }
+    }
+};
+
+// 비교용: 저장된 창마다 후보 전체를 훑는 중첩 탐색
+static size_t matchNested(const std::vector<WorkspaceWindow>& saved, const std::vector<WorkspaceCandidate>& live,
+                          std::vector<std::uint8_t>& claimed) {
+    claimed.assign(live.size(), 0);
+    size_t matched = 0;
+    for (const auto& entry : saved) {
+        for (size_t j = 0; j < live.size(); ++j) {
+            if (!claimed[j] && live[j].identity == entry.identity) {
+                claimed[j] = 1;
+                ++matched;
+                break;
+            }
+        }
+    }
+    return matched;
+}
+
+WM_BENCH(workspace) {
+    // 식별 값: 실행 파일/클래스는 대소문자 무시, 제목은 구분
+    benchCheck(windowAppKey("Chrome.EXE", "chrome_widgetwin_1") == windowAppKey("chrome.exe", "Chrome_WidgetWin_1") &&
+               windowAppKey("chrome.exe", "X") != windowAppKey("chrome.ex", "eX") &&
+               windowTitleKey("Inbox") != windowTitleKey("inbox"), "identity keys");
+
+    // 같은 슬롯에 부딪힌 키: 앞 키의 후보를 모두 가져가도 뒤로 밀려난 키를 찾아야 한다
+    {
+        const std::uint64_t keys[] = {1, 17, 17, 33};  // 16 슬롯 표에서 모두 1번 슬롯
+        WindowIdentityIndex index;
+        index.build(keys, 4);
+        std::vector<std::uint8_t> claimed(4, 0);
+        int first = index.take(17, claimed);
+        claimed[first] = 1;
+        int second = index.take(17, claimed);
+        claimed[second] = 1;
+        const bool drained = index.take(17, claimed) < 0;
+        benchCheck(first == 1 && second == 2 && drained, "colliding key hands out each candidate once");
+        benchCheck(index.take(1, claimed) == 0 && index.take(33, claimed) == 3 && index.take(49, claimed) < 0,
+                   "claimed chain keeps later keys reachable");
+        claimed[0] = 1;
+        benchCheck(index.take(1, claimed) < 0 && index.take(33, claimed) == 3, "probe continues past emptied slots");
+    }
+
+    WorkspaceFixture fx;
+    WorkspaceSwitcher switcher;
+    LayoutTransaction transaction(fx.os);
+    std::vector<WorkspaceCandidate> live;
+
+    // 처음에는 300 창 모두 보이고 현재 작업 공간 소속
+    switcher.setMembers(fx.windows.data(), fx.windows.size());
+    fx.candidates(switcher, live);
+    WorkspaceSwitchStats stats = switcher.plan(fx.a.data(), fx.a.size(), live.data(), live.size(), transaction);
+    LayoutCommitStats commit = transaction.commit();
+    benchCheck(stats.matched == 150 && stats.hidden == 150 && stats.shown == 0 && commit.batches == 1,
+               "first switch hides the other 150 in one batch");
+
+    // A -> B: 150 숨기기 + 150 보이기/이동이 DeferWindowPos 한 번
+    const size_t batchesBefore = fx.os.batchCalls;
+    fx.candidates(switcher, live);
+    stats = switcher.plan(fx.b.data(), fx.b.size(), live.data(), live.size(), transaction);
+    commit = transaction.commit();
+    bool placed = true;
+    for (int i = 0; i < 150; ++i) {
+        placed &= !fx.os.isVisible(fx.windows[i]);
+        placed &= fx.os.isVisible(fx.windows[150 + i]) && *fx.os.rectOf(fx.windows[150 + i]) == fx.b[i].position;
+    }
+    benchCheck(stats.matched == 150 && stats.shown == 150 && stats.hidden == 150 && stats.missing == 0,
+               "switch shows 150 and hides 150");
+    benchCheck(placed && commit.issued == 300 && fx.os.batchCalls == batchesBefore + 1 && fx.os.singleCalls == 0,
+               "switch is a single batched pass");
+
+    // 제목이 바뀐 창은 실행 파일 + 클래스로 찾고, 없는 창은 건너뛴다. 소속 없는 창은 그대로
+    {
+        std::vector<WorkspaceWindow> saved = fx.a;
+        saved[7].identity.title = windowTitleKey("renamed");
+        WorkspaceWindow gone;
+        gone.identity = makeWindowIdentity("closed.exe", "Gone", "x");
+        saved.push_back(gone);
+
+        fx.candidates(switcher, live);
+        const WindowId stray = 0x90000;
+        fx.os.addWindow(stray, {0, 0, 100, 100});
+        live.push_back({stray, makeWindowIdentity("calc.exe", "Calc", "Calculator"), true, false});
+        stats = switcher.plan(saved.data(), saved.size(), live.data(), live.size(), transaction);
+        transaction.commit();
+        benchCheck(stats.matched == 149 && stats.appMatched == 1 && stats.missing == 1,
+                   "renamed window matched by app, closed window reported missing");
+        benchCheck(*fx.os.rectOf(fx.windows[7]) == fx.a[7].position && fx.os.isVisible(stray),
+                   "renamed window placed, unrelated window left visible");
+    }
+
+    // 같은 식별 값을 가진 창 두 개는 서로 다른 창에 배정
+    {
+        WorkspaceSwitcher dup;
+        FakeWindowMoveBackend os;
+        LayoutTransaction tx(os);
+        const WindowIdentity same = makeWindowIdentity("cmd.exe", "ConsoleWindowClass", "cmd");
+        os.addWindow(1, {});
+        os.addWindow(2, {});
+        const WorkspaceCandidate twins[] = {{1, same, true, false}, {2, same, true, false}};
+        WorkspaceWindow saved[2];
+        saved[0].identity = saved[1].identity = same;
+        saved[0].position = {0, 0, 10, 10};
+        saved[1].position = {10, 0, 20, 10};
+        stats = dup.plan(saved, 2, twins, 2, tx);
+        tx.commit();
+        benchCheck(stats.matched == 2 && *os.rectOf(1) == saved[0].position && *os.rectOf(2) == saved[1].position,
+                   "duplicate identities get distinct windows");
+    }
+
+    // 비용: 150 창 작업 공간 두 개를 번갈아 전환 (후보 목록 + 계획 + 커밋, 가짜 백엔드)
+    switcher.setMembers(fx.windows.data(), 150);
+    fx.candidates(switcher, live);
+    switcher.plan(fx.a.data(), fx.a.size(), live.data(), live.size(), transaction);
+    transaction.commit();
+    bool toB = true;
+    double ns = measureNsPerOp(2'000, [&](std::uint64_t) {
+        const auto& target = toB ? fx.b : fx.a;
+        fx.candidates(switcher, live);
+        switcher.plan(target.data(), target.size(), live.data(), live.size(), transaction);
+        doNotOptimize(transaction.commit());
+        toB = !toB;
+    });
+    benchReport("workspace.switch", ns, 2'000, "150 <-> 150 windows, one batch (OS cost excluded)");
+
+    std::vector<std::uint8_t> claimed;
+    size_t matched = 0;
+    fx.candidates(switcher, live);
+    ns = measureNsPerOp(2'000, [&](std::uint64_t) { matched = matchNested(fx.b, live, claimed); });
+    benchCheck(matched == 150, "nested search finds the same windows");
+    benchReport("workspace.match_nested", ns, 2'000, "baseline: scan all candidates per saved window");
+
+    ns = measureNsPerOp(2'000, [&](std::uint64_t) {
+        doNotOptimize(switcher.plan(fx.b.data(), fx.b.size(), live.data(), live.size(), transaction));
+        transaction.clear();
+    });
+    benchReport("workspace.plan", ns, 2'000, "identity index, 150 saved / 300 candidates");
+}
@@ -0,0 +1,185 @@
+#include "bench.h"
+#include "drag_snapper.h"
+
+// 비교 기준: 우선순위 순 영역을 차례로 검사
+static int bruteForceHit(const ZoneLayout& layout, Point pt) {
+    for (const auto& region : layout.regions()) {
+        if (region.hit.contains(pt)) return region.target;
+    }
+    return -1;
+}
+
+// 8x8 균등 zone + 겹치는 zone 몇 개 + 합친 zone
+static std::vector<ZoneConfig> makeZones(int monitor) {
+    std::vector<ZoneConfig> zones;
+    for (int r = 0; r < 8; ++r) {
+        for (int c = 0; c < 8; ++c) {
+            ZoneConfig zone;
+            zone.monitor = monitor;
+            zone.rect = {c * 125, r * 125, (c + 1) * 125, (r + 1) * 125};
+            zones.push_back(zone);
+        }
+    }
+    ZoneConfig merged;
+    merged.monitor = monitor;
+    merged.merge = {0, 1, 8, 9};
+    zones.push_back(merged);
+    ZoneConfig overlay;
+    overlay.monitor = monitor;
+    overlay.rect = {300, 300, 700, 700};
+    zones.push_back(overlay);
+    return zones;
+}
+
+static MonitorTopology makeTopology(SimulatedMonitorBackend& backend) {
+    std::vector<MonitorInfo> monitors(2);
+    monitors[0].bounds = {0, 0, 3840, 2160};
+    monitors[0].workArea = {0, 0, 3840, 2100};
+    monitors[0].dpi = 144;
+    monitors[0].refreshHz = 144;
+    monitors[0].primary = true;
+    monitors[1].bounds = {3840, 0, 5760, 1080};
+    monitors[1].workArea = {3840, 0, 5760, 1040};
+    backend.setMonitors(monitors);
+    MonitorTopology topology;
+    topology.rebuild(backend);
+    return topology;
+}
+
+WM_BENCH(zone_layout) {
+    // 좌우 반반: 간격, 경계 띠, 바깥
+    {
+        std::vector<ZoneConfig> zones(2);
+        zones[0].rect = {0, 0, 500, 1000};
+        zones[1].rect = {500, 0, 1000, 1000};
+        ZoneLayout layout;
+        layout.build(zones, 0, {0, 0, 1920, 1040}, 96, 8, 24);
+        int hit = layout.hitTest({100, 100});
+        benchCheck(hit >= 0 && layout.target(hit) == Rect{8, 8, 956, 1032}, "zone target has gaps applied");
+        hit = layout.hitTest({970, 500});
+        benchCheck(hit >= 0 && layout.target(hit) == Rect{8, 8, 1912, 1032}, "shared edge spans both zones");
+        hit = layout.hitTest({930, 500});
+        benchCheck(hit >= 0 && layout.target(hit) == Rect{8, 8, 956, 1032}, "outside the span margin stays in one zone");
+        benchCheck(layout.hitTest({-1, 500}) < 0 && layout.hitTest({500, 1040}) < 0, "outside the work area misses");
+
+        layout.build(zones, 0, {0, 0, 2880, 1560}, 144, 8, 24);
+        hit = layout.hitTest({100, 100});
+        benchCheck(hit >= 0 && layout.target(hit) == Rect{12, 12, 1434, 1548}, "gaps scale with dpi");
+        hit = layout.hitTest({1440 + 30, 100});
+        benchCheck(hit >= 0 && layout.target(hit).right == 2868 && layout.target(hit).left == 12, "span margin scales with dpi");
+    }
+
+    // 합친 zone: 네 칸 중 위 두 칸
+    {
+        std::vector<ZoneConfig> zones(5);
+        zones[0].rect = {0, 0, 500, 500};
+        zones[1].rect = {500, 0, 1000, 500};
+        zones[2].rect = {0, 500, 500, 1000};
+        zones[3].rect = {500, 500, 1000, 1000};
+        zones[4].merge = {0, 1};
+        ZoneLayout layout;
+        layout.build(zones, 0, {0, 0, 1000, 1000}, 96, 0, 0);
+        benchCheck(layout.targets().size() == 3, "merged members are not separate zones");
+        int hit = layout.hitTest({100, 100});
+        benchCheck(hit >= 0 && layout.target(hit) == Rect{0, 0, 1000, 500}, "merged zone covers its members");
+        hit = layout.hitTest({900, 100});
+        benchCheck(hit >= 0 && layout.target(hit) == Rect{0, 0, 1000, 500}, "merged zone covers the second member");
+        hit = layout.hitTest({100, 900});
+        benchCheck(hit >= 0 && layout.target(hit) == Rect{0, 500, 500, 1000}, "other zones untouched");
+    }
+
+    // 64 zone 레이아웃: 무작위 점에서 전수 검사와 같은 결과
+    SimulatedMonitorBackend backend;
+    MonitorTopology topology = makeTopology(backend);
+    std::vector<ZoneConfig> zones = makeZones(0);
+    const std::vector<ZoneConfig> second = makeZones(1);
+    zones.insert(zones.end(), second.begin(), second.end());
+
+    ZoneLayout layout;
+    const Rect& work = topology.monitor(0).workArea;
+    auto buildStart = BenchClock::now();
+    layout.build(zones, 0, work, topology.monitor(0).dpi, 8, 24);
+    const double buildUs =
+        std::chrono::duration<double, std::micro>(BenchClock::now() - buildStart).count();
+
+    BenchRng rng;
+    std::vector<Point> points(4096);
+    for (auto& pt : points) pt = {rng.range(-50, work.right + 50), rng.range(-50, work.bottom + 50)};
+    int mismatches = 0;
+    for (int i = 0; i < 200'000; ++i) {
+        const Point pt = i < 4096 ? points[i] : Point{rng.range(-50, work.right + 50), rng.range(-50, work.bottom + 50)};
+        if (layout.hitTest(pt) != bruteForceHit(layout, pt)) ++mismatches;
+    }
+    benchCheck(mismatches == 0, "compiled hit test matches the brute force scan");
+    // 경계 바로 위/아래
+    for (const auto& region : layout.regions()) {
+        for (Point pt : {Point{region.hit.left, region.hit.top}, Point{region.hit.right - 1, region.hit.bottom - 1},
+                         Point{region.hit.right, region.hit.bottom}, Point{region.hit.left - 1, region.hit.top - 1}}) {
+            if (layout.hitTest(pt) != bruteForceHit(layout, pt)) ++mismatches;
+        }
+    }
+    benchCheck(mismatches == 0, "compiled hit test matches on region edges");
+
+    {
+        char note[128];
+        std::snprintf(note, sizeof(note), "%zu regions, %zu cells, build %.0f us", layout.regions().size(),
+                      layout.cellCount(), buildUs);
+        const std::uint64_t iterations = 4'000'000;
+        long long sink = 0;
+        double ns = measureNsPerOp(iterations, [&](std::uint64_t i) { sink += layout.hitTest(points[i & 4095]); });
+        doNotOptimize(sink);
+        benchReport("zone_layout.hit_test.compiled_64", ns, iterations, note);
+
+        ns = measureNsPerOp(iterations / 20, [&](std::uint64_t i) { sink += bruteForceHit(layout, points[i & 4095]); });
+        doNotOptimize(sink);
+        benchReport("zone_layout.hit_test.linear_scan", ns, iterations / 20);
+    }
+
+    // 드래그: 그리드만 vs 64 zone (두 모니터), 1000Hz 샘플 2초
+    for (bool withZones : {false, true}) {
+        DragSnapper snapper;
+        snapper.configure(topology, 12, 12);
+        if (withZones) snapper.configureZones(zones, 8, 24, 1);
+        const Rect window = {100, 100, 900, 700};
+        const int kSamples = 2000;
+        std::int64_t now = 0;
+
+        double ns = measureNsPerOp(20, [&](std::uint64_t) {
+            snapper.begin(1, window, {120, 120}, now);
+            for (int i = 1; i < kSamples; ++i) {
+                now += 1'000'000;
+                snapper.addSample({120 + i * 2, 120 + i}, now);
+            }
+            Rect target;
+            snapper.end(target);
+            doNotOptimize(target);
+        });
+        if (withZones) benchCheck(snapper.stats().zoneHits > 0, "drag snaps to zones");
+        benchReport(withZones ? "zone_layout.drag_2s.zones_64" : "zone_layout.drag_2s.grid_only", ns / kSamples, kSamples);
+
+        std::uint64_t iterations = 4'000'000;
+        long long sink = 0;
+        ns = measureNsPerOp(iterations, [&](std::uint64_t i) {
+            Rect r;
+            snapper.snapRect(window, points[i & 4095], r);
+            sink += r.left + r.top;
+        });
+        doNotOptimize(sink);
+        benchReport(withZones ? "zone_layout.snap_rect.zones_64" : "zone_layout.snap_rect.grid_only", ns, iterations);
+    }
+
+    // 설정/토폴로지가 그대로면 다시 컴파일하지 않는다
+    {
+        DragSnapper snapper;
+        snapper.configure(topology, 12, 12);
+        snapper.configureZones(zones, 8, 24, 7);
+        const ZoneLayout* before = snapper.zonesFor(0);
+        const size_t targets = before->targets().size();
+        const Rect* data = before->targets().data();
+        snapper.configureZones({}, 8, 24, 7);
+        benchCheck(snapper.zonesFor(0)->targets().data() == data && snapper.zonesFor(0)->targets().size() == targets,
+                   "same config version keeps the compiled layout");
+        snapper.configureZones({}, 8, 24, 8);
+        benchCheck(snapper.zonesFor(0)->empty(), "new config version recompiles");
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+
+// 힙 할당 세기 (WM_COUNT_ALLOCATIONS 로 빌드한 경우에만, 아니면 항상 0)
+// 전역 operator new 를 바꿔 스레드별/전체 할당 횟수를 센다. 벤치마크가 이 모드로 빌드되어
+// 단축키/스냅/드래그 경로가 준비 뒤에 할당하지 않는지 검사한다.
+bool allocationCountingEnabled();
+std::uint64_t threadAllocations();  // 이 스레드의 누적 횟수
+std::uint64_t totalAllocations();   // 모든 스레드의 누적 횟수
+
+// 구간 안에서 일어난 할당 횟수
+class AllocationScope {
+public:
+    AllocationScope() : m_thread(threadAllocations()), m_total(totalAllocations()) {}
+
+    std::uint64_t thread() const { return threadAllocations() - m_thread; }
+    std::uint64_t total() const { return totalAllocations() - m_total; }
+
+private:
+    std::uint64_t m_thread;
+    std::uint64_t m_total;
+};
@@ -0,0 +1,149 @@
+#pragma once
+#include "layout_transaction.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class LatencyTracer;
+
+struct AsyncMoveStats {
+    size_t queueDepth = 0;       // 실행을 기다리는 창 수
+    size_t inFlight = 0;         // 이동 호출 중인 창 수 (응답 없는 창 포함)
+    size_t hungWindows = 0;      // 시간 초과로 응답 없음 표시된 창 수
+    size_t workers = 0;          // 살아있는 작업 스레드 수
+    std::uint64_t submitted = 0;
+    std::uint64_t coalesced = 0; // 실행 전에 더 새 요청으로 대체된 이동
+    std::uint64_t completed = 0;
+    std::uint64_t skipped = 0;   // 이미 목표 위치
+    std::uint64_t failed = 0;
+    std::uint64_t timeouts = 0;
+    std::uint64_t recovered = 0; // 응답 없음에서 돌아온 창
+};
+
+// 창별 비동기 이동 실행기
+// - 창마다 대기 슬롯 하나: 실행 전이면 새 요청이 이전 요청을 덮어쓴다 (latest-wins)
+// - 같은 창의 이동은 동시에 하나만 실행되고, 끝나면 대기 중인 최신 목표를 이어서 실행
+// - 이동 호출이 제한 시간을 넘기면 그 창을 응답 없음으로 표시하고 작업 스레드를 하나 보충한다
+//   (응답 없는 창은 스레드 하나만 붙잡고, 다른 창의 이동은 영향을 받지 않는다)
+// 작업 스레드는 모두 분리(detach)되어 있고 공유 상태를 함께 소유하므로,
+// 응답 없는 호출이 남아 있어도 소멸자는 기다리지 않는다. 백엔드는 그 호출보다 오래 살아야 한다.
+class AsyncMoveExecutor {
+public:
+    explicit AsyncMoveExecutor(WindowMoveBackend& backend, size_t workers = 2,
+                               std::int64_t timeoutNs = 250'000'000, size_t maxWorkers = 8);
+    ~AsyncMoveExecutor();
+
+    AsyncMoveExecutor(const AsyncMoveExecutor&) = delete;
+    AsyncMoveExecutor& operator=(const AsyncMoveExecutor&) = delete;
+
+    // traceSpan 이 있으면 이동 반환/목표 도달 단계를 추적기에 기록 (대체된 요청의 구간은 버려짐)
+    void submit(WindowId window, const Rect& target, std::uint32_t traceSpan = 0);
+    void setTracer(LatencyTracer* tracer);
+    bool isHung(WindowId window) const;
+
+    // 응답하는 창의 이동이 모두 끝날 때까지 대기 (응답 없는 창은 기다리지 않음)
+    bool waitIdle(std::int64_t timeoutNs);
+
+    AsyncMoveStats stats() const;
+
+private:
+    // 이동이 끝난 창의 칸을 이만큼까지는 남겨 둔다 (같은 창을 다시 옮길 때 해시 노드 할당이 없도록)
+    static constexpr size_t kKeptSlots = 256;
+
+    struct Slot {
+        Rect target;
+        bool pending = false;   // 실행 대기 중인 목표가 있음
+        bool queued = false;    // 실행 큐에 들어 있음
+        bool inFlight = false;
+        bool hung = false;
+        std::int64_t startNs = 0;
+        std::uint32_t traceSpan = 0;
+    };
+
+    // 실행 대기 창 - 창마다 최대 하나. 비워지면 처음으로 돌아가 용량을 재사용한다
+    // (deque 는 덩어리 경계를 넘을 때마다 할당/해제를 반복한다)
+    struct ReadyQueue {
+        std::vector<WindowId> items;
+        size_t head = 0;
+
+        bool empty() const { return head == items.size(); }
+        size_t size() const { return items.size() - head; }
+        void push_back(WindowId window) { items.push_back(window); }
+        WindowId pop_front() {
+            const WindowId window = items[head++];
+            if (head == items.size()) {
+                items.clear();
+                head = 0;
+            } else if (head >= 64 && head * 2 >= items.size()) {
+                items.erase(items.begin(), items.begin() + head);
+                head = 0;
+            }
+            return window;
+        }
+    };
+
+    struct State {
+        explicit State(WindowMoveBackend& b) : backend(b) {
+            slots.reserve(kKeptSlots);
+            ready.items.reserve(64);
+        }
+
+        WindowMoveBackend& backend;
+        std::int64_t timeoutNs = 0;
+        size_t baseWorkers = 0;
+        size_t maxWorkers = 0;
+        LatencyTracer* tracer = nullptr;
+
+        mutable std::mutex mutex;
+        std::condition_variable work;     // 실행 큐에 창이 들어옴 / 종료
+        std::condition_variable idle;     // 이동 완료 / 작업 스레드 종료
+        std::condition_variable watchdog; // 종료 알림 (감시 스레드 전용)
+        std::unordered_map<WindowId, Slot> slots;
+        ReadyQueue ready;
+        size_t inFlight = 0;
+        size_t liveWorkers = 0;
+        size_t stuckWorkers = 0;          // 응답 없는 창의 호출에 묶인 스레드
+        bool stopping = false;
+        AsyncMoveStats stats;
+    };
+
+    static void spawnWorker(const std::shared_ptr<State>& state);
+    static void workerLoop(std::shared_ptr<State> state);
+    static void watchdogLoop(std::shared_ptr<State> state);
+    static std::int64_t nowNs();
+
+    std::shared_ptr<State> m_state;
+    std::thread m_watchdog;
+};
+
+// 테스트/벤치마크용 느린 창 백엔드 (스레드 안전)
+// 창마다 이동 지연을 주거나, 풀어줄 때까지 이동 호출을 막아 응답 없는 앱을 흉내낸다.
+class SlowWindowMoveBackend : public WindowMoveBackend {
+public:
+    void addWindow(WindowId window, const Rect& rect);
+    void setDelay(WindowId window, std::int64_t delayNs);
+    void setHung(WindowId window, bool hung);
+    bool rectOf(WindowId window, Rect& out) const;
+    size_t callsFor(WindowId window) const;
+
+    bool getWindowRect(WindowId window, Rect& out) override;
+    bool applyBatch(const WindowMove* moves, size_t count) override;
+    bool applyOne(const WindowMove& move) override;
+
+private:
+    struct Window {
+        Rect rect;
+        std::int64_t delayNs = 0;
+        bool hung = false;
+        size_t calls = 0;
+    };
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_released;
+    std::unordered_map<WindowId, Window> m_windows;
+};
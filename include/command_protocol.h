@@ -0,0 +1,111 @@
+#pragma once
+#include "core_types.h"
+#include "snap_geometry.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 스크립트용 로컬 명령 프로토콜
+//
+// 이진 프레임 (리틀 엔디언): [0xB7][버전][명령 수 u16][본문 길이 u32][본문]
+//   Snap         op u8, window u64, position u8 (WindowPosition)
+//   Move         op u8, window u64, left/top/right/bottom i32 (보이는 프레임 기준)
+//   ApplyLayout  op u8, 이름 길이 u16, 이름 (UTF-8) - 저장된 작업 공간으로 전환
+//   Query        op u8, window u64 (0 이면 관리 대상 창 전체)
+// 응답 프레임: [0xB8][버전][결과 수 u16][본문 길이 u32] + 결과마다
+//   status u8, 창 상태 수 u32, {window u64, rect i32 x4, visible u8} x 창 상태 수
+//
+// 텍스트 모드: 0xB7 이 아닌 바이트로 시작하면 한 줄이 한 배치, 명령은 ';' 로 구분
+//   snap 0x1234 left ; move 0x1234 0 0 960 1040 ; layout trading ; query 0x1234 ; query
+// 응답도 한 줄: "ok ; ok ; unknown-layout ; 0x1234 0 0 960 1040 visible ; ..."
+//
+// 한 배치의 이동은 레이아웃 커밋 한 번으로 적용되고, 질의는 그 이동 전 상태를 돌려준다.
+
+namespace command_format {
+
+constexpr std::uint8_t kRequestMagic = 0xB7;
+constexpr std::uint8_t kReplyMagic = 0xB8;
+constexpr std::uint8_t kVersion = 1;
+constexpr size_t kHeaderSize = 8;
+constexpr size_t kMaxFrame = 1u << 20;    // 본문 최대 1MB
+constexpr size_t kMaxTextLine = 64 * 1024;
+
+}  // namespace command_format
+
+enum class CommandOp : std::uint8_t {
+    Snap = 1,
+    Move = 2,
+    ApplyLayout = 3,
+    Query = 4,
+};
+
+enum class CommandStatus : std::uint8_t {
+    Ok = 0,
+    UnknownWindow = 1,  // 창이 없거나 관리 대상이 아님
+    UnknownLayout = 2,
+    Invalid = 3,
+};
+
+struct Command {
+    CommandOp op = CommandOp::Query;
+    WindowId window = 0;
+    WindowPosition position = WindowPosition::Center;
+    Rect rect;
+    std::string name;
+};
+
+struct CommandWindowState {
+    WindowId window = 0;
+    Rect rect;
+    bool visible = false;
+};
+
+struct CommandResult {
+    CommandStatus status = CommandStatus::Ok;
+    std::uint32_t firstState = 0;  // CommandBatch::states 안의 범위 (Query 만)
+    std::uint32_t stateCount = 0;
+};
+
+// 한 번에 실행할 명령 묶음과 그 결과 (연결마다 하나를 재사용)
+struct CommandBatch {
+    bool text = false;  // 응답도 같은 모드로
+    std::vector<Command> commands;
+    std::vector<CommandResult> results;  // 실행한 쪽이 commands 와 같은 길이로 채운다
+    std::vector<CommandWindowState> states;
+
+    void clear();
+    // 실행하는 쪽에서 결과 하나 추가
+    void addResult(CommandStatus status) { results.push_back({status, 0, 0}); }
+};
+
+const char* commandPositionName(WindowPosition position);
+const char* commandStatusName(CommandStatus status);
+
+// 받은 바이트를 쌓아 두고 완성된 배치를 하나씩 꺼낸다 (프레임이 여러 번에 나눠 와도 된다)
+class CommandDecoder {
+public:
+    enum class Result { NeedMore, Batch, Error };
+
+    void append(const char* data, size_t size);
+    // 잘못된 입력이면 Error - 연결을 끊는다
+    Result next(CommandBatch& out);
+    size_t buffered() const { return m_buffer.size() - m_offset; }
+
+private:
+    Result nextBinary(CommandBatch& out);
+    Result nextText(CommandBatch& out);
+
+    std::string m_buffer;
+    size_t m_offset = 0;
+};
+
+// 텍스트 한 줄 (줄바꿈 제외)
+bool parseCommandText(std::string_view line, CommandBatch& out);
+
+// 클라이언트 쪽: 명령 -> 이진 프레임 (out 뒤에 붙인다)
+void encodeCommands(const Command* commands, size_t count, std::string& out);
+// 서버 쪽: 결과 -> 응답 (batch.text 에 따라 이진 프레임 또는 텍스트 한 줄, out 뒤에 붙인다)
+void encodeReply(const CommandBatch& batch, std::string& out);
+// 클라이언트 쪽: 이진 응답 프레임 하나. 완성되지 않았으면 0, 잘못됐으면 -1, 아니면 소비한 바이트 수
+long long decodeReply(const char* data, size_t size, CommandBatch& out);
@@ -0,0 +1,126 @@
+#pragma once
+#include "command_protocol.h"
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 명령 배치를 실제로 실행하는 쪽 (WindowManager). 메시지 루프 스레드에서만 불린다
+class CommandHandler {
+public:
+    virtual ~CommandHandler() = default;
+    // batch.commands 를 실행하고 results (질의면 states 도) 를 채운다
+    virtual void execute(CommandBatch& batch) = 0;
+};
+
+struct CommandServerStats {
+    std::uint64_t connections = 0;
+    std::uint64_t batches = 0;
+    std::uint64_t commands = 0;
+    std::uint64_t errors = 0;  // 잘못된 입력으로 끊은 연결
+};
+
+// 스크립트용 로컬 명령 서버 (Windows: 이름 있는 파이프, 그 밖: Unix 도메인 소켓)
+// 연결마다 스레드가 읽고 디코드한 뒤 배치를 대기열에 넣고 pending 콜백으로 메시지 루프를 깨운다.
+// 창 이동은 메시지 루프 스레드의 processPending() 에서만 일어나고, 응답은 실행이 끝난 뒤 보낸다.
+class CommandServer {
+public:
+    using Callback = void (*)(void* context);
+
+    CommandServer() = default;
+    ~CommandServer() { stop(); }
+
+    CommandServer(const CommandServer&) = delete;
+    CommandServer& operator=(const CommandServer&) = delete;
+
+    // pending 은 대기열이 비어 있다가 배치가 들어올 때 연결 스레드에서 불린다
+    bool start(const std::string& endpoint, Callback pending, void* context);
+    // 기다리던 연결은 응답 없이 끊긴다
+    void stop();
+    bool isRunning() const { return m_listenThread.joinable(); }
+
+    // 쌓인 배치를 모두 실행하고 실행한 배치 수를 돌려준다
+    size_t processPending(CommandHandler& handler);
+    CommandServerStats stats() const;
+
+    // 사용자(세션)마다 하나
+    static std::string defaultEndpoint();
+
+private:
+    struct Connection {
+        std::intptr_t handle = -1;
+#ifdef _WIN32
+        void* event = nullptr;  // 겹친 I/O 완료 이벤트
+#endif
+        std::thread thread;
+        bool finished = false;
+    };
+    struct Request {
+        CommandBatch* batch = nullptr;
+        bool taken = false;  // 메시지 루프가 꺼내 실행 중
+        bool done = false;
+    };
+
+    void listen();
+    void serve(Connection& connection);
+    // 대기열에 넣고 실행이 끝날 때까지 기다린다. 멈추는 중이면 false
+    bool submit(CommandBatch& batch);
+    // 멈추는 중이면 핸들을 닫고 false (stop 의 interrupt 와 같은 잠금 안에서 판단)
+    bool addConnection(std::intptr_t handle);
+    void reapFinished();
+    // 플랫폼별
+    long readSome(Connection& connection, char* data, size_t size);
+    bool writeAll(Connection& connection, const char* data, size_t size);
+    void hangUp(Connection& connection);
+    void closeConnection(Connection& connection);
+    void interrupt();
+
+    std::string m_endpoint;
+    Callback m_pending = nullptr;
+    void* m_context = nullptr;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_done;
+    std::vector<Request*> m_queue;
+    std::vector<Request*> m_running;  // 메시지 루프 스레드만 사용
+    std::list<Connection> m_connections;
+    CommandServerStats m_stats;
+    bool m_stopping = false;
+
+    std::intptr_t m_listenHandle = -1;
+#ifdef _WIN32
+    void* m_stopEvent = nullptr;
+#endif
+    std::thread m_listenThread;
+};
+
+// 스크립트/벤치마크용 동기 클라이언트
+class CommandClient {
+public:
+    CommandClient() = default;
+    ~CommandClient() { close(); }
+
+    CommandClient(const CommandClient&) = delete;
+    CommandClient& operator=(const CommandClient&) = delete;
+
+    bool connect(const std::string& endpoint);
+    void close();
+    bool isConnected() const { return m_handle != -1; }
+
+    // 명령들을 한 배치로 보내고 응답을 기다린다 (reply.results/states 를 채운다)
+    bool call(const Command* commands, size_t count, CommandBatch& reply);
+    // 텍스트 모드: 한 줄 보내고 응답 한 줄 (줄바꿈 제외)
+    bool callText(const std::string& line, std::string& reply);
+
+    bool send(const char* data, size_t size);
+    // 받은 바이트 수, 끊겼으면 0 이하
+    long receive(char* data, size_t size);
+
+private:
+    std::intptr_t m_handle = -1;
+    std::string m_request;
+    std::string m_received;
+};
@@ -0,0 +1,187 @@
+#pragma once
+#include "file_watcher.h"
+#include "key_input.h"
+#include "tiling_engine.h"
+#include "window_rules.h"
+#include "zone_layout.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// 사용자가 편집하는 설정 (settings.conf)
+//   # 주석
+//   grid = 12 12              행 열 (1~64)
+//   grid = monitor=1; 4 6     그 모니터만 다른 행 열 (현재 모니터 구성에 묶여 layout 파일에도 저장)
+//   opacity = 0.5             0~1
+//   grid_visible = 1
+//   bind snap_left = win+left
+//   bind snap_center = win+shift+num5 x2        두 번 연속
+//   bind toggle_grid = alt+g, alt+h             코드 입력
+//   rule = exe=steam.exe; title=*friends*; float
+//   rule = class=Chrome_WidgetWin_1; slot=2; monitor=1; min=800x600
+//   rule = title=*password*; ignore
+//   zone = 0 0 500 1000                         작업 영역 천분율 (왼 위 오 아래)
+//   zone = monitor=1; 0 0 1000 500
+//   zone = monitor=1; merge=0 1                 같은 모니터의 앞선 zone 들을 합친다
+//   zone_gap = 8                                zone 사이 간격 (DIP)
+//   zone_span = 24                              경계에서 이 거리 안이면 이웃 zone 과 함께 (DIP, 0 은 끔)
+//   tiling = monitor=1; bsp; gap=8              모니터별 자동 타일링 (off|bsp|master|columns)
+//   tiling = master; master=0.6; masters=2      monitor 를 빼면 0번, 적지 않은 모니터는 끔
+// 적지 않은 항목은 기본값을 쓴다.
+
+// 모니터 하나의 자동 타일링
+struct TilingConfig {
+    int monitor = 0;
+    TilingOptions options;
+};
+
+// 게시된 뒤에는 바뀌지 않는 설정 스냅샷
+struct ConfigSnapshot {
+    std::uint64_t version = 0;  // 게시 순번 (ConfigStore 가 채운다)
+    int rows = 12;
+    int cols = 12;
+    float opacity = 0.5f;
+    bool gridVisible = false;
+    int animationMs = 0;  // 스냅 애니메이션 길이. 0 이면 바로 이동
+    std::vector<KeyBinding> bindings;  // 파일에 적힌 바인딩만 (나머지는 기본 단축키)
+    std::vector<WindowRuleConfig> rules;  // 기본값(layout json) 규칙 뒤에 파일의 규칙
+    // rules 를 컴파일한 것. 비어 있으면 게시할 때 채운다 (rules 를 고치면 nullptr 로)
+    std::shared_ptr<const CompiledWindowRules> ruleMatcher;
+    std::vector<ZoneConfig> zones;  // 드래그 스냅 zone (비어 있으면 그리드만)
+    int zoneGap = 0;
+    int zoneSpan = 24;
+    std::vector<TilingConfig> tiling;  // 모니터별 자동 타일링 (모니터마다 하나, 적지 않은 모니터는 끔)
+    std::vector<MonitorGridConfig> monitorGrids;  // 모니터별 그리드 (topologyKey 는 0, 적지 않은 모니터는 rows/cols)
+};
+
+// bind 에 쓰는 동작 이름 -> 단축키 id
+struct ConfigActionName {
+    const char* name;
+    int id;
+};
+
+struct ConfigError {
+    int line = 0;  // 0 이면 파일 자체 문제
+    std::string message;
+};
+
+// base 위에 text 의 항목을 덮어써서 out 을 만든다. 실패하면 out 은 쓰레기, error 에 첫 오류
+bool parseConfigText(std::string_view text, const std::vector<ConfigActionName>& actions,
+                     const ConfigSnapshot& base, ConfigSnapshot& out, ConfigError& error);
+// "ctrl+alt+left" 같은 입력 하나
+bool parseKeyStroke(std::string_view text, KeyStroke& out);
+
+// 스냅샷 게시/교체
+// 읽기는 ConfigReader 로 원자 포인터 하나와 카운터 하나만 건드린다 (잠금/할당 없음).
+// 교체된 스냅샷은 그 시점의 읽기가 모두 끝난 뒤(reclaim) 해제한다.
+class ConfigStore {
+public:
+    ConfigStore();
+    ~ConfigStore();
+
+    ConfigStore(const ConfigStore&) = delete;
+    ConfigStore& operator=(const ConfigStore&) = delete;
+
+    void setActions(std::vector<ConfigActionName> actions);
+    // 파일에 적지 않은 항목의 값
+    void setDefaults(const ConfigSnapshot& defaults);
+
+    // 새 스냅샷 게시 (쓰는 쪽끼리는 뮤텍스로 직렬화)
+    void publish(const ConfigSnapshot& snapshot);
+    // 현재 값을 복사해 고친 뒤 게시 (UI 에서 그리드 크기 변경 등)
+    template <typename F>
+    void modify(F&& fn) {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        ConfigSnapshot next = *m_current.load(std::memory_order_acquire);
+        fn(next);
+        publishLocked(next);
+    }
+
+    // 설정 텍스트를 다시 읽는다. 오류가 있으면 이전 스냅샷을 유지하고 false
+    bool reload(std::string_view text);
+    bool reloadFile(const std::filesystem::path& path);
+
+    // 교체된 스냅샷 중 읽는 쪽이 없는 것을 해제
+    void reclaim();
+
+    std::uint64_t version() const { return m_current.load(std::memory_order_acquire)->version; }
+    ConfigError lastError() const;
+    std::uint64_t failedReloads() const { return m_failedReloads.load(std::memory_order_relaxed); }
+    size_t retiredCount() const;
+
+private:
+    friend class ConfigReader;
+
+    void publishLocked(const ConfigSnapshot& snapshot);
+
+    std::atomic<const ConfigSnapshot*> m_current{nullptr};
+    std::atomic<std::uint32_t> m_epoch{0};
+    mutable std::atomic<std::uint32_t> m_readers[2] = {{0}, {0}};
+
+    mutable std::mutex m_writeMutex;
+    std::vector<std::unique_ptr<const ConfigSnapshot>> m_retired;
+    std::unique_ptr<const ConfigSnapshot> m_owned;  // m_current 가 가리키는 것
+    std::vector<ConfigActionName> m_actions;
+    ConfigSnapshot m_defaults;
+    ConfigError m_lastError;
+    std::atomic<std::uint64_t> m_failedReloads{0};
+    std::uint64_t m_nextVersion = 1;
+};
+
+// 읽기 구간 - 살아 있는 동안 받은 스냅샷은 해제되지 않는다
+class ConfigReader {
+public:
+    explicit ConfigReader(const ConfigStore& store)
+        : m_store(store), m_slot(store.m_epoch.load(std::memory_order_seq_cst) & 1) {
+        m_store.m_readers[m_slot].fetch_add(1, std::memory_order_seq_cst);
+        m_snapshot = m_store.m_current.load(std::memory_order_seq_cst);
+    }
+    ~ConfigReader() { m_store.m_readers[m_slot].fetch_sub(1, std::memory_order_release); }
+
+    ConfigReader(const ConfigReader&) = delete;
+    ConfigReader& operator=(const ConfigReader&) = delete;
+
+    const ConfigSnapshot& operator*() const { return *m_snapshot; }
+    const ConfigSnapshot* operator->() const { return m_snapshot; }
+
+private:
+    const ConfigStore& m_store;
+    std::uint32_t m_slot;
+    const ConfigSnapshot* m_snapshot;
+};
+
+// 설정 파일이 바뀌면 작업 스레드에서 다시 읽고 게시한다 (핫 패스 밖)
+class ConfigReloader {
+public:
+    // 다시 읽은 뒤 작업 스레드에서 호출 (ok 가 false 면 이전 설정 유지)
+    using Callback = void (*)(bool ok, void* context);
+
+    ~ConfigReloader() { stop(); }
+
+    // loadNow: 파일이 있으면 작업 스레드에서 먼저 한 번 읽는다 (시작 시 파싱/검사를 메시지 루프 밖에서)
+    bool start(ConfigStore& store, const std::filesystem::path& path, Callback callback, void* context,
+               bool loadNow = false);
+    void stop();
+    bool running() const { return m_running.load(std::memory_order_acquire); }
+    std::uint64_t reloads() const { return m_reloads.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    void reload();
+
+    ConfigStore* m_store = nullptr;
+    std::filesystem::path m_path;
+    bool m_loadNow = false;
+    FileWatcher m_watcher;
+    Callback m_callback = nullptr;
+    void* m_context = nullptr;
+    std::thread m_worker;
+    std::atomic<bool> m_running{false};
+    std::atomic<std::uint64_t> m_reloads{0};
+};
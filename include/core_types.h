@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// 플랫폼 독립 좌표/사각형 타입 (Linux 에서도 빌드되는 코어 모듈용)
+struct Point {
+    int x = 0;
+    int y = 0;
+};
+
+struct Rect {
+    int left = 0;
+    int top = 0;
+    int right = 0;
+    int bottom = 0;
+
+    int width() const { return right - left; }
+    int height() const { return bottom - top; }
+    bool empty() const { return right <= left || bottom <= top; }
+
+    bool contains(Point pt) const {
+        return pt.x >= left && pt.x < right && pt.y >= top && pt.y < bottom;
+    }
+
+    bool operator==(const Rect& other) const {
+        return left == other.left && top == other.top &&
+               right == other.right && bottom == other.bottom;
+    }
+    bool operator!=(const Rect& other) const { return !(*this == other); }
+};
+
+// 두 사각형이 겹치는 면적 (겹치지 않으면 0)
+inline long long intersectionArea(const Rect& a, const Rect& b) {
+    int l = a.left > b.left ? a.left : b.left;
+    int t = a.top > b.top ? a.top : b.top;
+    int r = a.right < b.right ? a.right : b.right;
+    int btm = a.bottom < b.bottom ? a.bottom : b.bottom;
+    if (r <= l || btm <= t) return 0;
+    return static_cast<long long>(r - l) * (btm - t);
+}
+
+// 점에서 사각형까지의 거리 제곱 (내부면 0)
+inline long long distanceSquared(const Rect& r, Point pt) {
+    long long dx = pt.x < r.left ? r.left - pt.x : (pt.x >= r.right ? pt.x - (r.right - 1) : 0);
+    long long dy = pt.y < r.top ? r.top - pt.y : (pt.y >= r.bottom ? pt.y - (r.bottom - 1) : 0);
+    return dx * dx + dy * dy;
+}
+
+// 창 식별자 (Windows 에서는 HWND 값)
+using WindowId = std::uintptr_t;
+
+#ifdef _WIN32
+inline Rect toRect(const RECT& r) { return {r.left, r.top, r.right, r.bottom}; }
+inline RECT toRECT(const Rect& r) { return {r.left, r.top, r.right, r.bottom}; }
+inline Point toPoint(POINT pt) { return {pt.x, pt.y}; }
+inline WindowId toWindowId(HWND hwnd) { return reinterpret_cast<WindowId>(hwnd); }
+inline HWND toHWND(WindowId id) { return reinterpret_cast<HWND>(id); }
+#endif
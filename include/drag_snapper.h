@@ -0,0 +1,94 @@
+#pragma once
+#include "layout_store.h"
+#include "monitor_topology.h"
+#include "zone_layout.h"
+#include <cstdint>
+#include <vector>
+
+// 모니터 하나의 그리드 선 좌표 표
+// 나머지 픽셀은 셀에 고르게 나눠서 마지막 선이 작업 영역 끝과 정확히 맞는다.
+class GridLines {
+public:
+    void build(const Rect& workArea, int rows, int cols);
+
+    // 가장 가까운 선 (이진 탐색)
+    int snapX(int x) const { return nearest(m_xs, x); }
+    int snapY(int y) const { return nearest(m_ys, y); }
+
+    const std::vector<int>& xs() const { return m_xs; }
+    const std::vector<int>& ys() const { return m_ys; }
+
+private:
+    static int nearest(const std::vector<int>& lines, int value);
+
+    std::vector<int> m_xs;
+    std::vector<int> m_ys;
+};
+
+struct DragStats {
+    std::uint64_t samples = 0;         // 받은 포인터 샘플
+    std::uint64_t frames = 0;          // 처리한 프레임
+    std::uint64_t previewUpdates = 0;  // 미리보기 위치가 바뀐 횟수
+    std::uint64_t moves = 0;           // 실제 창 이동 (놓을 때 1회)
+    std::uint64_t zoneHits = 0;        // zone 으로 스냅한 프레임
+};
+
+// 프레임 단위 드래그 스냅
+// 포인터 샘플은 최신 것만 보관하고, 디스플레이 프레임마다 한 번 스냅 위치를 계산해
+// 미리보기만 갱신한다. 창은 놓을 때 한 번만 이동한다.
+class DragSnapper {
+public:
+    // 토폴로지/그리드 크기가 바뀐 경우에만 선 표를 다시 만든다
+    // monitors 는 현재 모니터 구성의 모니터별 그리드 (적지 않은 모니터는 rows/cols)
+    void configure(const MonitorTopology& topology, int rows, int cols,
+                   const std::vector<MonitorGridConfig>& monitors = {});
+    // 설정 버전이나 토폴로지가 바뀐 경우에만 zone 레이아웃을 다시 컴파일한다 (configure 다음에 호출)
+    void configureZones(const std::vector<ZoneConfig>& zones, int gapDip, int spanDip, std::uint64_t version);
+    GridLines* linesFor(int monitorIndex) {
+        if (monitorIndex < 0 || monitorIndex >= static_cast<int>(m_lines.size())) return nullptr;
+        return &m_lines[monitorIndex];
+    }
+    const ZoneLayout* zonesFor(int monitorIndex) const;
+
+    void begin(WindowId window, const Rect& windowRect, Point pt, std::int64_t nowNs);
+    // 프레임 간격이 지났으면 그 프레임을 처리한다. 미리보기가 바뀌었으면 true
+    bool addSample(Point pt, std::int64_t nowNs);
+    // 처리되지 않은 마지막 샘플이 있으면 처리 (타이머에서 호출). 미리보기가 바뀌었으면 true
+    bool flush(std::int64_t nowNs);
+    // 놓을 때 적용할 목표. 위치가 바뀌지 않았으면 false
+    bool end(Rect& target);
+    void cancel();
+
+    bool active() const { return m_active; }
+    WindowId window() const { return m_window; }
+    const Rect& preview() const { return m_preview; }
+    std::int64_t frameIntervalNs() const { return m_frameIntervalNs; }
+    const DragStats& stats() const { return m_stats; }
+    void resetStats() { m_stats = DragStats(); }
+
+    // 포인터 아래 zone 의 목표 사각형. zone 이 없는 곳에서는 창 왼쪽 위를 가장 가까운 그리드 선에 맞춘 사각형
+    bool snapRect(const Rect& windowRect, Point pt, Rect& out);
+
+private:
+    bool processFrame(std::int64_t nowNs);
+
+    const MonitorTopology* m_topology = nullptr;
+    unsigned m_generation = 0;
+    int m_rows = 0;
+    int m_cols = 0;
+    std::vector<MonitorGridConfig> m_monitorGrids;
+    std::vector<GridLines> m_lines;
+    std::vector<ZoneLayout> m_zones;  // 모니터별 (zone 을 정의하지 않았으면 비어 있다)
+    std::uint64_t m_zoneVersion = 0;
+    unsigned m_zoneGeneration = 0;
+
+    bool m_active = false;
+    bool m_hasPending = false;
+    WindowId m_window = 0;
+    Rect m_start;
+    Rect m_preview;
+    Point m_pending;
+    std::int64_t m_lastFrameNs = 0;
+    std::int64_t m_frameIntervalNs = 16'666'667;
+    DragStats m_stats;
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// 이벤트 하나(단축키, 드래그 샘플, 커밋) 동안만 쓰는 임시 메모리
+// 덩어리 하나에서 앞으로만 잘라 주고 이벤트가 끝나면 통째로 되돌린다 (해제 비용 없음).
+// 넘치면 따로 빌린 덩어리로 처리하고, 비워질 때 최대 사용량만큼 키워 두므로
+// 준비가 끝난 뒤에는 힙 할당이 없다. 소멸자가 불리지 않으므로 단순한 타입만 담는다.
+class EventArena {
+public:
+    struct Mark {
+        size_t used = 0;
+        size_t blocks = 0;
+    };
+
+    // 이벤트 구간 - 끝나면 시작 시점으로 되돌린다 (중첩 가능)
+    class Scope {
+    public:
+        explicit Scope(EventArena& arena) : m_arena(arena), m_mark(arena.mark()) {}
+        ~Scope() { m_arena.rewind(m_mark); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        EventArena& m_arena;
+        Mark m_mark;
+    };
+
+    explicit EventArena(size_t capacity = 16 * 1024);
+
+    EventArena(const EventArena&) = delete;
+    EventArena& operator=(const EventArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    template <typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destroyed");
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    Mark mark() const { return {m_used, m_overflow.size()}; }
+    void rewind(const Mark& mark);
+    void reset() { rewind(Mark()); }
+
+    size_t used() const { return m_used + m_overflowBytes; }
+    size_t capacity() const { return m_capacity; }
+    size_t peak() const { return m_peak; }
+    // 덩어리를 넘쳐 따로 빌린 횟수 (준비가 끝난 뒤에는 늘지 않아야 한다)
+    std::uint64_t overflows() const { return m_overflows; }
+
+private:
+    std::unique_ptr<unsigned char[]> m_block;
+    size_t m_capacity = 0;
+    size_t m_used = 0;
+    std::vector<std::unique_ptr<unsigned char[]>> m_overflow;
+    std::vector<size_t> m_overflowSizes;
+    size_t m_overflowBytes = 0;
+    size_t m_peak = 0;
+    std::uint64_t m_overflows = 0;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <filesystem>
+#include <string>
+
+// 파일 하나의 변경 감시 (Windows: FindFirstChangeNotification, Linux: inotify)
+// 편집기는 임시 파일을 쓴 뒤 rename 으로 교체하는 경우가 많아 상위 디렉터리를 감시하고
+// 이름으로 거른다.
+class FileWatcher {
+public:
+    FileWatcher() = default;
+    ~FileWatcher() { stop(); }
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    bool start(const std::filesystem::path& file);
+    void stop();
+    bool isWatching() const;
+
+    // 최대 timeoutMs 동안 기다린다. 감시 대상 파일이 바뀌었으면 true
+    bool wait(int timeoutMs);
+
+private:
+    std::filesystem::path m_file;
+#ifdef _WIN32
+    void* m_handle = nullptr;
+    long long m_lastWrite = 0;
+#else
+    int m_fd = -1;
+    int m_watch = -1;
+    std::string m_name;
+#endif
+};
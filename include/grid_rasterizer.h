@@ -0,0 +1,70 @@
+#pragma once
+#include "core_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// premultiplied ARGB 픽셀 (메모리상 B,G,R,A - UpdateLayeredWindow/DIB 와 동일)
+inline std::uint32_t premultiply(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a) {
+    auto mul = [a](std::uint8_t c) {
+        unsigned t = static_cast<unsigned>(c) * a + 128;
+        return (t + (t >> 8)) >> 8;
+    };
+    return (static_cast<std::uint32_t>(a) << 24) | (mul(r) << 16) | (mul(g) << 8) | mul(b);
+}
+
+// 오버레이용 픽셀 버퍼 (행 간격 = 너비)
+class ArgbBuffer {
+public:
+    void resize(int width, int height);
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    std::uint32_t* data() { return m_pixels.data(); }
+    const std::uint32_t* data() const { return m_pixels.data(); }
+    std::uint32_t* row(int y) { return m_pixels.data() + static_cast<size_t>(y) * m_width; }
+    std::uint32_t pixel(int x, int y) const { return m_pixels[static_cast<size_t>(y) * m_width + x]; }
+    size_t byteSize() const { return m_pixels.size() * sizeof(std::uint32_t); }
+
+private:
+    std::vector<std::uint32_t> m_pixels;
+    int m_width = 0;
+    int m_height = 0;
+};
+
+// 스팬 연산 구현 선택 (기본은 실행 시 CPU 감지)
+enum class SimdLevel {
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+SimdLevel detectSimdLevel();
+SimdLevel activeSimdLevel();
+// 벤치마크/검증용: 지원하지 않는 수준이면 false
+bool setSimdLevel(SimdLevel level);
+const char* simdLevelName(SimdLevel level);
+
+// 스팬 연산 (모든 구현은 비트 단위로 같은 결과)
+void fillSpan(std::uint32_t* dst, int count, std::uint32_t color);
+// premultiplied source-over: dst = src + dst * (255 - srcA) / 255
+void blendSpan(std::uint32_t* dst, int count, std::uint32_t color);
+
+void fillRect(ArgbBuffer& buffer, const Rect& rect, std::uint32_t color);
+void blendRect(ArgbBuffer& buffer, const Rect& rect, std::uint32_t color);
+
+struct GridStyle {
+    std::uint32_t background = 0;       // 보통 완전 투명
+    std::uint32_t lineColor = 0;        // premultiplied
+    std::uint32_t highlightColor = 0;   // premultiplied
+    int lineWidth = 1;
+};
+
+// 그리드 선/강조 셀을 버퍼에 그린다
+// xs/ys 는 버퍼 좌표의 선 위치 (양 끝 선 포함), highlights 는 버퍼 좌표 사각형
+void rasterizeGrid(ArgbBuffer& buffer, const std::vector<int>& xs, const std::vector<int>& ys,
+                   const GridStyle& style, const Rect* highlights = nullptr, size_t highlightCount = 0);
+
+// region 안의 픽셀만 다시 그린다 (결과는 전체를 그렸을 때와 같다)
+void rasterizeGridRegion(ArgbBuffer& buffer, const std::vector<int>& xs, const std::vector<int>& ys,
+                         const GridStyle& style, const Rect* highlights, size_t highlightCount,
+                         const Rect& region);
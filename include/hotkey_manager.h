@@ -1,55 +1,101 @@
-#pragma once
-#include <windows.h>
-#include <map>
-#include <functional>
-
-// 핫키 ID 정의
-enum class HotkeyId {
-    SnapLeft = 1,
-    SnapRight,
-    SnapTop,
-    SnapBottom,
-    SnapTopLeft,
-    SnapTopRight,
-    SnapBottomLeft,
-    SnapBottomRight,
-    SnapCenter,
-    ToggleGrid,
-    ResetWindow
-};
-
-class HotkeyManager {
-public:
-    static HotkeyManager& getInstance();
-
-    // 초기화 및 정리
-    bool initialize();
-    void cleanup();
-
-    // 핫키 등록/해제
-    bool registerHotkeys();
-    void unregisterHotkeys();
-
-    // 핫키 이벤트 처리
-    void handleHotkey(int id);
-
-    // 사용자 정의 핫키 설정
-    bool setHotkey(HotkeyId id, UINT modifiers, UINT key);
-    
-private:
-    HotkeyManager();
-    ~HotkeyManager();
-    
-    HotkeyManager(const HotkeyManager&) = delete;
-    HotkeyManager& operator=(const HotkeyManager&) = delete;
-
-    struct HotkeyInfo {
-        UINT modifiers;
-        UINT key;
-    };
-
-    std::map<HotkeyId, HotkeyInfo> m_hotkeyMap;
-    bool m_initialized;
-
-    void initializeDefaultHotkeys();
-};
+#pragma once
+#include <windows.h>
+#include <map>
+#include <functional>
+#include <vector>
+#include "key_input.h"
+#include "config_store.h"
+
+// 핫키 ID 정의
+enum class HotkeyId {
+    SnapLeft = 1,
+    SnapRight,
+    SnapTop,
+    SnapBottom,
+    SnapTopLeft,
+    SnapTopRight,
+    SnapBottomLeft,
+    SnapBottomRight,
+    SnapCenter,
+    ToggleGrid,
+    ResetWindow,
+    // 방향: 포커스 이동 / 위치 맞바꾸기 / 밀기
+    FocusLeft,
+    FocusRight,
+    FocusUp,
+    FocusDown,
+    SwapLeft,
+    SwapRight,
+    SwapUp,
+    SwapDown,
+    PushLeft,
+    PushRight,
+    PushUp,
+    PushDown
+};
+
+// 핫키 입력 방식
+enum class HotkeyInputMode {
+    RegisterHotKey,  // 기본: RegisterHotKey, 다른 앱이 이미 가진 키만 훅으로 처리
+    KeyboardHook     // 모든 핫키를 저수준 키보드 훅으로 처리
+};
+
+class HotkeyManager {
+public:
+    static HotkeyManager& getInstance();
+
+    // 초기화 및 정리
+    // 등록에 실패한 키가 있으면 false 지만 나머지 키는 살아 있다 (메시지 상자 없음)
+    bool initialize();
+    void cleanup();
+    // 마지막 initialize 의 실패 내용 (없으면 빈 문자열)
+    const wchar_t* getErrorText() const { return m_errorText; }
+
+    // 핫키 등록/해제
+    bool registerHotkeys();
+    void unregisterHotkeys();
+
+    // 핫키 이벤트 처리
+    void handleHotkey(int id);
+
+    // 사용자 정의 핫키 설정
+    bool setHotkey(HotkeyId id, UINT modifiers, UINT key);
+    // 멀티 탭(taps > 1) 또는 코드 입력(second) 바인딩 - 항상 키보드 훅으로 처리
+    bool setHotkeySequence(HotkeyId id, const KeyBinding& binding);
+
+    // settings.conf 의 bind 이름 (snap_left ...)
+    static const std::vector<ConfigActionName>& configActions();
+    // 설정 파일의 바인딩으로 교체 (적지 않은 핫키는 기본값으로 되돌리고 다시 등록)
+    void applyBindings(const std::vector<KeyBinding>& bindings);
+
+    // initialize 전에 호출
+    void setInputMode(HotkeyInputMode mode) { m_inputMode = mode; }
+    HotkeyInputMode getInputMode() const { return m_inputMode; }
+    KeyInputStats getKeyInputStats() const { return m_keyInput.stats(); }
+    
+private:
+    HotkeyManager();
+    ~HotkeyManager();
+    
+    HotkeyManager(const HotkeyManager&) = delete;
+    HotkeyManager& operator=(const HotkeyManager&) = delete;
+
+    struct HotkeyInfo {
+        UINT modifiers;
+        UINT key;
+    };
+
+    std::map<HotkeyId, HotkeyInfo> m_hotkeyMap;
+    std::map<HotkeyId, KeyBinding> m_sequenceMap;
+    std::vector<HotkeyId> m_hookedIds;  // 훅으로 처리하는 단일 입력 핫키
+    HotkeyInputMode m_inputMode = HotkeyInputMode::RegisterHotKey;
+    KeyInputPipeline m_keyInput;
+    DWORD m_threadId = 0;
+    wchar_t m_errorText[1024] = L"";
+    bool m_initialized;
+
+    void initializeDefaultHotkeys();
+    bool startKeyboardHook();
+    void stopKeyboardHook();
+    static void onHookedHotkey(int id, void* context);
+};
@@ -0,0 +1,181 @@
+#pragma once
+#include "drag_snapper.h"
+#include "layout_transaction.h"
+#include "mapped_file.h"
+#include "monitor_topology.h"
+#include "snap_geometry.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+
+// 입력 기록/재생
+// 관리자가 소비하는 입력(단축키, 드래그 좌표, 디스플레이 변경, 포그라운드 변경)을
+// 고정 크기 이진 레코드로 남기고, 가상 모니터/창 백엔드에 최대 속도로 다시 흘려 넣는다.
+
+namespace input_trace_format {
+
+constexpr std::uint32_t kMagic = 0x5449'4D57;  // "WMIT"
+constexpr std::uint32_t kVersion = 1;
+
+struct FileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint32_t reserved;
+};
+
+// 24바이트 레코드 - payload 가 있으면 바로 뒤에 이어진다
+struct Record {
+    std::uint32_t deltaUs;   // 직전 레코드로부터의 시간
+    std::uint8_t type;       // InputEventType
+    std::uint8_t reserved;
+    std::uint16_t payload;   // DisplayChange: 모니터 수, WindowRect: 1
+    std::int32_t a;
+    std::int32_t b;
+    std::uint64_t window;
+};
+
+struct StoredMonitor {
+    Rect bounds;
+    Rect workArea;
+    std::uint32_t dpi;
+    std::uint32_t refreshHz;
+    std::uint32_t primary;
+    std::uint32_t reserved;
+    std::uint64_t handle;
+};
+
+}  // namespace input_trace_format
+
+enum class InputEventType : std::uint8_t {
+    Hotkey,         // a = 단축키 id
+    Foreground,     // window
+    DragMove,       // window, a/b = 포인터 좌표
+    DragEnd,        // window
+    DisplayChange,  // 뒤에 StoredMonitor 배열
+    WindowRect,     // window, 뒤에 Rect 하나 (사용자가 옮긴 창 / 기록 시작 시 창 목록)
+    GridSize,       // a = rows, b = cols
+};
+
+struct InputEvent {
+    InputEventType type = InputEventType::Hotkey;
+    std::int64_t timeUs = 0;  // 기록 시작 기준
+    WindowId window = 0;
+    std::int32_t a = 0;
+    std::int32_t b = 0;
+    Rect rect;
+    const input_trace_format::StoredMonitor* monitors = nullptr;
+    size_t monitorCount = 0;
+};
+
+class InputRecorder {
+public:
+    void start(std::int64_t timeUs);
+    void stop() { m_active = false; }
+    bool active() const { return m_active; }
+
+    void hotkey(int id, std::int64_t timeUs);
+    void foreground(WindowId window, std::int64_t timeUs);
+    void dragMove(WindowId window, Point pt, std::int64_t timeUs);
+    void dragEnd(WindowId window, std::int64_t timeUs);
+    void displayChange(const MonitorTopology& topology, std::int64_t timeUs);
+    void windowRect(WindowId window, const Rect& rect, std::int64_t timeUs);
+    void gridSize(int rows, int cols, std::int64_t timeUs);
+
+    const std::vector<unsigned char>& data() const { return m_data; }
+    size_t eventCount() const { return m_events; }
+    bool save(const std::filesystem::path& path) const;
+
+    static std::int64_t nowUs();
+
+private:
+    void append(InputEventType type, std::int64_t timeUs, WindowId window, std::int32_t a, std::int32_t b,
+                std::uint16_t payload);
+
+    std::vector<unsigned char> m_data;
+    std::int64_t m_lastUs = 0;
+    size_t m_events = 0;
+    bool m_active = false;
+};
+
+// 기록 읽기 (파일은 매핑해서 복사 없이 읽는다)
+class InputTraceReader {
+public:
+    bool open(const std::filesystem::path& path);
+    // data 는 리더보다 오래 살아야 한다
+    bool attach(const unsigned char* data, size_t size);
+
+    // 다음 이벤트. 끝이거나 잘린 레코드를 만나면 false
+    bool next(InputEvent& out);
+    void rewind();
+    bool truncated() const { return m_truncated; }
+
+private:
+    MappedFile m_file;
+    const unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_offset = 0;
+    std::int64_t m_timeUs = 0;
+    bool m_truncated = false;
+};
+
+// 단축키 id 가 하는 일 (앱마다 id 체계가 달라 재생하는 쪽에서 연결)
+struct HotkeyAction {
+    enum Kind : std::uint8_t {
+        None,
+        Position,  // arg = WindowPosition
+        Side,      // arg != 0 이면 왼쪽, 연속 입력 시 비율 순환
+        Half,      // arg != 0 이면 위쪽
+        Maximize,  // 작업 영역 전체
+    };
+    Kind kind = None;
+    int arg = 0;
+};
+
+struct ReplayStats {
+    std::uint64_t events = 0;
+    std::uint64_t hotkeys = 0;
+    std::uint64_t dragMoves = 0;
+    std::uint64_t displayChanges = 0;
+    std::uint64_t moves = 0;       // 실제로 위치가 바뀐 창 이동
+    double elapsedNs = 0;
+    double eventsPerSecond = 0;
+    bool truncated = false;
+};
+
+// 관리자 코어(토폴로지, 스냅 계산, 비율 순환, 드래그 스냅, 레이아웃 커밋)에
+// 기록을 최대 속도로 흘려 넣는다. 시간은 기록된 값을 그대로 써서 결과가 항상 같다.
+class InputReplayer {
+public:
+    InputReplayer();
+
+    void bindHotkey(int id, HotkeyAction action) { m_hotkeys[id] = action; }
+
+    ReplayStats run(InputTraceReader& reader);
+
+    const MonitorTopology& topology() const { return m_topology; }
+    bool rectOf(WindowId window, Rect& out) const;
+    // 창 id 순으로 정렬된 최종 위치
+    void finalGeometry(std::vector<WindowMove>& out) const;
+    // 최종 위치 해시 (회귀 비교용)
+    std::uint64_t geometryHash() const;
+
+private:
+    void apply(const InputEvent& event, ReplayStats& stats);
+    void moveWindow(WindowId window, const Rect& target, ReplayStats& stats);
+
+    SimulatedMonitorBackend m_monitorBackend;
+    MonitorTopology m_topology;
+    FakeWindowMoveBackend m_windows;
+    LayoutTransaction m_transaction;
+    DragSnapper m_drag;
+    RatioCycler m_cycler;
+    std::unordered_map<int, HotkeyAction> m_hotkeys;
+    std::vector<WindowId> m_known;
+    std::vector<MonitorInfo> m_monitorScratch;
+    WindowId m_foreground = 0;
+    int m_rows = 12;
+    int m_cols = 12;
+};
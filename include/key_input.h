@@ -0,0 +1,168 @@
+#pragma once
+#include "spsc_ring.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 저수준 키보드 훅 입력 경로 (플랫폼 독립 부분)
+// 훅 콜백: KeyFilter 로 비트맵 조회 -> KeyEvent 를 SPSC 링에 넣고 바로 반환
+// 작업 스레드: 링에서 꺼내 KeyBindingResolver 로 멀티 탭/코드 입력을 해석
+
+// 수식키 비트 (RegisterHotKey 의 MOD_ALT/MOD_CONTROL/MOD_SHIFT/MOD_WIN 과 같은 값)
+enum KeyModifiers : std::uint8_t {
+    KeyModAlt = 0x1,
+    KeyModControl = 0x2,
+    KeyModShift = 0x4,
+    KeyModWin = 0x8,
+};
+
+// 링으로 넘기는 8바이트 이벤트
+struct KeyEvent {
+    std::uint32_t timeMs = 0;
+    std::uint8_t vk = 0;
+    std::uint8_t modifiers = 0;
+    std::uint16_t reserved = 0;
+};
+
+// 수식키 + 가상 키 하나
+struct KeyStroke {
+    std::uint8_t modifiers = 0;
+    std::uint8_t vk = 0;
+    bool operator==(const KeyStroke& o) const { return modifiers == o.modifiers && vk == o.vk; }
+    bool operator!=(const KeyStroke& o) const { return !(*this == o); }
+};
+
+// 바인딩: first 를 taps 번 누르거나, first 다음에 second 를 누르는 코드 입력
+struct KeyBinding {
+    int id = 0;
+    KeyStroke first;
+    KeyStroke second;        // vk 가 0 이면 단일 입력
+    std::uint8_t taps = 1;   // second 가 있으면 무시
+};
+
+// KeyFilter::filter 결과
+enum KeyFilterResult : unsigned {
+    KeyFilterPass = 0,
+    KeyFilterPush = 1u << 0,     // 작업 스레드로 넘길 이벤트
+    KeyFilterSwallow = 1u << 1,  // 다른 앱에 전달하지 않음
+    KeyFilterMaskMenu = 1u << 2, // Win/Alt 가 눌린 조합을 삼킴 - 수식키만 뗀 것으로 보여 시작 메뉴/메뉴 바가 열리지 않게 해야 함
+};
+
+// 훅 스레드에서 쓰는 키 필터
+// 가상 키마다 수식키 조합(16가지) 비트마스크를 미리 만들어 두고 조회만 한다 (할당/분기 최소).
+class KeyFilter {
+public:
+    KeyFilter();
+
+    void build(const std::vector<KeyBinding>& bindings);
+
+    // 수식키 상태를 갱신하고 이벤트를 넘길지/삼킬지 판단
+    // (시각은 넘길 때만 호출한 쪽에서 채운다 - 대부분의 키는 시계를 읽지 않고 통과)
+    unsigned filter(std::uint8_t vk, bool down, KeyEvent& out);
+
+    // 코드 입력의 첫 키를 받은 뒤 작업 스레드가 켠다 (두 번째 키도 삼키도록)
+    void setChordArmed(bool armed) { m_chordArmed.store(armed, std::memory_order_relaxed); }
+    std::uint8_t modifiers() const { return m_modifiers; }
+    void reset();
+
+    static std::uint8_t modifierOf(std::uint8_t vk);
+
+private:
+    static bool testBit(const std::uint64_t* bits, std::uint8_t vk) { return (bits[vk >> 6] >> (vk & 63)) & 1; }
+    static void setBit(std::uint64_t* bits, std::uint8_t vk) { bits[vk >> 6] |= 1ull << (vk & 63); }
+    static void clearBit(std::uint64_t* bits, std::uint8_t vk) { bits[vk >> 6] &= ~(1ull << (vk & 63)); }
+
+    std::uint16_t m_firstMask[256];   // 첫 입력으로 쓰이는 수식키 조합
+    std::uint16_t m_secondMask[256];  // 코드 두 번째 입력으로 쓰이는 조합
+    std::uint64_t m_down[4];          // 눌린 키 (자동 반복 구분)
+    std::uint64_t m_swallowed[4];     // 누름을 삼킨 키 - 뗌도 삼킨다
+    std::uint8_t m_modifiers = 0;
+    std::atomic<bool> m_chordArmed{false};
+};
+
+// 작업 스레드에서 키 입력 순서를 바인딩으로 해석
+// 같은 입력에 단일/더블 탭이 모두 있으면 시간 제한까지 기다렸다가 확정한다.
+class KeyBindingResolver {
+public:
+    void build(const std::vector<KeyBinding>& bindings, std::uint32_t sequenceTimeoutMs = 400);
+
+    // 확정된 바인딩 id 를 out 에 추가
+    void feed(const KeyEvent& event, std::vector<int>& out);
+    // 시간 제한이 지난 대기 입력을 확정
+    void poll(std::uint32_t nowMs, std::vector<int>& out);
+
+    // 대기 중인 입력이 있으면 true 와 확정 시각
+    bool nextDeadline(std::uint32_t& deadlineMs) const;
+    bool chordArmed() const { return m_pendingTaps > 0 && m_pendingPrefix; }
+
+private:
+    struct StrokeInfo {
+        KeyStroke stroke;
+        std::uint8_t maxTaps = 0;  // 0 이면 바인딩 없음
+        bool prefix = false;       // 코드 입력의 첫 키
+    };
+
+    const StrokeInfo* info(const KeyStroke& stroke) const;
+    int findTaps(const KeyStroke& stroke, std::uint8_t taps) const;
+    int findChord(const KeyStroke& first, const KeyStroke& second) const;
+    void flushPending(std::vector<int>& out);
+    void start(const KeyStroke& stroke, std::uint32_t timeMs, std::vector<int>& out);
+
+    std::vector<KeyBinding> m_bindings;
+    std::vector<StrokeInfo> m_strokes;
+    std::uint32_t m_timeoutMs = 400;
+
+    KeyStroke m_pending;
+    std::uint8_t m_pendingTaps = 0;
+    bool m_pendingPrefix = false;
+    std::uint32_t m_pendingTime = 0;
+};
+
+struct KeyInputStats {
+    std::uint64_t pushed = 0;
+    std::uint64_t dropped = 0;  // 링이 가득 차서 버린 이벤트
+    std::uint64_t resolved = 0;
+};
+
+// 훅 스레드(생산자) -> SPSC 링 -> 작업 스레드(소비자) 파이프라인
+class KeyInputPipeline {
+public:
+    using Ring = SpscRing<KeyEvent, 256>;
+    using BindingCallback = void (*)(int bindingId, void* context);
+
+    ~KeyInputPipeline();
+
+    bool start(const std::vector<KeyBinding>& bindings, BindingCallback callback, void* context,
+               std::uint32_t sequenceTimeoutMs = 400);
+    void stop();
+    bool running() const { return m_running.load(std::memory_order_acquire); }
+
+    // 훅 스레드에서 호출 - KeyFilterResult 비트를 돌려준다
+    unsigned onKey(std::uint8_t vk, bool down);
+
+    KeyInputStats stats() const;
+    static std::uint32_t nowMs();
+
+private:
+    void run();
+
+    KeyFilter m_filter;
+    KeyBindingResolver m_resolver;
+    Ring m_ring;
+    BindingCallback m_callback = nullptr;
+    void* m_context = nullptr;
+
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_sleeping{false};
+
+    std::atomic<std::uint64_t> m_pushed{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<std::uint64_t> m_resolved{0};
+};
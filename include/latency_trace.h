@@ -0,0 +1,109 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// 단축키 -> 창 이동 구간별 지연 계측
+// 단계마다 직전 단계로부터의 시간을 히스토그램에 넣고, 고정 크기 링에 이진 이벤트로 남긴다.
+// 기록은 잠금/할당 없이 원자 연산만 사용하므로 UI 스레드와 이동 작업 스레드에서 함께 부를 수 있다.
+
+enum class TraceStage : std::uint8_t {
+    HotkeyReceived,    // WM_HOTKEY 수신 (구간 시작)
+    ForegroundLookup,  // 대상 창 확인
+    GeometryComputed,  // 목표 위치 계산
+    MoveReturned,      // SetWindowPos 반환
+    TargetReached,     // 창이 실제로 목표 위치에 있음
+    Count,
+};
+
+const char* traceStageName(TraceStage stage);
+
+// HDR 방식 로그-선형 히스토그램 (나노초)
+// 2의 거듭제곱 구간마다 32칸으로 나눠 상대 오차 약 3% 이내, 기록은 O(1)
+class LatencyHistogram {
+public:
+    static constexpr int kSubBits = 5;
+    static constexpr int kSubBuckets = 1 << kSubBits;
+    static constexpr int kBuckets = (64 - kSubBits + 1) * kSubBuckets;
+
+    void record(std::uint64_t ns);
+    void reset();
+
+    std::uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+    std::uint64_t min() const;
+    std::uint64_t max() const { return m_max.load(std::memory_order_relaxed); }
+    double mean() const;
+    // p 는 0~100, 해당 칸의 상한을 돌려준다
+    std::uint64_t percentile(double p) const;
+
+    static int bucketOf(std::uint64_t ns);
+    static std::uint64_t bucketLow(int bucket);
+    static std::uint64_t bucketHigh(int bucket);
+
+private:
+    std::atomic<std::uint64_t> m_buckets[kBuckets] = {};
+    std::atomic<std::uint64_t> m_count{0};
+    std::atomic<std::uint64_t> m_sum{0};
+    std::atomic<std::uint64_t> m_min{~0ull};
+    std::atomic<std::uint64_t> m_max{0};
+};
+
+// 링에서 읽어낸 이벤트
+struct TraceEvent {
+    std::int64_t startNs = 0;
+    std::uint32_t durationNs = 0;
+    std::uint32_t span = 0;
+    TraceStage stage = TraceStage::HotkeyReceived;
+};
+
+class LatencyTracer {
+public:
+    static constexpr size_t kRingSize = 4096;   // 최근 이벤트 수 (2의 거듭제곱)
+    static constexpr size_t kActiveSpans = 64;  // 동시에 진행 중인 구간 수
+
+    // 새 구간 시작 (HotkeyReceived 기록). 꺼져 있으면 0
+    std::uint32_t beginSpan();
+    // 구간의 다음 단계 기록 - span 이 0 이면 아무것도 하지 않는다
+    void mark(std::uint32_t span, TraceStage stage);
+
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    const LatencyHistogram& histogram(TraceStage stage) const { return m_stages[static_cast<int>(stage)]; }
+    // 단축키 수신부터 목표 도달까지
+    const LatencyHistogram& total() const { return m_total; }
+
+    // 오래된 것부터 최대 capacity 개 복사 (기록 중인 칸은 건너뜀)
+    size_t snapshot(TraceEvent* out, size_t capacity) const;
+    std::uint64_t recorded() const { return m_next.load(std::memory_order_relaxed); }
+    void reset();
+
+    // Chrome trace (chrome://tracing, Perfetto) JSON - 히스토그램 요약은 otherData 에
+    void exportChromeTrace(std::string& out) const;
+    bool writeChromeTrace(const std::filesystem::path& path) const;
+
+    static std::int64_t nowNs();
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0};  // 기록 번호 + 1, 기록 중이면 0
+        std::atomic<std::uint64_t> start{0};
+        std::atomic<std::uint64_t> packed{0};    // 길이(32) | 구간(24) | 단계(8)
+    };
+    struct Span {
+        std::atomic<std::int64_t> startNs{0};
+        std::atomic<std::int64_t> lastNs{0};
+    };
+
+    void push(std::int64_t startNs, std::uint64_t durationNs, std::uint32_t span, TraceStage stage);
+
+    std::atomic<bool> m_enabled{true};
+    std::atomic<std::uint32_t> m_nextSpan{0};
+    std::atomic<std::uint64_t> m_next{0};
+    Span m_spans[kActiveSpans];
+    Slot m_ring[kRingSize];
+    LatencyHistogram m_stages[static_cast<int>(TraceStage::Count)];
+    LatencyHistogram m_total;
+};
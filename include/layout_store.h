@@ -0,0 +1,212 @@
+#pragma once
+#include "core_types.h"
+#include "mapped_file.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 레이아웃 스냅샷 파일 포맷 (리틀 엔디언, 모든 레코드는 8바이트 정렬)
+//   FileHeader | SectionEntry[sectionCount] | 섹션 데이터...
+// 로드는 매핑한 메모리를 그대로 레코드 배열로 본다 (파싱 없음).
+namespace layout_format {
+
+constexpr char kMagic[8] = {'W', 'M', 'L', 'A', 'Y', 'O', 'U', 'T'};
+constexpr std::uint32_t kVersion = 1;
+
+enum SectionType : std::uint32_t {
+    SectionGrid = 1,
+    SectionLayouts = 2,
+    SectionLayoutWindows = 3,
+    SectionRules = 4,
+    SectionMonitors = 5,
+    SectionStrings = 6,
+    SectionWindowTitles = 7,  // LayoutWindows 와 같은 순서의 제목 해시 (uint64). 없는 파일도 읽는다
+};
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t sectionCount;
+    std::uint64_t fileSize;
+    std::uint32_t checksum;  // 헤더 이후 전체 바이트의 체크섬
+    std::uint32_t reserved;
+};
+
+struct SectionEntry {
+    std::uint32_t type;
+    std::uint32_t count;
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+// 문자열은 Strings 섹션의 (offset, length)
+struct StringRef {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+struct StoredGrid {
+    std::int32_t rows;
+    std::int32_t cols;
+    float opacity;
+    std::uint32_t visible;
+};
+
+struct StoredLayout {
+    StringRef name;
+    std::uint32_t firstWindow;
+    std::uint32_t windowCount;
+};
+
+enum StoredWindowFlags : std::uint32_t {
+    WindowMaximized = 1u << 0,
+};
+
+struct StoredWindowLayout {
+    std::uint64_t windowKey;  // 창 식별 키 (실행 파일 + 창 클래스 해시)
+    Rect position;
+    std::int32_t monitorIndex;
+    std::uint32_t flags;
+};
+
+struct StoredRule {
+    StringRef className;
+    StringRef titlePattern;
+    StringRef executable;
+    std::uint32_t action;
+    std::int32_t slot;
+    std::int32_t monitor;
+    std::int32_t minWidth;
+    std::int32_t minHeight;
+    std::uint32_t reserved;
+};
+
+struct StoredMonitorConfig {
+    std::uint64_t topologyKey;  // 모니터 구성 식별 키
+    std::int32_t monitorIndex;
+    std::int32_t rows;
+    std::int32_t cols;
+    std::uint32_t reserved;
+};
+
+std::uint32_t checksum(const unsigned char* data, size_t size);
+
+}  // namespace layout_format
+
+// 창 규칙 (소유 문자열 버전)
+struct WindowRuleConfig {
+    std::string className;
+    std::string titlePattern;
+    std::string executable;
+    std::uint32_t action = 0;
+    std::int32_t slot = -1;
+    std::int32_t monitor = -1;
+    std::int32_t minWidth = 0;
+    std::int32_t minHeight = 0;
+};
+
+// 모니터 구성별 그리드 설정 (topologyKey 는 MonitorTopology::key)
+struct MonitorGridConfig {
+    std::uint64_t topologyKey = 0;
+    std::int32_t monitorIndex = 0;
+    std::int32_t rows = 12;
+    std::int32_t cols = 12;
+
+    // settings.conf 의 grid 와 같은 범위 (1~64)
+    bool valid() const { return monitorIndex >= 0 && rows >= 1 && rows <= 64 && cols >= 1 && cols <= 64; }
+    bool operator==(const MonitorGridConfig& o) const {
+        return topologyKey == o.topologyKey && monitorIndex == o.monitorIndex && rows == o.rows && cols == o.cols;
+    }
+};
+
+// configs 에 monitorIndex 항목이 있으면 rows/cols 를 그 값으로 (현재 구성의 항목만 넘긴다)
+void monitorGridSize(const std::vector<MonitorGridConfig>& configs, int monitorIndex, int& rows, int& cols);
+
+// 스냅샷 작성기 - 모은 뒤 한 번에 직렬화하고 원자적으로 교체한다
+class LayoutSnapshotWriter {
+public:
+    void setGrid(int rows, int cols, float opacity, bool visible);
+    // titleHashes 는 windows 와 같은 길이 (비우면 0)
+    void addLayout(std::string_view name, const std::vector<layout_format::StoredWindowLayout>& windows,
+                   const std::vector<std::uint64_t>& titleHashes = {});
+    void addRule(const WindowRuleConfig& rule);
+    void addMonitorConfig(const MonitorGridConfig& config);
+
+    std::vector<unsigned char> serialize() const;
+    bool writeAtomic(const std::filesystem::path& path) const;
+
+private:
+    struct PendingLayout {
+        std::string name;
+        std::vector<layout_format::StoredWindowLayout> windows;
+        std::vector<std::uint64_t> titleHashes;
+    };
+
+    layout_format::StoredGrid m_grid = {12, 12, 0.5f, 0};
+    std::vector<PendingLayout> m_layouts;
+    std::vector<WindowRuleConfig> m_rules;
+    std::vector<MonitorGridConfig> m_monitors;
+};
+
+// 매핑된 스냅샷 읽기 전용 뷰
+class LayoutSnapshot {
+public:
+    struct LayoutView {
+        std::string_view name;
+        const layout_format::StoredWindowLayout* windows;
+        const std::uint64_t* titleHashes;  // 이전 파일이면 nullptr
+        size_t windowCount;
+    };
+
+    // 파일을 매핑하고 헤더/섹션 범위/체크섬을 검증
+    bool open(const std::filesystem::path& path);
+    // 이미 메모리에 있는 이미지 검증 (data 는 뷰보다 오래 살아야 함)
+    bool attach(const unsigned char* data, size_t size);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    const layout_format::StoredGrid* grid() const { return m_grid; }
+
+    size_t layoutCount() const { return m_layoutCount; }
+    LayoutView layout(size_t index) const;
+    // 이름은 정렬되어 저장되므로 이진 탐색
+    bool findLayout(std::string_view name, LayoutView& out) const;
+
+    size_t ruleCount() const { return m_ruleCount; }
+    const layout_format::StoredRule& rule(size_t index) const { return m_rules[index]; }
+    WindowRuleConfig ruleConfig(size_t index) const;
+
+    size_t monitorConfigCount() const { return m_monitorCount; }
+    const layout_format::StoredMonitorConfig& monitorConfig(size_t index) const { return m_monitors[index]; }
+
+    std::string_view string(layout_format::StringRef ref) const {
+        return std::string_view(m_strings + ref.offset, ref.length);
+    }
+
+private:
+    MappedFile m_file;
+    const unsigned char* m_data = nullptr;
+    const layout_format::StoredGrid* m_grid = nullptr;
+    const layout_format::StoredLayout* m_layouts = nullptr;
+    size_t m_layoutCount = 0;
+    const layout_format::StoredWindowLayout* m_windows = nullptr;
+    size_t m_windowCount = 0;
+    const std::uint64_t* m_titleHashes = nullptr;
+    const layout_format::StoredRule* m_rules = nullptr;
+    size_t m_ruleCount = 0;
+    const layout_format::StoredMonitorConfig* m_monitors = nullptr;
+    size_t m_monitorCount = 0;
+    const char* m_strings = nullptr;
+    size_t m_stringsSize = 0;
+};
+
+// 이전 버전의 텍스트 설정 ("rows cols opacity")
+struct LegacyGridConfig {
+    int rows = 12;
+    int cols = 12;
+    float opacity = 0.5f;
+};
+
+// 세 값이 모두 있고 범위 안(행/열 1~64, 불투명도 0~1)일 때만 out 을 채운다
+bool parseLegacyGridConfig(std::string_view text, LegacyGridConfig& out);
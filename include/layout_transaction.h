@@ -0,0 +1,125 @@
+#pragma once
+#include "core_types.h"
+#include "event_arena.h"
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// 이동과 함께 바꿀 표시 상태 (작업 공간 전환은 숨기기/보이기/이동을 한 배치로 적용)
+enum WindowMoveFlags : std::uint32_t {
+    MoveShow = 1u << 0,
+    MoveHide = 1u << 1,
+    MoveKeepRect = 1u << 2,  // target 무시, 표시 상태만 바꾼다
+    MoveAsync = 1u << 3,     // applyOne 전용: 기다리지 않고 대상 스레드에 요청만 보낸다 (애니메이션 단계)
+};
+
+// 창 하나의 목표 위치
+struct WindowMove {
+    WindowId window = 0;
+    Rect target;
+    std::uint32_t flags = 0;
+};
+
+// 창 이동 백엔드 - Windows 에서는 DeferWindowPos/SetWindowPos
+class WindowMoveBackend {
+public:
+    virtual ~WindowMoveBackend() = default;
+    virtual bool getWindowRect(WindowId window, Rect& out) = 0;
+    // 한 번의 지연 커밋으로 모두 적용. 하나라도 실패하면 false (적용된 것 없음)
+    virtual bool applyBatch(const WindowMove* moves, size_t count) = 0;
+    virtual bool applyOne(const WindowMove& move) = 0;
+};
+
+// 커밋 결과 통계
+struct LayoutCommitStats {
+    size_t requested = 0;  // 중복 제거 후 요청 수
+    size_t issued = 0;     // 실제로 이동시킨 창 수
+    size_t skipped = 0;    // 이미 목표 위치라 건너뛴 수
+    size_t failed = 0;     // 창이 없거나 이동 실패
+    size_t batches = 0;    // 배치 커밋 횟수 (0 또는 1)
+    bool fellBack = false; // 배치 실패로 개별 이동을 사용했는지
+};
+
+// 여러 창의 목표 위치를 모았다가 한 번에 커밋하는 트랜잭션
+class LayoutTransaction {
+public:
+    // arena 를 주면 커밋의 임시 메모리를 그 이벤트 구간에서 빌린다 (없으면 자체 arena)
+    explicit LayoutTransaction(WindowMoveBackend& backend, EventArena* arena = nullptr)
+        : m_backend(backend), m_arena(arena) {}
+
+    // 같은 창을 여러 번 넣으면 마지막 목표가 적용된다
+    void move(WindowId window, const Rect& target) { m_pending.push_back({window, target}); }
+    // 표시 상태가 바뀌는 요청은 위치가 같아도 건너뛰지 않는다
+    void show(WindowId window, const Rect& target) { m_pending.push_back({window, target, MoveShow}); }
+    void show(WindowId window) { m_pending.push_back({window, {}, MoveShow | MoveKeepRect}); }
+    void hide(WindowId window) { m_pending.push_back({window, {}, MoveHide | MoveKeepRect}); }
+    size_t size() const { return m_pending.size(); }
+    bool empty() const { return m_pending.empty(); }
+    void clear() { m_pending.clear(); }
+
+    // 변화 없는 이동을 제거하고 한 번의 배치로 적용. 커밋 후 트랜잭션은 비워진다
+    LayoutCommitStats commit();
+
+private:
+    WindowMoveBackend& m_backend;
+    EventArena* m_arena;
+    EventArena m_ownArena{0};  // 처음 커밋에서 필요한 만큼 자란다
+    std::vector<WindowMove> m_pending;
+    std::vector<WindowMove> m_effective;  // 커밋마다 재사용
+};
+
+// 테스트/벤치마크용 가짜 백엔드 - 창 위치를 메모리에만 보관
+class FakeWindowMoveBackend : public WindowMoveBackend {
+public:
+    void addWindow(WindowId window, const Rect& rect) { m_windows[window] = rect; }
+    void removeWindow(WindowId window) { m_windows.erase(window); }
+    bool isVisible(WindowId window) const { return m_windows.count(window) && !m_hidden.count(window); }
+    // 이 창이 포함된 배치와 개별 이동을 실패시킨다
+    void setFailing(WindowId window) { m_failing.insert(window); }
+    const Rect* rectOf(WindowId window) const {
+        auto it = m_windows.find(window);
+        return it != m_windows.end() ? &it->second : nullptr;
+    }
+
+    bool getWindowRect(WindowId window, Rect& out) override {
+        auto it = m_windows.find(window);
+        if (it == m_windows.end()) return false;
+        out = it->second;
+        return true;
+    }
+
+    bool applyBatch(const WindowMove* moves, size_t count) override {
+        ++batchCalls;
+        for (size_t i = 0; i < count; ++i) {
+            if (m_failing.count(moves[i].window) || !m_windows.count(moves[i].window)) return false;
+        }
+        for (size_t i = 0; i < count; ++i) apply(moves[i]);
+        movesApplied += count;
+        return true;
+    }
+
+    bool applyOne(const WindowMove& move) override {
+        ++singleCalls;
+        auto it = m_windows.find(move.window);
+        if (it == m_windows.end() || m_failing.count(move.window)) return false;
+        apply(move);
+        ++movesApplied;
+        return true;
+    }
+
+    size_t batchCalls = 0;
+    size_t singleCalls = 0;
+    size_t movesApplied = 0;
+
+private:
+    void apply(const WindowMove& move) {
+        if (!(move.flags & MoveKeepRect)) m_windows[move.window] = move.target;
+        if (move.flags & MoveHide) m_hidden.insert(move.window);
+        if (move.flags & MoveShow) m_hidden.erase(move.window);
+    }
+
+    std::unordered_map<WindowId, Rect> m_windows;
+    std::unordered_set<WindowId> m_failing;
+    std::unordered_set<WindowId> m_hidden;
+};
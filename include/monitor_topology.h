@@ -0,0 +1,64 @@
+#pragma once
+#include "core_types.h"
+#include <vector>
+
+// 모니터 한 개의 캐시된 정보
+struct MonitorInfo {
+    int index = -1;             // 안정 인덱스 (좌표 순 정렬)
+    std::uintptr_t handle = 0;  // 플랫폼 핸들 (Windows 에서는 HMONITOR)
+    Rect bounds;                // 전체 영역
+    Rect workArea;              // 작업 영역 (작업 표시줄 제외)
+    unsigned dpi = 96;
+    unsigned refreshHz = 60;
+    bool primary = false;
+};
+
+// 모니터 열거 백엔드 - 실제 시스템 호출은 여기서만 발생
+class MonitorBackend {
+public:
+    virtual ~MonitorBackend() = default;
+    virtual void enumerate(std::vector<MonitorInfo>& out) = 0;
+};
+
+// 테스트/벤치마크용 가상 모니터 배치
+class SimulatedMonitorBackend : public MonitorBackend {
+public:
+    void setMonitors(std::vector<MonitorInfo> monitors) { m_monitors = std::move(monitors); }
+    void enumerate(std::vector<MonitorInfo>& out) override { out = m_monitors; }
+
+private:
+    std::vector<MonitorInfo> m_monitors;
+};
+
+// 모니터 토폴로지 캐시
+// 디스플레이/작업 영역 변경 알림에서만 rebuild 하고,
+// 스냅 경로에서는 조회만 하므로 모니터 관련 시스템 호출이 없다.
+// 조회는 상태를 바꾸지 않으므로 rebuild 중이 아니면 여러 스레드에서 읽어도 된다.
+class MonitorTopology {
+public:
+    void rebuild(MonitorBackend& backend);
+
+    int size() const { return static_cast<int>(m_monitors.size()); }
+    bool empty() const { return m_monitors.empty(); }
+    const MonitorInfo& monitor(int index) const { return m_monitors[index]; }
+    const std::vector<MonitorInfo>& monitors() const { return m_monitors; }
+
+    // rebuild 할 때마다 증가 (다른 캐시의 무효화 기준)
+    unsigned generation() const { return m_generation; }
+    // 모니터 구성 식별 키 (개수와 각 전체 영역. 같은 배치로 돌아오면 같은 값)
+    std::uint64_t key() const { return m_key; }
+
+    // MONITOR_DEFAULTTONEAREST 와 같은 의미: 포함하는 모니터, 없으면 가장 가까운 모니터
+    int monitorFromPoint(Point pt) const;
+    // MonitorFromRect 와 같은 의미: 가장 많이 겹치는 모니터, 없으면 가장 가까운 모니터
+    int monitorFromRect(const Rect& rect) const;
+    int indexOfHandle(std::uintptr_t handle) const;
+    int primaryIndex() const { return m_primary; }
+
+private:
+    std::vector<MonitorInfo> m_monitors;
+    std::vector<Rect> m_bounds;  // 조회용으로 촘촘하게 모아둔 전체 영역
+    int m_primary = -1;
+    unsigned m_generation = 0;
+    std::uint64_t m_key = 0;
+};
@@ -0,0 +1,106 @@
+#pragma once
+#include "drag_snapper.h"
+#include "grid_rasterizer.h"
+#include "layout_store.h"
+#include "monitor_topology.h"
+#include <vector>
+
+// 다시 그려야 할 영역 목록 (개수가 많아지면 하나로 합친다)
+class DirtyRegion {
+public:
+    static const size_t kMaxRects = 8;
+
+    void add(const Rect& rect);
+    void clear() { m_count = 0; }
+    bool empty() const { return m_count == 0; }
+    size_t count() const { return m_count; }
+    const Rect& rect(size_t index) const { return m_rects[index]; }
+    Rect bounds() const;
+
+private:
+    Rect m_rects[kMaxRects];
+    size_t m_count = 0;
+};
+
+// 오버레이 그리기 설정 (행 열은 monitorGrids 에 적은 모니터만 따로)
+struct OverlayStyle {
+    int rows = 12;
+    int cols = 12;
+    std::vector<MonitorGridConfig> monitorGrids;  // 현재 모니터 구성의 항목
+    float opacity = 0.5f;
+    bool visible = false;
+};
+
+// 모니터 하나의 캐시된 오버레이 버퍼
+// 그리드 설정/DPI/작업 영역이 바뀔 때만 전체를 다시 그리고,
+// 강조 셀 변경은 해당 영역만 다시 그린다.
+class OverlaySurface {
+public:
+    const ArgbBuffer& buffer() const { return m_buffer; }
+    const Rect& bounds() const { return m_bounds; }  // 화면 좌표 (오버레이 창 위치)
+    const Rect& workArea() const { return m_work; }  // 버퍼 좌표
+    const GridLines& lines() const { return m_lines; }
+    bool hasHighlight() const { return m_hasHighlight; }
+    const Rect& highlight() const { return m_highlight; }
+
+private:
+    friend class OverlaySurfaceSet;
+
+    struct Key {
+        Rect bounds;
+        Rect work;
+        unsigned dpi = 0;
+        int rows = 0;
+        int cols = 0;
+        float opacity = 0.0f;
+        bool operator==(const Key& o) const {
+            return bounds == o.bounds && work == o.work && dpi == o.dpi &&
+                   rows == o.rows && cols == o.cols && opacity == o.opacity;
+        }
+    };
+
+    Key m_key;
+    bool m_valid = false;
+    bool m_fullRender = true;
+    ArgbBuffer m_buffer;
+    GridLines m_lines;
+    Rect m_bounds;
+    Rect m_work;
+    GridStyle m_style;
+    bool m_hasHighlight = false;
+    Rect m_highlight;        // 버퍼 좌표
+    DirtyRegion m_dirty;     // 버퍼 좌표
+};
+
+struct OverlayRenderStats {
+    std::uint64_t fullRenders = 0;
+    std::uint64_t partialRenders = 0;
+    std::uint64_t pixelsRendered = 0;
+};
+
+// 모니터별 오버레이 버퍼 묶음 (헤드리스 - 화면 출력은 플랫폼 쪽에서)
+class OverlaySurfaceSet {
+public:
+    // 토폴로지/스타일과 비교해 바뀐 모니터만 전체 다시 그리기로 표시
+    void sync(const MonitorTopology& topology, const OverlayStyle& style);
+
+    // 화면 좌표 사각형을 강조 (해당 모니터의 이전 강조 영역과 새 영역만 더럽힘)
+    void setHighlight(int monitorIndex, const Rect& screenRect);
+    void clearHighlight(int monitorIndex);
+    void clearHighlights();
+
+    // 더러운 부분만 다시 그린다. 다시 그린 영역(버퍼 좌표)을 돌려준다
+    // (비어 있으면 화면 갱신도 필요 없음)
+    bool render(int monitorIndex, Rect& updated);
+
+    bool needsRender(int monitorIndex) const;
+    int size() const { return static_cast<int>(m_surfaces.size()); }
+    const OverlaySurface& surface(int monitorIndex) const { return m_surfaces[monitorIndex]; }
+    const OverlayRenderStats& stats() const { return m_stats; }
+
+private:
+    void markDirty(OverlaySurface& surface, const Rect& rect);
+
+    std::vector<OverlaySurface> m_surfaces;
+    OverlayRenderStats m_stats;
+};
@@ -0,0 +1,113 @@
+#pragma once
+#include "core_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 단축키 스냅 위치 계산 (플랫폼 독립)
+// 작업 영역은 호출한 쪽이 MonitorTopology 캐시에서 넘긴다.
+
+// 창 위치 열거형
+enum class WindowPosition {
+    TopLeft,
+    TopCenter,
+    TopRight,
+    CenterLeft,
+    Center,
+    CenterRight,
+    BottomLeft,
+    BottomCenter,
+    BottomRight
+};
+
+// 슬롯 경계는 작업 영역 폭/높이의 유리수 배. 1/2, 1/3, 1/4 의 공통 분모(12) 단위로 바꿔 두고
+// 경계 좌표는 origin + extent * n / 12 (내림) 하나로만 계산하므로,
+// 같은 분수를 공유하는 이웃 슬롯은 나머지 픽셀과 관계없이 틈/겹침 없이 맞닿는다.
+constexpr int kSlotUnits = 12;
+
+struct SlotFraction {
+    std::uint8_t num;
+    std::uint8_t den;
+};
+
+struct SlotSpec {
+    SlotFraction left, top, right, bottom;
+};
+
+// kSlotUnits 단위로 바꾼 슬롯 (슬롯 표에서 컴파일 시간에 만든다)
+struct SlotUnits {
+    std::uint8_t left, top, right, bottom;
+};
+
+constexpr int kRatioSteps = 4;
+// 슬롯 번호: 9방향 위치, 왼쪽/오른쪽 비율 순환 단계, 위/아래 절반
+constexpr int kSideSlotBase = 9;
+constexpr int kHalfSlotBase = kSideSlotBase + 2 * kRatioSteps;
+constexpr int kSnapSlotCount = kHalfSlotBase + 2;
+
+constexpr int positionSlot(WindowPosition position) { return static_cast<int>(position); }
+constexpr int sideSlot(bool left, int step) { return kSideSlotBase + (left ? 0 : kRatioSteps) + step % kRatioSteps; }
+constexpr int halfSlot(bool top) { return kHalfSlotBase + (top ? 0 : 1); }
+
+const SlotSpec& snapSlotSpec(int slot);
+const SlotUnits& snapSlotUnits(int slot);
+
+// 경계 하나: origin + extent * units / kSlotUnits
+constexpr int slotEdge(int origin, int extent, int units) {
+    return origin + static_cast<int>(static_cast<unsigned>(extent) * static_cast<unsigned>(units) / kSlotUnits);
+}
+
+Rect slotRect(const Rect& workArea, int slot);
+
+// 작업 영역을 반으로 나눈 크기의 창을 9방향 중 하나에 배치
+Rect calculateSnapRect(const Rect& workArea, WindowPosition position);
+
+// 같은 방향 키를 연속으로 누르면 너비 비율을 1/2 -> 1/3 -> 1/4 -> 3/4 로 순환
+// 키마다 마지막 입력 시각을 기억하고, 제한 시간이 지나면 처음 비율로 돌아간다.
+class RatioCycler {
+public:
+    static constexpr int kSteps = kRatioSteps;
+    static constexpr int kMaxKeys = 8;
+
+    explicit RatioCycler(std::int64_t timeoutMs = 500) : m_timeoutMs(timeoutMs) {}
+
+    // 이번 입력의 단계 (0 부터)
+    int advance(int key, std::int64_t nowMs);
+    void reset() { m_keyCount = 0; }
+
+    // 표시용 (위치 계산은 슬롯 표의 정수 분수로 한다)
+    static float ratio(int step);
+
+private:
+    struct KeyState {
+        int key = 0;
+        int step = -1;
+        std::int64_t lastMs = 0;
+    };
+
+    std::int64_t m_timeoutMs;
+    KeyState m_keys[kMaxKeys];
+    int m_keyCount = 0;
+};
+
+// 왼쪽/오른쪽에 붙인 step 단계 너비의 창
+Rect sideSnapRect(const Rect& workArea, bool left, int step);
+// 위/아래 절반
+Rect halfSnapRect(const Rect& workArea, bool top);
+
+// 여러 창의 목표를 한 번에 계산하는 배열 구조체 (windowRuleTargets 가 새 창 묶음에 쓴다)
+// set 에서 슬롯 표를 풀어 단위 열에 넣어 두므로, computeSlotRects 는 간접 참조/분기 없는
+// 열 단위 산술뿐이고 컴파일러가 벡터화한다.
+struct SlotBatch {
+    std::vector<std::int32_t> areaLeft, areaTop;       // 작업 영역 원점
+    std::vector<std::uint32_t> areaWidth, areaHeight;  // 작업 영역 크기
+    std::vector<std::uint32_t> unitLeft, unitTop, unitRight, unitBottom;  // kSlotUnits 단위 경계
+    std::vector<std::int32_t> left, top, right, bottom;  // 결과
+
+    void resize(size_t count);
+    size_t size() const { return left.size(); }
+    void set(size_t index, const Rect& workArea, int slot);
+    Rect rect(size_t index) const { return {left[index], top[index], right[index], bottom[index]}; }
+};
+
+void computeSlotRects(SlotBatch& batch);
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// 단일 생산자/단일 소비자 락프리 링 버퍼
+// - 생산자는 tryPush, 소비자는 tryPop 만 호출한다 (각각 한 스레드)
+// - 상대 인덱스를 캐시해 두고 가득 참/빔처럼 보일 때만 다시 읽어 캐시 라인 왕복을 줄인다
+// - 가득 차면 기다리지 않고 false (훅 콜백은 절대 막히면 안 된다)
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    bool tryPush(const T& value) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead == Capacity) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == Capacity) return false;
+        }
+        m_items[tail & kMask] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& out) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) return false;
+        }
+        out = m_items[head & kMask];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 다른 스레드에서 보면 근사값
+    bool empty() const {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+    size_t size() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t kMask = Capacity - 1;
+    static constexpr size_t kCacheLine = 64;
+
+    // 소비자 쪽
+    alignas(kCacheLine) std::atomic<size_t> m_head{0};
+    size_t m_cachedTail = 0;
+    // 생산자 쪽
+    alignas(kCacheLine) std::atomic<size_t> m_tail{0};
+    size_t m_cachedHead = 0;
+    alignas(kCacheLine) T m_items[Capacity];
+};
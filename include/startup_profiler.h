@@ -0,0 +1,68 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// 시작 과정 타임라인 (프로세스 생성 시점 기준)
+// 단축키가 먼저 살아나고 나머지(설정 파싱, 창 열거, 명령 서버)는 메시지 루프가 돈 뒤에 채워진다.
+// 단계마다 처음 도달한 시각만 남긴다. 원자 연산만 쓰므로 설정 작업 스레드에서도 기록할 수 있다.
+
+enum class StartupStage : std::uint8_t {
+    MainEntered,         // WinMain / initialize 진입
+    WindowCreated,       // 메시지 창 생성
+    HotkeysLive,         // 단축키 등록 끝 (첫 단축키를 받을 수 있음)
+    MonitorsReady,       // 모니터 토폴로지
+    TrayReady,           // 트레이 아이콘/메뉴
+    ConfigLoaded,        // settings.conf 파싱/검사 (작업 스레드)
+    WindowsScanned,      // 기존 창 열거 + 창 이벤트 훅
+    CommandServerReady,  // 스크립트용 명령 서버
+    Idle,                // 미룬 초기화가 모두 끝남
+    FirstHotkey,         // 처음 받은 단축키
+    Count,
+};
+
+const char* startupStageName(StartupStage stage);
+
+// 프로세스가 만들어진 뒤 지난 시간 (모르면 0)
+std::int64_t processUptimeUs();
+// 현재 상주 메모리 (Windows: 작업 집합, Linux: RSS, 모르면 0)
+std::uint64_t residentMemoryBytes();
+
+class StartupTimeline {
+public:
+    static std::int64_t nowUs();
+
+    // 기본 원점은 프로세스 생성 시점 (정적 초기화 시간까지 포함)
+    StartupTimeline() : StartupTimeline(nowUs() - processUptimeUs()) {}
+    explicit StartupTimeline(std::int64_t originUs);
+
+    StartupTimeline(const StartupTimeline&) = delete;
+    StartupTimeline& operator=(const StartupTimeline&) = delete;
+
+    // 처음 한 번만 남고 이후 호출은 무시 (단축키마다 불러도 비용은 읽기 한 번)
+    void mark(StartupStage stage) {
+        if (!reached(stage)) markAt(stage, nowUs());
+    }
+    void markAt(StartupStage stage, std::int64_t timeUs);
+    // Idle 과 함께 그때의 상주 메모리를 남긴다
+    void markIdle();
+
+    bool reached(StartupStage stage) const { return offsetUs(stage) >= 0; }
+    // 원점부터의 시간 (도달하지 않았으면 -1)
+    std::int64_t offsetUs(StartupStage stage) const;
+    std::int64_t timeToFirstHotkeyUs() const { return offsetUs(StartupStage::HotkeysLive); }
+    std::uint64_t idleResidentBytes() const { return m_idleResident.load(std::memory_order_relaxed); }
+
+    // 사람이 읽는 표 (단계별 ms, 첫 단축키까지 시간, 유휴 상주 메모리)
+    void format(std::string& out) const;
+    bool writeReport(const std::filesystem::path& path) const;
+
+private:
+    static constexpr std::int64_t kNotReached = -1;
+
+    std::int64_t m_originUs;
+    std::atomic<std::int64_t> m_stages[static_cast<size_t>(StartupStage::Count)];
+    std::atomic<std::uint64_t> m_idleResident{0};
+};
@@ -0,0 +1,112 @@
+#pragma once
+#include "layout_transaction.h"
+#include "monitor_topology.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// 모니터별 자동 타일링 방식
+enum class TilingMode : std::uint8_t {
+    Off,
+    Bsp,          // 가장 큰 타일을 반으로 나눠 새 창을 넣는 이진 분할
+    MasterStack,  // 왼쪽 마스터 + 오른쪽 스택
+    Columns,      // 같은 너비의 세로 열
+};
+
+struct TilingOptions {
+    TilingMode mode = TilingMode::Off;
+    int gap = 0;                // 창 사이 간격 (px)
+    float masterRatio = 0.55f;  // MasterStack 마스터 영역 비율
+    int masterCount = 1;
+};
+
+struct TilingStats {
+    std::uint64_t nodesVisited = 0;     // 다시 계산한 BSP 노드 / 타일 수
+    std::uint64_t windowsLaidOut = 0;   // 목표 위치를 다시 계산한 창 수
+    std::uint64_t movesEmitted = 0;     // 실제로 위치가 바뀌어 내보낸 이동 수
+};
+
+// 자동 타일링 엔진 (플랫폼 독립)
+// 창 추가/제거/크기 조절은 영향을 받는 부분만 더럽히고, flush 에서 그 부분만 다시 계산해
+// 목표 위치가 바뀐 창의 이동만 내보낸다. 작업 영역은 calculateWindowPosition 과 같은
+// MonitorTopology 캐시에서 가져오고, 이동은 LayoutTransaction 으로 한 번에 커밋한다.
+class TilingEngine {
+public:
+    // 모니터 작업 영역 동기화 (바뀐 모니터만 전체 다시 계산)
+    void syncTopology(const MonitorTopology& topology);
+
+    void setOptions(int monitor, const TilingOptions& options);
+    const TilingOptions& options(int monitor) const { return m_monitors[monitor].options; }
+    int monitorCount() const { return static_cast<int>(m_monitors.size()); }
+
+    // BSP 에서는 splitTarget 타일을 나누고, 없으면 가장 큰 타일을 나눈다
+    bool addWindow(WindowId window, int monitor, WindowId splitTarget = 0);
+    bool removeWindow(WindowId window);
+    // 사용자가 창 크기를 바꾼 뒤 호출 - 맞닿은 분할 비율을 조정하고 나머지는 다시 맞춘다
+    bool resizeWindow(WindowId window, const Rect& actual);
+
+    bool contains(WindowId window) const { return m_index.count(window) != 0; }
+    int monitorOf(WindowId window) const;
+    bool targetOf(WindowId window, Rect& out) const;
+    size_t windowCount() const { return m_windows.size(); }
+
+    // 더러운 부분을 다시 계산하고 위치가 바뀐 창만 out 에 추가
+    size_t flush(std::vector<WindowMove>& out);
+    size_t flush(LayoutTransaction& transaction);
+
+    const TilingStats& stats() const { return m_stats; }
+    void resetStats() { m_stats = TilingStats(); }
+
+private:
+    struct Node {
+        int parent = -1;
+        int child[2] = {-1, -1};
+        int window = -1;        // 잎이면 m_windows 인덱스, 내부 노드 -1, 해제된 노드 -2
+        Rect rect;
+        float ratio = 0.5f;
+        bool vertical = true;   // true 면 좌우로 나눔
+    };
+
+    struct TiledWindow {
+        WindowId window = 0;
+        int monitor = 0;
+        int leaf = -1;          // BSP 잎 노드
+        Rect target;            // 마지막으로 계산한 목표
+        Rect placed;            // 마지막으로 내보낸 (또는 실제) 위치
+        bool changed = false;
+    };
+
+    struct MonitorState {
+        Rect workArea;
+        TilingOptions options;
+        std::vector<WindowId> order;  // 들어온 순서 (MasterStack/Columns, 모드 전환 시 재구성)
+        int root = -1;
+        std::vector<int> dirtyNodes;
+        bool dirtyAll = false;
+    };
+
+    int allocNode();
+    void freeNode(int node);
+    void insertLeaf(MonitorState& monitor, int windowIndex, int splitLeaf);
+    void removeLeaf(MonitorState& monitor, int leaf);
+    void rebuild(int monitorIndex);
+    int largestLeaf(const MonitorState& monitor) const;
+    void layoutSubtree(MonitorState& monitor, int node);
+    void layoutLinear(int monitorIndex);
+    void settle(int monitorIndex);  // 더러운 부분의 영역/목표를 다시 계산
+    void setTarget(int windowIndex, const Rect& tile, int gap);
+    void markDirty(MonitorState& monitor, int node);
+    Rect rootRect(const MonitorState& monitor) const;
+    void eraseWindow(int windowIndex);
+
+    std::vector<MonitorState> m_monitors;
+    std::vector<Node> m_nodes;
+    std::vector<int> m_freeNodes;
+    std::vector<TiledWindow> m_windows;
+    std::unordered_map<WindowId, int> m_index;
+    std::vector<WindowId> m_changed;  // 목표를 다시 계산했거나 실제 위치가 바뀐 창
+    std::vector<int> m_stack;  // 반복 순회용
+    std::vector<WindowMove> m_moves;
+    TilingStats m_stats;
+};
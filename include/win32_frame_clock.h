@@ -0,0 +1,16 @@
+#pragma once
+#include "window_animator.h"
+
+// DwmFlush 기반 프레임 시계 - 합성기가 다음 프레임을 내보낼 때 깨어난다
+// 합성이 꺼져 있거나 실패하면 새로 고침 간격만큼 잠든다.
+class Win32DwmFrameClock : public FrameClock {
+public:
+    Win32DwmFrameClock();
+
+    std::int64_t waitForFrame() override;
+    std::int64_t frameIntervalNs() const override { return m_intervalNs; }
+
+private:
+    std::int64_t m_intervalNs = 16'666'667;
+    SteadyFrameClock m_fallback;
+};
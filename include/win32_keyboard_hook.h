@@ -0,0 +1,28 @@
+#pragma once
+#include "key_input.h"
+#include <windows.h>
+
+// WH_KEYBOARD_LL 훅을 KeyInputPipeline 에 연결한다
+// 콜백은 비트맵 조회와 링 push 만 하고 바로 반환 (LowLevelHooksTimeout 에 걸리지 않도록).
+// 훅은 설치한 스레드의 메시지 루프에서 호출된다.
+class Win32KeyboardHook {
+public:
+    static Win32KeyboardHook& getInstance();
+
+    bool install(KeyInputPipeline& pipeline);
+    void uninstall();
+    bool installed() const { return m_hook != NULL; }
+
+private:
+    Win32KeyboardHook() = default;
+    ~Win32KeyboardHook();
+
+    Win32KeyboardHook(const Win32KeyboardHook&) = delete;
+    Win32KeyboardHook& operator=(const Win32KeyboardHook&) = delete;
+
+    static LRESULT CALLBACK hookProc(int code, WPARAM wParam, LPARAM lParam);
+    static void maskMenu();
+
+    HHOOK m_hook = NULL;
+    KeyInputPipeline* m_pipeline = nullptr;
+};
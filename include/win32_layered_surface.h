@@ -0,0 +1,25 @@
+#pragma once
+#include "grid_rasterizer.h"
+
+// ArgbBuffer 를 화면에 올리는 DIB 섹션 (크기가 바뀔 때만 다시 만든다)
+class Win32LayeredSurface {
+public:
+    ~Win32LayeredSurface();
+
+    // 레이어드 창 전체를 버퍼 내용으로 한 번에 교체 (UpdateLayeredWindow)
+    bool upload(HWND hwnd, const ArgbBuffer& buffer, Point screenPos);
+    // dirty 영역만 복사하고 합성기에 그 영역만 알린다 (UpdateLayeredWindowIndirect)
+    bool uploadDirty(HWND hwnd, const ArgbBuffer& buffer, Point screenPos, const Rect& dirty);
+    // 일반 DC 위에 알파 합성 (AlphaBlend)
+    bool blendTo(HDC hdc, const ArgbBuffer& buffer, Point pos);
+
+private:
+    bool ensureBitmap(const ArgbBuffer& buffer);
+
+    HDC m_memDC = NULL;
+    HBITMAP m_bitmap = NULL;
+    HGDIOBJ m_oldBitmap = NULL;
+    void* m_bits = nullptr;
+    int m_width = 0;
+    int m_height = 0;
+};
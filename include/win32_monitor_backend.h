@@ -0,0 +1,8 @@
+#pragma once
+#include "monitor_topology.h"
+
+// EnumDisplayMonitors/GetMonitorInfo/GetDpiForMonitor 기반 실제 백엔드
+class Win32MonitorBackend : public MonitorBackend {
+public:
+    void enumerate(std::vector<MonitorInfo>& out) override;
+};
@@ -0,0 +1,30 @@
+#pragma once
+#include "overlay_surfaces.h"
+#include "win32_layered_surface.h"
+#include <memory>
+#include <vector>
+
+// 모니터마다 하나씩 두는 클릭 통과 레이어드 오버레이 창
+// 그리드 표시/숨김은 창 표시 상태만 바꾸고 (다시 그리기 없음),
+// 내용 변경은 OverlaySurfaceSet 이 알려준 영역만 올린다.
+class Win32OverlayWindows {
+public:
+    ~Win32OverlayWindows();
+
+    // 모니터 수에 맞게 창을 만들거나 없애고, 바뀐 부분을 화면에 올린다
+    void present(OverlaySurfaceSet& surfaces);
+    void setVisible(bool visible);
+    void destroy();
+
+private:
+    struct OverlayWindow {
+        HWND hwnd = NULL;
+        Rect bounds;
+        Win32LayeredSurface surface;
+    };
+
+    HWND createWindow();
+
+    std::vector<std::unique_ptr<OverlayWindow>> m_windows;
+    bool m_visible = false;
+};
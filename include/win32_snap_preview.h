@@ -0,0 +1,18 @@
+#pragma once
+#include "core_types.h"
+
+// 드래그 중 스냅 목표를 보여주는 반투명 사각형 창
+// 클릭이 통과하고 포커스를 가져가지 않는다.
+class Win32SnapPreview {
+public:
+    ~Win32SnapPreview();
+
+    void show(const Rect& rect);
+    void hide();
+
+private:
+    bool create();
+
+    HWND m_hwnd = NULL;
+    bool m_visible = false;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include "window_event_queue.h"
+#include "window_registry.h"
+#include "window_frame_cache.h"
+
+// SetWinEventHook 으로 창 이벤트를 받아 WindowEventQueue 에 넣는다
+// 콜백은 큐에 넣기만 하고, 실제 처리는 큐가 비어있다가 채워질 때 알려주는 onPending 에서 예약한다.
+class Win32WindowEvents {
+public:
+    static Win32WindowEvents& getInstance();
+
+    bool install(WindowEventQueue& queue, void (*onPending)());
+    void uninstall();
+
+private:
+    Win32WindowEvents() = default;
+    ~Win32WindowEvents();
+
+    Win32WindowEvents(const Win32WindowEvents&) = delete;
+    Win32WindowEvents& operator=(const Win32WindowEvents&) = delete;
+
+    static void CALLBACK eventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                   LONG idObject, LONG idChild, DWORD thread, DWORD time);
+
+    std::vector<HWINEVENTHOOK> m_hooks;
+    WindowEventQueue* m_queue = nullptr;
+    void (*m_onPending)() = nullptr;
+};
+
+// GetWindowRect/IsWindowVisible 기반 조회 - 스타일/가림/프레임 간격은 WindowFrameCache 에서
+// 사각형은 보이는 프레임 기준 (타일링 목표와 같은 기준)
+class Win32WindowInfoSource : public WindowInfoSource {
+public:
+    explicit Win32WindowInfoSource(WindowFrameCache& frames) : m_frames(frames) {}
+
+    bool query(WindowId window, WindowSnapshot& out) override;
+
+private:
+    WindowFrameCache& m_frames;
+};
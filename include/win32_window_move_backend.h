@@ -0,0 +1,20 @@
+#pragma once
+#include "layout_transaction.h"
+#include "window_frame_cache.h"
+
+// BeginDeferWindowPos/DeferWindowPos/EndDeferWindowPos 기반 실제 백엔드 (바깥 사각형 기준)
+// 보이는 프레임 기준으로 옮기려면 FramedWindowMoveBackend 로 감싼다.
+class Win32WindowMoveBackend : public WindowMoveBackend {
+public:
+    bool getWindowRect(WindowId window, Rect& out) override;
+    bool applyBatch(const WindowMove* moves, size_t count) override;
+    bool applyOne(const WindowMove& move) override;
+};
+
+// GetWindowLong / DwmGetWindowAttribute(DWMWA_CLOAKED, DWMWA_EXTENDED_FRAME_BOUNDS) / GetDpiForWindow 기반 조회
+class Win32WindowFrameSource : public WindowFrameSource {
+public:
+    // 핸들 재사용 판별용 생성 스탬프 (창이 없으면 0). 창별 상태 표들도 모두 이 값을 쓴다
+    std::uint32_t stamp(WindowId window) override;
+    bool query(WindowId window, WindowFrameInfo& out) override;
+};
@@ -0,0 +1,129 @@
+#pragma once
+#include "latency_trace.h"
+#include "layout_transaction.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 디스플레이 프레임 시계 - 스케줄러 스레드를 프레임마다 한 번 깨운다
+class FrameClock {
+public:
+    virtual ~FrameClock() = default;
+    // 다음 프레임까지 기다리고 그 시각 (steady_clock ns)
+    virtual std::int64_t waitForFrame() = 0;
+    virtual std::int64_t frameIntervalNs() const = 0;
+};
+
+// 일정 간격 시계 (기본 60Hz). 늦게 깨어나면 밀린 프레임은 건너뛴다
+class SteadyFrameClock : public FrameClock {
+public:
+    explicit SteadyFrameClock(std::int64_t intervalNs = 16'666'667) : m_intervalNs(intervalNs) {}
+
+    std::int64_t waitForFrame() override;
+    std::int64_t frameIntervalNs() const override { return m_intervalNs; }
+
+private:
+    std::int64_t m_intervalNs;
+    std::int64_t m_nextNs = 0;
+};
+
+struct AnimationOptions {
+    double budgetFraction = 0.5;  // 프레임 간격 중 창 이동 호출에 쓸 수 있는 비율
+    int maxLagFrames = 4;         // 이전 단계를 아직 반영하지 못한 창을 기다려 주는 프레임 수
+};
+
+struct AnimationStats {
+    size_t active = 0;
+    std::uint64_t started = 0;
+    std::uint64_t retargeted = 0;     // 진행 중에 새 목표를 받아 현재 위치에서 다시 시작
+    std::uint64_t completed = 0;
+    std::uint64_t finishedEarly = 0;  // 예산 초과/느린 창이라 목표로 바로 보냄
+    std::uint64_t frames = 0;
+    std::uint64_t steps = 0;          // 창 이동 호출 수
+    std::uint64_t droppedSteps = 0;   // 창이 이전 단계를 아직 그리지 못해 건너뛴 프레임
+    std::uint64_t overBudgetFrames = 0;
+};
+
+// 0~1 -> 0~1 (끝에서 감속)
+double easeOutCubic(double t);
+Rect interpolateRect(const Rect& from, const Rect& to, double t);
+
+// 진행 중인 창 애니메이션 모음 (스레드 없음 - WindowAnimator 가 프레임마다 step)
+// - 창마다 애니메이션 하나: 새 목표는 대기열에 쌓지 않고 지금 보이는 위치에서 다시 시작한다
+// - 지난 프레임에 보낸 위치에 아직 없는 창(다시 그리기가 느린 창)은 그 프레임을 건너뛴다
+// - 한 프레임의 이동 호출이 예산을 넘기면 다음 프레임에 모두 목표로 보내 끝낸다
+class AnimationSet {
+public:
+    explicit AnimationSet(const AnimationOptions& options = {}) : m_options(options) {}
+
+    // from == to 이거나 이미 같은 목표로 움직이는 중이면 아무것도 하지 않는다
+    void animate(WindowId window, const Rect& from, const Rect& to, std::int64_t durationNs, std::int64_t nowNs);
+    bool cancel(WindowId window);
+
+    // 이번 프레임의 위치로 옮긴다. 끝난 애니메이션은 빠진다
+    void step(std::int64_t nowNs, std::int64_t frameIntervalNs, WindowMoveBackend& backend);
+
+    bool empty() const { return m_animations.empty(); }
+    size_t size() const { return m_animations.size(); }
+    const AnimationStats& stats() const { return m_stats; }
+    // 프레임마다 이동 호출에 쓴 시간
+    const LatencyHistogram& stepTimes() const { return m_stepTimes; }
+
+private:
+    struct Animation {
+        WindowId window = 0;
+        Rect from;
+        Rect to;
+        Rect last;                 // 마지막으로 보낸 위치
+        std::int64_t startNs = 0;
+        std::int64_t durationNs = 0;
+        int lagFrames = 0;
+        bool applied = false;
+    };
+
+    Animation* find(WindowId window);
+
+    AnimationOptions m_options;
+    std::vector<Animation> m_animations;  // 동시에 움직이는 창은 몇 개뿐이라 선형 탐색
+    AnimationStats m_stats;
+    LatencyHistogram m_stepTimes;
+    bool m_finishNext = false;
+};
+
+// 애니메이션 스케줄러
+// 스레드 하나가 프레임마다 진행 중인 모든 창을 한 번씩 옮기고, 애니메이션이 없으면 잠들어 CPU 를 쓰지 않는다.
+// 이동은 MoveAsync 로 보내므로 느리거나 응답 없는 앱이 스케줄러를 붙잡지 않는다.
+class WindowAnimator {
+public:
+    WindowAnimator(WindowMoveBackend& backend, FrameClock& clock, const AnimationOptions& options = {});
+    ~WindowAnimator();
+
+    WindowAnimator(const WindowAnimator&) = delete;
+    WindowAnimator& operator=(const WindowAnimator&) = delete;
+
+    // 현재 위치에서 target 까지. 진행 중이면 새 목표로 바꾼다. 창이 없으면 false
+    bool animate(WindowId window, const Rect& target, std::int64_t durationNs);
+    // 다른 경로(즉시 이동)로 옮기기 전에 호출
+    void cancel(WindowId window);
+
+    bool waitIdle(std::int64_t timeoutNs);
+    AnimationStats stats() const;
+    // 프레임 간격 (페이싱 흔들림 확인용)과 프레임마다 이동 호출에 쓴 시간
+    const LatencyHistogram& frameTimes() const { return m_frameTimes; }
+    const LatencyHistogram& stepTimes() const { return m_set.stepTimes(); }
+
+private:
+    void run();
+
+    WindowMoveBackend& m_backend;
+    FrameClock& m_clock;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    AnimationSet m_set;
+    LatencyHistogram m_frameTimes;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
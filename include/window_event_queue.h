@@ -0,0 +1,69 @@
+#pragma once
+#include "core_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// 레지스트리가 소비하는 창 이벤트 종류
+enum class WindowEventType : std::uint8_t {
+    Created,
+    Destroyed,
+    Shown,
+    Hidden,
+    LocationChanged,
+    MoveSizeEnd,
+    Foreground,
+    Cloaked,
+    Uncloaked,
+    FrameChanged,  // 최소화/복원 - 스타일과 프레임 간격이 바뀔 수 있음
+};
+
+// 창 하나에 대해 병합된 변경 플래그
+enum WindowChangeFlags : std::uint32_t {
+    ChangeCreated = 1u << 0,
+    ChangeDestroyed = 1u << 1,
+    ChangeVisibility = 1u << 2,
+    ChangeLocation = 1u << 3,
+    ChangeCloak = 1u << 4,
+    ChangeMoveSizeEnd = 1u << 5,  // 사용자가 끌기/크기 조절을 끝냄 (ChangeLocation 과 함께)
+    ChangeFrame = 1u << 6,        // 캐시된 스타일/프레임 정보를 다시 읽어야 함
+};
+
+struct WindowUpdate {
+    WindowId window = 0;
+    std::uint32_t flags = 0;
+    bool visible = false;  // ChangeVisibility 일 때 마지막 상태
+    bool cloaked = false;  // ChangeCloak 일 때 마지막 상태
+};
+
+// 창 이벤트 병합 큐
+// 같은 창의 이벤트는 하나의 WindowUpdate 로 합쳐진다 (위치 변경 500번 -> 1번).
+// WinEvent 훅(WINEVENT_OUTOFCONTEXT)은 설치한 스레드에서 호출되므로
+// push 와 drain 은 같은 스레드에서 부른다.
+class WindowEventQueue {
+public:
+    WindowEventQueue();
+
+    void push(WindowId window, WindowEventType type);
+
+    // 병합된 결과를 처음 도착한 순서대로 꺼낸다
+    void drain(std::vector<WindowUpdate>& out);
+
+    bool empty() const { return m_pending.empty() && !m_foregroundChanged; }
+    size_t pendingWindows() const { return m_pending.size(); }
+
+    // 마지막 drain 이후 포그라운드가 바뀌었으면 true 와 그 창
+    bool takeForeground(WindowId& window);
+
+    std::uint64_t pushedEvents() const { return m_pushed; }
+    std::uint64_t deliveredUpdates() const { return m_delivered; }
+
+private:
+    std::vector<WindowUpdate> m_pending;
+    std::unordered_map<WindowId, std::uint32_t> m_index;  // 창 -> m_pending 위치
+    WindowId m_foreground = 0;
+    bool m_foregroundChanged = false;
+    std::uint64_t m_pushed = 0;
+    std::uint64_t m_delivered = 0;
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include "layout_transaction.h"
+#include "window_state_table.h"
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// 창 사각형(GetWindowRect)과 실제로 보이는 프레임 사이의 간격
+// Win10 이상에서는 좌/우/아래에 보이지 않는 크기 조절 테두리가 있어 바깥 사각형으로 배치하면 틈이 생긴다.
+struct FrameInsets {
+    int left = 0;
+    int top = 0;
+    int right = 0;
+    int bottom = 0;
+};
+
+// 보이는 사각형 -> SetWindowPos 에 줄 바깥 사각형
+inline Rect outerFromVisible(const Rect& visible, const FrameInsets& insets) {
+    return {visible.left - insets.left, visible.top - insets.top, visible.right + insets.right,
+            visible.bottom + insets.bottom};
+}
+
+// GetWindowRect 의 바깥 사각형 -> 보이는 사각형
+inline Rect visibleFromOuter(const Rect& outer, const FrameInsets& insets) {
+    return {outer.left + insets.left, outer.top + insets.top, outer.right - insets.right,
+            outer.bottom - insets.bottom};
+}
+
+// 창마다 한 번 조회해 두는 속성 (스타일/DPI 가 바뀔 때만 다시 조회)
+struct WindowFrameInfo {
+    FrameInsets insets;
+    std::uint32_t dpi = 96;
+    bool manageable = false;  // 스타일 기준 (자식 창/도구 창이 아님)
+    bool cloaked = false;
+};
+
+// 창 속성 조회 백엔드 - 실제 시스템 호출은 여기서만
+class WindowFrameSource {
+public:
+    virtual ~WindowFrameSource() = default;
+    // 핸들 재사용 판별용 생성 스탬프. 창이 없으면 0
+    virtual std::uint32_t stamp(WindowId window) = 0;
+    virtual bool query(WindowId window, WindowFrameInfo& out) = 0;
+};
+
+// 테스트/벤치마크용 가상 창 속성
+class SimulatedWindowFrameSource : public WindowFrameSource {
+public:
+    void set(WindowId window, std::uint32_t stamp, const WindowFrameInfo& info) { m_windows[window] = {stamp, info}; }
+    void remove(WindowId window) { m_windows.erase(window); }
+
+    std::uint32_t stamp(WindowId window) override {
+        auto it = m_windows.find(window);
+        return it != m_windows.end() ? it->second.first : 0;
+    }
+    bool query(WindowId window, WindowFrameInfo& out) override {
+        ++queries;
+        auto it = m_windows.find(window);
+        if (it == m_windows.end()) return false;
+        out = it->second.second;
+        return true;
+    }
+
+    size_t queries = 0;
+
+private:
+    std::unordered_map<WindowId, std::pair<std::uint32_t, WindowFrameInfo>> m_windows;
+};
+
+struct WindowFrameCacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;         // 백엔드 조회 수
+    std::uint64_t invalidations = 0;  // 스타일/DPI 변경 등으로 버린 항목
+};
+
+// 창별 관리 가능 여부 / 가림 / DWM 프레임 간격 캐시
+// 단축키 경로는 캐시 조회 한 번으로 끝나고, 이벤트(생성/표시/최소화 복원/DPI 변경)에서만 버린다.
+// 이동 작업 스레드와 메시지 루프 스레드가 같이 쓰므로 짧은 잠금으로 보호하고, 조회는 잠금 밖에서 한다.
+class WindowFrameCache {
+public:
+    explicit WindowFrameCache(WindowFrameSource& source, size_t maxEntries = 1024)
+        : m_source(source), m_table(maxEntries) {}
+
+    // 캐시에 없으면 한 번 조회해 채운다. 창이 없으면 false
+    bool get(WindowId window, WindowFrameInfo& out);
+
+    void invalidate(WindowId window);
+    // 디스플레이 DPI/배율 변경 - 모든 창의 테두리 두께가 바뀔 수 있다
+    void invalidateAll();
+    // 가림 이벤트는 새 값을 함께 알려주므로 조회 없이 고친다
+    void setCloaked(WindowId window, bool cloaked);
+    void erase(WindowId window);
+
+    size_t size() const;
+    WindowFrameCacheStats stats() const;
+
+private:
+    WindowFrameSource& m_source;
+    mutable std::mutex m_mutex;
+    WindowStateTable<WindowFrameInfo> m_table;
+    WindowFrameCacheStats m_stats;
+    std::uint64_t m_epoch = 0;  // 무효화마다 증가
+};
+
+// 보이는 프레임 기준으로 옮기는 백엔드
+// 목표와 현재 위치는 보이는 사각형이고, 감싼 백엔드에는 캐시된 간격을 더한 바깥 사각형을 넘긴다.
+// 간격을 미리 알고 있으므로 SetWindowPos 한 번으로 픽셀 단위까지 맞는다 (옮긴 뒤 다시 재고 고치지 않음).
+class FramedWindowMoveBackend : public WindowMoveBackend {
+public:
+    FramedWindowMoveBackend(WindowMoveBackend& outer, WindowFrameCache& frames) : m_outer(outer), m_frames(frames) {}
+
+    bool getWindowRect(WindowId window, Rect& out) override;
+    // 메시지 루프 스레드에서만 (변환한 목록을 재사용)
+    bool applyBatch(const WindowMove* moves, size_t count) override;
+    bool applyOne(const WindowMove& move) override;
+
+private:
+    WindowMove toOuter(const WindowMove& move);
+
+    WindowMoveBackend& m_outer;
+    WindowFrameCache& m_frames;
+    std::vector<WindowMove> m_outerMoves;
+};
@@ -1,87 +1,243 @@
-#pragma once
-#include <windows.h>
-#include <vector>
-#include <map>
-#include <string>
-#include <memory>
-
-// 창 위치 열거형
-enum class WindowPosition {
-    TopLeft,
-    TopCenter,
-    TopRight,
-    CenterLeft,
-    Center,
-    CenterRight,
-    BottomLeft,
-    BottomCenter,
-    BottomRight
-};
-
-// 그리드 설정
-struct GridSettings {
-    int rows = 12;
-    int cols = 12;
-    bool visible = false;
-    float opacity = 0.5f;
-};
-
-// 창 레이아웃 정보
-struct WindowLayout {
-    RECT position;
-    bool isMaximized;
-    int monitorIndex;
-};
-
-class WindowManager {
-public:
-    static WindowManager& getInstance();
-    
-    // 초기화 및 정리
-    bool initialize();
-    void cleanup();
-
-    // 창 관리 기능
-    void handleWindowDrag(HWND hwnd, POINT pt);
-    void snapWindowToGrid(HWND hwnd, POINT pt);
-    void snapWindowToPosition(HWND hwnd, WindowPosition position);
-    
-    // 그리드 시스템
-    void toggleGrid();
-    void setGridSize(int rows, int cols);
-    void drawGrid(HDC hdc);
-    void setGridOpacity(float opacity);
-    
-    // 레이아웃 관리
-    void saveLayout(const std::string& name);
-    void loadLayout(const std::string& name);
-    void saveWindowState(HWND hwnd);
-    void restoreWindowState(HWND hwnd);
-    
-    // 단축키 처리
-    void handleHotkey(int id);
-    
-    // 다중 모니터 지원
-    void updateMonitorInfo();
-    int getCurrentMonitorIndex(HWND hwnd);
-
-private:
-    WindowManager();  // Singleton
-    ~WindowManager();
-    
-    WindowManager(const WindowManager&) = delete;
-    WindowManager& operator=(const WindowManager&) = delete;
-
-    // 내부 유틸리티 함수
-    RECT calculateWindowPosition(HWND hwnd, WindowPosition position);
-    bool isWindowManageable(HWND hwnd);
-    void saveConfig();
-    void loadConfig();
-
-    // 멤버 변수
-    GridSettings m_gridSettings;
-    std::map<HWND, WindowLayout> m_windowStates;
-    std::map<std::string, std::vector<WindowLayout>> m_savedLayouts;
-    std::vector<HMONITOR> m_monitors;
-    bool m_initialized;
-};
+#pragma once
+#include <windows.h>
+#include <vector>
+#include <map>
+#include <string>
+#include <memory>
+#include "monitor_topology.h"
+#include "snap_geometry.h"
+#include "layout_transaction.h"
+#include "async_move_executor.h"
+#include "latency_trace.h"
+#include "input_trace.h"
+#include "config_store.h"
+#include "tiling_engine.h"
+#include "window_state_table.h"
+#include "layout_store.h"
+#include "window_registry.h"
+#include "window_frame_cache.h"
+#include "win32_window_move_backend.h"
+#include "workspace.h"
+#include "window_animator.h"
+#include "win32_frame_clock.h"
+#include "drag_snapper.h"
+#include "win32_snap_preview.h"
+#include "win32_layered_surface.h"
+#include "win32_overlay_windows.h"
+#include "command_server.h"
+#include "window_spatial_index.h"
+#include "startup_profiler.h"
+#include <filesystem>
+
+// WindowManager 의 메시지 전용 창으로 보내는 메시지 (호스트 루프는 DispatchMessage 만 하면 된다)
+// 설정 파일을 다시 읽은 뒤 작업 스레드가 보낸다 (wParam: 성공 여부) - applyConfig() 호출
+constexpr UINT WM_CONFIG_RELOADED = WM_APP + 0x40;
+// 명령 서버에 배치가 들어왔을 때 - processCommands() 호출
+constexpr UINT WM_COMMANDS_PENDING = WM_APP + 0x41;
+// 시작 시 미룬 초기화 한 단계 - runDeferredInit() 호출 (끝날 때까지 스스로 다시 보낸다)
+constexpr UINT WM_DEFERRED_INIT = WM_APP + 0x42;
+
+// 창 레이아웃 정보
+struct WindowLayout {
+    HWND hwnd;
+    RECT position;
+    bool isMaximized;
+    int monitorIndex;
+};
+
+class WindowManager : private CommandHandler {
+public:
+    static WindowManager& getInstance();
+    
+    // 초기화 및 정리
+    // 단축키와 모니터만 바로 준비하고, 설정 파싱은 작업 스레드에서, 창 열거/창 이벤트/명령 서버는
+    // 메시지 루프가 돈 뒤 WM_DEFERRED_INIT 로 한 단계씩 (오버레이는 처음 보일 때 만든다)
+    bool initialize();
+    void runDeferredInit();
+    void cleanup();
+    // 시작 타임라인 (첫 단축키까지 시간, 유휴 상주 메모리)
+    StartupTimeline& getStartupTimeline() { return m_startup; }
+
+    // 창 관리 기능
+    // 드래그 중에는 프레임마다 미리보기만 갱신하고, 놓을 때 한 번 이동
+    void handleWindowDrag(HWND hwnd, POINT pt);
+    void flushWindowDrag();
+    void endWindowDrag(HWND hwnd);
+    const DragStats& getDragStats() const { return m_dragSnapper.stats(); }
+    void snapWindowToGrid(HWND hwnd, POINT pt);
+    void snapWindowToPosition(HWND hwnd, WindowPosition position, std::uint32_t traceSpan = 0);
+    
+    // 그리드 시스템
+    void toggleGrid();
+    void setGridSize(int rows, int cols);
+    void drawGrid(HDC hdc);
+    void setGridOpacity(float opacity);
+
+    // 설정 (settings.conf 를 감시해 바뀌면 새 스냅샷으로 교체)
+    // 핫키/드래그 처리는 ConfigReader 로 잠금 없이 읽고, 오버레이/핫키 등록만 여기서 갱신
+    void applyConfig();
+    const ConfigStore& getConfig() const { return m_config; }
+    
+    // 이름 있는 작업 공간 (창 식별 값 + 위치를 저장, 전환은 숨기기/보이기/이동을 한 배치로)
+    void saveWorkspace(const std::string& name);
+    bool switchWorkspace(const std::string& name);
+    const std::string& getActiveWorkspace() const { return m_activeWorkspace; }
+    const WorkspaceSwitchStats& getWorkspaceStats() const { return m_workspaceStats; }
+
+    // 스크립트용 명령 서버 (스냅/이동/작업 공간 전환/질의, 배치마다 레이아웃 커밋 한 번)
+    void processCommands();
+    CommandServerStats getCommandStats() const { return m_commandServer.stats(); }
+    void saveWindowState(HWND hwnd);
+    void restoreWindowState(HWND hwnd);
+    // 창 파괴 시 저장된 상태 제거
+    void onWindowDestroyed(HWND hwnd);
+    // 마지막 레이아웃 커밋 결과 (이동/건너뜀 수)
+    const LayoutCommitStats& getLastCommitStats() const { return m_lastCommitStats; }
+    // 비동기 단일 창 이동 (대기 수, 시간 초과, 응답 없는 창)
+    AsyncMoveStats getMoveStats() const { return m_moveExecutor->stats(); }
+    // 스냅 애니메이션 (settings.conf 의 animation_ms > 0 일 때). 프레임 간격/이동 호출 시간 포함
+    AnimationStats getAnimationStats() const { return m_animator->stats(); }
+    const WindowAnimator& getAnimator() const { return *m_animator; }
+    // 단축키 -> 이동 구간별 지연 (트레이 메뉴에서 Chrome trace 로 저장)
+    LatencyTracer& getLatencyTracer() { return m_latencyTracer; }
+    // 단축키/드래그 이벤트 하나 동안의 임시 메모리 (이벤트 진입점에서 EventArena::Scope 로 감싼다)
+    EventArena& getEventArena() { return m_eventArena; }
+    bool dumpLatencyTrace();
+    // 입력 기록 (중지하면 input_trace.wmit 로 저장, wm_bench --replay 로 재생)
+    void startInputRecording();
+    bool stopInputRecording();
+    bool isInputRecording() const { return m_inputRecorder.active(); }
+    void recordHotkey(int id, HWND foreground);
+    
+    // 창 이벤트 (WinEvent 훅 -> 병합 큐 -> 레지스트리)
+    void processWindowEvents();
+    const WindowRegistry& getWindowRegistry() const { return m_registry; }
+
+    // 자동 타일링 (모니터별 선택, 기본은 꺼짐 - settings.conf 의 tiling 항목으로 켠다)
+    void setTilingOptions(int monitor, const TilingOptions& options);
+    TilingOptions getTilingOptions(int monitor) const;
+    const TilingStats& getTilingStats() const { return m_tiling.stats(); }
+
+    // 방향 단축키: 그쪽에서 가장 가까운 창으로 포커스 이동 / 위치 맞바꾸기 / 그쪽으로 밀기
+    void focusWindowInDirection(HWND hwnd, Direction direction);
+    void swapWindowInDirection(HWND hwnd, Direction direction);
+    void pushWindowInDirection(HWND hwnd, Direction direction);
+    const WindowSpatialIndex& getSpatialIndex() const { return m_spatialIndex; }
+
+    // 단축키 처리
+    void handleHotkey(int id);
+    
+    // 다중 모니터 지원
+    // WM_DISPLAYCHANGE / WM_DPICHANGED / SPI_SETWORKAREA 변경 시에만 호출
+    void updateMonitorInfo();
+    int getCurrentMonitorIndex(HWND hwnd);
+    const MonitorTopology& getMonitorTopology() const { return m_topology; }
+
+private:
+    WindowManager();  // Singleton
+    ~WindowManager();
+    
+    WindowManager(const WindowManager&) = delete;
+    WindowManager& operator=(const WindowManager&) = delete;
+
+    // 내부 유틸리티 함수
+    RECT calculateWindowPosition(HWND hwnd, WindowPosition position);
+    bool isWindowManageable(HWND hwnd);
+    // 창에 걸린 규칙 (창마다 한 번 조회해 두고 창이 사라지거나 설정이 바뀌면 지운다)
+    WindowRuleResult windowRules(HWND hwnd);
+    // 새 창을 규칙의 슬롯/모니터/최소 크기에 맞춘다 (타일링 창은 엔진이 배치)
+    // queue 로 이벤트 한 묶음의 새 창을 모았다가 apply 에서 위치를 한 번에 계산
+    void queueWindowRule(const WindowRecord& record);
+    void applyWindowRules();
+    bool captureWindowLayout(HWND hwnd, WindowLayout& layout);
+    // 실행 파일 + 클래스 키는 창마다 한 번 구하고, 제목은 바뀔 수 있으므로 매번 해시
+    WindowIdentity windowIdentity(HWND hwnd);
+    void seedWindowRegistry();
+    void commitLayout(const std::vector<WindowLayout>& layouts);
+    // 작업 공간 전환을 트랜잭션에 쌓는다 (커밋과 최대화는 부르는 쪽에서)
+    bool planWorkspace(const std::string& name);
+    void execute(CommandBatch& batch) override;
+    void queryWindow(const WindowRecord& record, CommandBatch& batch);
+    static void onCommandsPending(void* context);
+    // 이벤트로 바뀐 창을 타일링 엔진에 반영하고 바뀐 타일만 이동
+    void updateTiling(const std::vector<WindowUpdate>& updates);
+    void trackTiledWindow(const WindowRecord& record);
+    // 보이는 관리 대상 창만 공간 색인에 둔다
+    void trackSpatialWindow(const WindowRecord& record);
+    // hwnd 의 현재 사각형과 direction 쪽 이웃 (없으면 0)
+    WindowId neighborInDirection(HWND hwnd, Direction direction, Rect& from);
+    void commitTiling();
+    // m_appliedTiling 을 모니터마다 엔진에 반영
+    void applyTilingConfig();
+    // settings.conf 를 읽은 뒤면 현재 모니터 구성의 그리드 항목을 파일 내용으로 바꾸고,
+    // 현재 구성 키에 맞는 항목만 m_monitorGrids 로 모은다
+    void applyMonitorGrids();
+    void showDragPreview();
+    void saveConfig();
+    void loadConfig();
+    void loadLegacyConfig();
+    void setConfigDefaults(int rows, int cols, float opacity);
+    std::filesystem::path configPath() const;
+    std::filesystem::path settingsPath() const;
+    static void onConfigReloaded(bool ok, void* context);
+    // 바뀐 모니터만 다시 그려 오버레이 창에 올린다
+    void refreshGridOverlay();
+
+    // 멤버 변수
+    StartupTimeline m_startup;
+    int m_deferredStage = 0;
+    ConfigStore m_config;
+    ConfigReloader m_configReloader;
+    std::uint64_t m_appliedConfig = 0;
+    std::vector<KeyBinding> m_appliedBindings;
+    std::shared_ptr<const CompiledWindowRules> m_appliedRules;
+    std::vector<TilingConfig> m_appliedTiling;
+    HWND m_messageWindow = NULL;  // WM_CONFIG_RELOADED 등을 받는 HWND_MESSAGE 창
+    WindowStateTable<WindowLayout> m_windowStates;
+    std::map<std::string, std::vector<WorkspaceWindow>> m_workspaces;
+    std::string m_activeWorkspace;
+    WorkspaceSwitcher m_workspaceSwitcher;
+    std::vector<WorkspaceCandidate> m_workspaceCandidates;
+    WorkspaceSwitchStats m_workspaceStats;
+    WindowStateTable<std::uint64_t> m_appKeys;
+    std::vector<WindowRuleConfig> m_windowRules;
+    WindowStateTable<WindowRuleResult> m_ruleResults;
+    RuleMatchScratch m_ruleScratch;
+    std::vector<RulePlacement> m_rulePlacements;
+    SlotBatch m_ruleSlots;
+    std::vector<MonitorGridConfig> m_monitorConfigs;  // 모든 모니터 구성 (layout 파일에 저장)
+    std::vector<MonitorGridConfig> m_monitorGrids;    // 현재 구성의 항목
+    bool m_settingsLoaded = false;  // settings.conf 를 읽었는지 (그 전에는 저장된 항목만 쓴다)
+    MonitorTopology m_topology;
+    // 창별 스타일/가림/프레임 간격 (이동 백엔드와 창 정보 조회가 같이 쓴다)
+    Win32WindowFrameSource m_frameSource;
+    WindowFrameCache m_frames;
+    Win32WindowMoveBackend m_win32Moves;
+    std::unique_ptr<MonitorBackend> m_monitorBackend;
+    std::unique_ptr<WindowMoveBackend> m_moveBackend;
+    EventArena m_eventArena;
+    LayoutTransaction m_transaction;
+    LatencyTracer m_latencyTracer;
+    InputRecorder m_inputRecorder;
+    std::unique_ptr<AsyncMoveExecutor> m_moveExecutor;
+    Win32DwmFrameClock m_frameClock;
+    std::unique_ptr<WindowAnimator> m_animator;
+    CommandServer m_commandServer;
+    std::vector<HWND> m_commandMaximize;
+    LayoutCommitStats m_lastCommitStats;
+    std::unique_ptr<WindowInfoSource> m_windowInfo;
+    WindowEventQueue m_eventQueue;
+    WindowRegistry m_registry;
+    WindowSpatialIndex m_spatialIndex;
+    std::vector<WindowUpdate> m_windowUpdates;
+    TilingEngine m_tiling;
+    DragSnapper m_dragSnapper;
+    Win32SnapPreview m_snapPreview;
+    UINT_PTR m_dragTimer = 0;
+    GridLines m_overlayLines;
+    ArgbBuffer m_gridBuffer;
+    Win32LayeredSurface m_gridSurface;
+    OverlaySurfaceSet m_overlaySurfaces;
+    Win32OverlayWindows m_overlayWindows;
+    bool m_initialized;
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include "window_event_queue.h"
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// 창 하나의 현재 상태
+struct WindowSnapshot {
+    Rect rect;
+    bool visible = false;
+    bool cloaked = false;
+    bool manageable = false;
+};
+
+// 창 상태 조회 백엔드 - 병합된 업데이트마다 한 번만 호출된다
+class WindowInfoSource {
+public:
+    virtual ~WindowInfoSource() = default;
+    virtual bool query(WindowId window, WindowSnapshot& out) = 0;
+};
+
+// 테스트/벤치마크용 가상 창 목록
+class SimulatedWindowInfoSource : public WindowInfoSource {
+public:
+    void set(WindowId window, const WindowSnapshot& snapshot) { m_windows[window] = snapshot; }
+    void remove(WindowId window) { m_windows.erase(window); }
+
+    bool query(WindowId window, WindowSnapshot& out) override {
+        ++queries;
+        auto it = m_windows.find(window);
+        if (it == m_windows.end()) return false;
+        out = it->second;
+        return true;
+    }
+
+    size_t queries = 0;
+
+private:
+    std::unordered_map<WindowId, WindowSnapshot> m_windows;
+};
+
+struct WindowRecord {
+    WindowId window = 0;
+    WindowSnapshot state;
+};
+
+// 이벤트로 갱신되는 창 목록 (전체 재열거 없이 유지)
+class WindowRegistry {
+public:
+    // 창이 사라질 때 호출 (상태 캐시 정리 등)
+    using RemovedCallback = std::function<void(WindowId)>;
+
+    void setRemovedCallback(RemovedCallback callback) { m_onRemoved = std::move(callback); }
+
+    // 시작 시 한 번 기존 창 목록으로 채운다
+    void seed(WindowId window, WindowInfoSource& source);
+
+    void apply(const std::vector<WindowUpdate>& updates, WindowInfoSource& source);
+    void setForeground(WindowId window) { m_foreground = window; }
+
+    const WindowRecord* find(WindowId window) const;
+    const std::vector<WindowRecord>& windows() const { return m_records; }
+    size_t size() const { return m_records.size(); }
+    WindowId foreground() const { return m_foreground; }
+
+private:
+    void refresh(WindowId window, WindowInfoSource& source);
+    void remove(WindowId window);
+
+    // 연속 배열 + 인덱스 (삭제는 마지막 항목과 교체)
+    std::vector<WindowRecord> m_records;
+    std::unordered_map<WindowId, size_t> m_index;
+    WindowId m_foreground = 0;
+    RemovedCallback m_onRemoved;
+};
@@ -0,0 +1,153 @@
+#pragma once
+#include "layout_store.h"
+#include "monitor_topology.h"
+#include "snap_geometry.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 앱별 창 규칙
+// 클래스 이름 / 제목 / 실행 파일 이름은 대소문자 구분 없는 glob ('*' 만 지원), 빈 값은 아무거나.
+// 규칙은 적힌 순서로 합친다: 동작 비트는 모두 OR, 슬롯/모니터는 처음 정한 규칙, 최소 크기는 큰 값.
+
+enum WindowRuleAction : std::uint32_t {
+    RuleIgnore = 1u << 0,  // 관리하지 않음
+    RuleFloat = 1u << 1,   // 관리하되 타일링하지 않음
+};
+
+// 규칙과 비교할 창 정보 (실행 파일은 경로 없이 이름만)
+struct WindowDescriptor {
+    std::string_view className;
+    std::string_view title;
+    std::string_view executable;
+};
+
+struct WindowRuleResult {
+    int rule = -1;  // 처음 일치한 규칙, 없으면 -1
+    std::uint32_t action = 0;
+    std::int32_t slot = -1;  // WindowPosition
+    std::int32_t monitor = -1;
+    std::int32_t minWidth = 0;
+    std::int32_t minHeight = 0;
+
+    bool matched() const { return rule >= 0; }
+};
+
+bool globMatch(std::string_view pattern, std::string_view text);
+// 규칙을 하나씩 비교 (기준 구현)
+WindowRuleResult matchWindowRulesLinear(const std::vector<WindowRuleConfig>& rules, const WindowDescriptor& window);
+
+// 슬롯/모니터/최소 크기 규칙을 적용한 새 창 위치. 옮길 필요가 없으면 false
+bool windowRuleTarget(const WindowRuleResult& rule, const MonitorTopology& topology, const Rect& current, Rect& out);
+
+// 여러 창의 규칙 위치를 한 번에 (창 이벤트 한 묶음에 새 창이 여럿일 때)
+struct RulePlacement {
+    WindowId window = 0;
+    WindowRuleResult rule;
+    Rect current;
+    Rect target;        // move 일 때만 의미 있음
+    bool move = false;  // windowRuleTarget 의 반환값
+    int from = -1, to = -1;  // 계산 중에 쓰는 모니터 번호
+};
+
+// 슬롯 규칙은 SlotBatch 에 모아 computeSlotRects 로 계산한다 (batch 는 호출하는 쪽의 작업 공간)
+void windowRuleTargets(std::vector<RulePlacement>& placements, const MonitorTopology& topology, SlotBatch& batch);
+
+// 호출하는 쪽이 가진 작업 공간 - 처음 한 번 커진 뒤에는 할당 없음
+struct RuleMatchScratch {
+    std::vector<std::uint32_t> stamps;
+    std::vector<std::uint32_t> hits;
+    std::vector<std::uint32_t> matched;
+    std::uint32_t generation = 0;
+};
+
+// 규칙 집합을 한 번 컴파일해 두고 조회만 한다
+// - 와일드카드 없는 값: 필드별 해시 표에서 한 번 조회
+// - glob: '*' 사이의 고정 조각을 필드별 Aho-Corasick 오토마톤으로 한 번에 찾고,
+//   조각이 모두 나온 후보만 glob 으로 순서/양 끝을 확인
+// 컴파일 뒤에는 읽기 전용이라 여러 스레드에서 같이 쓸 수 있다 (작업 공간만 따로).
+class CompiledWindowRules {
+public:
+    void compile(const std::vector<WindowRuleConfig>& rules);
+    WindowRuleResult match(const WindowDescriptor& window, RuleMatchScratch& scratch) const;
+
+    size_t ruleCount() const { return m_rules.size(); }
+    size_t automatonStates() const {
+        return m_classGlobs.stateCount() + m_executableGlobs.stateCount() + m_titleGlobs.stateCount();
+    }
+    size_t memoryBytes() const;
+
+private:
+    enum FieldBits : std::uint8_t {
+        FieldClass = 1u << 0,
+        FieldTitle = 1u << 1,
+        FieldExecutable = 1u << 2,
+    };
+
+    // 사전 항목 값은 (규칙 id << 5) | 규칙 안의 조각 번호
+
+    // 소문자 키 -> 항목 값 목록 (오픈 어드레싱, 키는 m_keys 에 모아 둔다)
+    class ExactTable {
+    public:
+        void build(const std::vector<std::pair<std::string, std::uint32_t>>& entries);
+        // 일치하는 항목 값 범위 [begin, end)
+        bool find(std::string_view text, const std::uint32_t*& begin, const std::uint32_t*& end) const;
+        size_t memoryBytes() const;
+
+    private:
+        struct Slot {
+            std::uint64_t hash = 0;
+            std::uint32_t keyOffset = 0;
+            std::uint32_t keyLength = 0;
+            std::uint32_t rulesBegin = 0;
+            std::uint32_t rulesEnd = 0;  // begin == end 이면 빈 슬롯
+        };
+        std::vector<Slot> m_slots;
+        std::vector<char> m_keys;
+        std::vector<std::uint32_t> m_rules;
+        size_t m_mask = 0;
+    };
+
+    // 고정 조각 -> 항목 값 목록 (Aho-Corasick, 실패 전이를 미리 펼친 DFA)
+    class SubstringAutomaton {
+    public:
+        void build(const std::vector<std::pair<std::string, std::uint32_t>>& anchors);
+        // text 안에서 찾은 조각마다 항목 값 범위로 fn(begin, end) 호출
+        template <typename F>
+        void scan(std::string_view text, F&& fn) const {
+            if (!m_stateCount) return;
+            std::int32_t state = 0;
+            for (char c : text) {
+                state = m_next[static_cast<size_t>(state) * m_classCount + m_byteClass[static_cast<unsigned char>(c)]];
+                const std::uint32_t from = m_outputBegin[state], to = m_outputBegin[state + 1];
+                if (from != to) fn(m_outputs.data() + from, m_outputs.data() + to);
+            }
+        }
+        size_t stateCount() const { return m_stateCount; }
+        size_t memoryBytes() const;
+
+    private:
+        // 바이트 -> 문자 클래스 (조각에 없는 바이트는 0, 대문자는 소문자와 같은 클래스)
+        std::uint8_t m_byteClass[256] = {};
+        int m_classCount = 1;
+        size_t m_stateCount = 0;
+        std::vector<std::int32_t> m_next;          // 상태 x 클래스 -> 다음 상태
+        std::vector<std::uint32_t> m_outputBegin;  // 상태마다 일치한 항목 범위 (실패 링크 출력 포함)
+        std::vector<std::uint32_t> m_outputs;
+    };
+
+    bool verify(std::uint32_t rule, const WindowDescriptor& window) const;
+
+    std::vector<WindowRuleConfig> m_rules;
+    std::vector<std::uint32_t> m_required; // 규칙마다 채워야 하는 사전 항목 비트
+    std::vector<std::uint8_t> m_verify;    // 후보가 된 뒤 glob 으로 확인할 필드
+    std::vector<std::uint32_t> m_always;   // 사전 조회할 필드가 없는 규칙
+
+    ExactTable m_classes;
+    ExactTable m_executables;
+    ExactTable m_titles;
+    SubstringAutomaton m_classGlobs;
+    SubstringAutomaton m_executableGlobs;
+    SubstringAutomaton m_titleGlobs;
+};
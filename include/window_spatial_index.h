@@ -0,0 +1,89 @@
+#pragma once
+#include "core_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+enum class Direction : std::uint8_t { Left, Right, Up, Down };
+
+// direction 쪽 창의 점수 (작을수록 가깝다). 중심이 그쪽에 있지 않으면 -1
+// 진행 방향 중심 거리 + 2 x 수직 방향 간격 (겹치면 0) - 같은 줄/열의 창을 먼저 고른다
+// 단위는 반 픽셀 (중심을 정수로 다루기 위해)
+std::int64_t directionalScore(const Rect& from, const Rect& to, Direction direction);
+// 점수가 같을 때: 수직 방향 중심 거리, 그다음 창 id 가 작은 쪽
+bool directionalBetter(const Rect& from, std::int64_t score, const Rect& rect, WindowId window,
+                       std::int64_t bestScore, const Rect& bestRect, WindowId best, Direction direction);
+
+// direction 쪽으로 밀기: 가로막는 창(수직 방향으로 겹치는 경우만)이나 작업 영역 끝에 닿을 때까지
+Rect pushRect(const Rect& window, Direction direction, const Rect* obstacle, const Rect& workArea);
+
+struct SpatialQueryStats {
+    std::uint64_t cellsVisited = 0;
+    std::uint64_t candidatesScored = 0;
+};
+
+// 관리 대상 창 사각형의 공간 색인 (방향별 가장 가까운 창 찾기)
+// 모니터 작업 영역마다 균일 격자를 두고 창은 중심이 들어 있는 칸 하나에만 넣는다.
+// 창이 움직이면 그 창 하나만 칸을 옮긴다. 어느 모니터에도 중심이 없는 창은 따로 모아 선형 탐색.
+// 질의는 방향 쪽으로 열(행)을 차례로 훑고, 그 열의 최소 거리가 지금까지의 최선보다 크면 멈춘다.
+// 열 안에서도 수직 방향으로 멀어 최선을 넘을 수밖에 없는 칸은 건너뛴다.
+class WindowSpatialIndex {
+public:
+    explicit WindowSpatialIndex(int cellSize = 256) : m_cellSize(cellSize) {}
+
+    // 모니터 구성이 바뀌면 격자를 다시 만들고 모든 창을 다시 넣는다
+    void setMonitors(const std::vector<Rect>& workAreas);
+    // 새 창이면 넣고, 있으면 위치만 바꾼다
+    void update(WindowId window, const Rect& rect);
+    void remove(WindowId window);
+    void clear();
+
+    bool contains(WindowId window) const { return m_index.count(window) != 0; }
+    const Rect* rectOf(WindowId window) const;
+    size_t size() const { return m_entries.size(); }
+
+    // from 에서 direction 쪽으로 가장 가까운 창 (exclude 는 제외). 없으면 0
+    WindowId nearest(const Rect& from, Direction direction, WindowId exclude = 0,
+                     SpatialQueryStats* stats = nullptr) const;
+    // 밀기용: from 과 수직 방향으로 겹치고 direction 쪽 앞에 있는 창 중 가까운 모서리가 가장 가까운 창.
+    // 점수가 좋은 이웃이 옆줄에 있어도 실제로 가로막는 창을 고른다. 없으면 0
+    WindowId blocking(const Rect& from, Direction direction, WindowId exclude = 0,
+                      SpatialQueryStats* stats = nullptr) const;
+
+private:
+    struct Entry {
+        WindowId window = 0;
+        Rect rect;
+        int grid = -1;             // -1: 모니터 밖
+        std::uint32_t cell = 0;
+        std::uint32_t slot = 0;    // 칸(또는 m_stray) 안의 위치
+    };
+    struct Grid {
+        Rect area;
+        int cols = 0;
+        int rows = 0;
+        std::vector<std::vector<std::uint32_t>> cells;  // 행 우선, m_entries 인덱스
+    };
+
+    void place(std::uint32_t entry);
+    void unplace(std::uint32_t entry);
+    std::vector<std::uint32_t>& bucketOf(const Entry& entry);
+    void searchGrid(const Grid& grid, const Rect& from, Direction direction, WindowId exclude, std::int64_t& bestScore,
+                    std::uint32_t& best, SpatialQueryStats* stats) const;
+    void consider(std::uint32_t entry, const Rect& from, Direction direction, WindowId exclude,
+                  std::int64_t& bestScore, std::uint32_t& best) const;
+    void searchBlocking(const Grid& grid, const Rect& from, Direction direction, WindowId exclude,
+                        std::int64_t& bestLead, std::uint32_t& best, SpatialQueryStats* stats) const;
+    void considerBlocking(std::uint32_t entry, const Rect& from, Direction direction, WindowId exclude,
+                          std::int64_t& bestLead, std::uint32_t& best) const;
+
+    int m_cellSize;
+    std::vector<Grid> m_grids;
+    std::vector<std::uint32_t> m_stray;
+    std::vector<Entry> m_entries;
+    std::unordered_map<WindowId, std::uint32_t> m_index;
+    // 칸 건너뛰기용 가장 큰 창 크기 (줄지 않는다 - setMonitors 때 다시 계산)
+    int m_maxWidth = 0;
+    int m_maxHeight = 0;
+};
@@ -0,0 +1,146 @@
+#pragma once
+#include "core_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 창별 상태를 보관하는 오픈 어드레싱 해시 테이블
+// - 선형 탐사 + backward-shift 삭제 (툼스톤 없음)
+// - 항목마다 생성 스탬프를 저장해 재사용된 핸들이 이전 상태를 물려받지 않게 한다
+// - 최대 항목 수가 고정되어 있고, 가득 차면 CLOCK(second chance) 방식으로 오래된 항목을 내보낸다
+template <typename Value>
+class WindowStateTable {
+public:
+    explicit WindowStateTable(size_t maxEntries = 4096) : m_maxEntries(maxEntries ? maxEntries : 1) {
+        size_t capacity = 8;
+        while (capacity < m_maxEntries * 2) capacity <<= 1;
+        m_slots.resize(capacity);
+        m_mask = capacity - 1;
+        m_shift = 64;
+        for (size_t c = capacity; c > 1; c >>= 1) --m_shift;
+    }
+
+    // 스탬프가 다르면 재사용된 핸들로 보고 항목을 지운다
+    Value* find(WindowId window, std::uint32_t stamp) {
+        size_t index;
+        if (!locate(window, index)) return nullptr;
+        Slot& slot = m_slots[index];
+        if (slot.stamp != stamp) {
+            removeAt(index);
+            ++m_staleEvictions;
+            return nullptr;
+        }
+        slot.referenced = 1;
+        return &slot.value;
+    }
+
+    Value& insert(WindowId window, std::uint32_t stamp, const Value& value) {
+        size_t index;
+        if (!locate(window, index)) {
+            if (m_size >= m_maxEntries) {
+                evictOne();
+                locate(window, index);
+            }
+            m_slots[index].key = window;
+            ++m_size;
+        }
+        Slot& slot = m_slots[index];
+        slot.stamp = stamp;
+        slot.referenced = 1;
+        slot.value = value;
+        return slot.value;
+    }
+
+    bool erase(WindowId window) {
+        size_t index;
+        if (!locate(window, index)) return false;
+        removeAt(index);
+        return true;
+    }
+
+    void clear() {
+        for (auto& slot : m_slots) slot = Slot();
+        m_size = 0;
+        m_clockHand = 0;
+    }
+
+    size_t size() const { return m_size; }
+    size_t maxEntries() const { return m_maxEntries; }
+    size_t slotCount() const { return m_slots.size(); }
+    size_t memoryBytes() const { return m_slots.size() * sizeof(Slot); }
+    size_t capacityEvictions() const { return m_capacityEvictions; }
+    size_t staleEvictions() const { return m_staleEvictions; }
+
+private:
+    struct Slot {
+        WindowId key = 0;  // 0 이면 빈 슬롯
+        std::uint32_t stamp = 0;
+        std::uint8_t referenced = 0;
+        Value value{};
+    };
+
+    size_t home(WindowId window) const {
+        // 핸들 값은 하위 비트가 고르지 않으므로 피보나치 해싱
+        return static_cast<size_t>((static_cast<std::uint64_t>(window) * 0x9E3779B97F4A7C15ull) >> m_shift);
+    }
+
+    // 찾으면 true 와 그 위치, 못 찾으면 false 와 삽입할 빈 슬롯 위치
+    bool locate(WindowId window, size_t& index) const {
+        size_t i = home(window);
+        while (true) {
+            const WindowId key = m_slots[i].key;
+            if (key == window) {
+                index = i;
+                return true;
+            }
+            if (key == 0) {
+                index = i;
+                return false;
+            }
+            i = (i + 1) & m_mask;
+        }
+    }
+
+    void removeAt(size_t index) {
+        // backward-shift: 뒤에 이어지는 항목을 당겨 탐사 체인을 유지
+        size_t hole = index;
+        size_t i = (index + 1) & m_mask;
+        while (m_slots[i].key != 0) {
+            size_t want = home(m_slots[i].key);
+            // want 가 (hole, i] 범위 밖이면 hole 로 옮길 수 있다
+            bool movable = hole <= i ? (want <= hole || want > i) : (want <= hole && want > i);
+            if (movable) {
+                m_slots[hole] = m_slots[i];
+                hole = i;
+            }
+            i = (i + 1) & m_mask;
+        }
+        m_slots[hole] = Slot();
+        --m_size;
+    }
+
+    void evictOne() {
+        while (true) {
+            Slot& slot = m_slots[m_clockHand];
+            size_t current = m_clockHand;
+            m_clockHand = (m_clockHand + 1) & m_mask;
+            if (slot.key == 0) continue;
+            if (slot.referenced) {
+                slot.referenced = 0;
+                continue;
+            }
+            removeAt(current);
+            ++m_capacityEvictions;
+            return;
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    size_t m_mask = 0;
+    unsigned m_shift = 0;
+    size_t m_maxEntries;
+    size_t m_size = 0;
+    size_t m_clockHand = 0;
+    size_t m_capacityEvictions = 0;
+    size_t m_staleEvictions = 0;
+};
@@ -0,0 +1,98 @@
+#pragma once
+#include "layout_transaction.h"
+#include <cstdint>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// 재시작 후에도 같은 창을 찾기 위한 식별 값 (HWND 는 실행마다 바뀐다)
+// app: 실행 파일 이름 + 창 클래스 (대소문자 무시), title: 제목 해시
+struct WindowIdentity {
+    std::uint64_t app = 0;
+    std::uint64_t title = 0;
+
+    bool operator==(const WindowIdentity& other) const { return app == other.app && title == other.title; }
+};
+
+std::uint64_t windowAppKey(std::string_view executable, std::string_view className);
+std::uint64_t windowTitleKey(std::string_view title);
+inline WindowIdentity makeWindowIdentity(std::string_view executable, std::string_view className,
+                                         std::string_view title) {
+    return {windowAppKey(executable, className), windowTitleKey(title)};
+}
+
+enum WorkspaceWindowFlags : std::uint32_t {
+    WorkspaceMaximized = 1u << 0,
+};
+
+// 작업 공간에 저장된 창 하나 (위치는 보이는 프레임 기준)
+struct WorkspaceWindow {
+    WindowIdentity identity;
+    Rect position;
+    std::int32_t monitorIndex = -1;
+    std::uint32_t flags = 0;
+};
+
+// 전환 대상이 될 수 있는 지금의 창 (보이는 관리 대상 창 + 작업 공간 전환으로 숨긴 창)
+struct WorkspaceCandidate {
+    WindowId window = 0;
+    WindowIdentity identity;
+    bool visible = false;
+    bool maximized = false;
+};
+
+struct WorkspaceSwitchStats {
+    size_t matched = 0;     // 제목까지 같은 창
+    size_t appMatched = 0;  // 제목이 바뀌어 실행 파일 + 클래스로 찾은 창
+    size_t missing = 0;     // 저장됐지만 지금은 없는 창
+    size_t shown = 0;
+    size_t hidden = 0;
+};
+
+// 식별 값 -> 후보 인덱스 (같은 값의 후보는 연결 목록, 찾을 때마다 앞에서 하나씩 가져간다)
+class WindowIdentityIndex {
+public:
+    void build(const std::uint64_t* keys, size_t count);
+    // 아직 가져가지 않은 후보 하나. 없으면 -1
+    int take(std::uint64_t key, const std::vector<std::uint8_t>& claimed);
+
+private:
+    std::vector<std::uint64_t> m_keys;
+    std::vector<std::uint8_t> m_used;   // 슬롯 사용 여부 (선형 탐색은 빈 슬롯에서만 멈춘다)
+    std::vector<std::int32_t> m_heads;  // 슬롯별 남은 후보 목록 머리 (-1: 모두 가져감)
+    std::vector<std::int32_t> m_next;
+    size_t m_mask = 0;
+};
+
+// 작업 공간 전환
+// 저장된 창을 식별 색인으로 한 번에 찾고 (창마다 선형 탐색 없음), 보이기/숨기기/이동을 트랜잭션 하나에 담는다.
+// 현재 작업 공간의 창 중 대상에 없는 창만 숨기고, 어느 작업 공간에도 속하지 않은 창은 그대로 둔다.
+class WorkspaceSwitcher {
+public:
+    // 저장 직후 - 이 창들이 현재 작업 공간
+    void setMembers(const WindowId* windows, size_t count);
+
+    // transaction 에 요청만 담는다. 호출한 쪽이 toRestore() 를 풀고, 커밋한 뒤 toMaximize() 를 최대화한다
+    // (최대화 상태는 SetWindowPos 로 바꿀 수 없다)
+    WorkspaceSwitchStats plan(const WorkspaceWindow* saved, size_t savedCount,
+                              const WorkspaceCandidate* live, size_t liveCount, LayoutTransaction& transaction);
+    const std::vector<WindowId>& toRestore() const { return m_toRestore; }
+    const std::vector<WindowId>& toMaximize() const { return m_toMaximize; }
+
+    bool isHidden(WindowId window) const { return m_hidden.count(window) != 0; }
+    size_t hiddenCount() const { return m_hidden.size(); }
+    // 종료 시 숨겨 둔 창을 모두 다시 보인다
+    void showHidden(LayoutTransaction& transaction);
+    void forget(WindowId window);
+
+private:
+    std::unordered_set<WindowId> m_members;
+    std::unordered_set<WindowId> m_hidden;
+    WindowIdentityIndex m_exact;
+    WindowIdentityIndex m_app;
+    std::vector<std::uint64_t> m_keys;
+    std::vector<std::uint8_t> m_claimed;
+    std::vector<std::int32_t> m_assigned;
+    std::vector<WindowId> m_toRestore;
+    std::vector<WindowId> m_toMaximize;
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include "core_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 설정에 적은 zone 하나
+// rect 는 작업 영역 기준 천분율 (0~1000). merge 가 있으면 같은 모니터의 앞선 zone 들을 합친 zone 이고
+// 합쳐진 zone 들은 따로 잡히지 않는다.
+struct ZoneConfig {
+    int monitor = 0;
+    Rect rect;
+    std::vector<int> merge;  // 같은 모니터 안에서의 zone 순번 (선언 순, 0 부터)
+};
+
+// 잡히는 영역 하나 (우선순위 순으로 정렬되어 있다)
+struct ZoneRegion {
+    Rect hit;     // 포인터가 이 안에 있으면
+    int target;   // targets() 의 이 사각형으로 스냅
+    bool span;    // 이웃한 두 zone 을 함께 덮는 경계 띠
+};
+
+// 모니터 하나의 zone 레이아웃을 픽셀 단위 판정 표로 컴파일한 것
+// x 경계로 나눈 세로 띠마다 y 경계와 목표 번호를 평평한 배열에 담아 두어
+// 조회는 이진 탐색 두 번이고 할당이 없다. 빌드는 설정/토폴로지가 바뀔 때만 한다.
+class ZoneLayout {
+public:
+    // zones 중 monitorIndex 의 것만 쓴다. gap/span 은 DIP (dpi/96 으로 늘린다)
+    void build(const std::vector<ZoneConfig>& zones, int monitorIndex, const Rect& workArea, unsigned dpi,
+               int gapDip, int spanDip);
+    void clear();
+
+    bool empty() const { return m_targets.empty(); }
+    // 포인터 아래 zone 의 목표 번호, 없으면 -1
+    int hitTest(Point pt) const;
+    const Rect& target(int index) const { return m_targets[index]; }
+    const std::vector<Rect>& targets() const { return m_targets; }
+    const std::vector<ZoneRegion>& regions() const { return m_regions; }
+    size_t cellCount() const { return m_ids.size(); }
+
+private:
+    std::vector<Rect> m_targets;       // 간격을 뺀 스냅 목표
+    std::vector<ZoneRegion> m_regions;
+    std::vector<int> m_xs;             // 띠 경계 (정렬)
+    std::vector<std::uint32_t> m_slabs;  // 띠 i 의 y 경계는 m_ys[m_slabs[i] .. m_slabs[i + 1])
+    std::vector<int> m_ys;
+    std::vector<int> m_ids;            // m_ys[k] ~ m_ys[k + 1] 구간의 목표 (-1 은 없음)
+};
@@ -0,0 +1,237 @@
+#include "async_move_executor.h"
+#include "latency_trace.h"
+#include <chrono>
+
+std::int64_t AsyncMoveExecutor::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+AsyncMoveExecutor::AsyncMoveExecutor(WindowMoveBackend& backend, size_t workers, std::int64_t timeoutNs,
+                                     size_t maxWorkers)
+    : m_state(std::make_shared<State>(backend)) {
+    m_state->timeoutNs = timeoutNs;
+    m_state->baseWorkers = workers ? workers : 1;
+    m_state->maxWorkers = maxWorkers > m_state->baseWorkers ? maxWorkers : m_state->baseWorkers;
+
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    for (size_t i = 0; i < m_state->baseWorkers; ++i) spawnWorker(m_state);
+    m_watchdog = std::thread(watchdogLoop, m_state);
+}
+
+AsyncMoveExecutor::~AsyncMoveExecutor() {
+    {
+        std::unique_lock<std::mutex> lock(m_state->mutex);
+        m_state->stopping = true;
+        m_state->work.notify_all();
+        m_state->watchdog.notify_all();
+        // 응답 없는 호출에 묶인 스레드는 기다리지 않는다 (끝나면 스스로 종료)
+        m_state->idle.wait(lock, [this] { return m_state->liveWorkers == m_state->stuckWorkers; });
+    }
+    m_watchdog.join();
+}
+
+// mutex 를 잡은 상태에서 호출
+void AsyncMoveExecutor::spawnWorker(const std::shared_ptr<State>& state) {
+    ++state->liveWorkers;
+    std::thread(workerLoop, state).detach();
+}
+
+void AsyncMoveExecutor::setTracer(LatencyTracer* tracer) {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->tracer = tracer;
+}
+
+void AsyncMoveExecutor::submit(WindowId window, const Rect& target, std::uint32_t traceSpan) {
+    State& s = *m_state;
+    std::lock_guard<std::mutex> lock(s.mutex);
+    ++s.stats.submitted;
+
+    Slot& slot = s.slots[window];
+    if (slot.pending) ++s.stats.coalesced;
+    slot.target = target;
+    slot.traceSpan = traceSpan;
+    slot.pending = true;
+
+    // 실행 중이면 끝난 뒤 이어서 실행된다 (응답 없는 창도 스레드를 더 쓰지 않음)
+    if (slot.inFlight || slot.queued) return;
+    slot.queued = true;
+    s.ready.push_back(window);
+    s.work.notify_one();
+}
+
+bool AsyncMoveExecutor::isHung(WindowId window) const {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    auto it = m_state->slots.find(window);
+    return it != m_state->slots.end() && it->second.hung;
+}
+
+bool AsyncMoveExecutor::waitIdle(std::int64_t timeoutNs) {
+    State& s = *m_state;
+    std::unique_lock<std::mutex> lock(s.mutex);
+    return s.idle.wait_for(lock, std::chrono::nanoseconds(timeoutNs), [&s] {
+        return s.ready.empty() && s.inFlight == s.stats.hungWindows;
+    });
+}
+
+AsyncMoveStats AsyncMoveExecutor::stats() const {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    AsyncMoveStats stats = m_state->stats;
+    stats.queueDepth = m_state->ready.size();
+    stats.inFlight = m_state->inFlight;
+    stats.workers = m_state->liveWorkers;
+    return stats;
+}
+
+void AsyncMoveExecutor::workerLoop(std::shared_ptr<State> state) {
+    State& s = *state;
+    std::unique_lock<std::mutex> lock(s.mutex);
+
+    while (true) {
+        s.work.wait(lock, [&s] { return s.stopping || !s.ready.empty(); });
+        if (s.stopping) break;
+
+        const WindowId window = s.ready.pop_front();
+        Slot& slot = s.slots[window];
+        const WindowMove move = {window, slot.target};
+        const std::uint32_t span = s.tracer ? slot.traceSpan : 0;
+        LatencyTracer* tracer = s.tracer;
+        slot.traceSpan = 0;
+        slot.queued = false;
+        slot.pending = false;
+        slot.inFlight = true;
+        slot.startNs = nowNs();
+        ++s.inFlight;
+        lock.unlock();
+
+        // GetWindowRect 는 대상 스레드에 메시지를 보내지 않으므로 응답 없는 창에도 막히지 않는다
+        Rect current;
+        bool exists = s.backend.getWindowRect(window, current);
+        bool unchanged = exists && current == move.target;
+        bool ok = unchanged || (exists && s.backend.applyOne(move));
+        if (span && ok) {
+            tracer->mark(span, TraceStage::MoveReturned);
+            // 최소 크기/DPI 보정으로 목표와 다르게 놓였으면 도달로 치지 않는다
+            if (unchanged || (s.backend.getWindowRect(window, current) && current == move.target)) {
+                tracer->mark(span, TraceStage::TargetReached);
+            }
+        }
+
+        lock.lock();
+        --s.inFlight;
+        Slot& done = s.slots[window];
+        done.inFlight = false;
+        if (unchanged) ++s.stats.skipped;
+        else if (ok) ++s.stats.completed;
+        else ++s.stats.failed;
+
+        bool retire = false;
+        if (done.hung) {
+            done.hung = false;
+            --s.stats.hungWindows;
+            ++s.stats.recovered;
+            --s.stuckWorkers;
+            // 대신 만든 스레드가 있으면 돌아온 스레드는 물러난다
+            retire = s.liveWorkers - s.stuckWorkers > s.baseWorkers;
+        }
+
+        if (done.pending) {
+            done.queued = true;
+            s.ready.push_back(window);
+            s.work.notify_one();
+        } else if (s.slots.size() > kKeptSlots) {
+            s.slots.erase(window);
+        }
+        s.idle.notify_all();
+        if (retire) break;
+    }
+
+    --s.liveWorkers;
+    s.idle.notify_all();
+}
+
+void AsyncMoveExecutor::watchdogLoop(std::shared_ptr<State> state) {
+    State& s = *state;
+    const auto interval = std::chrono::nanoseconds(s.timeoutNs / 4 > 1'000'000 ? s.timeoutNs / 4 : 1'000'000);
+    std::unique_lock<std::mutex> lock(s.mutex);
+
+    while (!s.stopping) {
+        s.watchdog.wait_for(lock, interval);
+        if (s.stopping) break;
+        if (s.inFlight == 0) continue;
+
+        const std::int64_t now = nowNs();
+        for (auto& [window, slot] : s.slots) {
+            if (!slot.inFlight || slot.hung || now - slot.startNs < s.timeoutNs) continue;
+            slot.hung = true;
+            ++s.stats.hungWindows;
+            ++s.stats.timeouts;
+            ++s.stuckWorkers;
+            // 응답하는 스레드 수를 기본값으로 유지
+            if (s.liveWorkers - s.stuckWorkers < s.baseWorkers && s.liveWorkers < s.maxWorkers) {
+                spawnWorker(state);
+            }
+        }
+        s.idle.notify_all();
+    }
+}
+
+void SlowWindowMoveBackend::addWindow(WindowId window, const Rect& rect) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_windows[window].rect = rect;
+}
+
+void SlowWindowMoveBackend::setDelay(WindowId window, std::int64_t delayNs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_windows[window].delayNs = delayNs;
+}
+
+void SlowWindowMoveBackend::setHung(WindowId window, bool hung) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_windows[window].hung = hung;
+    }
+    m_released.notify_all();
+}
+
+bool SlowWindowMoveBackend::rectOf(WindowId window, Rect& out) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_windows.find(window);
+    if (it == m_windows.end()) return false;
+    out = it->second.rect;
+    return true;
+}
+
+size_t SlowWindowMoveBackend::callsFor(WindowId window) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_windows.find(window);
+    return it != m_windows.end() ? it->second.calls : 0;
+}
+
+bool SlowWindowMoveBackend::getWindowRect(WindowId window, Rect& out) {
+    return rectOf(window, out);
+}
+
+bool SlowWindowMoveBackend::applyBatch(const WindowMove* moves, size_t count) {
+    bool ok = true;
+    for (size_t i = 0; i < count; ++i) ok = applyOne(moves[i]) && ok;
+    return ok;
+}
+
+bool SlowWindowMoveBackend::applyOne(const WindowMove& move) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_windows.find(move.window);
+    if (it == m_windows.end()) return false;
+    ++it->second.calls;
+
+    const std::int64_t delayNs = it->second.delayNs;
+    if (delayNs > 0) {
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::nanoseconds(delayNs));
+        lock.lock();
+    }
+    // 응답 없는 창: 풀릴 때까지 호출이 돌아오지 않는다
+    m_released.wait(lock, [&] { return !m_windows[move.window].hung; });
+    if (!(move.flags & MoveKeepRect)) m_windows[move.window].rect = move.target;
+    return true;
+}
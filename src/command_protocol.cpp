@@ -0,0 +1,360 @@
+#include "command_protocol.h"
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+using namespace command_format;
+
+void CommandBatch::clear() {
+    text = false;
+    commands.clear();
+    results.clear();
+    states.clear();
+}
+
+static const struct {
+    const char* name;
+    WindowPosition position;
+} kPositionNames[] = {
+    {"left", WindowPosition::CenterLeft},        {"right", WindowPosition::CenterRight},
+    {"top", WindowPosition::TopCenter},          {"bottom", WindowPosition::BottomCenter},
+    {"center", WindowPosition::Center},          {"topleft", WindowPosition::TopLeft},
+    {"topright", WindowPosition::TopRight},      {"bottomleft", WindowPosition::BottomLeft},
+    {"bottomright", WindowPosition::BottomRight},
+};
+
+const char* commandPositionName(WindowPosition position) {
+    for (const auto& entry : kPositionNames) {
+        if (entry.position == position) return entry.name;
+    }
+    return "center";
+}
+
+const char* commandStatusName(CommandStatus status) {
+    switch (status) {
+        case CommandStatus::Ok: return "ok";
+        case CommandStatus::UnknownWindow: return "unknown-window";
+        case CommandStatus::UnknownLayout: return "unknown-layout";
+        case CommandStatus::Invalid: return "invalid";
+    }
+    return "invalid";
+}
+
+// ---- 이진 ----
+
+namespace {
+
+struct Reader {
+    const unsigned char* p;
+    size_t left;
+    bool ok = true;
+
+    template <typename T>
+    T read() {
+        T value = 0;
+        if (left < sizeof(T)) {
+            ok = false;
+            return value;
+        }
+        std::memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        left -= sizeof(T);
+        return value;
+    }
+};
+
+template <typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void putHeader(std::string& out, std::uint8_t magic, size_t count, size_t bodySize) {
+    out.push_back(static_cast<char>(magic));
+    out.push_back(static_cast<char>(kVersion));
+    put<std::uint16_t>(out, static_cast<std::uint16_t>(count));
+    put<std::uint32_t>(out, static_cast<std::uint32_t>(bodySize));
+}
+
+}  // namespace
+
+void encodeCommands(const Command* commands, size_t count, std::string& out) {
+    const size_t header = out.size();
+    putHeader(out, kRequestMagic, count, 0);
+    for (size_t i = 0; i < count; ++i) {
+        const Command& command = commands[i];
+        out.push_back(static_cast<char>(command.op));
+        switch (command.op) {
+            case CommandOp::Snap:
+                put<std::uint64_t>(out, command.window);
+                out.push_back(static_cast<char>(command.position));
+                break;
+            case CommandOp::Move:
+                put<std::uint64_t>(out, command.window);
+                put<std::int32_t>(out, command.rect.left);
+                put<std::int32_t>(out, command.rect.top);
+                put<std::int32_t>(out, command.rect.right);
+                put<std::int32_t>(out, command.rect.bottom);
+                break;
+            case CommandOp::ApplyLayout:
+                put<std::uint16_t>(out, static_cast<std::uint16_t>(command.name.size()));
+                out.append(command.name);
+                break;
+            case CommandOp::Query:
+                put<std::uint64_t>(out, command.window);
+                break;
+        }
+    }
+    const std::uint32_t body = static_cast<std::uint32_t>(out.size() - header - kHeaderSize);
+    std::memcpy(&out[header + 4], &body, sizeof(body));
+}
+
+CommandDecoder::Result CommandDecoder::nextBinary(CommandBatch& out) {
+    if (buffered() < kHeaderSize) return Result::NeedMore;
+    Reader header{reinterpret_cast<const unsigned char*>(m_buffer.data() + m_offset), kHeaderSize};
+    header.read<std::uint8_t>();
+    const std::uint8_t version = header.read<std::uint8_t>();
+    const std::uint16_t count = header.read<std::uint16_t>();
+    const std::uint32_t length = header.read<std::uint32_t>();
+    if (version != kVersion || length > kMaxFrame) return Result::Error;
+    if (buffered() < kHeaderSize + length) return Result::NeedMore;
+
+    Reader body{reinterpret_cast<const unsigned char*>(m_buffer.data() + m_offset + kHeaderSize), length};
+    out.clear();
+    out.commands.resize(count);
+    for (Command& command : out.commands) {
+        command.op = static_cast<CommandOp>(body.read<std::uint8_t>());
+        switch (command.op) {
+            case CommandOp::Snap: {
+                command.window = static_cast<WindowId>(body.read<std::uint64_t>());
+                const std::uint8_t position = body.read<std::uint8_t>();
+                if (position > static_cast<std::uint8_t>(WindowPosition::BottomRight)) return Result::Error;
+                command.position = static_cast<WindowPosition>(position);
+                break;
+            }
+            case CommandOp::Move:
+                command.window = static_cast<WindowId>(body.read<std::uint64_t>());
+                command.rect.left = body.read<std::int32_t>();
+                command.rect.top = body.read<std::int32_t>();
+                command.rect.right = body.read<std::int32_t>();
+                command.rect.bottom = body.read<std::int32_t>();
+                break;
+            case CommandOp::ApplyLayout: {
+                const std::uint16_t size = body.read<std::uint16_t>();
+                if (!body.ok || body.left < size) return Result::Error;
+                command.name.assign(reinterpret_cast<const char*>(body.p), size);
+                body.p += size;
+                body.left -= size;
+                break;
+            }
+            case CommandOp::Query:
+                command.window = static_cast<WindowId>(body.read<std::uint64_t>());
+                break;
+            default:
+                return Result::Error;
+        }
+        if (!body.ok) return Result::Error;
+    }
+    // 본문 길이와 명령이 정확히 맞아야 한다
+    if (body.left != 0) return Result::Error;
+    m_offset += kHeaderSize + length;
+    return Result::Batch;
+}
+
+void encodeReply(const CommandBatch& batch, std::string& out) {
+    if (batch.text) {
+        for (size_t i = 0; i < batch.results.size(); ++i) {
+            if (i) out.append(" ; ");
+            const CommandResult& result = batch.results[i];
+            const bool query = i < batch.commands.size() && batch.commands[i].op == CommandOp::Query;
+            if (result.status != CommandStatus::Ok || !query) {
+                out.append(commandStatusName(result.status));
+                continue;
+            }
+            if (result.stateCount == 0) out.append("none");
+            for (std::uint32_t s = 0; s < result.stateCount; ++s) {
+                const CommandWindowState& state = batch.states[result.firstState + s];
+                char line[96];
+                std::snprintf(line, sizeof(line), "%s0x%llx %d %d %d %d %s", s ? ", " : "",
+                              static_cast<unsigned long long>(state.window), state.rect.left, state.rect.top,
+                              state.rect.right, state.rect.bottom, state.visible ? "visible" : "hidden");
+                out.append(line);
+            }
+        }
+        out.push_back('\n');
+        return;
+    }
+
+    const size_t header = out.size();
+    putHeader(out, kReplyMagic, batch.results.size(), 0);
+    for (const CommandResult& result : batch.results) {
+        out.push_back(static_cast<char>(result.status));
+        put<std::uint32_t>(out, result.stateCount);
+        for (std::uint32_t s = 0; s < result.stateCount; ++s) {
+            const CommandWindowState& state = batch.states[result.firstState + s];
+            put<std::uint64_t>(out, state.window);
+            put<std::int32_t>(out, state.rect.left);
+            put<std::int32_t>(out, state.rect.top);
+            put<std::int32_t>(out, state.rect.right);
+            put<std::int32_t>(out, state.rect.bottom);
+            out.push_back(state.visible ? 1 : 0);
+        }
+    }
+    const std::uint32_t body = static_cast<std::uint32_t>(out.size() - header - kHeaderSize);
+    std::memcpy(&out[header + 4], &body, sizeof(body));
+}
+
+long long decodeReply(const char* data, size_t size, CommandBatch& out) {
+    if (size < kHeaderSize) return 0;
+    Reader header{reinterpret_cast<const unsigned char*>(data), kHeaderSize};
+    const std::uint8_t magic = header.read<std::uint8_t>();
+    const std::uint8_t version = header.read<std::uint8_t>();
+    const std::uint16_t count = header.read<std::uint16_t>();
+    const std::uint32_t length = header.read<std::uint32_t>();
+    if (magic != kReplyMagic || version != kVersion || length > kMaxFrame) return -1;
+    if (size < kHeaderSize + length) return 0;
+
+    Reader body{reinterpret_cast<const unsigned char*>(data + kHeaderSize), length};
+    out.results.clear();
+    out.states.clear();
+    for (std::uint16_t i = 0; i < count; ++i) {
+        CommandResult result;
+        result.status = static_cast<CommandStatus>(body.read<std::uint8_t>());
+        result.firstState = static_cast<std::uint32_t>(out.states.size());
+        result.stateCount = body.read<std::uint32_t>();
+        if (!body.ok || result.stateCount > body.left / 25) return -1;
+        for (std::uint32_t s = 0; s < result.stateCount; ++s) {
+            CommandWindowState state;
+            state.window = static_cast<WindowId>(body.read<std::uint64_t>());
+            state.rect.left = body.read<std::int32_t>();
+            state.rect.top = body.read<std::int32_t>();
+            state.rect.right = body.read<std::int32_t>();
+            state.rect.bottom = body.read<std::int32_t>();
+            state.visible = body.read<std::uint8_t>() != 0;
+            out.states.push_back(state);
+        }
+        out.results.push_back(result);
+    }
+    if (!body.ok || body.left != 0) return -1;
+    return static_cast<long long>(kHeaderSize + length);
+}
+
+// ---- 텍스트 ----
+
+static std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+    return text;
+}
+
+// 공백으로 나눈 다음 낱말
+static std::string_view nextWord(std::string_view& text) {
+    text = trim(text);
+    size_t end = 0;
+    while (end < text.size() && text[end] != ' ' && text[end] != '\t') ++end;
+    std::string_view word = text.substr(0, end);
+    text.remove_prefix(end);
+    return word;
+}
+
+static bool parseWindow(std::string_view word, WindowId& out) {
+    int base = 10;
+    if (word.size() > 2 && word[0] == '0' && (word[1] == 'x' || word[1] == 'X')) {
+        word.remove_prefix(2);
+        base = 16;
+    }
+    unsigned long long value = 0;
+    auto [end, ec] = std::from_chars(word.data(), word.data() + word.size(), value, base);
+    if (ec != std::errc() || end != word.data() + word.size() || word.empty()) return false;
+    out = static_cast<WindowId>(value);
+    return true;
+}
+
+static bool parseInt(std::string_view word, int& out) {
+    auto [end, ec] = std::from_chars(word.data(), word.data() + word.size(), out);
+    return ec == std::errc() && end == word.data() + word.size() && !word.empty();
+}
+
+static bool parseTextCommand(std::string_view text, Command& command) {
+    const std::string_view op = nextWord(text);
+    if (op == "snap") {
+        command.op = CommandOp::Snap;
+        if (!parseWindow(nextWord(text), command.window)) return false;
+        const std::string_view position = nextWord(text);
+        bool found = false;
+        for (const auto& entry : kPositionNames) {
+            if (position == entry.name) {
+                command.position = entry.position;
+                found = true;
+            }
+        }
+        if (!found) return false;
+    } else if (op == "move") {
+        command.op = CommandOp::Move;
+        if (!parseWindow(nextWord(text), command.window) || !parseInt(nextWord(text), command.rect.left) ||
+            !parseInt(nextWord(text), command.rect.top) || !parseInt(nextWord(text), command.rect.right) ||
+            !parseInt(nextWord(text), command.rect.bottom)) {
+            return false;
+        }
+    } else if (op == "layout") {
+        command.op = CommandOp::ApplyLayout;
+        // 이름에는 공백이 들어갈 수 있다
+        text = trim(text);
+        if (text.empty() || text.size() > 0xFFFF) return false;
+        command.name.assign(text.data(), text.size());
+        return true;
+    } else if (op == "query") {
+        command.op = CommandOp::Query;
+        const std::string_view window = nextWord(text);
+        if (!window.empty() && !parseWindow(window, command.window)) return false;
+    } else {
+        return false;
+    }
+    return trim(text).empty();
+}
+
+bool parseCommandText(std::string_view line, CommandBatch& out) {
+    out.clear();
+    out.text = true;
+    while (true) {
+        const size_t separator = line.find(';');
+        const std::string_view part = trim(line.substr(0, separator));
+        if (!part.empty()) {
+            out.commands.emplace_back();
+            if (!parseTextCommand(part, out.commands.back())) return false;
+        }
+        if (separator == std::string_view::npos) break;
+        line.remove_prefix(separator + 1);
+    }
+    return !out.commands.empty();
+}
+
+CommandDecoder::Result CommandDecoder::nextText(CommandBatch& out) {
+    while (buffered() > 0) {
+        const size_t newline = m_buffer.find('\n', m_offset);
+        if (newline == std::string::npos) {
+            return buffered() > kMaxTextLine ? Result::Error : Result::NeedMore;
+        }
+        const std::string_view line(m_buffer.data() + m_offset, newline - m_offset);
+        m_offset = newline + 1;
+        if (trim(line).empty()) continue;
+        return parseCommandText(line, out) ? Result::Batch : Result::Error;
+    }
+    return Result::NeedMore;
+}
+
+// ---- 디코더 ----
+
+void CommandDecoder::append(const char* data, size_t size) {
+    // 다 읽은 앞부분은 버퍼가 커지기 전에 버린다
+    if (m_offset > 0 && m_offset * 2 >= m_buffer.size()) {
+        m_buffer.erase(0, m_offset);
+        m_offset = 0;
+    }
+    m_buffer.append(data, size);
+}
+
+CommandDecoder::Result CommandDecoder::next(CommandBatch& out) {
+    if (buffered() == 0) return Result::NeedMore;
+    if (static_cast<std::uint8_t>(m_buffer[m_offset]) == kRequestMagic) return nextBinary(out);
+    return nextText(out);
+}
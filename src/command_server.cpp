@@ -0,0 +1,514 @@
+#include "command_server.h"
+#include <iterator>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstdlib>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// ---- 공통 ----
+
+CommandServerStats CommandServer::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+bool CommandServer::submit(CommandBatch& batch) {
+    Request request;
+    request.batch = &batch;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_stopping) return false;
+    const bool wake = m_queue.empty();
+    m_queue.push_back(&request);
+    if (wake && m_pending) {
+        lock.unlock();
+        m_pending(m_context);
+        lock.lock();
+    }
+    // 메시지 루프가 이미 꺼내 간 배치는 멈추는 중이라도 끝날 때까지 기다린다 (batch 를 쓰는 중)
+    m_done.wait(lock, [&] { return request.done || (m_stopping && !request.taken); });
+    if (request.done) return true;
+    for (auto it = m_queue.begin(); it != m_queue.end(); ++it) {
+        if (*it == &request) {
+            m_queue.erase(it);
+            break;
+        }
+    }
+    return false;
+}
+
+size_t CommandServer::processPending(CommandHandler& handler) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running.swap(m_queue);
+        for (Request* request : m_running) request->taken = true;
+    }
+    if (m_running.empty()) return 0;
+
+    size_t commands = 0;
+    for (Request* request : m_running) {
+        CommandBatch& batch = *request->batch;
+        batch.results.clear();
+        batch.states.clear();
+        handler.execute(batch);
+        // 응답은 명령마다 하나
+        batch.results.resize(batch.commands.size(), {CommandStatus::Invalid, 0, 0});
+        commands += batch.commands.size();
+    }
+
+    const size_t count = m_running.size();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Request* request : m_running) request->done = true;
+        m_stats.batches += count;
+        m_stats.commands += commands;
+    }
+    m_running.clear();
+    m_done.notify_all();
+    return count;
+}
+
+void CommandServer::serve(Connection& connection) {
+    CommandDecoder decoder;
+    CommandBatch batch;
+    std::string reply;
+    char buffer[16 * 1024];
+
+    bool open = true;
+    while (open) {
+        const long received = readSome(connection, buffer, sizeof(buffer));
+        if (received <= 0) break;
+        decoder.append(buffer, static_cast<size_t>(received));
+
+        // 한 번에 도착한 배치들은 차례로 실행하고 응답은 한 번에 보낸다
+        reply.clear();
+        CommandDecoder::Result result;
+        while ((result = decoder.next(batch)) == CommandDecoder::Result::Batch) {
+            if (!submit(batch)) {
+                open = false;
+                break;
+            }
+            encodeReply(batch, reply);
+        }
+        if (!reply.empty() && !writeAll(connection, reply.data(), reply.size())) break;
+        if (result == CommandDecoder::Result::Error) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.errors;
+            break;
+        }
+    }
+
+    // 클라이언트에는 바로 끊겼음을 알리고, 핸들은 reapFinished/stop 에서 닫는다
+    // (다른 스레드가 interrupt 로 쓰는 중일 수 있다)
+    hangUp(connection);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    connection.finished = true;
+}
+
+bool CommandServer::addConnection(std::intptr_t handle) {
+    reapFinished();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stopping) {
+        // interrupt 가 이미 지나갔으면 이 연결은 깨울 수 없어 recv 가 stop 을 붙잡는다
+        Connection rejected;
+        rejected.handle = handle;
+        closeConnection(rejected);
+        return false;
+    }
+    ++m_stats.connections;
+    m_connections.emplace_back();
+    Connection& connection = m_connections.back();
+    connection.handle = handle;
+#ifdef _WIN32
+    connection.event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+#endif
+    connection.thread = std::thread([this, &connection] { serve(connection); });
+    return true;
+}
+
+void CommandServer::reapFinished() {
+    std::list<Connection> finished;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_connections.begin(); it != m_connections.end();) {
+            auto next = std::next(it);
+            if (it->finished) finished.splice(finished.end(), m_connections, it);
+            it = next;
+        }
+    }
+    for (Connection& connection : finished) {
+        connection.thread.join();
+        closeConnection(connection);
+    }
+}
+
+void CommandServer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_listenThread.joinable()) return;
+        m_stopping = true;
+    }
+    m_done.notify_all();
+    interrupt();
+    m_listenThread.join();
+
+    // 리스너가 끝났으니 연결은 더 늘지 않는다
+    for (Connection& connection : m_connections) {
+        connection.thread.join();
+        closeConnection(connection);
+    }
+    m_connections.clear();
+
+#ifdef _WIN32
+    if (m_listenHandle != -1) CloseHandle(reinterpret_cast<HANDLE>(m_listenHandle));
+    CloseHandle(static_cast<HANDLE>(m_stopEvent));
+    m_stopEvent = nullptr;
+#else
+    if (m_listenHandle != -1) ::close(static_cast<int>(m_listenHandle));
+    ::unlink(m_endpoint.c_str());
+#endif
+    m_listenHandle = -1;
+    m_stopping = false;
+}
+
+bool CommandClient::call(const Command* commands, size_t count, CommandBatch& reply) {
+    m_request.clear();
+    encodeCommands(commands, count, m_request);
+    if (!send(m_request.data(), m_request.size())) return false;
+
+    char buffer[16 * 1024];
+    while (true) {
+        const long long consumed = decodeReply(m_received.data(), m_received.size(), reply);
+        if (consumed < 0) return false;
+        if (consumed > 0) {
+            m_received.erase(0, static_cast<size_t>(consumed));
+            return true;
+        }
+        const long received = receive(buffer, sizeof(buffer));
+        if (received <= 0) return false;
+        m_received.append(buffer, static_cast<size_t>(received));
+    }
+}
+
+bool CommandClient::callText(const std::string& line, std::string& reply) {
+    m_request = line;
+    m_request.push_back('\n');
+    if (!send(m_request.data(), m_request.size())) return false;
+
+    char buffer[4096];
+    while (true) {
+        const size_t newline = m_received.find('\n');
+        if (newline != std::string::npos) {
+            reply.assign(m_received, 0, newline);
+            m_received.erase(0, newline + 1);
+            return true;
+        }
+        const long received = receive(buffer, sizeof(buffer));
+        if (received <= 0) return false;
+        m_received.append(buffer, static_cast<size_t>(received));
+    }
+}
+
+#ifdef _WIN32
+
+static std::wstring widen(const std::string& text) {
+    const int length = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), -1, nullptr, 0);
+    std::wstring wide(length > 0 ? length - 1 : 0, L'\0');
+    if (length > 1) MultiByteToWideChar(CP_UTF8, 0, text.c_str(), -1, wide.data(), length);
+    return wide;
+}
+
+static HANDLE createPipeInstance(const std::wstring& name, bool first) {
+    // 원격 클라이언트는 받지 않는다. 첫 인스턴스는 이미 있는 같은 이름의 파이프를 가로채지 않도록
+    const DWORD open = PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED | (first ? FILE_FLAG_FIRST_PIPE_INSTANCE : 0);
+    return CreateNamedPipeW(name.c_str(), open,
+                            PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+                            PIPE_UNLIMITED_INSTANCES, 64 * 1024, 64 * 1024, 0, nullptr);
+}
+
+// 겹친 I/O 하나가 끝나거나 stop 될 때까지 기다린다
+static bool waitIo(HANDLE pipe, OVERLAPPED& overlapped, HANDLE stopEvent, DWORD& transferred) {
+    HANDLE events[2] = {overlapped.hEvent, stopEvent};
+    if (WaitForMultipleObjects(2, events, FALSE, INFINITE) != WAIT_OBJECT_0) {
+        CancelIoEx(pipe, &overlapped);
+        GetOverlappedResult(pipe, &overlapped, &transferred, TRUE);
+        return false;
+    }
+    return GetOverlappedResult(pipe, &overlapped, &transferred, FALSE) != FALSE;
+}
+
+std::string CommandServer::defaultEndpoint() {
+    DWORD session = 0;
+    ProcessIdToSessionId(GetCurrentProcessId(), &session);
+    return "\\\\.\\pipe\\WindowManager-" + std::to_string(session);
+}
+
+bool CommandServer::start(const std::string& endpoint, Callback pending, void* context) {
+    stop();
+    HANDLE pipe = createPipeInstance(widen(endpoint), true);
+    if (pipe == INVALID_HANDLE_VALUE) return false;
+
+    m_endpoint = endpoint;
+    m_pending = pending;
+    m_context = context;
+    m_listenHandle = reinterpret_cast<std::intptr_t>(pipe);
+    m_stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    m_listenThread = std::thread([this] { listen(); });
+    return true;
+}
+
+void CommandServer::listen() {
+    const std::wstring name = widen(m_endpoint);
+    HANDLE event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+    while (true) {
+        HANDLE pipe = reinterpret_cast<HANDLE>(m_listenHandle);
+        OVERLAPPED overlapped = {};
+        overlapped.hEvent = event;
+        ResetEvent(event);
+        bool connected = ConnectNamedPipe(pipe, &overlapped) != FALSE;
+        if (!connected) {
+            const DWORD error = GetLastError();
+            DWORD transferred = 0;
+            if (error == ERROR_IO_PENDING) {
+                connected = waitIo(pipe, overlapped, static_cast<HANDLE>(m_stopEvent), transferred);
+            } else {
+                connected = error == ERROR_PIPE_CONNECTED;
+            }
+        }
+        if (WaitForSingleObject(static_cast<HANDLE>(m_stopEvent), 0) == WAIT_OBJECT_0) break;
+        if (!connected) {
+            DisconnectNamedPipe(pipe);
+            continue;
+        }
+
+        // 연결된 인스턴스는 연결 스레드로 넘기고 다음 클라이언트용 인스턴스를 만든다
+        HANDLE next = createPipeInstance(name, false);
+        addConnection(reinterpret_cast<std::intptr_t>(pipe));
+        m_listenHandle = reinterpret_cast<std::intptr_t>(next);
+        if (next == INVALID_HANDLE_VALUE) break;
+    }
+    CloseHandle(event);
+}
+
+long CommandServer::readSome(Connection& connection, char* data, size_t size) {
+    HANDLE pipe = reinterpret_cast<HANDLE>(connection.handle);
+    OVERLAPPED overlapped = {};
+    overlapped.hEvent = static_cast<HANDLE>(connection.event);
+    ResetEvent(overlapped.hEvent);
+    DWORD transferred = 0;
+    if (!ReadFile(pipe, data, static_cast<DWORD>(size), &transferred, &overlapped)) {
+        if (GetLastError() != ERROR_IO_PENDING) return -1;
+        if (!waitIo(pipe, overlapped, static_cast<HANDLE>(m_stopEvent), transferred)) return -1;
+    } else if (!GetOverlappedResult(pipe, &overlapped, &transferred, FALSE)) {
+        return -1;
+    }
+    return static_cast<long>(transferred);
+}
+
+bool CommandServer::writeAll(Connection& connection, const char* data, size_t size) {
+    HANDLE pipe = reinterpret_cast<HANDLE>(connection.handle);
+    while (size > 0) {
+        OVERLAPPED overlapped = {};
+        overlapped.hEvent = static_cast<HANDLE>(connection.event);
+        ResetEvent(overlapped.hEvent);
+        DWORD transferred = 0;
+        if (!WriteFile(pipe, data, static_cast<DWORD>(size), &transferred, &overlapped)) {
+            if (GetLastError() != ERROR_IO_PENDING) return false;
+            if (!waitIo(pipe, overlapped, static_cast<HANDLE>(m_stopEvent), transferred)) return false;
+        } else if (!GetOverlappedResult(pipe, &overlapped, &transferred, FALSE)) {
+            return false;
+        }
+        data += transferred;
+        size -= transferred;
+    }
+    return true;
+}
+
+void CommandServer::hangUp(Connection& connection) {
+    DisconnectNamedPipe(reinterpret_cast<HANDLE>(connection.handle));
+}
+
+void CommandServer::closeConnection(Connection& connection) {
+    HANDLE pipe = reinterpret_cast<HANDLE>(connection.handle);
+    CloseHandle(pipe);
+    CloseHandle(static_cast<HANDLE>(connection.event));
+    connection.handle = -1;
+    connection.event = nullptr;
+}
+
+void CommandServer::interrupt() {
+    // 모든 대기 (ConnectNamedPipe, 연결별 ReadFile/WriteFile) 가 이 이벤트로 깨어난다
+    SetEvent(static_cast<HANDLE>(m_stopEvent));
+}
+
+bool CommandClient::connect(const std::string& endpoint) {
+    close();
+    const std::wstring name = widen(endpoint);
+    for (int attempt = 0; attempt < 10; ++attempt) {
+        HANDLE pipe = CreateFileW(name.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+        if (pipe != INVALID_HANDLE_VALUE) {
+            m_handle = reinterpret_cast<std::intptr_t>(pipe);
+            m_received.clear();
+            return true;
+        }
+        // 모든 인스턴스가 사용 중 - 서버가 다음 인스턴스를 만들 때까지
+        if (GetLastError() != ERROR_PIPE_BUSY || !WaitNamedPipeW(name.c_str(), 1000)) return false;
+    }
+    return false;
+}
+
+void CommandClient::close() {
+    if (m_handle != -1) CloseHandle(reinterpret_cast<HANDLE>(m_handle));
+    m_handle = -1;
+}
+
+bool CommandClient::send(const char* data, size_t size) {
+    while (size > 0) {
+        DWORD written = 0;
+        if (!WriteFile(reinterpret_cast<HANDLE>(m_handle), data, static_cast<DWORD>(size), &written, nullptr)) {
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+long CommandClient::receive(char* data, size_t size) {
+    DWORD read = 0;
+    if (!ReadFile(reinterpret_cast<HANDLE>(m_handle), data, static_cast<DWORD>(size), &read, nullptr)) return -1;
+    return static_cast<long>(read);
+}
+
+#else
+
+// Linux 테스트/벤치마크용: 이름 있는 파이프 대신 같은 프로토콜을 Unix 도메인 소켓으로
+static bool socketAddress(const std::string& endpoint, sockaddr_un& address) {
+    address = {};
+    address.sun_family = AF_UNIX;
+    if (endpoint.empty() || endpoint.size() >= sizeof(address.sun_path)) return false;
+    endpoint.copy(address.sun_path, endpoint.size());
+    return true;
+}
+
+std::string CommandServer::defaultEndpoint() {
+    const char* runtime = std::getenv("XDG_RUNTIME_DIR");
+    if (runtime && *runtime) return std::string(runtime) + "/windowmanager.sock";
+    return "/tmp/windowmanager-" + std::to_string(::getuid()) + ".sock";
+}
+
+bool CommandServer::start(const std::string& endpoint, Callback pending, void* context) {
+    stop();
+    sockaddr_un address;
+    if (!socketAddress(endpoint, address)) return false;
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+    // 이전 실행이 남긴 소켓 파일
+    ::unlink(endpoint.c_str());
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::chmod(endpoint.c_str(), 0600) != 0 || ::listen(fd, 16) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    m_endpoint = endpoint;
+    m_pending = pending;
+    m_context = context;
+    m_listenHandle = fd;
+    m_listenThread = std::thread([this] { listen(); });
+    return true;
+}
+
+void CommandServer::listen() {
+    while (true) {
+        const int fd = ::accept4(static_cast<int>(m_listenHandle), nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;
+        }
+        if (!addConnection(fd)) break;
+    }
+}
+
+long CommandServer::readSome(Connection& connection, char* data, size_t size) {
+    while (true) {
+        const ssize_t received = ::recv(static_cast<int>(connection.handle), data, size, 0);
+        if (received >= 0 || errno != EINTR) return static_cast<long>(received);
+    }
+}
+
+bool CommandServer::writeAll(Connection& connection, const char* data, size_t size) {
+    while (size > 0) {
+        const ssize_t sent = ::send(static_cast<int>(connection.handle), data, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+void CommandServer::hangUp(Connection& connection) {
+    ::shutdown(static_cast<int>(connection.handle), SHUT_RDWR);
+}
+
+void CommandServer::closeConnection(Connection& connection) {
+    ::close(static_cast<int>(connection.handle));
+    connection.handle = -1;
+}
+
+void CommandServer::interrupt() {
+    // shutdown 은 막혀 있는 accept/recv 를 깨운다 (닫기는 스레드가 끝난 뒤)
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ::shutdown(static_cast<int>(m_listenHandle), SHUT_RDWR);
+    for (Connection& connection : m_connections) ::shutdown(static_cast<int>(connection.handle), SHUT_RDWR);
+}
+
+bool CommandClient::connect(const std::string& endpoint) {
+    close();
+    sockaddr_un address;
+    if (!socketAddress(endpoint, address)) return false;
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return false;
+    }
+    m_handle = fd;
+    m_received.clear();
+    return true;
+}
+
+void CommandClient::close() {
+    if (m_handle != -1) ::close(static_cast<int>(m_handle));
+    m_handle = -1;
+}
+
+bool CommandClient::send(const char* data, size_t size) {
+    while (size > 0) {
+        const ssize_t sent = ::send(static_cast<int>(m_handle), data, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+long CommandClient::receive(char* data, size_t size) {
+    while (true) {
+        const ssize_t received = ::recv(static_cast<int>(m_handle), data, size, 0);
+        if (received >= 0 || errno != EINTR) return static_cast<long>(received);
+    }
+}
+
+#endif
@@ -0,0 +1,583 @@
+#include "config_store.h"
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+// ---- 파싱 ----
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static std::string_view trim(std::string_view text) {
+    while (!text.empty() && isSpace(text.front())) text.remove_prefix(1);
+    while (!text.empty() && isSpace(text.back())) text.remove_suffix(1);
+    return text;
+}
+
+static bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        char x = a[i], y = b[i];
+        if (x >= 'A' && x <= 'Z') x = static_cast<char>(x - 'A' + 'a');
+        if (y >= 'A' && y <= 'Z') y = static_cast<char>(y - 'A' + 'a');
+        if (x != y) return false;
+    }
+    return true;
+}
+
+// 공백으로 나뉜 값을 정확히 count 개 읽는다
+template <typename T>
+static bool parseValues(std::string_view text, T* out, int count) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    for (int i = 0; i < count; ++i) {
+        while (p < end && isSpace(*p)) ++p;
+        auto result = std::from_chars(p, end, out[i]);
+        if (result.ec != std::errc() || (result.ptr < end && !isSpace(*result.ptr))) return false;
+        p = result.ptr;
+    }
+    while (p < end && isSpace(*p)) ++p;
+    return p == end;
+}
+
+struct NamedKey {
+    const char* name;
+    std::uint8_t vk;
+};
+
+// Windows 가상 키 코드 (A~Z, 0~9 는 문자 코드 그대로)
+static const NamedKey kNamedKeys[] = {
+    {"left", 0x25}, {"up", 0x26}, {"right", 0x27}, {"down", 0x28},
+    {"enter", 0x0D}, {"space", 0x20}, {"tab", 0x09}, {"esc", 0x1B}, {"backspace", 0x08},
+    {"home", 0x24}, {"end", 0x23}, {"pageup", 0x21}, {"pagedown", 0x22},
+    {"insert", 0x2D}, {"delete", 0x2E},
+};
+
+static bool parseKeyName(std::string_view name, std::uint8_t& vk) {
+    if (name.size() == 1) {
+        char c = name[0];
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+            vk = static_cast<std::uint8_t>(c);
+            return true;
+        }
+        return false;
+    }
+    for (const auto& key : kNamedKeys) {
+        if (equalsIgnoreCase(name, key.name)) {
+            vk = key.vk;
+            return true;
+        }
+    }
+    // f1~f24, num0~num9
+    int number = 0;
+    if ((name[0] == 'f' || name[0] == 'F') &&
+        std::from_chars(name.data() + 1, name.data() + name.size(), number).ptr == name.data() + name.size() &&
+        number >= 1 && number <= 24) {
+        vk = static_cast<std::uint8_t>(0x70 + number - 1);
+        return true;
+    }
+    if (name.size() == 4 && equalsIgnoreCase(name.substr(0, 3), "num") && name[3] >= '0' && name[3] <= '9') {
+        vk = static_cast<std::uint8_t>(0x60 + (name[3] - '0'));
+        return true;
+    }
+    return false;
+}
+
+bool parseKeyStroke(std::string_view text, KeyStroke& out) {
+    text = trim(text);
+    KeyStroke stroke;
+    while (!text.empty()) {
+        const size_t plus = text.find('+');
+        const std::string_view part = trim(text.substr(0, plus));
+        text = plus == std::string_view::npos ? std::string_view() : text.substr(plus + 1);
+        if (part.empty()) return false;
+
+        if (equalsIgnoreCase(part, "ctrl")) {
+            stroke.modifiers |= KeyModControl;
+        } else if (equalsIgnoreCase(part, "alt")) {
+            stroke.modifiers |= KeyModAlt;
+        } else if (equalsIgnoreCase(part, "shift")) {
+            stroke.modifiers |= KeyModShift;
+        } else if (equalsIgnoreCase(part, "win")) {
+            stroke.modifiers |= KeyModWin;
+        } else {
+            // 키는 마지막에 하나만
+            if (stroke.vk || !text.empty() || !parseKeyName(part, stroke.vk)) return false;
+        }
+    }
+    if (!stroke.vk) return false;
+    out = stroke;
+    return true;
+}
+
+static bool parseBinding(std::string_view text, KeyBinding& out) {
+    KeyBinding binding;
+    const size_t comma = text.find(',');
+    std::string_view first = trim(text.substr(0, comma));
+
+    // "... x2" 연속 입력 횟수
+    const size_t space = first.find_last_of(" \t");
+    if (space != std::string_view::npos) {
+        const std::string_view suffix = first.substr(space + 1);
+        int taps = 0;
+        if (suffix.size() < 2 || (suffix[0] != 'x' && suffix[0] != 'X') ||
+            std::from_chars(suffix.data() + 1, suffix.data() + suffix.size(), taps).ptr !=
+                suffix.data() + suffix.size() ||
+            taps < 1 || taps > 4) {
+            return false;
+        }
+        binding.taps = static_cast<std::uint8_t>(taps);
+        first = trim(first.substr(0, space));
+    }
+    if (!parseKeyStroke(first, binding.first)) return false;
+    if (comma != std::string_view::npos) {
+        if (binding.taps != 1 || !parseKeyStroke(text.substr(comma + 1), binding.second)) return false;
+    }
+    out = binding;
+    return true;
+}
+
+// "class=X; exe=y.exe; title=*foo*; float; slot=3; monitor=1; min=800x600"
+static bool parseRule(std::string_view text, WindowRuleConfig& out) {
+    WindowRuleConfig rule;
+    bool hasMatch = false, hasAction = false;
+    while (!text.empty()) {
+        const size_t semicolon = text.find(';');
+        const std::string_view part = trim(text.substr(0, semicolon));
+        text = semicolon == std::string_view::npos ? std::string_view() : text.substr(semicolon + 1);
+        if (part.empty()) continue;
+
+        const size_t equals = part.find('=');
+        const std::string_view name = trim(part.substr(0, equals));
+        const std::string_view value = equals == std::string_view::npos ? std::string_view() : trim(part.substr(equals + 1));
+        if (equals == std::string_view::npos) {
+            if (name == "ignore") {
+                rule.action |= RuleIgnore;
+            } else if (name == "float") {
+                rule.action |= RuleFloat;
+            } else {
+                return false;
+            }
+            hasAction = true;
+            continue;
+        }
+        if (value.empty()) return false;
+        if (name == "class") {
+            rule.className = std::string(value);
+            hasMatch = true;
+        } else if (name == "title") {
+            rule.titlePattern = std::string(value);
+            hasMatch = true;
+        } else if (name == "exe") {
+            rule.executable = std::string(value);
+            hasMatch = true;
+        } else if (name == "slot") {
+            if (!parseValues(value, &rule.slot, 1) || rule.slot < 0 || rule.slot > 8) return false;
+            hasAction = true;
+        } else if (name == "monitor") {
+            if (!parseValues(value, &rule.monitor, 1) || rule.monitor < 0) return false;
+            hasAction = true;
+        } else if (name == "min") {
+            const size_t x = value.find_first_of("xX");
+            if (x == std::string_view::npos || !parseValues(value.substr(0, x), &rule.minWidth, 1) ||
+                !parseValues(value.substr(x + 1), &rule.minHeight, 1) || rule.minWidth < 0 || rule.minHeight < 0) {
+                return false;
+            }
+            hasAction = true;
+        } else {
+            return false;
+        }
+    }
+    // 모든 창에 걸리는 규칙이나 아무것도 안 하는 규칙은 실수로 본다
+    if (!hasMatch || !hasAction) return false;
+    out = std::move(rule);
+    return true;
+}
+
+// "monitor=1; 0 0 500 1000" 또는 "monitor=1; merge=0 1"
+// existing 은 앞서 읽은 zone 들 (merge 는 같은 모니터의 앞선 zone 만 가리킬 수 있다)
+static bool parseZone(std::string_view text, const std::vector<ZoneConfig>& existing, ZoneConfig& out) {
+    ZoneConfig zone;
+    bool hasRect = false;
+    while (!text.empty()) {
+        const size_t semicolon = text.find(';');
+        const std::string_view part = trim(text.substr(0, semicolon));
+        text = semicolon == std::string_view::npos ? std::string_view() : text.substr(semicolon + 1);
+        if (part.empty()) continue;
+
+        const size_t equals = part.find('=');
+        if (equals == std::string_view::npos) {
+            int values[4];
+            if (hasRect || !parseValues(part, values, 4)) return false;
+            zone.rect = {values[0], values[1], values[2], values[3]};
+            hasRect = true;
+            continue;
+        }
+        const std::string_view name = trim(part.substr(0, equals));
+        std::string_view value = trim(part.substr(equals + 1));
+        if (name == "monitor") {
+            if (!parseValues(value, &zone.monitor, 1) || zone.monitor < 0) return false;
+        } else if (name == "merge") {
+            while (!value.empty()) {
+                const size_t space = value.find_first_of(" \t");
+                int member;
+                if (!parseValues(value.substr(0, space), &member, 1) || member < 0) return false;
+                zone.merge.push_back(member);
+                value = space == std::string_view::npos ? std::string_view() : trim(value.substr(space));
+            }
+        } else {
+            return false;
+        }
+    }
+
+    if (hasRect == !zone.merge.empty()) return false;
+    if (hasRect) {
+        const Rect& r = zone.rect;
+        if (r.left < 0 || r.top < 0 || r.right > 1000 || r.bottom > 1000 || r.empty()) return false;
+    } else {
+        int count = 0;
+        for (const auto& previous : existing) {
+            if (previous.monitor == zone.monitor) ++count;
+        }
+        if (zone.merge.size() < 2) return false;
+        for (int member : zone.merge) {
+            if (member >= count) return false;
+        }
+    }
+    out = std::move(zone);
+    return true;
+}
+
+// "monitor=1; bsp; gap=8" 또는 "master; master=0.6; masters=2"
+static bool parseTiling(std::string_view text, TilingConfig& out) {
+    TilingConfig tiling;
+    bool hasMode = false;
+    while (!text.empty()) {
+        const size_t semicolon = text.find(';');
+        const std::string_view part = trim(text.substr(0, semicolon));
+        text = semicolon == std::string_view::npos ? std::string_view() : text.substr(semicolon + 1);
+        if (part.empty()) continue;
+
+        const size_t equals = part.find('=');
+        if (equals == std::string_view::npos) {
+            if (hasMode) return false;
+            if (part == "off") {
+                tiling.options.mode = TilingMode::Off;
+            } else if (part == "bsp") {
+                tiling.options.mode = TilingMode::Bsp;
+            } else if (part == "master") {
+                tiling.options.mode = TilingMode::MasterStack;
+            } else if (part == "columns") {
+                tiling.options.mode = TilingMode::Columns;
+            } else {
+                return false;
+            }
+            hasMode = true;
+            continue;
+        }
+        const std::string_view name = trim(part.substr(0, equals));
+        const std::string_view value = trim(part.substr(equals + 1));
+        TilingOptions& options = tiling.options;
+        if (name == "monitor") {
+            if (!parseValues(value, &tiling.monitor, 1) || tiling.monitor < 0) return false;
+        } else if (name == "gap") {
+            if (!parseValues(value, &options.gap, 1) || options.gap < 0 || options.gap > 200) return false;
+        } else if (name == "master") {
+            if (!parseValues(value, &options.masterRatio, 1) ||
+                !(options.masterRatio >= 0.1f && options.masterRatio <= 0.9f)) {
+                return false;
+            }
+        } else if (name == "masters") {
+            if (!parseValues(value, &options.masterCount, 1) || options.masterCount < 1 || options.masterCount > 16) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    if (!hasMode) return false;
+    out = tiling;
+    return true;
+}
+
+// "12 12" 또는 "monitor=1; 4 6" (행 열은 1~64). 모니터를 적지 않았으면 monitor 는 -1
+static bool parseGrid(std::string_view text, MonitorGridConfig& out) {
+    MonitorGridConfig grid;
+    grid.monitorIndex = -1;
+    bool hasSize = false;
+    while (!text.empty()) {
+        const size_t semicolon = text.find(';');
+        const std::string_view part = trim(text.substr(0, semicolon));
+        text = semicolon == std::string_view::npos ? std::string_view() : text.substr(semicolon + 1);
+        if (part.empty()) continue;
+
+        const size_t equals = part.find('=');
+        if (equals == std::string_view::npos) {
+            int size[2];
+            if (hasSize || !parseValues(part, size, 2)) return false;
+            grid.rows = size[0];
+            grid.cols = size[1];
+            hasSize = true;
+            continue;
+        }
+        if (trim(part.substr(0, equals)) != "monitor" || grid.monitorIndex >= 0) return false;
+        if (!parseValues(trim(part.substr(equals + 1)), &grid.monitorIndex, 1) || grid.monitorIndex < 0) return false;
+    }
+    if (!hasSize || grid.rows < 1 || grid.rows > 64 || grid.cols < 1 || grid.cols > 64) return false;
+    out = grid;
+    return true;
+}
+
+static bool fail(ConfigError& error, int line, const char* message) {
+    error.line = line;
+    error.message = message;
+    return false;
+}
+
+bool parseConfigText(std::string_view text, const std::vector<ConfigActionName>& actions,
+                     const ConfigSnapshot& base, ConfigSnapshot& out, ConfigError& error) {
+    out = base;
+    out.bindings.clear();
+    out.ruleMatcher = nullptr;
+    out.zones.clear();
+    out.tiling.clear();
+    out.monitorGrids.clear();
+
+    int lineNumber = 0;
+    while (!text.empty()) {
+        const size_t newline = text.find('\n');
+        std::string_view line = text.substr(0, newline);
+        text = newline == std::string_view::npos ? std::string_view() : text.substr(newline + 1);
+        ++lineNumber;
+
+        const size_t hash = line.find('#');
+        if (hash != std::string_view::npos) line = line.substr(0, hash);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        const size_t equals = line.find('=');
+        if (equals == std::string_view::npos) return fail(error, lineNumber, "'=' 가 없습니다");
+        const std::string_view key = trim(line.substr(0, equals));
+        const std::string_view value = trim(line.substr(equals + 1));
+
+        if (key == "grid") {
+            MonitorGridConfig grid;
+            if (!parseGrid(value, grid)) {
+                return fail(error, lineNumber, "grid 는 '행 열' 또는 'monitor=N; 행 열' (1~64)");
+            }
+            if (grid.monitorIndex < 0) {
+                out.rows = grid.rows;
+                out.cols = grid.cols;
+            } else {
+                // 같은 모니터를 다시 적으면 뒤의 것이 이긴다
+                bool replaced = false;
+                for (auto& existing : out.monitorGrids) {
+                    if (existing.monitorIndex == grid.monitorIndex) {
+                        existing = grid;
+                        replaced = true;
+                    }
+                }
+                if (!replaced) out.monitorGrids.push_back(grid);
+            }
+        } else if (key == "opacity") {
+            float opacity;
+            if (!parseValues(value, &opacity, 1) || !(opacity >= 0.0f && opacity <= 1.0f)) {
+                return fail(error, lineNumber, "opacity 는 0~1");
+            }
+            out.opacity = opacity;
+        } else if (key == "grid_visible") {
+            int visible;
+            if (!parseValues(value, &visible, 1) || (visible != 0 && visible != 1)) {
+                return fail(error, lineNumber, "grid_visible 은 0 또는 1");
+            }
+            out.gridVisible = visible != 0;
+        } else if (key == "animation_ms") {
+            int ms;
+            if (!parseValues(value, &ms, 1) || ms < 0 || ms > 1000) {
+                return fail(error, lineNumber, "animation_ms 는 0~1000");
+            }
+            out.animationMs = ms;
+        } else if (key == "zone") {
+            ZoneConfig zone;
+            if (!parseZone(value, out.zones, zone)) return fail(error, lineNumber, "잘못된 zone");
+            out.zones.push_back(std::move(zone));
+        } else if (key == "zone_gap" || key == "zone_span") {
+            int dip;
+            if (!parseValues(value, &dip, 1) || dip < 0 || dip > 200) {
+                return fail(error, lineNumber, "zone_gap/zone_span 은 0~200");
+            }
+            (key == "zone_gap" ? out.zoneGap : out.zoneSpan) = dip;
+        } else if (key == "tiling") {
+            TilingConfig tiling;
+            if (!parseTiling(value, tiling)) return fail(error, lineNumber, "잘못된 tiling");
+            // 같은 모니터를 다시 적으면 뒤의 것이 이긴다
+            bool replaced = false;
+            for (auto& existing : out.tiling) {
+                if (existing.monitor == tiling.monitor) {
+                    existing = tiling;
+                    replaced = true;
+                }
+            }
+            if (!replaced) out.tiling.push_back(tiling);
+        } else if (key.substr(0, 5) == "bind " || key.substr(0, 5) == "bind\t") {
+            const std::string_view name = trim(key.substr(5));
+            const ConfigActionName* action = nullptr;
+            for (const auto& candidate : actions) {
+                if (name == candidate.name) action = &candidate;
+            }
+            if (!action) return fail(error, lineNumber, "알 수 없는 동작");
+
+            KeyBinding binding;
+            if (!parseBinding(value, binding)) return fail(error, lineNumber, "잘못된 키 입력");
+            binding.id = action->id;
+            // 같은 동작을 다시 적으면 뒤의 것이 이긴다
+            bool replaced = false;
+            for (auto& existing : out.bindings) {
+                if (existing.id == binding.id) {
+                    existing = binding;
+                    replaced = true;
+                }
+            }
+            if (!replaced) out.bindings.push_back(binding);
+        } else if (key == "rule") {
+            WindowRuleConfig rule;
+            if (!parseRule(value, rule)) return fail(error, lineNumber, "잘못된 창 규칙");
+            out.rules.push_back(std::move(rule));
+        } else {
+            return fail(error, lineNumber, "알 수 없는 항목");
+        }
+    }
+    return true;
+}
+
+// ---- 게시 ----
+
+ConfigStore::ConfigStore() {
+    publish(m_defaults);
+}
+
+ConfigStore::~ConfigStore() = default;
+
+void ConfigStore::setActions(std::vector<ConfigActionName> actions) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    m_actions = std::move(actions);
+}
+
+void ConfigStore::setDefaults(const ConfigSnapshot& defaults) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    m_defaults = defaults;
+}
+
+void ConfigStore::publish(const ConfigSnapshot& snapshot) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    publishLocked(snapshot);
+}
+
+void ConfigStore::publishLocked(const ConfigSnapshot& snapshot) {
+    auto next = std::make_unique<ConfigSnapshot>(snapshot);
+    next->version = m_nextVersion++;
+    // 규칙은 바뀔 때만 다시 컴파일 (읽는 쪽은 게시된 것을 그대로 쓴다)
+    if (!next->ruleMatcher) {
+        auto matcher = std::make_shared<CompiledWindowRules>();
+        matcher->compile(next->rules);
+        next->ruleMatcher = std::move(matcher);
+    }
+    m_current.store(next.get(), std::memory_order_seq_cst);
+    if (m_owned) m_retired.push_back(std::move(m_owned));
+    m_owned = std::move(next);
+}
+
+bool ConfigStore::reload(std::string_view text) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    ConfigSnapshot parsed;
+    ConfigError error;
+    if (!parseConfigText(text, m_actions, m_defaults, parsed, error)) {
+        m_lastError = error;
+        m_failedReloads.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_lastError = ConfigError();
+    publishLocked(parsed);
+    return true;
+}
+
+bool ConfigStore::reloadFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_lastError = {0, "설정 파일을 열 수 없습니다"};
+        m_failedReloads.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return reload(text);
+}
+
+void ConfigStore::reclaim() {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    if (m_retired.empty()) return;
+
+    // 두 번 뒤집으며 각 카운터가 비기를 기다린다.
+    // 교체 전에 포인터를 읽은 읽기는 어느 쪽 카운터에 있든 이 사이에 끝난다.
+    for (int pass = 0; pass < 2; ++pass) {
+        const std::uint32_t old = m_epoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+        while (m_readers[old].load(std::memory_order_acquire) != 0) std::this_thread::yield();
+    }
+    m_retired.clear();
+}
+
+ConfigError ConfigStore::lastError() const {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    return m_lastError;
+}
+
+size_t ConfigStore::retiredCount() const {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    return m_retired.size();
+}
+
+// ---- 다시 읽기 스레드 ----
+
+bool ConfigReloader::start(ConfigStore& store, const std::filesystem::path& path, Callback callback,
+                           void* context, bool loadNow) {
+    stop();
+    if (!m_watcher.start(path)) return false;
+    m_store = &store;
+    m_path = path;
+    m_callback = callback;
+    m_context = context;
+    m_loadNow = loadNow;
+    m_running.store(true, std::memory_order_release);
+    m_worker = std::thread(&ConfigReloader::run, this);
+    return true;
+}
+
+void ConfigReloader::stop() {
+    m_running.store(false, std::memory_order_release);
+    if (m_worker.joinable()) m_worker.join();
+    m_watcher.stop();
+}
+
+void ConfigReloader::run() {
+    std::error_code ec;
+    if (m_loadNow && std::filesystem::exists(m_path, ec)) reload();
+
+    while (m_running.load(std::memory_order_acquire)) {
+        // 짧게 기다려서 stop 이 오래 막히지 않게 한다
+        if (!m_watcher.wait(100)) continue;
+        // 저장이 여러 번의 쓰기로 나뉘는 경우가 있어 잠깐 조용해질 때까지 기다린다
+        while (m_running.load(std::memory_order_acquire) && m_watcher.wait(30)) {}
+        reload();
+    }
+}
+
+void ConfigReloader::reload() {
+    const bool ok = m_store->reloadFile(m_path);
+    m_store->reclaim();
+    m_reloads.fetch_add(1, std::memory_order_relaxed);
+    if (m_callback) m_callback(ok, m_context);
+}
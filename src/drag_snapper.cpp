@@ -0,0 +1,145 @@
+#include "drag_snapper.h"
+#include <algorithm>
+
+void GridLines::build(const Rect& workArea, int rows, int cols) {
+    rows = std::max(rows, 1);
+    cols = std::max(cols, 1);
+    m_xs.resize(cols + 1);
+    m_ys.resize(rows + 1);
+    const long long width = workArea.width();
+    const long long height = workArea.height();
+    for (int i = 0; i <= cols; ++i) m_xs[i] = workArea.left + static_cast<int>(width * i / cols);
+    for (int i = 0; i <= rows; ++i) m_ys[i] = workArea.top + static_cast<int>(height * i / rows);
+}
+
+int GridLines::nearest(const std::vector<int>& lines, int value) {
+    // 분기 없는 이진 탐색: base 는 value 이하인 마지막 선 (없으면 첫 선)
+    const int* base = lines.data();
+    size_t count = lines.size();
+    while (count > 1) {
+        size_t half = count / 2;
+        base = base[half] <= value ? base + half : base;
+        count -= half;
+    }
+    if (value <= base[0] || base == &lines.back()) return base[0];
+    return (value - base[0]) < (base[1] - value) ? base[0] : base[1];
+}
+
+void DragSnapper::configure(const MonitorTopology& topology, int rows, int cols,
+                            const std::vector<MonitorGridConfig>& monitors) {
+    if (m_topology == &topology && m_generation == topology.generation() &&
+        m_rows == rows && m_cols == cols && m_monitorGrids == monitors) return;
+
+    m_topology = &topology;
+    m_generation = topology.generation();
+    m_rows = rows;
+    m_cols = cols;
+    m_monitorGrids = monitors;
+    m_lines.resize(topology.size());
+    for (int i = 0; i < topology.size(); ++i) {
+        int monitorRows = rows, monitorCols = cols;
+        monitorGridSize(monitors, i, monitorRows, monitorCols);
+        m_lines[i].build(topology.monitor(i).workArea, monitorRows, monitorCols);
+    }
+}
+
+void DragSnapper::configureZones(const std::vector<ZoneConfig>& zones, int gapDip, int spanDip,
+                                 std::uint64_t version) {
+    if (!m_topology) return;
+    if (m_zoneVersion == version && m_zoneGeneration == m_generation && m_zones.size() == m_lines.size()) return;
+
+    m_zoneVersion = version;
+    m_zoneGeneration = m_generation;
+    m_zones.resize(m_topology->size());
+    for (int i = 0; i < m_topology->size(); ++i) {
+        const MonitorInfo& monitor = m_topology->monitor(i);
+        m_zones[i].build(zones, i, monitor.workArea, monitor.dpi, gapDip, spanDip);
+    }
+}
+
+const ZoneLayout* DragSnapper::zonesFor(int monitorIndex) const {
+    if (monitorIndex < 0 || monitorIndex >= static_cast<int>(m_zones.size())) return nullptr;
+    return &m_zones[monitorIndex];
+}
+
+bool DragSnapper::snapRect(const Rect& windowRect, Point pt, Rect& out) {
+    if (!m_topology) return false;
+    const int monitorIndex = m_topology->monitorFromPoint(pt);
+
+    // zone 이 있으면 미리 컴파일한 판정 표에서 찾는다 (할당 없음)
+    if (const ZoneLayout* zones = zonesFor(monitorIndex)) {
+        const int hit = zones->hitTest(pt);
+        if (hit >= 0) {
+            out = zones->target(hit);
+            ++m_stats.zoneHits;
+            return true;
+        }
+    }
+
+    GridLines* lines = linesFor(monitorIndex);
+    if (!lines) return false;
+
+    int x = lines->snapX(pt.x);
+    int y = lines->snapY(pt.y);
+    out = {x, y, x + windowRect.width(), y + windowRect.height()};
+    return true;
+}
+
+void DragSnapper::begin(WindowId window, const Rect& windowRect, Point pt, std::int64_t nowNs) {
+    m_active = true;
+    m_window = window;
+    m_start = windowRect;
+    m_preview = windowRect;
+    m_hasPending = false;
+
+    // 포인터가 있는 모니터의 주사율에 맞춘다
+    unsigned hz = 60;
+    if (m_topology) {
+        int index = m_topology->monitorFromPoint(pt);
+        if (index >= 0 && m_topology->monitor(index).refreshHz > 0) hz = m_topology->monitor(index).refreshHz;
+    }
+    m_frameIntervalNs = 1'000'000'000LL / hz;
+    m_lastFrameNs = nowNs - m_frameIntervalNs;
+    addSample(pt, nowNs);
+}
+
+bool DragSnapper::addSample(Point pt, std::int64_t nowNs) {
+    if (!m_active) return false;
+    ++m_stats.samples;
+    m_pending = pt;
+    m_hasPending = true;
+    if (nowNs - m_lastFrameNs < m_frameIntervalNs) return false;
+    return processFrame(nowNs);
+}
+
+bool DragSnapper::flush(std::int64_t nowNs) {
+    if (!m_active || !m_hasPending) return false;
+    return processFrame(nowNs);
+}
+
+bool DragSnapper::processFrame(std::int64_t nowNs) {
+    m_hasPending = false;
+    m_lastFrameNs = nowNs;
+    ++m_stats.frames;
+
+    Rect target;
+    if (!snapRect(m_start, m_pending, target) || target == m_preview) return false;
+    m_preview = target;
+    ++m_stats.previewUpdates;
+    return true;
+}
+
+bool DragSnapper::end(Rect& target) {
+    if (!m_active) return false;
+    if (m_hasPending) processFrame(m_lastFrameNs + m_frameIntervalNs);
+    m_active = false;
+    target = m_preview;
+    if (target == m_start) return false;
+    ++m_stats.moves;
+    return true;
+}
+
+void DragSnapper::cancel() {
+    m_active = false;
+    m_hasPending = false;
+}
@@ -0,0 +1,47 @@
+#include "event_arena.h"
+
+static size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+EventArena::EventArena(size_t capacity) : m_capacity(capacity) {
+    if (capacity) m_block.reset(new unsigned char[capacity]);
+    m_overflow.reserve(8);
+    m_overflowSizes.reserve(8);
+}
+
+void* EventArena::allocate(size_t bytes, size_t alignment) {
+    if (bytes == 0) bytes = 1;
+    // 덩어리 시작은 max_align_t 정렬이므로 오프셋만 맞추면 된다
+    const size_t offset = alignUp(m_used, alignment);
+    if (m_block && offset + bytes <= m_capacity) {
+        m_used = offset + bytes;
+        if (used() > m_peak) m_peak = used();
+        return m_block.get() + offset;
+    }
+
+    // 넘침: 이번 이벤트 동안만 따로 빌린다
+    ++m_overflows;
+    const size_t size = bytes + alignment;
+    m_overflow.emplace_back(new unsigned char[size]);
+    m_overflowSizes.push_back(size);
+    m_overflowBytes += size;
+    if (used() > m_peak) m_peak = used();
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_overflow.back().get());
+    return reinterpret_cast<void*>(alignUp(base, alignment));
+}
+
+void EventArena::rewind(const Mark& mark) {
+    while (m_overflow.size() > mark.blocks) {
+        m_overflowBytes -= m_overflowSizes.back();
+        m_overflow.pop_back();
+        m_overflowSizes.pop_back();
+    }
+    m_used = mark.used;
+
+    // 다 비었을 때 최대 사용량이 덩어리보다 컸으면 그만큼 키운다 (다음부터는 넘치지 않는다)
+    if (m_used == 0 && m_overflow.empty() && m_peak > m_capacity) {
+        m_capacity = alignUp(m_peak, 4096);
+        m_block.reset(new unsigned char[m_capacity]);
+    }
+}
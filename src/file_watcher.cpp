@@ -0,0 +1,120 @@
+#include "file_watcher.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+static long long lastWriteTime(const std::filesystem::path& path) {
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &data)) return 0;
+    return (static_cast<long long>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+}
+
+bool FileWatcher::start(const std::filesystem::path& file) {
+    stop();
+    m_file = file;
+    const std::filesystem::path dir = file.has_parent_path() ? file.parent_path() : std::filesystem::current_path();
+    HANDLE handle = FindFirstChangeNotificationW(
+        dir.c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+    m_handle = handle;
+    m_lastWrite = lastWriteTime(file);
+    return true;
+}
+
+void FileWatcher::stop() {
+    if (m_handle) FindCloseChangeNotification(static_cast<HANDLE>(m_handle));
+    m_handle = nullptr;
+}
+
+bool FileWatcher::isWatching() const {
+    return m_handle != nullptr;
+}
+
+bool FileWatcher::wait(int timeoutMs) {
+    if (!m_handle) return false;
+    if (WaitForSingleObject(static_cast<HANDLE>(m_handle), static_cast<DWORD>(timeoutMs)) != WAIT_OBJECT_0) {
+        return false;
+    }
+    FindNextChangeNotification(static_cast<HANDLE>(m_handle));
+
+    // 디렉터리 단위 알림이라 다른 파일의 변경은 수정 시각으로 거른다
+    const long long lastWrite = lastWriteTime(m_file);
+    if (lastWrite == m_lastWrite) return false;
+    m_lastWrite = lastWrite;
+    return true;
+}
+
+#elif defined(__linux__)
+
+bool FileWatcher::start(const std::filesystem::path& file) {
+    stop();
+    m_file = file;
+    m_name = file.filename().string();
+    const std::filesystem::path dir = file.has_parent_path() ? file.parent_path() : std::filesystem::current_path();
+
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) return false;
+    m_watch = inotify_add_watch(m_fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE);
+    if (m_watch < 0) {
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void FileWatcher::stop() {
+    if (m_fd >= 0) ::close(m_fd);
+    m_fd = -1;
+    m_watch = -1;
+}
+
+bool FileWatcher::isWatching() const {
+    return m_fd >= 0;
+}
+
+bool FileWatcher::wait(int timeoutMs) {
+    if (m_fd < 0) return false;
+    pollfd descriptor{m_fd, POLLIN, 0};
+    if (poll(&descriptor, 1, timeoutMs) <= 0) return false;
+
+    // 쌓인 이벤트를 모두 읽고 대상 파일 이름이 있었는지만 본다
+    alignas(inotify_event) char buffer[4096];
+    bool changed = false;
+    while (true) {
+        const ssize_t length = ::read(m_fd, buffer, sizeof(buffer));
+        if (length <= 0) break;
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            if (event->len && m_name == event->name) changed = true;
+            offset += sizeof(inotify_event) + event->len;
+        }
+    }
+    return changed;
+}
+
+#else
+
+// 감시를 지원하지 않는 플랫폼 - 시작 시 한 번 읽은 설정만 사용
+bool FileWatcher::start(const std::filesystem::path& file) {
+    m_file = file;
+    return false;
+}
+
+void FileWatcher::stop() {}
+
+bool FileWatcher::isWatching() const {
+    return false;
+}
+
+bool FileWatcher::wait(int) {
+    return false;
+}
+
+#endif
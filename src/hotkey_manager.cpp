@@ -1,145 +1,299 @@
-#include "hotkey_manager.h"
-#include "window_manager.h"
-#include <sstream>
-
-HotkeyManager& HotkeyManager::getInstance() {
-    static HotkeyManager instance;
-    return instance;
-}
-
-HotkeyManager::HotkeyManager() : m_initialized(false) {
-    initializeDefaultHotkeys();
-}
-
-HotkeyManager::~HotkeyManager() {
-    cleanup();
-}
-
-void HotkeyManager::initializeDefaultHotkeys() {
-    // 기본 단축키 설정을 MOD_NOREPEAT 플래그 추가
-    m_hotkeyMap[HotkeyId::SnapLeft] = {MOD_WIN | MOD_NOREPEAT, VK_LEFT};
-    m_hotkeyMap[HotkeyId::SnapRight] = {MOD_WIN | MOD_NOREPEAT, VK_RIGHT};
-    m_hotkeyMap[HotkeyId::SnapTop] = {MOD_WIN | MOD_NOREPEAT, VK_UP};
-    m_hotkeyMap[HotkeyId::SnapBottom] = {MOD_WIN | MOD_NOREPEAT, VK_DOWN};
-
-    // 모서리/중앙 정렬 단축키
-    m_hotkeyMap[HotkeyId::SnapTopLeft] = {MOD_WIN | MOD_SHIFT | MOD_NOREPEAT, VK_NUMPAD7};
-    m_hotkeyMap[HotkeyId::SnapTopRight] = {MOD_WIN | MOD_SHIFT | MOD_NOREPEAT, VK_NUMPAD9};
-    m_hotkeyMap[HotkeyId::SnapBottomLeft] = {MOD_WIN | MOD_SHIFT | MOD_NOREPEAT, VK_NUMPAD1};
-    m_hotkeyMap[HotkeyId::SnapBottomRight] = {MOD_WIN | MOD_SHIFT | MOD_NOREPEAT, VK_NUMPAD3};
-    m_hotkeyMap[HotkeyId::SnapCenter] = {MOD_WIN | MOD_SHIFT | MOD_NOREPEAT, VK_NUMPAD5};
-
-    // 기타 기능키 - 충돌 가능성이 적은 키 조합으로 변경
-    m_hotkeyMap[HotkeyId::ToggleGrid] = {MOD_ALT | MOD_NOREPEAT, 'G'};
-    m_hotkeyMap[HotkeyId::ResetWindow] = {MOD_ALT | MOD_NOREPEAT, 'R'};
-}
-
-bool HotkeyManager::initialize() {
-    if (m_initialized) return true;
-    
-    // 이전에 등록된 핫키가 있다면 모두 해제
-    unregisterHotkeys();
-
-    // 핫키 등록 시도
-    bool success = true;
-    std::wstringstream errorMsg;
-    
-    for (const auto& [id, info] : m_hotkeyMap) {
-        if (!RegisterHotKey(NULL, static_cast<int>(id), info.modifiers, info.key)) {
-            DWORD error = GetLastError();
-            if (error == ERROR_HOTKEY_ALREADY_REGISTERED) {
-                // 이미 등록된 핫키는 건너뛰기
-                continue;
-            }
-            
-            success = false;
-            errorMsg << L"핫키 등록 실패 (ID: " << static_cast<int>(id) 
-                    << L", Error: " << error << L")\n";
-        }
-    }
-
-    if (!success) {
-        // 에러 메시지 표시
-        MessageBoxW(NULL, errorMsg.str().c_str(), L"HotkeyManager 초기화 실패", MB_OK | MB_ICONERROR);
-        unregisterHotkeys();
-        return false;
-    }
-
-    m_initialized = true;
-    return true;
-}
-
-void HotkeyManager::cleanup() {
-    if (!m_initialized) return;
-    
-    unregisterHotkeys();
-    m_initialized = false;
-}
-
-void HotkeyManager::unregisterHotkeys() {
-    for (const auto& [id, _] : m_hotkeyMap) {
-        UnregisterHotKey(NULL, static_cast<int>(id));
-    }
-}
-
-void HotkeyManager::handleHotkey(int id) {
-    auto& windowManager = WindowManager::getInstance();
-    HWND foregroundWindow = GetForegroundWindow();
-
-    if (!foregroundWindow) return;
-
-    switch (static_cast<HotkeyId>(id)) {
-        case HotkeyId::SnapLeft:
-            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::CenterLeft);
-            break;
-        case HotkeyId::SnapRight:
-            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::CenterRight);
-            break;
-        case HotkeyId::SnapTop:
-            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::TopCenter);
-            break;
-        case HotkeyId::SnapBottom:
-            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::BottomCenter);
-            break;
-        case HotkeyId::SnapTopLeft:
-            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::TopLeft);
-            break;
-        case HotkeyId::SnapTopRight:
-            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::TopRight);
-            break;
-        case HotkeyId::SnapBottomLeft:
-            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::BottomLeft);
-            break;
-        case HotkeyId::SnapBottomRight:
-            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::BottomRight);
-            break;
-        case HotkeyId::SnapCenter:
-            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::Center);
-            break;
-        case HotkeyId::ToggleGrid:
-            windowManager.toggleGrid();
-            break;
-        case HotkeyId::ResetWindow:
-            ShowWindow(foregroundWindow, SW_RESTORE);
-            break;
-    }
-}
-
-bool HotkeyManager::setHotkey(HotkeyId id, UINT modifiers, UINT key) {
-    if (!m_initialized) return false;
-
-    // 기존 핫키 해제
-    UnregisterHotKey(NULL, static_cast<int>(id));
-
-    // 새 핫키 등록
-    if (!RegisterHotKey(NULL, static_cast<int>(id), modifiers | MOD_NOREPEAT, key)) {
-        // 실패 시 기존 핫키 재등록
-        const auto& oldInfo = m_hotkeyMap[id];
-        RegisterHotKey(NULL, static_cast<int>(id), oldInfo.modifiers, oldInfo.key);
-        return false;
-    }
-
-    // 성공 시 맵 업데이트
-    m_hotkeyMap[id] = {modifiers | MOD_NOREPEAT, key};
-    return true;
-}
+#include "hotkey_manager.h"
+#include "window_manager.h"
+#include "win32_keyboard_hook.h"
+#include <algorithm>
+#include <cwchar>
+#include <iterator>
+
+HotkeyManager& HotkeyManager::getInstance() {
+    static HotkeyManager instance;
+    return instance;
+}
+
+HotkeyManager::HotkeyManager() : m_initialized(false) {
+    initializeDefaultHotkeys();
+}
+
+HotkeyManager::~HotkeyManager() {
+    cleanup();
+}
+
+void HotkeyManager::initializeDefaultHotkeys() {
+    // 기본 단축키 설정을 MOD_NOREPEAT 플래그 추가
+    m_hotkeyMap[HotkeyId::SnapLeft] = {MOD_WIN | MOD_NOREPEAT, VK_LEFT};
+    m_hotkeyMap[HotkeyId::SnapRight] = {MOD_WIN | MOD_NOREPEAT, VK_RIGHT};
+    m_hotkeyMap[HotkeyId::SnapTop] = {MOD_WIN | MOD_NOREPEAT, VK_UP};
+    m_hotkeyMap[HotkeyId::SnapBottom] = {MOD_WIN | MOD_NOREPEAT, VK_DOWN};
+
+    // 모서리/중앙 정렬 단축키
+    m_hotkeyMap[HotkeyId::SnapTopLeft] = {MOD_WIN | MOD_SHIFT | MOD_NOREPEAT, VK_NUMPAD7};
+    m_hotkeyMap[HotkeyId::SnapTopRight] = {MOD_WIN | MOD_SHIFT | MOD_NOREPEAT, VK_NUMPAD9};
+    m_hotkeyMap[HotkeyId::SnapBottomLeft] = {MOD_WIN | MOD_SHIFT | MOD_NOREPEAT, VK_NUMPAD1};
+    m_hotkeyMap[HotkeyId::SnapBottomRight] = {MOD_WIN | MOD_SHIFT | MOD_NOREPEAT, VK_NUMPAD3};
+    m_hotkeyMap[HotkeyId::SnapCenter] = {MOD_WIN | MOD_SHIFT | MOD_NOREPEAT, VK_NUMPAD5};
+
+    // 기타 기능키 - 충돌 가능성이 적은 키 조합으로 변경
+    m_hotkeyMap[HotkeyId::ToggleGrid] = {MOD_ALT | MOD_NOREPEAT, 'G'};
+    m_hotkeyMap[HotkeyId::ResetWindow] = {MOD_ALT | MOD_NOREPEAT, 'R'};
+
+    // 방향 단축키: Win+Alt+화살표 포커스, +Shift 맞바꾸기, +Ctrl 밀기
+    const UINT arrows[] = {VK_LEFT, VK_RIGHT, VK_UP, VK_DOWN};
+    for (int i = 0; i < 4; ++i) {
+        m_hotkeyMap[static_cast<HotkeyId>(static_cast<int>(HotkeyId::FocusLeft) + i)] =
+            {MOD_WIN | MOD_ALT | MOD_NOREPEAT, arrows[i]};
+        m_hotkeyMap[static_cast<HotkeyId>(static_cast<int>(HotkeyId::SwapLeft) + i)] =
+            {MOD_WIN | MOD_ALT | MOD_SHIFT | MOD_NOREPEAT, arrows[i]};
+        m_hotkeyMap[static_cast<HotkeyId>(static_cast<int>(HotkeyId::PushLeft) + i)] =
+            {MOD_WIN | MOD_ALT | MOD_CONTROL | MOD_NOREPEAT, arrows[i]};
+    }
+}
+
+bool HotkeyManager::initialize() {
+    if (m_initialized) return true;
+    
+    // 이전에 등록된 핫키가 있다면 모두 해제
+    unregisterHotkeys();
+    m_threadId = GetCurrentThreadId();
+    m_hookedIds.clear();
+
+    // 핫키 등록 시도 (오류 메시지는 고정 버퍼에 - 스트림/문자열 할당 없음)
+    // 시작 경로를 막지 않도록 메시지 상자 없이 모으기만 하고, 실패한 키 외에는 그대로 살려 둔다
+    bool success = true;
+    m_errorText[0] = L'\0';
+    size_t errorLength = 0;
+    auto appendError = [&](const wchar_t* format, auto... args) {
+        const int written =
+            std::swprintf(m_errorText + errorLength, std::size(m_errorText) - errorLength, format, args...);
+        if (written > 0) errorLength += static_cast<size_t>(written);
+    };
+    
+    for (const auto& [id, info] : m_hotkeyMap) {
+        // 시퀀스 바인딩이 있는 핫키는 훅에서만 처리
+        if (m_sequenceMap.count(id)) continue;
+        if (m_inputMode == HotkeyInputMode::KeyboardHook) {
+            m_hookedIds.push_back(id);
+            continue;
+        }
+        if (!RegisterHotKey(NULL, static_cast<int>(id), info.modifiers, info.key)) {
+            DWORD error = GetLastError();
+            if (error == ERROR_HOTKEY_ALREADY_REGISTERED) {
+                // 다른 앱이 이미 가진 핫키는 키보드 훅으로 가로챈다
+                m_hookedIds.push_back(id);
+                continue;
+            }
+            
+            success = false;
+            appendError(L"핫키 등록 실패 (ID: %d, Error: %lu)\n", static_cast<int>(id), error);
+        }
+    }
+
+    if (!startKeyboardHook()) {
+        success = false;
+        appendError(L"키보드 훅 설치 실패 (Error: %lu)\n", GetLastError());
+    }
+
+    // 결과는 getErrorText() 로 (트레이 알림 등은 부르는 쪽에서 메시지 루프를 막지 않게)
+    if (!success) OutputDebugStringW(m_errorText);
+
+    m_initialized = true;
+    return success;
+}
+
+void HotkeyManager::cleanup() {
+    if (!m_initialized) return;
+    
+    unregisterHotkeys();
+    m_initialized = false;
+}
+
+void HotkeyManager::unregisterHotkeys() {
+    for (const auto& [id, _] : m_hotkeyMap) {
+        UnregisterHotKey(NULL, static_cast<int>(id));
+    }
+    stopKeyboardHook();
+}
+
+bool HotkeyManager::startKeyboardHook() {
+    stopKeyboardHook();
+
+    std::vector<KeyBinding> bindings;
+    for (HotkeyId id : m_hookedIds) {
+        const HotkeyInfo& info = m_hotkeyMap[id];
+        KeyBinding binding;
+        binding.id = static_cast<int>(id);
+        // MOD_NOREPEAT 는 제외 (훅 쪽은 항상 자동 반복을 무시)
+        binding.first = {static_cast<std::uint8_t>(info.modifiers & 0xF), static_cast<std::uint8_t>(info.key)};
+        bindings.push_back(binding);
+    }
+    for (const auto& [id, binding] : m_sequenceMap) {
+        bindings.push_back(binding);
+        bindings.back().id = static_cast<int>(id);
+    }
+    if (bindings.empty()) return true;
+
+    // 해석은 작업 스레드에서, 실행은 WM_HOTKEY 로 메시지 루프 스레드에서 (RegisterHotKey 경로와 동일)
+    m_keyInput.start(bindings, onHookedHotkey, this);
+    if (!Win32KeyboardHook::getInstance().install(m_keyInput)) {
+        m_keyInput.stop();
+        return false;
+    }
+    return true;
+}
+
+void HotkeyManager::stopKeyboardHook() {
+    Win32KeyboardHook::getInstance().uninstall();
+    m_keyInput.stop();
+}
+
+void HotkeyManager::onHookedHotkey(int id, void* context) {
+    auto* self = static_cast<HotkeyManager*>(context);
+    PostThreadMessageW(self->m_threadId, WM_HOTKEY, static_cast<WPARAM>(id), 0);
+}
+
+void HotkeyManager::handleHotkey(int id) {
+    auto& windowManager = WindowManager::getInstance();
+    // 이 단축키 처리 중의 임시 메모리는 끝나면 한꺼번에 되돌린다
+    EventArena::Scope scope(windowManager.getEventArena());
+    LatencyTracer& tracer = windowManager.getLatencyTracer();
+    const std::uint32_t span = tracer.beginSpan();
+    windowManager.getStartupTimeline().mark(StartupStage::FirstHotkey);
+    HWND foregroundWindow = GetForegroundWindow();
+
+    if (!foregroundWindow) return;
+    tracer.mark(span, TraceStage::ForegroundLookup);
+    windowManager.recordHotkey(id, foregroundWindow);
+
+    switch (static_cast<HotkeyId>(id)) {
+        case HotkeyId::SnapLeft:
+            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::CenterLeft, span);
+            break;
+        case HotkeyId::SnapRight:
+            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::CenterRight, span);
+            break;
+        case HotkeyId::SnapTop:
+            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::TopCenter, span);
+            break;
+        case HotkeyId::SnapBottom:
+            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::BottomCenter, span);
+            break;
+        case HotkeyId::SnapTopLeft:
+            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::TopLeft, span);
+            break;
+        case HotkeyId::SnapTopRight:
+            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::TopRight, span);
+            break;
+        case HotkeyId::SnapBottomLeft:
+            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::BottomLeft, span);
+            break;
+        case HotkeyId::SnapBottomRight:
+            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::BottomRight, span);
+            break;
+        case HotkeyId::SnapCenter:
+            windowManager.snapWindowToPosition(foregroundWindow, WindowPosition::Center, span);
+            break;
+        case HotkeyId::ToggleGrid:
+            windowManager.toggleGrid();
+            break;
+        case HotkeyId::ResetWindow:
+            ShowWindow(foregroundWindow, SW_RESTORE);
+            break;
+        case HotkeyId::FocusLeft:
+        case HotkeyId::FocusRight:
+        case HotkeyId::FocusUp:
+        case HotkeyId::FocusDown:
+            windowManager.focusWindowInDirection(
+                foregroundWindow, static_cast<Direction>(id - static_cast<int>(HotkeyId::FocusLeft)));
+            break;
+        case HotkeyId::SwapLeft:
+        case HotkeyId::SwapRight:
+        case HotkeyId::SwapUp:
+        case HotkeyId::SwapDown:
+            windowManager.swapWindowInDirection(
+                foregroundWindow, static_cast<Direction>(id - static_cast<int>(HotkeyId::SwapLeft)));
+            break;
+        case HotkeyId::PushLeft:
+        case HotkeyId::PushRight:
+        case HotkeyId::PushUp:
+        case HotkeyId::PushDown:
+            windowManager.pushWindowInDirection(
+                foregroundWindow, static_cast<Direction>(id - static_cast<int>(HotkeyId::PushLeft)));
+            break;
+    }
+}
+
+bool HotkeyManager::setHotkey(HotkeyId id, UINT modifiers, UINT key) {
+    if (!m_initialized) return false;
+
+    // 기존 핫키 해제
+    UnregisterHotKey(NULL, static_cast<int>(id));
+
+    // 새 핫키 등록
+    if (!RegisterHotKey(NULL, static_cast<int>(id), modifiers | MOD_NOREPEAT, key)) {
+        // 실패 시 기존 핫키 재등록
+        const auto& oldInfo = m_hotkeyMap[id];
+        RegisterHotKey(NULL, static_cast<int>(id), oldInfo.modifiers, oldInfo.key);
+        return false;
+    }
+
+    // 성공 시 맵 업데이트
+    m_hotkeyMap[id] = {modifiers | MOD_NOREPEAT, key};
+    return true;
+}
+
+const std::vector<ConfigActionName>& HotkeyManager::configActions() {
+    static const std::vector<ConfigActionName> actions = {
+        {"snap_left", static_cast<int>(HotkeyId::SnapLeft)},
+        {"snap_right", static_cast<int>(HotkeyId::SnapRight)},
+        {"snap_top", static_cast<int>(HotkeyId::SnapTop)},
+        {"snap_bottom", static_cast<int>(HotkeyId::SnapBottom)},
+        {"snap_top_left", static_cast<int>(HotkeyId::SnapTopLeft)},
+        {"snap_top_right", static_cast<int>(HotkeyId::SnapTopRight)},
+        {"snap_bottom_left", static_cast<int>(HotkeyId::SnapBottomLeft)},
+        {"snap_bottom_right", static_cast<int>(HotkeyId::SnapBottomRight)},
+        {"snap_center", static_cast<int>(HotkeyId::SnapCenter)},
+        {"toggle_grid", static_cast<int>(HotkeyId::ToggleGrid)},
+        {"reset_window", static_cast<int>(HotkeyId::ResetWindow)},
+        {"focus_left", static_cast<int>(HotkeyId::FocusLeft)},
+        {"focus_right", static_cast<int>(HotkeyId::FocusRight)},
+        {"focus_up", static_cast<int>(HotkeyId::FocusUp)},
+        {"focus_down", static_cast<int>(HotkeyId::FocusDown)},
+        {"swap_left", static_cast<int>(HotkeyId::SwapLeft)},
+        {"swap_right", static_cast<int>(HotkeyId::SwapRight)},
+        {"swap_up", static_cast<int>(HotkeyId::SwapUp)},
+        {"swap_down", static_cast<int>(HotkeyId::SwapDown)},
+        {"push_left", static_cast<int>(HotkeyId::PushLeft)},
+        {"push_right", static_cast<int>(HotkeyId::PushRight)},
+        {"push_up", static_cast<int>(HotkeyId::PushUp)},
+        {"push_down", static_cast<int>(HotkeyId::PushDown)},
+    };
+    return actions;
+}
+
+void HotkeyManager::applyBindings(const std::vector<KeyBinding>& bindings) {
+    const bool wasInitialized = m_initialized;
+    cleanup();
+
+    m_hotkeyMap.clear();
+    m_sequenceMap.clear();
+    initializeDefaultHotkeys();
+    for (const auto& binding : bindings) {
+        const HotkeyId id = static_cast<HotkeyId>(binding.id);
+        if (binding.taps == 1 && binding.second.vk == 0) {
+            m_hotkeyMap[id] = {static_cast<UINT>(binding.first.modifiers) | MOD_NOREPEAT, binding.first.vk};
+        } else {
+            m_sequenceMap[id] = binding;
+        }
+    }
+
+    if (wasInitialized) initialize();
+}
+
+bool HotkeyManager::setHotkeySequence(HotkeyId id, const KeyBinding& binding) {
+    m_sequenceMap[id] = binding;
+    if (!m_initialized) return true;
+
+    // 같은 id 의 RegisterHotKey 등록은 풀고 훅 바인딩을 다시 만든다
+    UnregisterHotKey(NULL, static_cast<int>(id));
+    m_hookedIds.erase(std::remove(m_hookedIds.begin(), m_hookedIds.end(), id), m_hookedIds.end());
+    return startKeyboardHook();
+}
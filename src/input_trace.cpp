@@ -0,0 +1,338 @@
+#include "input_trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+using namespace input_trace_format;
+
+static_assert(sizeof(FileHeader) == 16, "FileHeader layout");
+static_assert(sizeof(Record) == 24, "Record layout");
+static_assert(sizeof(StoredMonitor) == 56, "StoredMonitor layout");
+static_assert(sizeof(Rect) == 16, "Rect layout");
+
+// 한 번에 기록할 수 있는 모니터 수 상한 (손상된 파일 방어)
+constexpr size_t kMaxMonitors = 64;
+
+// ---- 기록 ----
+
+std::int64_t InputRecorder::nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void InputRecorder::start(std::int64_t timeUs) {
+    m_data.clear();
+    m_data.reserve(64 * 1024);
+    m_events = 0;
+    m_lastUs = timeUs;
+    m_active = true;
+
+    FileHeader header{kMagic, kVersion, static_cast<std::uint32_t>(sizeof(Record)), 0};
+    m_data.resize(sizeof(header));
+    std::memcpy(m_data.data(), &header, sizeof(header));
+}
+
+void InputRecorder::append(InputEventType type, std::int64_t timeUs, WindowId window, std::int32_t a,
+                           std::int32_t b, std::uint16_t payload) {
+    // 시간은 단조 증가로 보정하고, 32비트를 넘는 간격(약 71분)은 잘라서 기록
+    std::int64_t delta = timeUs - m_lastUs;
+    if (delta < 0) delta = 0;
+    if (delta > 0xFFFFFFFFll) delta = 0xFFFFFFFFll;
+    m_lastUs += delta;
+
+    Record record{};
+    record.deltaUs = static_cast<std::uint32_t>(delta);
+    record.type = static_cast<std::uint8_t>(type);
+    record.payload = payload;
+    record.a = a;
+    record.b = b;
+    record.window = static_cast<std::uint64_t>(window);
+
+    const size_t offset = m_data.size();
+    m_data.resize(offset + sizeof(record));
+    std::memcpy(m_data.data() + offset, &record, sizeof(record));
+    ++m_events;
+}
+
+void InputRecorder::hotkey(int id, std::int64_t timeUs) {
+    if (m_active) append(InputEventType::Hotkey, timeUs, 0, id, 0, 0);
+}
+
+void InputRecorder::foreground(WindowId window, std::int64_t timeUs) {
+    if (m_active) append(InputEventType::Foreground, timeUs, window, 0, 0, 0);
+}
+
+void InputRecorder::dragMove(WindowId window, Point pt, std::int64_t timeUs) {
+    if (m_active) append(InputEventType::DragMove, timeUs, window, pt.x, pt.y, 0);
+}
+
+void InputRecorder::dragEnd(WindowId window, std::int64_t timeUs) {
+    if (m_active) append(InputEventType::DragEnd, timeUs, window, 0, 0, 0);
+}
+
+void InputRecorder::displayChange(const MonitorTopology& topology, std::int64_t timeUs) {
+    if (!m_active) return;
+    const size_t count = std::min(topology.monitors().size(), kMaxMonitors);
+    append(InputEventType::DisplayChange, timeUs, 0, 0, 0, static_cast<std::uint16_t>(count));
+
+    const size_t offset = m_data.size();
+    m_data.resize(offset + count * sizeof(StoredMonitor));
+    for (size_t i = 0; i < count; ++i) {
+        const MonitorInfo& info = topology.monitor(static_cast<int>(i));
+        StoredMonitor stored{info.bounds, info.workArea, info.dpi, info.refreshHz, info.primary ? 1u : 0u, 0,
+                             static_cast<std::uint64_t>(info.handle)};
+        std::memcpy(m_data.data() + offset + i * sizeof(StoredMonitor), &stored, sizeof(stored));
+    }
+}
+
+void InputRecorder::windowRect(WindowId window, const Rect& rect, std::int64_t timeUs) {
+    if (!m_active) return;
+    append(InputEventType::WindowRect, timeUs, window, 0, 0, 1);
+    const size_t offset = m_data.size();
+    m_data.resize(offset + sizeof(Rect));
+    std::memcpy(m_data.data() + offset, &rect, sizeof(Rect));
+}
+
+void InputRecorder::gridSize(int rows, int cols, std::int64_t timeUs) {
+    if (m_active) append(InputEventType::GridSize, timeUs, 0, rows, cols, 0);
+}
+
+bool InputRecorder::save(const std::filesystem::path& path) const {
+    if (m_data.empty()) return false;
+    return writeFileAtomic(path, m_data.data(), m_data.size());
+}
+
+// ---- 읽기 ----
+
+bool InputTraceReader::open(const std::filesystem::path& path) {
+    if (!m_file.open(path)) return false;
+    return attach(m_file.data(), m_file.size());
+}
+
+bool InputTraceReader::attach(const unsigned char* data, size_t size) {
+    m_data = nullptr;
+    m_size = 0;
+    if (!data || size < sizeof(FileHeader)) return false;
+
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion || header.recordSize != sizeof(Record)) return false;
+
+    m_data = data;
+    m_size = size;
+    rewind();
+    return true;
+}
+
+void InputTraceReader::rewind() {
+    m_offset = sizeof(FileHeader);
+    m_timeUs = 0;
+    m_truncated = false;
+}
+
+bool InputTraceReader::next(InputEvent& out) {
+    if (!m_data || m_offset >= m_size) return false;
+    if (m_size - m_offset < sizeof(Record)) {
+        m_truncated = true;
+        return false;
+    }
+
+    Record record;
+    std::memcpy(&record, m_data + m_offset, sizeof(record));
+    const size_t payloadOffset = m_offset + sizeof(record);
+
+    size_t payloadBytes = 0;
+    switch (static_cast<InputEventType>(record.type)) {
+        case InputEventType::Hotkey:
+        case InputEventType::Foreground:
+        case InputEventType::DragMove:
+        case InputEventType::DragEnd:
+        case InputEventType::GridSize:
+            break;
+        case InputEventType::DisplayChange:
+            if (record.payload > kMaxMonitors) {
+                m_truncated = true;
+                return false;
+            }
+            payloadBytes = record.payload * sizeof(StoredMonitor);
+            break;
+        case InputEventType::WindowRect:
+            payloadBytes = sizeof(Rect);
+            break;
+        default:
+            m_truncated = true;  // 알 수 없는 타입은 손상으로 본다
+            return false;
+    }
+    if (m_size - payloadOffset < payloadBytes) {
+        m_truncated = true;
+        return false;
+    }
+
+    m_timeUs += record.deltaUs;
+    out.type = static_cast<InputEventType>(record.type);
+    out.timeUs = m_timeUs;
+    out.window = static_cast<WindowId>(record.window);
+    out.a = record.a;
+    out.b = record.b;
+    out.monitors = nullptr;
+    out.monitorCount = 0;
+    if (out.type == InputEventType::WindowRect) {
+        std::memcpy(&out.rect, m_data + payloadOffset, sizeof(Rect));
+    } else if (out.type == InputEventType::DisplayChange) {
+        // 레코드가 8바이트 단위라 payload 도 정렬되어 있다
+        out.monitors = reinterpret_cast<const StoredMonitor*>(m_data + payloadOffset);
+        out.monitorCount = record.payload;
+    }
+    m_offset = payloadOffset + payloadBytes;
+    return true;
+}
+
+// ---- 재생 ----
+
+InputReplayer::InputReplayer() : m_transaction(m_windows), m_cycler(500) {}
+
+bool InputReplayer::rectOf(WindowId window, Rect& out) const {
+    const Rect* rect = m_windows.rectOf(window);
+    if (!rect) return false;
+    out = *rect;
+    return true;
+}
+
+void InputReplayer::moveWindow(WindowId window, const Rect& target, ReplayStats& stats) {
+    m_transaction.move(window, target);
+    stats.moves += m_transaction.commit().issued;
+}
+
+void InputReplayer::apply(const InputEvent& event, ReplayStats& stats) {
+    switch (event.type) {
+        case InputEventType::WindowRect:
+            if (!m_windows.rectOf(event.window)) m_known.push_back(event.window);
+            m_windows.addWindow(event.window, event.rect);
+            break;
+
+        case InputEventType::Foreground:
+            m_foreground = event.window;
+            break;
+
+        case InputEventType::GridSize:
+            if (event.a > 0 && event.b > 0) {
+                m_rows = event.a;
+                m_cols = event.b;
+            }
+            break;
+
+        case InputEventType::DisplayChange: {
+            ++stats.displayChanges;
+            m_monitorScratch.resize(event.monitorCount);
+            for (size_t i = 0; i < event.monitorCount; ++i) {
+                const auto& stored = event.monitors[i];
+                MonitorInfo& info = m_monitorScratch[i];
+                info.handle = static_cast<std::uintptr_t>(stored.handle);
+                info.bounds = stored.bounds;
+                info.workArea = stored.workArea;
+                info.dpi = stored.dpi;
+                info.refreshHz = stored.refreshHz;
+                info.primary = stored.primary != 0;
+            }
+            m_monitorBackend.setMonitors(m_monitorScratch);
+            m_topology.rebuild(m_monitorBackend);
+            if (m_drag.active()) m_drag.cancel();
+            break;
+        }
+
+        case InputEventType::Hotkey: {
+            ++stats.hotkeys;
+            auto it = m_hotkeys.find(event.a);
+            const Rect* current = m_windows.rectOf(m_foreground);
+            if (it == m_hotkeys.end() || !current || m_topology.empty()) break;
+
+            const Rect& work = m_topology.monitor(m_topology.monitorFromRect(*current)).workArea;
+            const HotkeyAction& action = it->second;
+            Rect target;
+            switch (action.kind) {
+                case HotkeyAction::Position:
+                    target = calculateSnapRect(work, static_cast<WindowPosition>(action.arg));
+                    break;
+                case HotkeyAction::Side:
+                    target = sideSnapRect(work, action.arg != 0, m_cycler.advance(event.a, event.timeUs / 1000));
+                    break;
+                case HotkeyAction::Half:
+                    target = halfSnapRect(work, action.arg != 0);
+                    break;
+                case HotkeyAction::Maximize:
+                    target = work;
+                    break;
+                default:
+                    return;
+            }
+            moveWindow(m_foreground, target, stats);
+            break;
+        }
+
+        case InputEventType::DragMove: {
+            ++stats.dragMoves;
+            const std::int64_t nowNs = event.timeUs * 1000;
+            const Point pt{event.a, event.b};
+            if (!m_drag.active() || m_drag.window() != event.window) {
+                const Rect* current = m_windows.rectOf(event.window);
+                if (!current || m_topology.empty()) break;
+                if (m_drag.active()) m_drag.cancel();
+                m_drag.configure(m_topology, m_rows, m_cols);
+                m_drag.begin(event.window, *current, pt, nowNs);
+            } else {
+                m_drag.addSample(pt, nowNs);
+            }
+            break;
+        }
+
+        case InputEventType::DragEnd: {
+            if (!m_drag.active() || m_drag.window() != event.window) break;
+            Rect target;
+            if (m_drag.end(target)) moveWindow(event.window, target, stats);
+            break;
+        }
+    }
+}
+
+ReplayStats InputReplayer::run(InputTraceReader& reader) {
+    ReplayStats stats;
+    const auto start = std::chrono::steady_clock::now();
+    InputEvent event;
+    while (reader.next(event)) {
+        apply(event, stats);
+        ++stats.events;
+    }
+    stats.elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    stats.eventsPerSecond = stats.elapsedNs > 0 ? stats.events * 1e9 / stats.elapsedNs : 0;
+    stats.truncated = reader.truncated();
+    return stats;
+}
+
+void InputReplayer::finalGeometry(std::vector<WindowMove>& out) const {
+    out.clear();
+    out.reserve(m_known.size());
+    for (WindowId window : m_known) {
+        if (const Rect* rect = m_windows.rectOf(window)) out.push_back({window, *rect});
+    }
+    std::sort(out.begin(), out.end(), [](const WindowMove& a, const WindowMove& b) { return a.window < b.window; });
+}
+
+std::uint64_t InputReplayer::geometryHash() const {
+    std::vector<WindowMove> geometry;
+    finalGeometry(geometry);
+
+    // FNV-1a
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    auto mix = [&hash](std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 0x100000001B3ull;
+        }
+    };
+    for (const auto& move : geometry) {
+        mix(static_cast<std::uint64_t>(move.window));
+        mix(static_cast<std::uint32_t>(move.target.left) | static_cast<std::uint64_t>(static_cast<std::uint32_t>(move.target.top)) << 32);
+        mix(static_cast<std::uint32_t>(move.target.right) | static_cast<std::uint64_t>(static_cast<std::uint32_t>(move.target.bottom)) << 32);
+    }
+    return hash;
+}
@@ -0,0 +1,299 @@
+#include "key_input.h"
+#include <chrono>
+#include <cstring>
+
+// 좌/우 구분 코드를 포함한 수식키 가상 키 코드
+static const std::uint8_t kShiftKeys[] = {0x10, 0xA0, 0xA1};
+static const std::uint8_t kControlKeys[] = {0x11, 0xA2, 0xA3};
+static const std::uint8_t kAltKeys[] = {0x12, 0xA4, 0xA5};
+static const std::uint8_t kWinKeys[] = {0x5B, 0x5C};
+
+KeyFilter::KeyFilter() {
+    std::memset(m_firstMask, 0, sizeof(m_firstMask));
+    std::memset(m_secondMask, 0, sizeof(m_secondMask));
+    reset();
+}
+
+std::uint8_t KeyFilter::modifierOf(std::uint8_t vk) {
+    switch (vk) {
+        case 0x10: case 0xA0: case 0xA1: return KeyModShift;
+        case 0x11: case 0xA2: case 0xA3: return KeyModControl;
+        case 0x12: case 0xA4: case 0xA5: return KeyModAlt;
+        case 0x5B: case 0x5C: return KeyModWin;
+        default: return 0;
+    }
+}
+
+void KeyFilter::build(const std::vector<KeyBinding>& bindings) {
+    std::memset(m_firstMask, 0, sizeof(m_firstMask));
+    std::memset(m_secondMask, 0, sizeof(m_secondMask));
+    for (const auto& binding : bindings) {
+        m_firstMask[binding.first.vk] |= static_cast<std::uint16_t>(1u << (binding.first.modifiers & 0xF));
+        if (binding.second.vk) {
+            m_secondMask[binding.second.vk] |= static_cast<std::uint16_t>(1u << (binding.second.modifiers & 0xF));
+        }
+    }
+    reset();
+}
+
+void KeyFilter::reset() {
+    std::memset(m_down, 0, sizeof(m_down));
+    std::memset(m_swallowed, 0, sizeof(m_swallowed));
+    m_modifiers = 0;
+    m_chordArmed.store(false, std::memory_order_relaxed);
+}
+
+unsigned KeyFilter::filter(std::uint8_t vk, bool down, KeyEvent& out) {
+    const std::uint8_t modifier = modifierOf(vk);
+    if (modifier) {
+        // 수식키는 상태만 추적 (좌/우 중 하나라도 눌려 있으면 켜짐)
+        if (down) {
+            setBit(m_down, vk);
+            m_modifiers |= modifier;
+        } else {
+            clearBit(m_down, vk);
+            const std::uint8_t* keys = kShiftKeys;
+            size_t count = 3;
+            if (modifier == KeyModControl) keys = kControlKeys;
+            else if (modifier == KeyModAlt) keys = kAltKeys;
+            else if (modifier == KeyModWin) keys = kWinKeys, count = 2;
+            bool stillDown = false;
+            for (size_t i = 0; i < count; ++i) stillDown = stillDown || testBit(m_down, keys[i]);
+            if (!stillDown) m_modifiers &= static_cast<std::uint8_t>(~modifier);
+        }
+        return KeyFilterPass;
+    }
+
+    if (!down) {
+        clearBit(m_down, vk);
+        if (!testBit(m_swallowed, vk)) return KeyFilterPass;
+        clearBit(m_swallowed, vk);
+        return KeyFilterSwallow;
+    }
+
+    const bool repeat = testBit(m_down, vk);
+    setBit(m_down, vk);
+
+    const std::uint16_t bit = static_cast<std::uint16_t>(1u << (m_modifiers & 0xF));
+    const bool match = (m_firstMask[vk] & bit) ||
+                       ((m_secondMask[vk] & bit) && m_chordArmed.load(std::memory_order_relaxed));
+    if (!match) return KeyFilterPass;
+
+    setBit(m_swallowed, vk);
+    unsigned result = KeyFilterSwallow;
+    // 자동 반복은 넘기지 않는다 (MOD_NOREPEAT 와 같은 동작)
+    if (!repeat) {
+        out.vk = vk;
+        out.modifiers = m_modifiers;
+        result |= KeyFilterPush;
+        if (m_modifiers & (KeyModAlt | KeyModWin)) result |= KeyFilterMaskMenu;
+    }
+    return result;
+}
+
+void KeyBindingResolver::build(const std::vector<KeyBinding>& bindings, std::uint32_t sequenceTimeoutMs) {
+    m_bindings = bindings;
+    m_timeoutMs = sequenceTimeoutMs;
+    m_strokes.clear();
+    for (const auto& binding : m_bindings) {
+        StrokeInfo* found = nullptr;
+        for (auto& entry : m_strokes) {
+            if (entry.stroke == binding.first) found = &entry;
+        }
+        if (!found) {
+            m_strokes.push_back({binding.first, 0, false});
+            found = &m_strokes.back();
+        }
+        if (binding.second.vk) {
+            found->prefix = true;
+        } else if (binding.taps > found->maxTaps) {
+            found->maxTaps = binding.taps;
+        }
+    }
+    m_pendingTaps = 0;
+    m_pendingPrefix = false;
+}
+
+const KeyBindingResolver::StrokeInfo* KeyBindingResolver::info(const KeyStroke& stroke) const {
+    for (const auto& entry : m_strokes) {
+        if (entry.stroke == stroke) return &entry;
+    }
+    return nullptr;
+}
+
+int KeyBindingResolver::findTaps(const KeyStroke& stroke, std::uint8_t taps) const {
+    for (const auto& binding : m_bindings) {
+        if (!binding.second.vk && binding.first == stroke && binding.taps == taps) return binding.id;
+    }
+    return -1;
+}
+
+int KeyBindingResolver::findChord(const KeyStroke& first, const KeyStroke& second) const {
+    for (const auto& binding : m_bindings) {
+        if (binding.second.vk && binding.first == first && binding.second == second) return binding.id;
+    }
+    return -1;
+}
+
+void KeyBindingResolver::flushPending(std::vector<int>& out) {
+    if (m_pendingTaps == 0) return;
+    int id = findTaps(m_pending, m_pendingTaps);
+    if (id >= 0) out.push_back(id);
+    m_pendingTaps = 0;
+    m_pendingPrefix = false;
+}
+
+void KeyBindingResolver::start(const KeyStroke& stroke, std::uint32_t timeMs, std::vector<int>& out) {
+    const StrokeInfo* entry = info(stroke);
+    if (!entry) return;
+
+    // 뒤따를 입력이 없으면 바로 확정
+    if (entry->maxTaps <= 1 && !entry->prefix) {
+        int id = findTaps(stroke, 1);
+        if (id >= 0) out.push_back(id);
+        return;
+    }
+    m_pending = stroke;
+    m_pendingTaps = 1;
+    m_pendingPrefix = entry->prefix;
+    m_pendingTime = timeMs;
+}
+
+void KeyBindingResolver::feed(const KeyEvent& event, std::vector<int>& out) {
+    const KeyStroke stroke = {event.modifiers, event.vk};
+    if (m_pendingTaps > 0 && event.timeMs - m_pendingTime > m_timeoutMs) flushPending(out);
+
+    if (m_pendingTaps > 0) {
+        if (m_pendingPrefix) {
+            int id = findChord(m_pending, stroke);
+            if (id >= 0) {
+                out.push_back(id);
+                m_pendingTaps = 0;
+                m_pendingPrefix = false;
+                return;
+            }
+        }
+        const StrokeInfo* entry = info(stroke);
+        if (stroke == m_pending && entry && entry->maxTaps > m_pendingTaps) {
+            // 코드 입력은 첫 번째 누름에서만 시작된다
+            ++m_pendingTaps;
+            m_pendingPrefix = false;
+            m_pendingTime = event.timeMs;
+            if (m_pendingTaps == entry->maxTaps) flushPending(out);
+            return;
+        }
+        flushPending(out);
+    }
+    start(stroke, event.timeMs, out);
+}
+
+void KeyBindingResolver::poll(std::uint32_t nowMs, std::vector<int>& out) {
+    if (m_pendingTaps > 0 && nowMs - m_pendingTime >= m_timeoutMs) flushPending(out);
+}
+
+bool KeyBindingResolver::nextDeadline(std::uint32_t& deadlineMs) const {
+    if (m_pendingTaps == 0) return false;
+    deadlineMs = m_pendingTime + m_timeoutMs;
+    return true;
+}
+
+KeyInputPipeline::~KeyInputPipeline() {
+    stop();
+}
+
+std::uint32_t KeyInputPipeline::nowMs() {
+    return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+bool KeyInputPipeline::start(const std::vector<KeyBinding>& bindings, BindingCallback callback, void* context,
+                             std::uint32_t sequenceTimeoutMs) {
+    if (running()) return true;
+
+    m_filter.build(bindings);
+    m_resolver.build(bindings, sequenceTimeoutMs);
+    m_callback = callback;
+    m_context = context;
+    KeyEvent stale;
+    while (m_ring.tryPop(stale)) {}
+
+    m_running.store(true, std::memory_order_release);
+    m_worker = std::thread(&KeyInputPipeline::run, this);
+    return true;
+}
+
+void KeyInputPipeline::stop() {
+    if (!running()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running.store(false, std::memory_order_release);
+    }
+    m_wake.notify_one();
+    if (m_worker.joinable()) m_worker.join();
+    m_filter.reset();
+}
+
+unsigned KeyInputPipeline::onKey(std::uint8_t vk, bool down) {
+    if (!m_running.load(std::memory_order_relaxed)) return KeyFilterPass;
+
+    KeyEvent event;
+    unsigned result = m_filter.filter(vk, down, event);
+    if (!(result & KeyFilterPush)) return result;
+    event.timeMs = nowMs();
+
+    if (!m_ring.tryPush(event)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return result & ~KeyFilterPush;
+    }
+    m_pushed.fetch_add(1, std::memory_order_relaxed);
+
+    // 작업 스레드가 잠들어 있을 때만 깨운다 (바쁠 때는 락 없이 반환)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wake.notify_one();
+    }
+    return result;
+}
+
+KeyInputStats KeyInputPipeline::stats() const {
+    KeyInputStats stats;
+    stats.pushed = m_pushed.load(std::memory_order_relaxed);
+    stats.dropped = m_dropped.load(std::memory_order_relaxed);
+    stats.resolved = m_resolved.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void KeyInputPipeline::run() {
+    // 한 번에 해석되는 단축키는 링 크기를 넘지 않는다 - 미리 잡아 두면 키 입력마다 할당이 없다
+    std::vector<int> resolved;
+    resolved.reserve(64);
+    KeyEvent event;
+
+    while (true) {
+        while (m_ring.tryPop(event)) m_resolver.feed(event, resolved);
+        m_resolver.poll(nowMs(), resolved);
+        m_filter.setChordArmed(m_resolver.chordArmed());
+
+        for (int id : resolved) {
+            m_callback(id, m_context);
+            m_resolved.fetch_add(1, std::memory_order_relaxed);
+        }
+        resolved.clear();
+
+        if (!m_running.load(std::memory_order_acquire)) break;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto ready = [this] { return !m_ring.empty() || !m_running.load(std::memory_order_acquire); };
+        std::uint32_t deadline;
+        if (m_resolver.nextDeadline(deadline)) {
+            const std::int32_t waitMs = static_cast<std::int32_t>(deadline - nowMs());
+            m_wake.wait_for(lock, std::chrono::milliseconds(waitMs > 0 ? waitMs : 0), ready);
+        } else {
+            m_wake.wait(lock, ready);
+        }
+        m_sleeping.store(false, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,236 @@
+#include "latency_trace.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+static int highestBit(std::uint64_t v) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, v);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(v);
+#endif
+}
+
+const char* traceStageName(TraceStage stage) {
+    switch (stage) {
+        case TraceStage::HotkeyReceived: return "hotkey";
+        case TraceStage::ForegroundLookup: return "foreground";
+        case TraceStage::GeometryComputed: return "geometry";
+        case TraceStage::MoveReturned: return "move";
+        case TraceStage::TargetReached: return "settled";
+        default: return "unknown";
+    }
+}
+
+// ---- 히스토그램 ----
+
+int LatencyHistogram::bucketOf(std::uint64_t ns) {
+    if (ns < static_cast<std::uint64_t>(kSubBuckets)) return static_cast<int>(ns);
+    const int exponent = highestBit(ns);
+    const int group = exponent - kSubBits + 1;
+    return group * kSubBuckets + static_cast<int>(ns >> (exponent - kSubBits)) - kSubBuckets;
+}
+
+std::uint64_t LatencyHistogram::bucketLow(int bucket) {
+    const int group = bucket / kSubBuckets;
+    if (group == 0) return static_cast<std::uint64_t>(bucket);
+    const int exponent = group + kSubBits - 1;
+    const std::uint64_t mantissa = static_cast<std::uint64_t>(bucket - group * kSubBuckets + kSubBuckets);
+    return mantissa << (exponent - kSubBits);
+}
+
+std::uint64_t LatencyHistogram::bucketHigh(int bucket) {
+    const int group = bucket / kSubBuckets;
+    if (group == 0) return static_cast<std::uint64_t>(bucket);
+    const int exponent = group + kSubBits - 1;
+    return bucketLow(bucket) + ((1ull << (exponent - kSubBits)) - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t ns) {
+    m_buckets[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(ns, std::memory_order_relaxed);
+
+    std::uint64_t current = m_min.load(std::memory_order_relaxed);
+    while (ns < current && !m_min.compare_exchange_weak(current, ns, std::memory_order_relaxed)) {}
+    current = m_max.load(std::memory_order_relaxed);
+    while (ns > current && !m_max.compare_exchange_weak(current, ns, std::memory_order_relaxed)) {}
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : m_buckets) bucket.store(0, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(~0ull, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::min() const {
+    return count() ? m_min.load(std::memory_order_relaxed) : 0;
+}
+
+double LatencyHistogram::mean() const {
+    const std::uint64_t n = count();
+    return n ? static_cast<double>(m_sum.load(std::memory_order_relaxed)) / n : 0.0;
+}
+
+std::uint64_t LatencyHistogram::percentile(double p) const {
+    const std::uint64_t n = count();
+    if (n == 0) return 0;
+    std::uint64_t rank = static_cast<std::uint64_t>(p / 100.0 * n + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+
+    std::uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            const std::uint64_t high = bucketHigh(i);
+            return high < max() ? high : max();
+        }
+    }
+    return max();
+}
+
+// ---- 추적기 ----
+
+std::int64_t LatencyTracer::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::uint32_t LatencyTracer::beginSpan() {
+    if (!enabled()) return 0;
+    std::uint32_t span = (m_nextSpan.fetch_add(1, std::memory_order_relaxed) + 1) & 0xFFFFFF;
+    if (span == 0) span = m_nextSpan.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    const std::int64_t now = nowNs();
+    Span& s = m_spans[span & (kActiveSpans - 1)];
+    s.startNs.store(now, std::memory_order_relaxed);
+    s.lastNs.store(now, std::memory_order_relaxed);
+    push(now, 0, span, TraceStage::HotkeyReceived);
+    return span;
+}
+
+void LatencyTracer::mark(std::uint32_t span, TraceStage stage) {
+    if (span == 0 || !enabled()) return;
+    const std::int64_t now = nowNs();
+    Span& s = m_spans[span & (kActiveSpans - 1)];
+    const std::int64_t previous = s.lastNs.exchange(now, std::memory_order_relaxed);
+    const std::uint64_t duration = now > previous ? static_cast<std::uint64_t>(now - previous) : 0;
+
+    m_stages[static_cast<int>(stage)].record(duration);
+    push(previous, duration, span, stage);
+    if (stage == TraceStage::TargetReached) {
+        const std::int64_t start = s.startNs.load(std::memory_order_relaxed);
+        m_total.record(now > start ? static_cast<std::uint64_t>(now - start) : 0);
+    }
+}
+
+// 시퀀스 잠금: 기록 중에는 번호를 0 으로 두고, 다 쓴 뒤 번호를 붙인다
+void LatencyTracer::push(std::int64_t startNs, std::uint64_t durationNs, std::uint32_t span, TraceStage stage) {
+    const std::uint64_t ticket = m_next.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = m_ring[ticket & (kRingSize - 1)];
+    if (durationNs > 0xFFFFFFFFull) durationNs = 0xFFFFFFFFull;
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.start.store(static_cast<std::uint64_t>(startNs), std::memory_order_relaxed);
+    slot.packed.store((durationNs << 32) | (static_cast<std::uint64_t>(span & 0xFFFFFF) << 8) |
+                          static_cast<std::uint64_t>(stage),
+                      std::memory_order_relaxed);
+    slot.sequence.store(ticket + 1, std::memory_order_release);
+}
+
+size_t LatencyTracer::snapshot(TraceEvent* out, size_t capacity) const {
+    const std::uint64_t end = m_next.load(std::memory_order_acquire);
+    std::uint64_t begin = end > kRingSize ? end - kRingSize : 0;
+    if (end - begin > capacity) begin = end - capacity;
+
+    size_t count = 0;
+    for (std::uint64_t ticket = begin; ticket < end; ++ticket) {
+        const Slot& slot = m_ring[ticket & (kRingSize - 1)];
+        const std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        const std::uint64_t start = slot.start.load(std::memory_order_relaxed);
+        const std::uint64_t packed = slot.packed.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::uint64_t after = slot.sequence.load(std::memory_order_relaxed);
+        if (before != ticket + 1 || after != before) continue;
+
+        TraceEvent& event = out[count++];
+        event.startNs = static_cast<std::int64_t>(start);
+        event.durationNs = static_cast<std::uint32_t>(packed >> 32);
+        event.span = static_cast<std::uint32_t>(packed >> 8) & 0xFFFFFF;
+        event.stage = static_cast<TraceStage>(packed & 0xFF);
+    }
+    return count;
+}
+
+void LatencyTracer::reset() {
+    for (auto& slot : m_ring) slot.sequence.store(0, std::memory_order_relaxed);
+    m_next.store(0, std::memory_order_relaxed);
+    for (auto& histogram : m_stages) histogram.reset();
+    m_total.reset();
+}
+
+static void appendSummary(std::string& out, const char* name, const LatencyHistogram& h, bool& first) {
+    char line[256];
+    std::snprintf(line, sizeof(line),
+                  "%s\"%s\":\"count=%llu mean=%.2fus p50=%.2fus p90=%.2fus p99=%.2fus max=%.2fus\"",
+                  first ? "" : ",", name, static_cast<unsigned long long>(h.count()), h.mean() / 1000.0,
+                  h.percentile(50) / 1000.0, h.percentile(90) / 1000.0, h.percentile(99) / 1000.0,
+                  h.max() / 1000.0);
+    out += line;
+    first = false;
+}
+
+void LatencyTracer::exportChromeTrace(std::string& out) const {
+    std::vector<TraceEvent> events(kRingSize);
+    events.resize(snapshot(events.data(), events.size()));
+
+    std::int64_t origin = events.empty() ? 0 : events.front().startNs;
+    for (const auto& event : events) origin = event.startNs < origin ? event.startNs : origin;
+
+    out.clear();
+    out.reserve(events.size() * 120 + 1024);
+    out += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    char line[192];
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent& e = events[i];
+        const double ts = (e.startNs - origin) / 1000.0;
+        if (e.stage == TraceStage::HotkeyReceived) {
+            std::snprintf(line, sizeof(line),
+                          "%s{\"name\":\"%s\",\"cat\":\"snap\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                          i ? "," : "", traceStageName(e.stage), ts, e.span);
+        } else {
+            std::snprintf(line, sizeof(line),
+                          "%s{\"name\":\"%s\",\"cat\":\"snap\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                          i ? "," : "", traceStageName(e.stage), ts, e.durationNs / 1000.0, e.span);
+        }
+        out += line;
+    }
+
+    out += "],\"otherData\":{";
+    bool first = true;
+    for (int s = static_cast<int>(TraceStage::ForegroundLookup); s < static_cast<int>(TraceStage::Count); ++s) {
+        appendSummary(out, traceStageName(static_cast<TraceStage>(s)), m_stages[s], first);
+    }
+    appendSummary(out, "total", m_total, first);
+    out += "}}\n";
+}
+
+bool LatencyTracer::writeChromeTrace(const std::filesystem::path& path) const {
+    std::string json;
+    exportChromeTrace(json);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(json.data(), static_cast<std::streamsize>(json.size()));
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,360 @@
+#include "layout_store.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+using namespace layout_format;
+
+static_assert(sizeof(FileHeader) == 32, "FileHeader layout");
+static_assert(sizeof(SectionEntry) == 24, "SectionEntry layout");
+static_assert(sizeof(StoredGrid) == 16, "StoredGrid layout");
+static_assert(sizeof(StoredLayout) == 16, "StoredLayout layout");
+static_assert(sizeof(StoredWindowLayout) == 32, "StoredWindowLayout layout");
+static_assert(sizeof(StoredRule) == 48, "StoredRule layout");
+static_assert(sizeof(StoredMonitorConfig) == 24, "StoredMonitorConfig layout");
+
+static const std::uint32_t kSectionCount = 7;
+
+std::uint32_t layout_format::checksum(const unsigned char* data, size_t size) {
+    // 8바이트 단위 FNV-1a 변형 (로드 시간에서 체크섬 비중을 줄이기 위해)
+    std::uint64_t hash = 14695981039346656037ull;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 1099511628211ull;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+}
+
+static size_t alignUp(size_t value) { return (value + 7) & ~static_cast<size_t>(7); }
+
+void monitorGridSize(const std::vector<MonitorGridConfig>& configs, int monitorIndex, int& rows, int& cols) {
+    for (const auto& config : configs) {
+        if (config.monitorIndex == monitorIndex) {
+            rows = config.rows;
+            cols = config.cols;
+        }
+    }
+}
+
+// ---- 작성 ----
+
+void LayoutSnapshotWriter::setGrid(int rows, int cols, float opacity, bool visible) {
+    m_grid = {rows, cols, opacity, visible ? 1u : 0u};
+}
+
+void LayoutSnapshotWriter::addLayout(std::string_view name, const std::vector<StoredWindowLayout>& windows,
+                                     const std::vector<std::uint64_t>& titleHashes) {
+    std::vector<std::uint64_t> titles = titleHashes;
+    titles.resize(windows.size(), 0);
+    for (auto& layout : m_layouts) {
+        if (layout.name == name) {
+            layout.windows = windows;
+            layout.titleHashes = std::move(titles);
+            return;
+        }
+    }
+    m_layouts.push_back({std::string(name), windows, std::move(titles)});
+}
+
+void LayoutSnapshotWriter::addRule(const WindowRuleConfig& rule) {
+    m_rules.push_back(rule);
+}
+
+void LayoutSnapshotWriter::addMonitorConfig(const MonitorGridConfig& config) {
+    m_monitors.push_back(config);
+}
+
+std::vector<unsigned char> LayoutSnapshotWriter::serialize() const {
+    std::string strings;
+    auto addString = [&strings](std::string_view text) {
+        StringRef ref = {static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(text.size())};
+        strings.append(text.data(), text.size());
+        return ref;
+    };
+
+    // 이름순 정렬 (로드 시 이진 탐색)
+    std::vector<const PendingLayout*> sorted;
+    sorted.reserve(m_layouts.size());
+    for (const auto& layout : m_layouts) sorted.push_back(&layout);
+    std::sort(sorted.begin(), sorted.end(),
+        [](const PendingLayout* a, const PendingLayout* b) { return a->name < b->name; });
+
+    std::vector<StoredLayout> layouts;
+    std::vector<StoredWindowLayout> windows;
+    std::vector<std::uint64_t> titles;
+    layouts.reserve(sorted.size());
+    for (const PendingLayout* layout : sorted) {
+        StoredLayout stored;
+        stored.name = addString(layout->name);
+        stored.firstWindow = static_cast<std::uint32_t>(windows.size());
+        stored.windowCount = static_cast<std::uint32_t>(layout->windows.size());
+        windows.insert(windows.end(), layout->windows.begin(), layout->windows.end());
+        titles.insert(titles.end(), layout->titleHashes.begin(), layout->titleHashes.end());
+        layouts.push_back(stored);
+    }
+
+    std::vector<StoredRule> rules;
+    rules.reserve(m_rules.size());
+    for (const auto& rule : m_rules) {
+        StoredRule stored = {};
+        stored.className = addString(rule.className);
+        stored.titlePattern = addString(rule.titlePattern);
+        stored.executable = addString(rule.executable);
+        stored.action = rule.action;
+        stored.slot = rule.slot;
+        stored.monitor = rule.monitor;
+        stored.minWidth = rule.minWidth;
+        stored.minHeight = rule.minHeight;
+        rules.push_back(stored);
+    }
+
+    std::vector<StoredMonitorConfig> monitors;
+    monitors.reserve(m_monitors.size());
+    for (const auto& config : m_monitors) {
+        monitors.push_back({config.topologyKey, config.monitorIndex, config.rows, config.cols, 0});
+    }
+
+    struct Section {
+        std::uint32_t type;
+        std::uint32_t count;
+        const void* data;
+        size_t size;
+    };
+    const Section sections[kSectionCount] = {
+        {SectionGrid, 1, &m_grid, sizeof(StoredGrid)},
+        {SectionLayouts, static_cast<std::uint32_t>(layouts.size()), layouts.data(), layouts.size() * sizeof(StoredLayout)},
+        {SectionLayoutWindows, static_cast<std::uint32_t>(windows.size()), windows.data(), windows.size() * sizeof(StoredWindowLayout)},
+        {SectionRules, static_cast<std::uint32_t>(rules.size()), rules.data(), rules.size() * sizeof(StoredRule)},
+        {SectionMonitors, static_cast<std::uint32_t>(monitors.size()), monitors.data(), monitors.size() * sizeof(StoredMonitorConfig)},
+        {SectionStrings, static_cast<std::uint32_t>(strings.size()), strings.data(), strings.size()},
+        {SectionWindowTitles, static_cast<std::uint32_t>(titles.size()), titles.data(), titles.size() * sizeof(std::uint64_t)},
+    };
+
+    size_t offset = sizeof(FileHeader) + kSectionCount * sizeof(SectionEntry);
+    SectionEntry entries[kSectionCount];
+    for (std::uint32_t i = 0; i < kSectionCount; ++i) {
+        offset = alignUp(offset);
+        entries[i] = {sections[i].type, sections[i].count, offset, sections[i].size};
+        offset += sections[i].size;
+    }
+
+    std::vector<unsigned char> image(alignUp(offset), 0);
+    std::memcpy(image.data() + sizeof(FileHeader), entries, sizeof(entries));
+    for (std::uint32_t i = 0; i < kSectionCount; ++i) {
+        if (sections[i].size) std::memcpy(image.data() + entries[i].offset, sections[i].data, sections[i].size);
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.sectionCount = kSectionCount;
+    header.fileSize = image.size();
+    header.checksum = checksum(image.data() + sizeof(FileHeader), image.size() - sizeof(FileHeader));
+    std::memcpy(image.data(), &header, sizeof(header));
+    return image;
+}
+
+bool LayoutSnapshotWriter::writeAtomic(const std::filesystem::path& path) const {
+    std::vector<unsigned char> image = serialize();
+    return writeFileAtomic(path, image.data(), image.size());
+}
+
+// ---- 로드 ----
+
+bool LayoutSnapshot::open(const std::filesystem::path& path) {
+    close();
+    if (!m_file.open(path)) return false;
+    if (!attach(m_file.data(), m_file.size())) {
+        m_file.close();
+        return false;
+    }
+    return true;
+}
+
+void LayoutSnapshot::close() {
+    m_file.close();
+    m_data = nullptr;
+    m_grid = nullptr;
+    m_layouts = nullptr;
+    m_layoutCount = 0;
+    m_windows = nullptr;
+    m_windowCount = 0;
+    m_titleHashes = nullptr;
+    m_rules = nullptr;
+    m_ruleCount = 0;
+    m_monitors = nullptr;
+    m_monitorCount = 0;
+    m_strings = nullptr;
+    m_stringsSize = 0;
+}
+
+bool LayoutSnapshot::attach(const unsigned char* data, size_t size) {
+    m_data = nullptr;
+    if (!data || size < sizeof(FileHeader)) return false;
+
+    const auto* header = reinterpret_cast<const FileHeader*>(data);
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0) return false;
+    if (header->version != kVersion) return false;
+    if (header->fileSize != size) return false;
+    if (header->sectionCount == 0 || header->sectionCount > 64) return false;
+    if (sizeof(FileHeader) + header->sectionCount * sizeof(SectionEntry) > size) return false;
+    if (checksum(data + sizeof(FileHeader), size - sizeof(FileHeader)) != header->checksum) return false;
+
+    const auto* entries = reinterpret_cast<const SectionEntry*>(data + sizeof(FileHeader));
+    LayoutSnapshot view;
+    std::uint32_t titleCount = 0;
+    for (std::uint32_t i = 0; i < header->sectionCount; ++i) {
+        const SectionEntry& entry = entries[i];
+        if (entry.offset % 8 != 0 || entry.offset > size || entry.size > size - entry.offset) return false;
+
+        const unsigned char* p = data + entry.offset;
+        auto expect = [&entry](size_t recordSize) {
+            return entry.size == static_cast<std::uint64_t>(entry.count) * recordSize;
+        };
+        switch (entry.type) {
+            case SectionGrid:
+                if (entry.count != 1 || !expect(sizeof(StoredGrid))) return false;
+                view.m_grid = reinterpret_cast<const StoredGrid*>(p);
+                // 체크섬이 맞아도 값은 settings.conf / 이전 텍스트 설정과 같은 범위만 받는다
+                if (view.m_grid->rows < 1 || view.m_grid->rows > 64 || view.m_grid->cols < 1 ||
+                    view.m_grid->cols > 64 || !(view.m_grid->opacity >= 0.0f && view.m_grid->opacity <= 1.0f)) {
+                    return false;
+                }
+                break;
+            case SectionLayouts:
+                if (!expect(sizeof(StoredLayout))) return false;
+                view.m_layouts = reinterpret_cast<const StoredLayout*>(p);
+                view.m_layoutCount = entry.count;
+                break;
+            case SectionLayoutWindows:
+                if (!expect(sizeof(StoredWindowLayout))) return false;
+                view.m_windows = reinterpret_cast<const StoredWindowLayout*>(p);
+                view.m_windowCount = entry.count;
+                break;
+            case SectionRules:
+                if (!expect(sizeof(StoredRule))) return false;
+                view.m_rules = reinterpret_cast<const StoredRule*>(p);
+                view.m_ruleCount = entry.count;
+                break;
+            case SectionMonitors:
+                if (!expect(sizeof(StoredMonitorConfig))) return false;
+                view.m_monitors = reinterpret_cast<const StoredMonitorConfig*>(p);
+                view.m_monitorCount = entry.count;
+                break;
+            case SectionWindowTitles:
+                if (!expect(sizeof(std::uint64_t))) return false;
+                view.m_titleHashes = reinterpret_cast<const std::uint64_t*>(p);
+                titleCount = entry.count;
+                break;
+            case SectionStrings:
+                if (!expect(1)) return false;
+                view.m_strings = reinterpret_cast<const char*>(p);
+                view.m_stringsSize = entry.count;
+                break;
+            default:
+                // 이후 버전에서 추가된 섹션은 무시
+                break;
+        }
+    }
+    if (!view.m_grid) return false;
+    if (view.m_titleHashes && titleCount != view.m_windowCount) return false;
+
+    // 인덱스/문자열 참조 범위만 확인 (레코드 자체는 그대로 사용)
+    auto validRef = [&view](StringRef ref) {
+        return ref.offset <= view.m_stringsSize && ref.length <= view.m_stringsSize - ref.offset;
+    };
+    for (size_t i = 0; i < view.m_layoutCount; ++i) {
+        const StoredLayout& layout = view.m_layouts[i];
+        if (!validRef(layout.name)) return false;
+        if (layout.firstWindow > view.m_windowCount ||
+            layout.windowCount > view.m_windowCount - layout.firstWindow) return false;
+    }
+    for (size_t i = 0; i < view.m_ruleCount; ++i) {
+        const StoredRule& rule = view.m_rules[i];
+        if (!validRef(rule.className) || !validRef(rule.titlePattern) || !validRef(rule.executable)) return false;
+    }
+
+    m_data = data;
+    m_grid = view.m_grid;
+    m_layouts = view.m_layouts;
+    m_layoutCount = view.m_layoutCount;
+    m_windows = view.m_windows;
+    m_windowCount = view.m_windowCount;
+    m_titleHashes = view.m_titleHashes;
+    m_rules = view.m_rules;
+    m_ruleCount = view.m_ruleCount;
+    m_monitors = view.m_monitors;
+    m_monitorCount = view.m_monitorCount;
+    m_strings = view.m_strings;
+    m_stringsSize = view.m_stringsSize;
+    return true;
+}
+
+LayoutSnapshot::LayoutView LayoutSnapshot::layout(size_t index) const {
+    const StoredLayout& layout = m_layouts[index];
+    return {string(layout.name), m_windows + layout.firstWindow,
+            m_titleHashes ? m_titleHashes + layout.firstWindow : nullptr, layout.windowCount};
+}
+
+bool LayoutSnapshot::findLayout(std::string_view name, LayoutView& out) const {
+    size_t lo = 0, hi = m_layoutCount;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        std::string_view midName = string(m_layouts[mid].name);
+        if (midName < name) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == m_layoutCount || string(m_layouts[lo].name) != name) return false;
+    out = layout(lo);
+    return true;
+}
+
+WindowRuleConfig LayoutSnapshot::ruleConfig(size_t index) const {
+    const StoredRule& stored = m_rules[index];
+    WindowRuleConfig rule;
+    rule.className = std::string(string(stored.className));
+    rule.titlePattern = std::string(string(stored.titlePattern));
+    rule.executable = std::string(string(stored.executable));
+    rule.action = stored.action;
+    rule.slot = stored.slot;
+    rule.monitor = stored.monitor;
+    rule.minWidth = stored.minWidth;
+    rule.minHeight = stored.minHeight;
+    return rule;
+}
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+template <typename T>
+static bool parseField(const char*& p, const char* end, T& out) {
+    while (p < end && isSpace(*p)) ++p;
+    auto result = std::from_chars(p, end, out);
+    if (result.ec != std::errc() || (result.ptr < end && !isSpace(*result.ptr))) return false;
+    p = result.ptr;
+    return true;
+}
+
+bool parseLegacyGridConfig(std::string_view text, LegacyGridConfig& out) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    LegacyGridConfig parsed;
+    if (!parseField(p, end, parsed.rows) || !parseField(p, end, parsed.cols) ||
+        !parseField(p, end, parsed.opacity)) {
+        return false;
+    }
+    if (parsed.rows < 1 || parsed.rows > 64 || parsed.cols < 1 || parsed.cols > 64) return false;
+    if (!(parsed.opacity >= 0.0f && parsed.opacity <= 1.0f)) return false;
+    out = parsed;
+    return true;
+}
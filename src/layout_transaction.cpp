@@ -0,0 +1,56 @@
+#include "layout_transaction.h"
+#include <algorithm>
+
+LayoutCommitStats LayoutTransaction::commit() {
+    LayoutCommitStats stats;
+
+    // 같은 창은 마지막 요청만 남긴다. 요청 순번을 함께 정렬해 순서를 유지한다
+    // (stable_sort 는 임시 버퍼를 힙에서 할당하므로 순번 배열을 이벤트 arena 에서 빌린다)
+    EventArena& arena = m_arena ? *m_arena : m_ownArena;
+    EventArena::Scope scope(arena);
+    const size_t count = m_pending.size();
+    std::uint32_t* order = arena.allocateArray<std::uint32_t>(count);
+    for (size_t i = 0; i < count; ++i) order[i] = static_cast<std::uint32_t>(i);
+    std::sort(order, order + count, [this](std::uint32_t a, std::uint32_t b) {
+        const WindowId wa = m_pending[a].window, wb = m_pending[b].window;
+        return wa != wb ? wa < wb : a < b;
+    });
+
+    m_effective.clear();
+    for (size_t i = 0; i < count; ++i) {
+        if (i + 1 < count && m_pending[order[i + 1]].window == m_pending[order[i]].window) continue;
+        const WindowMove& move = m_pending[order[i]];
+        ++stats.requested;
+
+        Rect current;
+        if (!m_backend.getWindowRect(move.window, current)) {
+            ++stats.failed;
+        } else if (!(move.flags & (MoveShow | MoveHide)) && current == move.target) {
+            ++stats.skipped;
+        } else {
+            m_effective.push_back(move);
+        }
+    }
+    m_pending.clear();
+
+    if (m_effective.empty()) return stats;
+
+    if (m_effective.size() > 1) {
+        ++stats.batches;
+        if (m_backend.applyBatch(m_effective.data(), m_effective.size())) {
+            stats.issued = m_effective.size();
+            return stats;
+        }
+        stats.fellBack = true;
+    }
+
+    // 배치 실패(또는 창 하나)면 창별로 개별 이동
+    for (const auto& move : m_effective) {
+        if (m_backend.applyOne(move)) {
+            ++stats.issued;
+        } else {
+            ++stats.failed;
+        }
+    }
+    return stats;
+}
@@ -1,140 +1,186 @@
-#include <windows.h>
-#include <shellapi.h>
-#include <tchar.h>
-#include "window_manager.h"
-#include "hotkey_manager.h"
-
-#define WM_TRAYICON (WM_USER + 1)
-#define IDI_TRAYICON 1
-#define IDM_EXIT 100
-
-NOTIFYICONDATA nid = {0};
-HWND hwnd;
-HMENU hPopMenu;
-
-// 디버그 메시지 출력
-void ShowDebugMessage(const TCHAR* message) {
-    MessageBox(NULL, message, _T("디버그"), MB_OK);
-}
-
-// 윈도우 프로시저
-LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
-    switch (msg) {
-        case WM_CREATE: {
-            ShowDebugMessage(_T("WM_CREATE 시작"));
-
-            // 트레이 아이콘 설정
-            nid.cbSize = sizeof(NOTIFYICONDATA);
-            nid.hWnd = hwnd;
-            nid.uID = IDI_TRAYICON;
-            nid.uFlags = NIF_ICON | NIF_MESSAGE | NIF_TIP;
-            nid.uCallbackMessage = WM_TRAYICON;
-            nid.hIcon = LoadIcon(NULL, IDI_APPLICATION);
-            _tcscpy_s(nid.szTip, _T("Window Manager"));
-            
-            if (!Shell_NotifyIcon(NIM_ADD, &nid)) {
-                ShowDebugMessage(_T("트레이 아이콘 생성 실패"));
-                return -1;
-            }
-
-            // 팝업 메뉴
-            hPopMenu = CreatePopupMenu();
-            InsertMenu(hPopMenu, 0, MF_BYPOSITION | MF_STRING, IDM_EXIT, _T("종료"));
-
-            // 기본 핫키 등록 (Win + 1)
-            if (!RegisterHotKey(hwnd, 1, MOD_WIN, '1')) {
-                ShowDebugMessage(_T("테스트 핫키 등록 실패"));
-                return -1;
-            }
-
-            ShowDebugMessage(_T("초기화 완료"));
-            return 0;
-        }
-
-        case WM_HOTKEY: {
-            ShowDebugMessage(_T("핫키 감지됨"));
-            HWND foreground = GetForegroundWindow();
-            if (foreground) {
-                // 테스트: 창을 화면 왼쪽으로 이동
-                RECT workArea;
-                SystemParametersInfo(SPI_GETWORKAREA, 0, &workArea, 0);
-                SetWindowPos(foreground, NULL, 
-                           workArea.left, workArea.top,
-                           (workArea.right - workArea.left) / 2,
-                           workArea.bottom - workArea.top,
-                           SWP_NOZORDER);
-            }
-            break;
-        }
-
-        case WM_TRAYICON:
-            if (lParam == WM_RBUTTONUP) {
-                POINT pt;
-                GetCursorPos(&pt);
-                SetForegroundWindow(hwnd);
-                TrackPopupMenu(hPopMenu, TPM_RIGHTALIGN | TPM_BOTTOMALIGN | TPM_RIGHTBUTTON,
-                             pt.x, pt.y, 0, hwnd, NULL);
-            }
-            break;
-
-        case WM_COMMAND:
-            if (LOWORD(wParam) == IDM_EXIT) {
-                DestroyWindow(hwnd);
-            }
-            break;
-
-        case WM_DESTROY:
-            UnregisterHotKey(hwnd, 1);  // 핫키 해제
-            Shell_NotifyIcon(NIM_DELETE, &nid);
-            PostQuitMessage(0);
-            break;
-
-        default:
-            return DefWindowProc(hwnd, msg, wParam, lParam);
-    }
-    return 0;
-}
-
-int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
-    ShowDebugMessage(_T("프로그램 시작"));
-
-    // 윈도우 클래스 등록
-    WNDCLASSEX wc = {0};
-    wc.cbSize = sizeof(WNDCLASSEX);
-    wc.lpfnWndProc = WndProc;
-    wc.hInstance = hInstance;
-    wc.lpszClassName = _T("WindowManager");
-    
-    if (!RegisterClassEx(&wc)) {
-        ShowDebugMessage(_T("윈도우 클래스 등록 실패"));
-        return FALSE;
-    }
-
-    // 윈도우 생성
-    hwnd = CreateWindowEx(
-        WS_EX_TOOLWINDOW,
-        _T("WindowManager"),
-        _T("Window Manager"),
-        WS_OVERLAPPED,
-        CW_USEDEFAULT, CW_USEDEFAULT,
-        1, 1,
-        NULL, NULL, hInstance, NULL
-    );
-
-    if (!hwnd) {
-        ShowDebugMessage(_T("윈도우 생성 실패"));
-        return FALSE;
-    }
-
-    ShowWindow(hwnd, SW_HIDE);
-    ShowDebugMessage(_T("메시지 루프 시작"));
-
-    // 메시지 루프
-    MSG msg;
-    while (GetMessage(&msg, NULL, 0, 0)) {
-        TranslateMessage(&msg);
-        DispatchMessage(&msg);
-    }
-
-    return (int)msg.wParam;
-}
+#include <windows.h>
+#include <shellapi.h>
+#include <tchar.h>
+#include "window_manager.h"
+#include "hotkey_manager.h"
+
+#define WM_TRAYICON (WM_USER + 1)
+#define IDI_TRAYICON 1
+#define IDM_EXIT 100
+#define IDM_TOGGLE_GRID 101
+#define IDM_TRACE_ENABLE 102
+#define IDM_TRACE_DUMP 103
+#define IDM_INPUT_RECORD 104
+
+NOTIFYICONDATA nid = {0};
+HWND hwnd;
+HMENU hPopMenu;
+
+// 디버그 메시지 출력
+void ShowDebugMessage(const TCHAR* message) {
+    // 메시지 박스는 핫키 처리 중에도 루프를 막으므로 디버거 출력만 사용
+    OutputDebugString(message);
+    OutputDebugString(_T("\n"));
+}
+
+// 풍선 알림
+void ShowTrayNotice(bool ok, const TCHAR* message) {
+    nid.uFlags = NIF_INFO;
+    nid.dwInfoFlags = ok ? NIIF_INFO : NIIF_WARNING;
+    _tcscpy_s(nid.szInfoTitle, _T("Window Manager"));
+    _tcsncpy_s(nid.szInfo, message, _TRUNCATE);
+    Shell_NotifyIcon(NIM_MODIFY, &nid);
+    nid.uFlags = NIF_ICON | NIF_MESSAGE | NIF_TIP;
+}
+
+// 윈도우 프로시저
+// 단축키/설정/창 이벤트는 WindowManager 와 HotkeyManager 가 처리하고, 이 창은 트레이와 디스플레이 변경만 받는다
+LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+    WindowManager& manager = WindowManager::getInstance();
+    switch (msg) {
+        case WM_CREATE: {
+            // 단축키와 모니터를 먼저 살리고 settings.conf/창 열거/명령 서버는 메시지 루프가 돈 뒤에
+            if (!manager.initialize()) {
+                ShowDebugMessage(_T("WindowManager 초기화 실패"));
+                return -1;
+            }
+
+            // 트레이 아이콘 설정
+            nid.cbSize = sizeof(NOTIFYICONDATA);
+            nid.hWnd = hwnd;
+            nid.uID = IDI_TRAYICON;
+            nid.uFlags = NIF_ICON | NIF_MESSAGE | NIF_TIP;
+            nid.uCallbackMessage = WM_TRAYICON;
+            nid.hIcon = LoadIcon(NULL, IDI_APPLICATION);
+            _tcscpy_s(nid.szTip, _T("Window Manager"));
+            Shell_NotifyIcon(NIM_ADD, &nid);
+
+            // 팝업 메뉴
+            hPopMenu = CreatePopupMenu();
+            AppendMenu(hPopMenu, MF_STRING, IDM_TOGGLE_GRID, _T("그리드"));
+            AppendMenu(hPopMenu, MF_STRING | MF_CHECKED, IDM_TRACE_ENABLE, _T("지연 시간 추적"));
+            AppendMenu(hPopMenu, MF_STRING, IDM_TRACE_DUMP, _T("지연 시간 추적 저장"));
+            AppendMenu(hPopMenu, MF_STRING, IDM_INPUT_RECORD, _T("입력 기록"));
+            AppendMenu(hPopMenu, MF_SEPARATOR, 0, NULL);
+            AppendMenu(hPopMenu, MF_STRING, IDM_EXIT, _T("종료"));
+            manager.getStartupTimeline().mark(StartupStage::TrayReady);
+
+            // 등록에 실패한 핫키는 메시지 상자 대신 풍선 알림 (기다리지 않는다)
+            const wchar_t* errors = HotkeyManager::getInstance().getErrorText();
+            if (errors[0]) ShowTrayNotice(false, errors);
+            return 0;
+        }
+
+        case WM_DISPLAYCHANGE:
+        case WM_DPICHANGED:
+            manager.updateMonitorInfo();
+            return DefWindowProc(hwnd, msg, wParam, lParam);
+
+        case WM_SETTINGCHANGE:
+            if (wParam == SPI_SETWORKAREA) manager.updateMonitorInfo();
+            return DefWindowProc(hwnd, msg, wParam, lParam);
+
+        case WM_TRAYICON:
+            if (lParam == WM_RBUTTONUP) {
+                POINT pt;
+                GetCursorPos(&pt);
+                SetForegroundWindow(hwnd);
+                TrackPopupMenu(hPopMenu, TPM_RIGHTALIGN | TPM_BOTTOMALIGN | TPM_RIGHTBUTTON,
+                             pt.x, pt.y, 0, hwnd, NULL);
+            }
+            break;
+
+        case WM_COMMAND:
+            switch (LOWORD(wParam)) {
+                case IDM_EXIT:
+                    DestroyWindow(hwnd);
+                    break;
+                case IDM_TOGGLE_GRID:
+                    manager.toggleGrid();
+                    break;
+                case IDM_TRACE_ENABLE: {
+                    LatencyTracer& tracer = manager.getLatencyTracer();
+                    tracer.setEnabled(!tracer.enabled());
+                    CheckMenuItem(hPopMenu, IDM_TRACE_ENABLE,
+                                  MF_BYCOMMAND | (tracer.enabled() ? MF_CHECKED : MF_UNCHECKED));
+                    break;
+                }
+                case IDM_TRACE_DUMP: {
+                    bool ok = manager.dumpLatencyTrace();
+                    ShowTrayNotice(ok, ok ? _T("지연 시간 추적을 latency_trace.json 에 저장했습니다.")
+                                          : _T("지연 시간 추적 저장 실패"));
+                    break;
+                }
+                case IDM_INPUT_RECORD:
+                    if (!manager.isInputRecording()) {
+                        manager.startInputRecording();
+                    } else {
+                        bool ok = manager.stopInputRecording();
+                        ShowTrayNotice(ok, ok ? _T("입력 기록을 input_trace.wmit 에 저장했습니다.")
+                                              : _T("입력 기록 저장 실패"));
+                    }
+                    CheckMenuItem(hPopMenu, IDM_INPUT_RECORD,
+                                  MF_BYCOMMAND | (manager.isInputRecording() ? MF_CHECKED : MF_UNCHECKED));
+                    break;
+            }
+            break;
+
+        case WM_DESTROY:
+            // 레이아웃/모니터별 그리드 저장 후 핫키 해제
+            manager.cleanup();
+            HotkeyManager::getInstance().cleanup();
+            Shell_NotifyIcon(NIM_DELETE, &nid);
+            PostQuitMessage(0);
+            break;
+
+        default:
+            return DefWindowProc(hwnd, msg, wParam, lParam);
+    }
+    return 0;
+}
+
+int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
+    // 윈도우 클래스 등록
+    WNDCLASSEX wc = {0};
+    wc.cbSize = sizeof(WNDCLASSEX);
+    wc.lpfnWndProc = WndProc;
+    wc.hInstance = hInstance;
+    wc.lpszClassName = _T("WindowManager");
+
+    if (!RegisterClassEx(&wc)) {
+        ShowDebugMessage(_T("윈도우 클래스 등록 실패"));
+        return FALSE;
+    }
+
+    // 트레이/디스플레이 변경 알림용 숨김 창 (메시지 전용 창은 WM_DISPLAYCHANGE 를 받지 못한다)
+    hwnd = CreateWindowEx(
+        WS_EX_TOOLWINDOW,
+        _T("WindowManager"),
+        _T("Window Manager"),
+        WS_OVERLAPPED,
+        CW_USEDEFAULT, CW_USEDEFAULT,
+        1, 1,
+        NULL, NULL, hInstance, NULL
+    );
+
+    if (!hwnd) {
+        ShowDebugMessage(_T("윈도우 생성 실패"));
+        return FALSE;
+    }
+
+    ShowWindow(hwnd, SW_HIDE);
+
+    // 메시지 루프
+    // RegisterHotKey(NULL, ...) 와 키보드 훅의 단축키는 창이 없는 스레드 메시지로 오므로 여기서 넘긴다
+    MSG msg;
+    while (GetMessage(&msg, NULL, 0, 0)) {
+        if (msg.hwnd == NULL && msg.message == WM_HOTKEY) {
+            HotkeyManager::getInstance().handleHotkey(static_cast<int>(msg.wParam));
+            continue;
+        }
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+    }
+
+    return (int)msg.wParam;
+}
@@ -0,0 +1,85 @@
+#include "monitor_topology.h"
+#include <algorithm>
+
+void MonitorTopology::rebuild(MonitorBackend& backend) {
+    m_monitors.clear();
+    backend.enumerate(m_monitors);
+
+    // 열거 순서와 무관하게 인덱스가 유지되도록 좌표 순으로 정렬
+    std::sort(m_monitors.begin(), m_monitors.end(),
+        [](const MonitorInfo& a, const MonitorInfo& b) {
+            if (a.bounds.left != b.bounds.left) return a.bounds.left < b.bounds.left;
+            return a.bounds.top < b.bounds.top;
+        });
+
+    m_bounds.clear();
+    m_bounds.reserve(m_monitors.size());
+    m_primary = m_monitors.empty() ? -1 : 0;
+    // 값 단위 FNV-1a (바이트 단위일 필요는 없다)
+    std::uint64_t key = 14695981039346656037ull;
+    auto mix = [&key](std::int64_t value) {
+        key ^= static_cast<std::uint64_t>(value);
+        key *= 1099511628211ull;
+    };
+    mix(static_cast<std::int64_t>(m_monitors.size()));
+    for (size_t i = 0; i < m_monitors.size(); ++i) {
+        m_monitors[i].index = static_cast<int>(i);
+        m_bounds.push_back(m_monitors[i].bounds);
+        if (m_monitors[i].primary) m_primary = static_cast<int>(i);
+        const Rect& b = m_monitors[i].bounds;
+        mix(b.left);
+        mix(b.top);
+        mix(b.right);
+        mix(b.bottom);
+    }
+    m_key = key;
+
+    ++m_generation;
+}
+
+int MonitorTopology::monitorFromPoint(Point pt) const {
+    const int count = static_cast<int>(m_bounds.size());
+    if (count == 0) return -1;
+
+    int nearest = 0;
+    long long bestDistance = -1;
+    for (int i = 0; i < count; ++i) {
+        long long d = distanceSquared(m_bounds[i], pt);
+        if (d == 0) return i;
+        if (bestDistance < 0 || d < bestDistance) {
+            bestDistance = d;
+            nearest = i;
+        }
+    }
+    return nearest;
+}
+
+int MonitorTopology::monitorFromRect(const Rect& rect) const {
+    const int count = static_cast<int>(m_bounds.size());
+    if (count == 0) return -1;
+
+    // 한 모니터 안에 완전히 들어가는 경우가 대부분 (모니터는 겹치지 않으므로 그 모니터가 최대)
+    const long long rectArea = static_cast<long long>(rect.width()) * rect.height();
+    int best = -1;
+    long long bestArea = 0;
+    for (int i = 0; i < count; ++i) {
+        long long area = intersectionArea(m_bounds[i], rect);
+        if (area > 0 && area == rectArea) return i;
+        if (area > bestArea) {
+            bestArea = area;
+            best = i;
+        }
+    }
+    if (best >= 0) return best;
+
+    // 어느 모니터와도 겹치지 않으면 중심점 기준으로 가장 가까운 모니터
+    Point center = {rect.left + rect.width() / 2, rect.top + rect.height() / 2};
+    return monitorFromPoint(center);
+}
+
+int MonitorTopology::indexOfHandle(std::uintptr_t handle) const {
+    for (const auto& m : m_monitors) {
+        if (m.handle == handle) return m.index;
+    }
+    return -1;
+}
@@ -0,0 +1,149 @@
+#include "overlay_surfaces.h"
+#include <algorithm>
+
+static Rect unionRect(const Rect& a, const Rect& b) {
+    return {std::min(a.left, b.left), std::min(a.top, b.top),
+            std::max(a.right, b.right), std::max(a.bottom, b.bottom)};
+}
+
+static bool touches(const Rect& a, const Rect& b) {
+    return a.left <= b.right && b.left <= a.right && a.top <= b.bottom && b.top <= a.bottom;
+}
+
+void DirtyRegion::add(const Rect& rect) {
+    if (rect.empty()) return;
+
+    // 겹치거나 맞닿은 사각형은 합친다
+    Rect merged = rect;
+    size_t i = 0;
+    while (i < m_count) {
+        if (touches(m_rects[i], merged)) {
+            merged = unionRect(m_rects[i], merged);
+            m_rects[i] = m_rects[--m_count];
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+
+    if (m_count == kMaxRects) {
+        // 너무 잘게 쪼개지면 전체를 하나로
+        merged = unionRect(bounds(), merged);
+        m_count = 0;
+    }
+    m_rects[m_count++] = merged;
+}
+
+Rect DirtyRegion::bounds() const {
+    if (m_count == 0) return Rect();
+    Rect result = m_rects[0];
+    for (size_t i = 1; i < m_count; ++i) result = unionRect(result, m_rects[i]);
+    return result;
+}
+
+void OverlaySurfaceSet::sync(const MonitorTopology& topology, const OverlayStyle& style) {
+    m_surfaces.resize(topology.size());
+
+    for (int i = 0; i < topology.size(); ++i) {
+        const MonitorInfo& monitor = topology.monitor(i);
+        OverlaySurface& surface = m_surfaces[i];
+
+        OverlaySurface::Key key;
+        key.bounds = monitor.bounds;
+        key.work = {monitor.workArea.left - monitor.bounds.left, monitor.workArea.top - monitor.bounds.top,
+                    monitor.workArea.right - monitor.bounds.left, monitor.workArea.bottom - monitor.bounds.top};
+        key.dpi = monitor.dpi;
+        key.rows = style.rows;
+        key.cols = style.cols;
+        monitorGridSize(style.monitorGrids, i, key.rows, key.cols);
+        key.opacity = style.opacity;
+        if (surface.m_valid && surface.m_key == key) continue;
+
+        surface.m_key = key;
+        surface.m_valid = true;
+        surface.m_fullRender = true;
+        surface.m_dirty.clear();
+        surface.m_hasHighlight = false;
+        surface.m_bounds = monitor.bounds;
+        surface.m_work = key.work;
+        surface.m_buffer.resize(monitor.bounds.width(), monitor.bounds.height());
+        surface.m_lines.build(key.work, key.rows, key.cols);
+
+        // 선 두께는 DPI 에 비례 (96 DPI = 1px)
+        const std::uint8_t alpha = static_cast<std::uint8_t>(std::clamp(style.opacity, 0.0f, 1.0f) * 255);
+        surface.m_style.background = 0;
+        surface.m_style.lineColor = premultiply(200, 200, 200, alpha);
+        surface.m_style.highlightColor = premultiply(0, 120, 215, static_cast<std::uint8_t>(alpha / 2));
+        surface.m_style.lineWidth = std::max(1u, (monitor.dpi + 48) / 96);
+    }
+}
+
+void OverlaySurfaceSet::markDirty(OverlaySurface& surface, const Rect& rect) {
+    if (!surface.m_fullRender) surface.m_dirty.add(rect);
+}
+
+void OverlaySurfaceSet::setHighlight(int monitorIndex, const Rect& screenRect) {
+    if (monitorIndex < 0 || monitorIndex >= size()) return;
+    OverlaySurface& surface = m_surfaces[monitorIndex];
+
+    Rect local = {screenRect.left - surface.m_bounds.left, screenRect.top - surface.m_bounds.top,
+                  screenRect.right - surface.m_bounds.left, screenRect.bottom - surface.m_bounds.top};
+    if (surface.m_hasHighlight && surface.m_highlight == local) return;
+
+    if (surface.m_hasHighlight) markDirty(surface, surface.m_highlight);
+    surface.m_highlight = local;
+    surface.m_hasHighlight = true;
+    markDirty(surface, local);
+}
+
+void OverlaySurfaceSet::clearHighlight(int monitorIndex) {
+    if (monitorIndex < 0 || monitorIndex >= size()) return;
+    OverlaySurface& surface = m_surfaces[monitorIndex];
+    if (!surface.m_hasHighlight) return;
+    markDirty(surface, surface.m_highlight);
+    surface.m_hasHighlight = false;
+}
+
+void OverlaySurfaceSet::clearHighlights() {
+    for (int i = 0; i < size(); ++i) clearHighlight(i);
+}
+
+bool OverlaySurfaceSet::needsRender(int monitorIndex) const {
+    const OverlaySurface& surface = m_surfaces[monitorIndex];
+    return surface.m_fullRender || !surface.m_dirty.empty();
+}
+
+bool OverlaySurfaceSet::render(int monitorIndex, Rect& updated) {
+    if (monitorIndex < 0 || monitorIndex >= size()) return false;
+    OverlaySurface& surface = m_surfaces[monitorIndex];
+    ArgbBuffer& buffer = surface.m_buffer;
+    const Rect* highlight = surface.m_hasHighlight ? &surface.m_highlight : nullptr;
+    const size_t highlightCount = surface.m_hasHighlight ? 1 : 0;
+
+    if (surface.m_fullRender) {
+        rasterizeGrid(buffer, surface.m_lines.xs(), surface.m_lines.ys(), surface.m_style, highlight, highlightCount);
+        surface.m_fullRender = false;
+        surface.m_dirty.clear();
+        updated = {0, 0, buffer.width(), buffer.height()};
+        ++m_stats.fullRenders;
+        m_stats.pixelsRendered += static_cast<std::uint64_t>(buffer.width()) * buffer.height();
+        return true;
+    }
+    if (surface.m_dirty.empty()) return false;
+
+    for (size_t i = 0; i < surface.m_dirty.count(); ++i) {
+        const Rect& rect = surface.m_dirty.rect(i);
+        rasterizeGridRegion(buffer, surface.m_lines.xs(), surface.m_lines.ys(), surface.m_style,
+                            highlight, highlightCount, rect);
+        m_stats.pixelsRendered += static_cast<std::uint64_t>(
+            intersectionArea(rect, {0, 0, buffer.width(), buffer.height()}));
+    }
+    updated = surface.m_dirty.bounds();
+    updated.left = std::max(updated.left, 0);
+    updated.top = std::max(updated.top, 0);
+    updated.right = std::min(updated.right, buffer.width());
+    updated.bottom = std::min(updated.bottom, buffer.height());
+    surface.m_dirty.clear();
+    ++m_stats.partialRenders;
+    return !updated.empty();
+}
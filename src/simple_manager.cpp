@@ -1,293 +1,535 @@
-#include <windows.h>
-#include <shellapi.h>
-#include <tchar.h>
-#include <map>
-#include <vector>
-#include <string>
-#include <dwmapi.h>
-#include <chrono>
-
-#pragma comment(lib, "dwmapi.lib")
-
-#define WM_TRAYICON (WM_USER + 1)
-#define IDI_TRAYICON 1
-#define IDM_EXIT 100
-
-// 핫키 ID 정의
-enum HotkeyIds {
-    HK_LEFT = 1001,
-    HK_RIGHT = 1002,
-    HK_TOP = 1003,
-    HK_BOTTOM = 1004,
-    HK_FULLSCREEN = 1005,
-    HK_TOGGLE_GRID = 1006,
-    HK_RESET = 1007
-};
-
-// 전역 변수
-NOTIFYICONDATA nid = {0};
-HWND hwnd;
-HMENU hPopMenu;
-bool isGridVisible = false;
-std::map<std::string, RECT> savedWindowPositions;
-int gridSize = 12;
-float gridOpacity = 0.3f;
-
-// 연속 키 입력 추적을 위한 변수
-struct KeyState {
-    int count;
-    std::chrono::steady_clock::time_point lastPress;
-};
-std::map<int, KeyState> keyStates;
-const int KEY_TIMEOUT_MS = 500;
-
-// 디버그 메시지 출력
-void ShowDebugMessage(const TCHAR* message) {
-    OutputDebugString(message);
-    OutputDebugString(_T("\n"));
-}
-
-// 핫키 등록 함수
-bool RegisterAppHotkey(HWND hwnd, int id, UINT modifiers, UINT vk, const TCHAR* description) {
-    UnregisterHotKey(hwnd, id);
-    if (!RegisterHotKey(hwnd, id, modifiers, vk)) {
-        TCHAR buffer[256];
-        _stprintf_s(buffer, _T("핫키 등록 실패: %s (Error: %d)"), description, GetLastError());
-        MessageBox(NULL, buffer, _T("오류"), MB_OK | MB_ICONERROR);
-        return false;
-    }
-    return true;
-}
-
-// 창 위치 조정 함수
-void SnapWindow(HWND targetWindow, int position) {
-    if (!targetWindow || !IsWindow(targetWindow)) return;
-
-    // 현재 모니터의 작업 영역 가져오기
-    HMONITOR hMonitor = MonitorFromWindow(targetWindow, MONITOR_DEFAULTTONEAREST);
-    MONITORINFO mi = { sizeof(MONITORINFO) };
-    GetMonitorInfo(hMonitor, &mi);
-    RECT workArea = mi.rcWork;
-
-    int screenWidth = workArea.right - workArea.left;
-    int screenHeight = workArea.bottom - workArea.top;
-    RECT newPos = workArea;
-
-    // 좌우 키 처리
-    if (position == HK_LEFT || position == HK_RIGHT) {
-        auto now = std::chrono::steady_clock::now();
-        auto& state = keyStates[position];
-        
-        // 타임아웃 체크
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - state.lastPress).count();
-        if (elapsed > KEY_TIMEOUT_MS) {
-            state.count = -1;
-        }
-
-        // 비율 설정 (1/2 → 1/3 → 1/4 → 3/4)
-        float ratios[] = {0.5f, 0.33f, 0.25f, 0.75f};
-        state.count = (state.count + 1) % 4;
-        state.lastPress = now;
-
-        int newWidth = static_cast<int>(screenWidth * ratios[state.count]);
-
-        if (position == HK_LEFT) {
-            newPos.right = workArea.left + newWidth;
-        } else {
-            newPos.left = workArea.right - newWidth;
-        }
-
-        TCHAR buffer[256];
-        _stprintf_s(buffer, _T("단계: %d, 비율: %.3f, 너비: %d (전체: %d)"),
-                    state.count + 1, ratios[state.count], newWidth, screenWidth);
-        ShowDebugMessage(buffer);
-    }
-    // 상하 키 처리
-    else if (position == HK_TOP || position == HK_BOTTOM) {
-        if (position == HK_TOP) {
-            newPos.bottom = workArea.top + screenHeight/2;
-        } else {
-            newPos.top = workArea.top + screenHeight/2;
-        }
-    }
-
-    // 창 위치 및 크기 설정
-    SetWindowPos(targetWindow, NULL,
-                newPos.left, newPos.top,
-                newPos.right - newPos.left,
-                newPos.bottom - newPos.top,
-                SWP_NOZORDER);
-}
-
-// 그리드 그리기 함수
-void DrawGrid(HDC hdc, const RECT& rect) {
-    BLENDFUNCTION blend = {AC_SRC_OVER, 0, static_cast<BYTE>(gridOpacity * 255), AC_SRC_ALPHA};
-    
-    int cellWidth = (rect.right - rect.left) / gridSize;
-    int cellHeight = (rect.bottom - rect.top) / gridSize;
-
-    HPEN hPen = CreatePen(PS_SOLID, 1, RGB(100, 100, 100));
-    HPEN hOldPen = (HPEN)SelectObject(hdc, hPen);
-
-    for (int i = 1; i < gridSize; i++) {
-        int x = rect.left + i * cellWidth;
-        MoveToEx(hdc, x, rect.top, NULL);
-        LineTo(hdc, x, rect.bottom);
-    }
-
-    for (int i = 1; i < gridSize; i++) {
-        int y = rect.top + i * cellHeight;
-        MoveToEx(hdc, rect.left, y, NULL);
-        LineTo(hdc, rect.right, y);
-    }
-
-    SelectObject(hdc, hOldPen);
-    DeleteObject(hPen);
-}
-
-// 윈도우 프로시저
-LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
-    switch (msg) {
-        case WM_CREATE: {
-            // 트레이 아이콘 설정
-            nid.cbSize = sizeof(NOTIFYICONDATA);
-            nid.hWnd = hwnd;
-            nid.uID = IDI_TRAYICON;
-            nid.uFlags = NIF_ICON | NIF_MESSAGE | NIF_TIP;
-            nid.uCallbackMessage = WM_TRAYICON;
-            nid.hIcon = LoadIcon(NULL, IDI_APPLICATION);
-            _tcscpy_s(nid.szTip, _T("Window Manager"));
-            Shell_NotifyIcon(NIM_ADD, &nid);
-
-            // 팝업 메뉴
-            hPopMenu = CreatePopupMenu();
-            InsertMenu(hPopMenu, 0, MF_BYPOSITION | MF_STRING, IDM_EXIT, _T("종료"));
-
-            // KeyState 초기화
-            keyStates[HK_LEFT] = {-1, std::chrono::steady_clock::now()};
-            keyStates[HK_RIGHT] = {-1, std::chrono::steady_clock::now()};
-
-            // 핫키 등록
-            bool success = true;
-            success &= RegisterAppHotkey(hwnd, HK_LEFT, MOD_CONTROL, VK_LEFT, _T("Ctrl + Left"));
-            success &= RegisterAppHotkey(hwnd, HK_RIGHT, MOD_CONTROL, VK_RIGHT, _T("Ctrl + Right"));
-            success &= RegisterAppHotkey(hwnd, HK_TOP, MOD_CONTROL, VK_UP, _T("Ctrl + Up"));
-            success &= RegisterAppHotkey(hwnd, HK_BOTTOM, MOD_CONTROL, VK_DOWN, _T("Ctrl + Down"));
-            success &= RegisterAppHotkey(hwnd, HK_FULLSCREEN, MOD_CONTROL, VK_RETURN, _T("Ctrl + Enter"));
-            success &= RegisterAppHotkey(hwnd, HK_TOGGLE_GRID, MOD_CONTROL, 'G', _T("Ctrl + G"));
-            success &= RegisterAppHotkey(hwnd, HK_RESET, MOD_CONTROL, 'R', _T("Ctrl + R"));
-
-            if (!success) {
-                MessageBox(NULL, _T("일부 핫키 등록 실패"), _T("경고"), MB_OK | MB_ICONWARNING);
-            }
-
-            MessageBox(NULL, _T("Window Manager가 시작되었습니다.\n\n"
-                               "Ctrl + ←/→: 좌/우 정렬 (연속 입력 시 1/2 → 1/3 → 1/4 → 3/4)\n"
-                               "Ctrl + ↑/↓: 상/하 절반\n"
-                               "Ctrl + Enter: 전체화면\n"
-                               "Ctrl + G: 그리드 표시/숨김\n"
-                               "Ctrl + R: 창 크기 초기화"),
-                      _T("Window Manager"), MB_OK | MB_ICONINFORMATION);
-            break;
-        }
-
-        case WM_HOTKEY: {
-            int hotkeyId = (int)wParam;
-            ShowDebugMessage(_T("핫키 감지"));
-
-            HWND foreground = GetForegroundWindow();
-            if (foreground) {
-                if (hotkeyId == HK_TOGGLE_GRID) {
-                    ShowDebugMessage(_T("그리드 토글"));
-                    isGridVisible = !isGridVisible;
-                    InvalidateRect(NULL, NULL, TRUE);
-                } else if (hotkeyId == HK_RESET) {
-                    ShowDebugMessage(_T("창 크기 초기화"));
-                    ShowWindow(foreground, SW_RESTORE);
-                } else {
-                    SnapWindow(foreground, hotkeyId);
-                }
-            }
-            break;
-        }
-
-        case WM_PAINT:
-            if (isGridVisible) {
-                PAINTSTRUCT ps;
-                HDC hdc = BeginPaint(hwnd, &ps);
-                RECT workArea;
-                SystemParametersInfo(SPI_GETWORKAREA, 0, &workArea, 0);
-                DrawGrid(hdc, workArea);
-                EndPaint(hwnd, &ps);
-            }
-            break;
-
-        case WM_TRAYICON:
-            if (lParam == WM_RBUTTONUP) {
-                POINT pt;
-                GetCursorPos(&pt);
-                SetForegroundWindow(hwnd);
-                TrackPopupMenu(hPopMenu, TPM_RIGHTALIGN | TPM_BOTTOMALIGN | TPM_RIGHTBUTTON,
-                             pt.x, pt.y, 0, hwnd, NULL);
-            }
-            break;
-
-        case WM_COMMAND:
-            if (LOWORD(wParam) == IDM_EXIT) {
-                DestroyWindow(hwnd);
-            }
-            break;
-
-        case WM_DESTROY:
-            // 핫키 해제
-            for (int i = HK_LEFT; i <= HK_RESET; i++) {
-                UnregisterHotKey(hwnd, i);
-            }
-            Shell_NotifyIcon(NIM_DELETE, &nid);
-            PostQuitMessage(0);
-            break;
-
-        default:
-            return DefWindowProc(hwnd, msg, wParam, lParam);
-    }
-    return 0;
-}
-
-int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
-    // 윈도우 클래스 등록
-    WNDCLASSEX wc = {0};
-    wc.cbSize = sizeof(WNDCLASSEX);
-    wc.lpfnWndProc = WndProc;
-    wc.hInstance = hInstance;
-    wc.lpszClassName = _T("WindowManager");
-    RegisterClassEx(&wc);
-
-    // 윈도우 생성
-    hwnd = CreateWindowEx(
-        WS_EX_TOOLWINDOW | WS_EX_LAYERED,
-        _T("WindowManager"),
-        _T("Window Manager"),
-        WS_POPUP,
-        0, 0, GetSystemMetrics(SM_CXSCREEN), GetSystemMetrics(SM_CYSCREEN),
-        NULL, NULL, hInstance, NULL
-    );
-
-    if (!hwnd) {
-        MessageBox(NULL, _T("윈도우 생성 실패"), _T("오류"), MB_OK | MB_ICONERROR);
-        return FALSE;
-    }
-
-    // 투명도 설정
-    SetLayeredWindowAttributes(hwnd, 0, 0, LWA_ALPHA);
-    ShowWindow(hwnd, SW_SHOW);
-
-    // 메시지 루프
-    MSG msg;
-    while (GetMessage(&msg, NULL, 0, 0)) {
-        TranslateMessage(&msg);
-        DispatchMessage(&msg);
-    }
-
-    return (int)msg.wParam;
-}
+#include <windows.h>
+#include <shellapi.h>
+#include <tchar.h>
+#include <vector>
+#include <string>
+#include <dwmapi.h>
+#include <chrono>
+#include <filesystem>
+#include "monitor_topology.h"
+#include "win32_monitor_backend.h"
+#include "win32_window_move_backend.h"
+#include "async_move_executor.h"
+#include "window_animator.h"
+#include "win32_frame_clock.h"
+#include "win32_overlay_windows.h"
+#include "drag_snapper.h"
+#include "snap_geometry.h"
+#include "latency_trace.h"
+#include "input_trace.h"
+#include "command_server.h"
+#include "startup_profiler.h"
+
+#pragma comment(lib, "dwmapi.lib")
+
+#define WM_TRAYICON (WM_USER + 1)
+#define WM_APP_COMMANDS_PENDING (WM_USER + 2)
+#define WM_APP_DEFERRED_INIT (WM_USER + 3)
+#define IDI_TRAYICON 1
+#define IDM_EXIT 100
+#define IDM_TRACE_ENABLE 101
+#define IDM_TRACE_DUMP 102
+#define IDM_INPUT_RECORD 103
+#define IDM_ANIMATE 104
+#define IDM_STARTUP_REPORT 105
+
+// 핫키 ID 정의
+enum HotkeyIds {
+    HK_LEFT = 1001,
+    HK_RIGHT = 1002,
+    HK_TOP = 1003,
+    HK_BOTTOM = 1004,
+    HK_FULLSCREEN = 1005,
+    HK_TOGGLE_GRID = 1006,
+    HK_RESET = 1007
+};
+
+// 시작 타임라인 (프로세스 생성 시점 기준, 트레이 메뉴로 startup_timeline.txt 에 저장)
+StartupTimeline startupTimeline;
+
+// 전역 변수
+NOTIFYICONDATA nid = {0};
+HWND hwnd;
+HMENU hPopMenu;
+bool isGridVisible = false;
+int gridSize = 12;
+float gridOpacity = 0.3f;
+
+// 모니터 토폴로지 캐시 (디스플레이/작업 영역 변경 시에만 갱신)
+Win32MonitorBackend monitorBackend;
+MonitorTopology monitorTopology;
+
+// 단축키 -> 이동 구간별 지연 (트레이 메뉴에서 Chrome trace 로 저장, 이동 작업 스레드도 기록)
+LatencyTracer latencyTracer;
+
+// 입력 기록 (단축키/포그라운드/디스플레이 변경, wm_bench --replay 로 재생)
+InputRecorder inputRecorder;
+
+// 창별 스타일/가림/프레임 간격 캐시 (단축키마다 속성을 다시 묻지 않고, 배율이 바뀌면 비운다)
+Win32WindowFrameSource frameSource;
+WindowFrameCache frameCache(frameSource);
+
+// 창 이동은 작업 스레드에서 (응답 없는 앱이 메시지 루프를 막지 않도록, 변화 없는 이동은 건너뜀)
+// 보이는 프레임 기준으로 배치해 보이지 않는 테두리 때문에 틈이 생기지 않는다
+Win32WindowMoveBackend win32MoveBackend;
+FramedWindowMoveBackend moveBackend(win32MoveBackend, frameCache);
+AsyncMoveExecutor moveExecutor(moveBackend);
+
+// 스냅 애니메이션 (트레이 메뉴로 켬). 스레드 하나가 DWM 프레임마다 진행 중인 창을 옮긴다
+Win32DwmFrameClock frameClock;
+WindowAnimator animator(moveBackend, frameClock);
+bool animateSnaps = false;
+const std::int64_t kSnapAnimationNs = 150'000'000;
+
+// 그리드 오버레이 (모니터마다 버퍼/창 하나, 설정이 바뀐 모니터만 다시 그림)
+OverlaySurfaceSet overlaySurfaces;
+Win32OverlayWindows overlayWindows;
+
+// 연속 키 입력 추적 (같은 방향 키를 제한 시간 안에 다시 누르면 다음 비율)
+RatioCycler ratioCycler(500);
+
+// 디버그 메시지 출력
+void ShowDebugMessage(const TCHAR* message) {
+    OutputDebugString(message);
+    OutputDebugString(_T("\n"));
+}
+
+// 등록에 실패한 핫키 이름 (메시지 루프가 돈 뒤 풍선 알림으로 한 번에 표시)
+TCHAR hotkeyErrors[128] = _T("");
+
+// 핫키 등록 함수
+// 시작을 막지 않도록 메시지 상자 없이 실패한 키만 모은다
+bool RegisterAppHotkey(HWND hwnd, int id, UINT modifiers, UINT vk, const TCHAR* description) {
+    UnregisterHotKey(hwnd, id);
+    if (!RegisterHotKey(hwnd, id, modifiers, vk)) {
+        TCHAR buffer[128];
+        _stprintf_s(buffer, _T("핫키 등록 실패: %s (Error: %d)\n"), description, GetLastError());
+        OutputDebugString(buffer);
+        if (hotkeyErrors[0]) _tcscat_s(hotkeyErrors, _T(", "));
+        _tcscat_s(hotkeyErrors, description);
+        return false;
+    }
+    return true;
+}
+
+// 스크립트용 명령 서버 - 배치의 이동은 트랜잭션 한 번으로 적용
+// 이 실행 파일에는 저장된 작업 공간이 없어 레이아웃 명령은 unknown-layout
+class ScriptCommandHandler : public CommandHandler {
+public:
+    void execute(CommandBatch& batch) override {
+        for (const Command& command : batch.commands) {
+            switch (command.op) {
+                case CommandOp::Snap:
+                case CommandOp::Move: {
+                    HWND target = toHWND(command.window);
+                    WindowFrameInfo frame;
+                    RECT windowRect;
+                    if (!IsWindow(target) || !frameCache.get(command.window, frame) || !frame.manageable ||
+                        !GetWindowRect(target, &windowRect)) {
+                        batch.addResult(CommandStatus::UnknownWindow);
+                        break;
+                    }
+                    Rect newPos = command.rect;
+                    if (command.op == CommandOp::Snap) {
+                        const int monitorIndex = monitorTopology.monitorFromRect(toRect(windowRect));
+                        if (monitorIndex < 0) {
+                            batch.addResult(CommandStatus::Invalid);
+                            break;
+                        }
+                        newPos = calculateSnapRect(monitorTopology.monitor(monitorIndex).workArea, command.position);
+                    }
+                    if (newPos.right <= newPos.left || newPos.bottom <= newPos.top) {
+                        batch.addResult(CommandStatus::Invalid);
+                        break;
+                    }
+                    animator.cancel(command.window);
+                    if (moveExecutor.isHung(command.window)) {
+                        moveExecutor.submit(command.window, newPos);
+                    } else {
+                        if (IsZoomed(target)) ShowWindow(target, SW_RESTORE);
+                        m_transaction.move(command.window, newPos);
+                    }
+                    batch.addResult(CommandStatus::Ok);
+                    break;
+                }
+                case CommandOp::Query: {
+                    CommandResult result{CommandStatus::Ok, static_cast<std::uint32_t>(batch.states.size()), 0};
+                    if (command.window) {
+                        if (!queryWindow(toHWND(command.window), batch)) {
+                            batch.addResult(CommandStatus::UnknownWindow);
+                            break;
+                        }
+                    } else {
+                        // 창 이벤트 훅이 없으므로 최상위 창을 열거한다
+                        EnumWindows([](HWND window, LPARAM param) -> BOOL {
+                            if (IsWindowVisible(window)) queryWindow(window, *reinterpret_cast<CommandBatch*>(param));
+                            return TRUE;
+                        }, reinterpret_cast<LPARAM>(&batch));
+                    }
+                    result.stateCount = static_cast<std::uint32_t>(batch.states.size()) - result.firstState;
+                    batch.results.push_back(result);
+                    break;
+                }
+                case CommandOp::ApplyLayout:
+                    batch.addResult(CommandStatus::UnknownLayout);
+                    break;
+                default:
+                    batch.addResult(CommandStatus::Invalid);
+                    break;
+            }
+        }
+        if (!m_transaction.empty()) m_transaction.commit();
+    }
+
+private:
+    static bool queryWindow(HWND window, CommandBatch& batch) {
+        WindowFrameInfo frame;
+        Rect rect;
+        if (!IsWindow(window) || !frameCache.get(toWindowId(window), frame) || !frame.manageable ||
+            !moveBackend.getWindowRect(toWindowId(window), rect)) {
+            return false;
+        }
+        batch.states.push_back({toWindowId(window), rect, IsWindowVisible(window) && !frame.cloaked});
+        return true;
+    }
+
+    LayoutTransaction m_transaction{moveBackend};
+};
+
+CommandServer commandServer;
+ScriptCommandHandler commandHandler;
+
+// 연결 스레드에서 불린다 - 실행은 메시지 루프에서
+void OnCommandsPending(void*) {
+    PostMessage(hwnd, WM_APP_COMMANDS_PENDING, 0, 0);
+}
+
+// 창 위치 조정 함수
+void SnapWindow(HWND targetWindow, int position, std::uint32_t traceSpan) {
+    // 자식/도구 창과 가려진 창은 옮기지 않는다 (캐시 조회)
+    WindowFrameInfo frame;
+    if (!targetWindow || !frameCache.get(toWindowId(targetWindow), frame)) return;
+    // 창 이벤트 훅이 없으므로 DPI 가 다른 모니터로 옮겨진 창은 여기서 알아채고 다시 읽는다
+    if (GetDpiForWindow(targetWindow) != frame.dpi) {
+        frameCache.invalidate(toWindowId(targetWindow));
+        if (!frameCache.get(toWindowId(targetWindow), frame)) return;
+    }
+    if (!frame.manageable || frame.cloaked) return;
+
+    // 현재 모니터의 작업 영역 가져오기 (캐시 조회)
+    RECT windowRect;
+    if (!GetWindowRect(targetWindow, &windowRect)) return;
+    int monitorIndex = monitorTopology.monitorFromRect(toRect(windowRect));
+    if (monitorIndex < 0) return;
+    const Rect& workArea = monitorTopology.monitor(monitorIndex).workArea;
+    Rect newPos = workArea;
+
+    // 좌우 키 처리 (비율 1/2 → 1/3 → 1/4 → 3/4)
+    if (position == HK_LEFT || position == HK_RIGHT) {
+        int step = ratioCycler.advance(position, static_cast<std::int64_t>(GetTickCount64()));
+        newPos = sideSnapRect(workArea, position == HK_LEFT, step);
+
+        TCHAR buffer[256];
+        _stprintf_s(buffer, _T("단계: %d, 비율: %.3f, 너비: %d (전체: %d)"),
+                    step + 1, RatioCycler::ratio(step), newPos.width(), workArea.width());
+        ShowDebugMessage(buffer);
+    }
+    // 상하 키 처리
+    else if (position == HK_TOP || position == HK_BOTTOM) {
+        newPos = halfSnapRect(workArea, position == HK_TOP);
+    }
+
+    // 창 위치 및 크기 설정
+    // 애니메이션 중에 비율이 바뀌면 새 애니메이션을 쌓지 않고 진행 중인 것의 목표만 바꾼다
+    latencyTracer.mark(traceSpan, TraceStage::GeometryComputed);
+    const WindowId window = toWindowId(targetWindow);
+    if (animateSnaps && !moveExecutor.isHung(window) && animator.animate(window, newPos, kSnapAnimationNs)) return;
+    animator.cancel(window);
+    moveExecutor.submit(window, newPos, traceSpan);
+}
+
+// %LOCALAPPDATA%\WindowManager
+std::filesystem::path AppDataDir() {
+    wchar_t base[MAX_PATH];
+    DWORD length = GetEnvironmentVariableW(L"LOCALAPPDATA", base, MAX_PATH);
+    std::filesystem::path dir = (length > 0 && length < MAX_PATH)
+        ? std::filesystem::path(base) / L"WindowManager"
+        : std::filesystem::current_path();
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    return dir;
+}
+
+// 풍선 알림
+void ShowTrayNotice(bool ok, const TCHAR* message) {
+    nid.uFlags = NIF_INFO;
+    nid.dwInfoFlags = ok ? NIIF_INFO : NIIF_WARNING;
+    _tcscpy_s(nid.szInfoTitle, _T("Window Manager"));
+    _tcscpy_s(nid.szInfo, message);
+    Shell_NotifyIcon(NIM_MODIFY, &nid);
+    nid.uFlags = NIF_ICON | NIF_MESSAGE | NIF_TIP;
+}
+
+// latency_trace.json 에 저장하고 풍선 알림으로 결과 표시
+void DumpLatencyTrace() {
+    bool ok = latencyTracer.writeChromeTrace(AppDataDir() / L"latency_trace.json");
+    ShowTrayNotice(ok, ok ? _T("지연 시간 추적을 latency_trace.json 에 저장했습니다.")
+                          : _T("지연 시간 추적 저장 실패"));
+}
+
+// 입력 기록 시작/중지 (중지하면 input_trace.wmit 로 저장)
+void ToggleInputRecording() {
+    if (!inputRecorder.active()) {
+        const std::int64_t now = InputRecorder::nowUs();
+        inputRecorder.start(now);
+        inputRecorder.displayChange(monitorTopology, now);
+        inputRecorder.gridSize(gridSize, gridSize, now);
+    } else {
+        inputRecorder.stop();
+        bool ok = inputRecorder.save(AppDataDir() / L"input_trace.wmit");
+        ShowTrayNotice(ok, ok ? _T("입력 기록을 input_trace.wmit 에 저장했습니다.")
+                              : _T("입력 기록 저장 실패"));
+    }
+    CheckMenuItem(hPopMenu, IDM_INPUT_RECORD, MF_BYCOMMAND | (inputRecorder.active() ? MF_CHECKED : MF_UNCHECKED));
+}
+
+// startup_timeline.txt 에 저장하고 풍선 알림으로 결과 표시
+void DumpStartupTimeline() {
+    bool ok = startupTimeline.writeReport(AppDataDir() / L"startup_timeline.txt");
+    ShowTrayNotice(ok, ok ? _T("시작 시간 기록을 startup_timeline.txt 에 저장했습니다.")
+                          : _T("시작 시간 기록 저장 실패"));
+}
+
+// 그리드 오버레이 갱신 함수
+// 표시/숨김은 창 상태만 바꾸고, 내용은 설정/토폴로지가 바뀐 모니터만 다시 그린다
+void UpdateGridOverlay() {
+    if (!isGridVisible) {
+        overlayWindows.setVisible(false);
+        return;
+    }
+
+    OverlayStyle style;
+    style.rows = gridSize;
+    style.cols = gridSize;
+    style.opacity = gridOpacity;
+    style.visible = true;
+    overlaySurfaces.sync(monitorTopology, style);
+    overlayWindows.present(overlaySurfaces);
+    overlayWindows.setVisible(true);
+}
+
+// 윈도우 프로시저
+LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+    switch (msg) {
+        case WM_CREATE: {
+            startupTimeline.mark(StartupStage::WindowCreated);
+            ::hwnd = hwnd;
+
+            // 로그인 직후 다른 프로그램들과 같이 뜨므로 핫키부터 등록 (실패는 모아 두었다가 알림)
+            bool success = true;
+            success &= RegisterAppHotkey(hwnd, HK_LEFT, MOD_CONTROL, VK_LEFT, _T("Ctrl + Left"));
+            success &= RegisterAppHotkey(hwnd, HK_RIGHT, MOD_CONTROL, VK_RIGHT, _T("Ctrl + Right"));
+            success &= RegisterAppHotkey(hwnd, HK_TOP, MOD_CONTROL, VK_UP, _T("Ctrl + Up"));
+            success &= RegisterAppHotkey(hwnd, HK_BOTTOM, MOD_CONTROL, VK_DOWN, _T("Ctrl + Down"));
+            success &= RegisterAppHotkey(hwnd, HK_FULLSCREEN, MOD_CONTROL, VK_RETURN, _T("Ctrl + Enter"));
+            success &= RegisterAppHotkey(hwnd, HK_TOGGLE_GRID, MOD_CONTROL, 'G', _T("Ctrl + G"));
+            success &= RegisterAppHotkey(hwnd, HK_RESET, MOD_CONTROL, 'R', _T("Ctrl + R"));
+            startupTimeline.mark(StartupStage::HotkeysLive);
+
+            // 모니터 정보 캐시 (첫 단축키가 바로 쓴다)
+            monitorTopology.rebuild(monitorBackend);
+            moveExecutor.setTracer(&latencyTracer);
+            startupTimeline.mark(StartupStage::MonitorsReady);
+
+            // 트레이 아이콘 설정
+            nid.cbSize = sizeof(NOTIFYICONDATA);
+            nid.hWnd = hwnd;
+            nid.uID = IDI_TRAYICON;
+            nid.uFlags = NIF_ICON | NIF_MESSAGE | NIF_TIP;
+            nid.uCallbackMessage = WM_TRAYICON;
+            nid.hIcon = LoadIcon(NULL, IDI_APPLICATION);
+            _tcscpy_s(nid.szTip, _T("Window Manager"));
+            Shell_NotifyIcon(NIM_ADD, &nid);
+
+            // 팝업 메뉴
+            hPopMenu = CreatePopupMenu();
+            AppendMenu(hPopMenu, MF_STRING | MF_CHECKED, IDM_TRACE_ENABLE, _T("지연 시간 추적"));
+            AppendMenu(hPopMenu, MF_STRING, IDM_TRACE_DUMP, _T("지연 시간 추적 저장"));
+            AppendMenu(hPopMenu, MF_STRING, IDM_INPUT_RECORD, _T("입력 기록"));
+            AppendMenu(hPopMenu, MF_STRING, IDM_ANIMATE, _T("스냅 애니메이션"));
+            AppendMenu(hPopMenu, MF_STRING, IDM_STARTUP_REPORT, _T("시작 시간 기록 저장"));
+            AppendMenu(hPopMenu, MF_SEPARATOR, 0, NULL);
+            AppendMenu(hPopMenu, MF_STRING, IDM_EXIT, _T("종료"));
+            startupTimeline.mark(StartupStage::TrayReady);
+
+            // 나머지(명령 서버, 시작 알림)는 메시지 루프가 돈 뒤에 (그리드 오버레이는 처음 켤 때 만든다)
+            PostMessage(hwnd, WM_APP_DEFERRED_INIT, 0, 0);
+            break;
+        }
+
+        case WM_APP_DEFERRED_INIT: {
+            // 다른 인스턴스가 이미 쓰고 있으면 명령 서버 없이 동작
+            commandServer.start(CommandServer::defaultEndpoint(), OnCommandsPending, nullptr);
+            startupTimeline.mark(StartupStage::CommandServerReady);
+
+            // 시작 안내/핫키 실패는 메시지 상자 대신 풍선 알림 (기다리지 않는다)
+            if (hotkeyErrors[0]) {
+                TCHAR notice[192];
+                _stprintf_s(notice, _T("핫키 등록 실패: %s"), hotkeyErrors);
+                ShowTrayNotice(false, notice);
+            } else {
+                ShowTrayNotice(true, _T("Window Manager가 시작되었습니다.\n"
+                                        "Ctrl + 방향키: 정렬, Ctrl + Enter: 전체화면, Ctrl + G: 그리드, Ctrl + R: 초기화"));
+            }
+
+            startupTimeline.markIdle();
+            std::string report;
+            startupTimeline.format(report);
+            OutputDebugStringA(report.c_str());
+            break;
+        }
+
+        case WM_HOTKEY: {
+            int hotkeyId = (int)wParam;
+            std::uint32_t span = latencyTracer.beginSpan();
+            startupTimeline.mark(StartupStage::FirstHotkey);
+
+            HWND foreground = GetForegroundWindow();
+            if (foreground) {
+                latencyTracer.mark(span, TraceStage::ForegroundLookup);
+                if (inputRecorder.active()) {
+                    // 단축키 직전 창 위치를 함께 남겨 재생이 같은 위치에서 출발하게 한다
+                    const std::int64_t now = InputRecorder::nowUs();
+                    RECT windowRect;
+                    if (GetWindowRect(foreground, &windowRect)) {
+                        inputRecorder.windowRect(toWindowId(foreground), toRect(windowRect), now);
+                    }
+                    inputRecorder.foreground(toWindowId(foreground), now);
+                    inputRecorder.hotkey(hotkeyId, now);
+                }
+                if (hotkeyId == HK_TOGGLE_GRID) {
+                    ShowDebugMessage(_T("그리드 토글"));
+                    isGridVisible = !isGridVisible;
+                    UpdateGridOverlay();
+                } else if (hotkeyId == HK_RESET) {
+                    ShowDebugMessage(_T("창 크기 초기화"));
+                    ShowWindow(foreground, SW_RESTORE);
+                } else {
+                    SnapWindow(foreground, hotkeyId, span);
+                }
+            }
+            break;
+        }
+
+        case WM_DISPLAYCHANGE:
+        case WM_DPICHANGED:
+            monitorTopology.rebuild(monitorBackend);
+            frameCache.invalidateAll();
+            inputRecorder.displayChange(monitorTopology, InputRecorder::nowUs());
+            UpdateGridOverlay();
+            return DefWindowProc(hwnd, msg, wParam, lParam);
+
+        case WM_SETTINGCHANGE:
+            if (wParam == SPI_SETWORKAREA) {
+                monitorTopology.rebuild(monitorBackend);
+                inputRecorder.displayChange(monitorTopology, InputRecorder::nowUs());
+                UpdateGridOverlay();
+            }
+            return DefWindowProc(hwnd, msg, wParam, lParam);
+
+        case WM_APP_COMMANDS_PENDING:
+            commandServer.processPending(commandHandler);
+            break;
+
+        case WM_TRAYICON:
+            if (lParam == WM_RBUTTONUP) {
+                POINT pt;
+                GetCursorPos(&pt);
+                SetForegroundWindow(hwnd);
+                TrackPopupMenu(hPopMenu, TPM_RIGHTALIGN | TPM_BOTTOMALIGN | TPM_RIGHTBUTTON,
+                             pt.x, pt.y, 0, hwnd, NULL);
+            }
+            break;
+
+        case WM_COMMAND:
+            switch (LOWORD(wParam)) {
+                case IDM_EXIT:
+                    DestroyWindow(hwnd);
+                    break;
+                case IDM_TRACE_ENABLE:
+                    latencyTracer.setEnabled(!latencyTracer.enabled());
+                    CheckMenuItem(hPopMenu, IDM_TRACE_ENABLE,
+                                  MF_BYCOMMAND | (latencyTracer.enabled() ? MF_CHECKED : MF_UNCHECKED));
+                    break;
+                case IDM_TRACE_DUMP:
+                    DumpLatencyTrace();
+                    break;
+                case IDM_INPUT_RECORD:
+                    ToggleInputRecording();
+                    break;
+                case IDM_ANIMATE:
+                    animateSnaps = !animateSnaps;
+                    CheckMenuItem(hPopMenu, IDM_ANIMATE, MF_BYCOMMAND | (animateSnaps ? MF_CHECKED : MF_UNCHECKED));
+                    break;
+                case IDM_STARTUP_REPORT:
+                    DumpStartupTimeline();
+                    break;
+            }
+            break;
+
+        case WM_DESTROY:
+            commandServer.stop();
+            // 핫키 해제
+            for (int i = HK_LEFT; i <= HK_RESET; i++) {
+                UnregisterHotKey(hwnd, i);
+            }
+            Shell_NotifyIcon(NIM_DELETE, &nid);
+            overlayWindows.destroy();
+            PostQuitMessage(0);
+            break;
+
+        default:
+            return DefWindowProc(hwnd, msg, wParam, lParam);
+    }
+    return 0;
+}
+
+int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
+    startupTimeline.mark(StartupStage::MainEntered);
+
+    // 윈도우 클래스 등록
+    WNDCLASSEX wc = {0};
+    wc.cbSize = sizeof(WNDCLASSEX);
+    wc.lpfnWndProc = WndProc;
+    wc.hInstance = hInstance;
+    wc.lpszClassName = _T("WindowManager");
+    RegisterClassEx(&wc);
+
+    // 윈도우 생성
+    hwnd = CreateWindowEx(
+        WS_EX_TOOLWINDOW | WS_EX_LAYERED | WS_EX_TRANSPARENT | WS_EX_NOACTIVATE,
+        _T("WindowManager"),
+        _T("Window Manager"),
+        WS_POPUP,
+        0, 0, GetSystemMetrics(SM_CXSCREEN), GetSystemMetrics(SM_CYSCREEN),
+        NULL, NULL, hInstance, NULL
+    );
+
+    if (!hwnd) {
+        // 로그인 시작을 막지 않도록 메시지 상자 없이 종료
+        ShowDebugMessage(_T("윈도우 생성 실패"));
+        return FALSE;
+    }
+
+    // 메인 창은 트레이/핫키 메시지만 받고 숨겨둔다 (그리드는 모니터별 오버레이 창)
+    ShowWindow(hwnd, SW_HIDE);
+
+    // 메시지 루프
+    MSG msg;
+    while (GetMessage(&msg, NULL, 0, 0)) {
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+    }
+
+    return (int)msg.wParam;
+}
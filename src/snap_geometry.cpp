@@ -0,0 +1,161 @@
+#include "snap_geometry.h"
+#include <array>
+
+// 비율 순환 단계: 1/2 -> 1/3 -> 1/4 -> 3/4
+static constexpr SlotFraction kRatioFractions[kRatioSteps] = {{1, 2}, {1, 3}, {1, 4}, {3, 4}};
+
+static constexpr std::array<SlotSpec, kSnapSlotCount> makeSlotSpecs() {
+    constexpr SlotFraction zero{0, 1}, quarter{1, 4}, half{1, 2}, threeQuarters{3, 4}, one{1, 1};
+    std::array<SlotSpec, kSnapSlotCount> specs{};
+    // WindowPosition 순서. 가운데 줄/열은 1/4 ~ 3/4
+    specs[0] = {zero, zero, half, half};
+    specs[1] = {quarter, zero, threeQuarters, half};
+    specs[2] = {half, zero, one, half};
+    specs[3] = {zero, quarter, half, threeQuarters};
+    specs[4] = {quarter, quarter, threeQuarters, threeQuarters};
+    specs[5] = {half, quarter, one, threeQuarters};
+    specs[6] = {zero, half, half, one};
+    specs[7] = {quarter, half, threeQuarters, one};
+    specs[8] = {half, half, one, one};
+    // 오른쪽 슬롯의 왼쪽 경계는 1 - 비율 (왼쪽 슬롯과 같은 분수라 둘이 정확히 맞닿는다)
+    for (int step = 0; step < kRatioSteps; ++step) {
+        const SlotFraction ratio = kRatioFractions[step];
+        const SlotFraction rest{static_cast<std::uint8_t>(ratio.den - ratio.num), ratio.den};
+        specs[sideSlot(true, step)] = {zero, zero, ratio, one};
+        specs[sideSlot(false, step)] = {rest, zero, one, one};
+    }
+    specs[halfSlot(true)] = {zero, zero, one, half};
+    specs[halfSlot(false)] = {zero, half, one, one};
+    return specs;
+}
+
+static constexpr std::array<SlotSpec, kSnapSlotCount> kSlotSpecs = makeSlotSpecs();
+
+static constexpr bool exactUnits(SlotFraction f) {
+    return f.den > 0 && kSlotUnits % f.den == 0 && f.num <= f.den;
+}
+
+static constexpr std::uint8_t toUnits(SlotFraction f) {
+    return static_cast<std::uint8_t>(f.num * (kSlotUnits / f.den));
+}
+
+static constexpr bool slotSpecsExact() {
+    for (const SlotSpec& spec : kSlotSpecs) {
+        if (!exactUnits(spec.left) || !exactUnits(spec.top) || !exactUnits(spec.right) || !exactUnits(spec.bottom)) {
+            return false;
+        }
+        if (toUnits(spec.left) >= toUnits(spec.right) || toUnits(spec.top) >= toUnits(spec.bottom)) return false;
+    }
+    return true;
+}
+static_assert(slotSpecsExact(), "slot fractions must be exact in twelfths and non-empty");
+
+static constexpr std::array<SlotUnits, kSnapSlotCount> makeSlotUnits() {
+    std::array<SlotUnits, kSnapSlotCount> units{};
+    for (int i = 0; i < kSnapSlotCount; ++i) {
+        const SlotSpec& spec = kSlotSpecs[i];
+        units[i] = {toUnits(spec.left), toUnits(spec.top), toUnits(spec.right), toUnits(spec.bottom)};
+    }
+    return units;
+}
+
+static constexpr std::array<SlotUnits, kSnapSlotCount> kSlotUnitTable = makeSlotUnits();
+
+const SlotSpec& snapSlotSpec(int slot) {
+    return kSlotSpecs[static_cast<unsigned>(slot) < kSnapSlotCount ? slot : 0];
+}
+
+const SlotUnits& snapSlotUnits(int slot) {
+    return kSlotUnitTable[static_cast<unsigned>(slot) < kSnapSlotCount ? slot : 0];
+}
+
+Rect slotRect(const Rect& workArea, int slot) {
+    const SlotUnits& units = snapSlotUnits(slot);
+    const int width = workArea.width();
+    const int height = workArea.height();
+    return {slotEdge(workArea.left, width, units.left), slotEdge(workArea.top, height, units.top),
+            slotEdge(workArea.left, width, units.right), slotEdge(workArea.top, height, units.bottom)};
+}
+
+Rect calculateSnapRect(const Rect& workArea, WindowPosition position) {
+    return slotRect(workArea, positionSlot(position));
+}
+
+int RatioCycler::advance(int key, std::int64_t nowMs) {
+    KeyState* state = nullptr;
+    for (int i = 0; i < m_keyCount; ++i) {
+        if (m_keys[i].key == key) {
+            state = &m_keys[i];
+            break;
+        }
+    }
+    if (!state) {
+        // 키 종류는 몇 개뿐 - 가득 차면 첫 칸을 재사용
+        state = &m_keys[m_keyCount < kMaxKeys ? m_keyCount++ : 0];
+        *state = KeyState();
+        state->key = key;
+    }
+
+    if (state->step < 0 || nowMs - state->lastMs > m_timeoutMs) state->step = -1;
+    state->step = (state->step + 1) % kSteps;
+    state->lastMs = nowMs;
+    return state->step;
+}
+
+float RatioCycler::ratio(int step) {
+    const SlotFraction& ratio = kRatioFractions[step % kSteps];
+    return static_cast<float>(ratio.num) / ratio.den;
+}
+
+Rect sideSnapRect(const Rect& workArea, bool left, int step) {
+    return slotRect(workArea, sideSlot(left, step));
+}
+
+Rect halfSnapRect(const Rect& workArea, bool top) {
+    return slotRect(workArea, halfSlot(top));
+}
+
+// ---- 일괄 계산 ----
+
+void SlotBatch::resize(size_t count) {
+    for (auto* column : {&areaLeft, &areaTop, &left, &top, &right, &bottom}) column->resize(count);
+    for (auto* column : {&areaWidth, &areaHeight, &unitLeft, &unitTop, &unitRight, &unitBottom}) column->resize(count);
+}
+
+void SlotBatch::set(size_t index, const Rect& workArea, int slot) {
+    const SlotUnits& units = snapSlotUnits(slot);
+    areaLeft[index] = workArea.left;
+    areaTop[index] = workArea.top;
+    areaWidth[index] = static_cast<std::uint32_t>(workArea.width());
+    areaHeight[index] = static_cast<std::uint32_t>(workArea.height());
+    unitLeft[index] = units.left;
+    unitTop[index] = units.top;
+    unitRight[index] = units.right;
+    unitBottom[index] = units.bottom;
+}
+
+void computeSlotRects(SlotBatch& batch) {
+    const size_t count = batch.size();
+    const std::int32_t* areaLeft = batch.areaLeft.data();
+    const std::int32_t* areaTop = batch.areaTop.data();
+    const std::uint32_t* width = batch.areaWidth.data();
+    const std::uint32_t* height = batch.areaHeight.data();
+    const std::uint32_t* unitLeft = batch.unitLeft.data();
+    const std::uint32_t* unitTop = batch.unitTop.data();
+    const std::uint32_t* unitRight = batch.unitRight.data();
+    const std::uint32_t* unitBottom = batch.unitBottom.data();
+    std::int32_t* left = batch.left.data();
+    std::int32_t* top = batch.top.data();
+    std::int32_t* right = batch.right.data();
+    std::int32_t* bottom = batch.bottom.data();
+
+    // 12 로 나누기는 곱셈/시프트가 된다 (slotEdge 와 같은 식이라 결과도 같다)
+    for (size_t i = 0; i < count; ++i) {
+        left[i] = areaLeft[i] + static_cast<std::int32_t>(width[i] * unitLeft[i] / kSlotUnits);
+        right[i] = areaLeft[i] + static_cast<std::int32_t>(width[i] * unitRight[i] / kSlotUnits);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        top[i] = areaTop[i] + static_cast<std::int32_t>(height[i] * unitTop[i] / kSlotUnits);
+        bottom[i] = areaTop[i] + static_cast<std::int32_t>(height[i] * unitBottom[i] / kSlotUnits);
+    }
+}
@@ -0,0 +1,159 @@
+#include "startup_profiler.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+const char* startupStageName(StartupStage stage) {
+    switch (stage) {
+        case StartupStage::MainEntered: return "main_entered";
+        case StartupStage::WindowCreated: return "window_created";
+        case StartupStage::HotkeysLive: return "hotkeys_live";
+        case StartupStage::MonitorsReady: return "monitors_ready";
+        case StartupStage::TrayReady: return "tray_ready";
+        case StartupStage::ConfigLoaded: return "config_loaded";
+        case StartupStage::WindowsScanned: return "windows_scanned";
+        case StartupStage::CommandServerReady: return "command_server_ready";
+        case StartupStage::Idle: return "idle";
+        case StartupStage::FirstHotkey: return "first_hotkey";
+        default: return "?";
+    }
+}
+
+#ifdef _WIN32
+
+std::int64_t processUptimeUs() {
+    FILETIME creation, exitTime, kernel, user, now;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user)) return 0;
+    GetSystemTimeAsFileTime(&now);
+    auto toTicks = [](const FILETIME& time) {
+        return (static_cast<std::int64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    // FILETIME 은 100ns 단위
+    const std::int64_t elapsed = (toTicks(now) - toTicks(creation)) / 10;
+    return elapsed > 0 ? elapsed : 0;
+}
+
+std::uint64_t residentMemoryBytes() {
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return counters.WorkingSetSize;
+}
+
+#elif defined(__linux__)
+
+std::int64_t processUptimeUs() {
+    // /proc/self/stat 의 22번째 값 = 부팅 후 프로세스 시작 시각 (clock tick)
+    // 2번째 값(실행 파일 이름)에 공백이 있을 수 있어 마지막 ')' 뒤부터 센다
+    char stat[1024];
+    FILE* file = std::fopen("/proc/self/stat", "r");
+    if (!file) return 0;
+    const size_t length = std::fread(stat, 1, sizeof(stat) - 1, file);
+    std::fclose(file);
+    stat[length] = '\0';
+    const char* p = nullptr;
+    for (const char* c = stat; *c; ++c) {
+        if (*c == ')') p = c;
+    }
+    if (!p) return 0;
+    unsigned long long startTicks = 0;
+    int field = 2;
+    for (; *p && field < 22; ++p) {
+        if (*p == ' ') ++field;
+    }
+    if (field != 22 || std::sscanf(p, "%llu", &startTicks) != 1) return 0;
+
+    double uptimeSeconds = 0;
+    file = std::fopen("/proc/uptime", "r");
+    if (!file) return 0;
+    const bool ok = std::fscanf(file, "%lf", &uptimeSeconds) == 1;
+    std::fclose(file);
+    const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    if (!ok || ticksPerSecond <= 0) return 0;
+
+    const double elapsed = uptimeSeconds - static_cast<double>(startTicks) / static_cast<double>(ticksPerSecond);
+    return elapsed > 0 ? static_cast<std::int64_t>(elapsed * 1e6) : 0;
+}
+
+std::uint64_t residentMemoryBytes() {
+    // /proc/self/statm: 전체 페이지 수, 상주 페이지 수, ...
+    unsigned long long pages = 0, resident = 0;
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file) return 0;
+    const bool ok = std::fscanf(file, "%llu %llu", &pages, &resident) == 2;
+    std::fclose(file);
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    return ok && pageSize > 0 ? resident * static_cast<std::uint64_t>(pageSize) : 0;
+}
+
+#else
+
+std::int64_t processUptimeUs() { return 0; }
+std::uint64_t residentMemoryBytes() { return 0; }
+
+#endif
+
+std::int64_t StartupTimeline::nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+StartupTimeline::StartupTimeline(std::int64_t originUs) : m_originUs(originUs) {
+    for (auto& stage : m_stages) stage.store(kNotReached, std::memory_order_relaxed);
+}
+
+void StartupTimeline::markAt(StartupStage stage, std::int64_t timeUs) {
+    const std::int64_t offset = timeUs > m_originUs ? timeUs - m_originUs : 0;
+    std::int64_t expected = kNotReached;
+    m_stages[static_cast<size_t>(stage)].compare_exchange_strong(expected, offset, std::memory_order_relaxed);
+}
+
+void StartupTimeline::markIdle() {
+    if (reached(StartupStage::Idle)) return;
+    m_idleResident.store(residentMemoryBytes(), std::memory_order_relaxed);
+    mark(StartupStage::Idle);
+}
+
+std::int64_t StartupTimeline::offsetUs(StartupStage stage) const {
+    return m_stages[static_cast<size_t>(stage)].load(std::memory_order_relaxed);
+}
+
+void StartupTimeline::format(std::string& out) const {
+    char line[96];
+    out += "startup timeline (ms since process start)\n";
+    for (size_t i = 0; i < static_cast<size_t>(StartupStage::Count); ++i) {
+        const StartupStage stage = static_cast<StartupStage>(i);
+        const std::int64_t offset = offsetUs(stage);
+        if (offset < 0) {
+            std::snprintf(line, sizeof(line), "  %-22s -\n", startupStageName(stage));
+        } else {
+            std::snprintf(line, sizeof(line), "  %-22s %10.3f\n", startupStageName(stage), offset / 1000.0);
+        }
+        out += line;
+    }
+    const std::int64_t firstHotkey = timeToFirstHotkeyUs();
+    if (firstHotkey >= 0) {
+        std::snprintf(line, sizeof(line), "time to first hotkey: %.3f ms\n", firstHotkey / 1000.0);
+        out += line;
+    }
+    if (reached(StartupStage::Idle)) {
+        std::snprintf(line, sizeof(line), "idle resident memory: %.1f MB\n",
+                      static_cast<double>(idleResidentBytes()) / (1024.0 * 1024.0));
+        out += line;
+    }
+}
+
+bool StartupTimeline::writeReport(const std::filesystem::path& path) const {
+    std::string text;
+    format(text);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,437 @@
+#include "tiling_engine.h"
+#include <algorithm>
+#include <cmath>
+
+static Rect insetRect(const Rect& r, int inset) {
+    return {r.left + inset, r.top + inset, r.right - inset, r.bottom - inset};
+}
+
+static float clampRatio(float ratio) {
+    return std::min(0.9f, std::max(0.1f, ratio));
+}
+
+void TilingEngine::syncTopology(const MonitorTopology& topology) {
+    const int count = topology.size();
+
+    // 사라진 모니터의 창은 첫 번째 모니터로 옮긴다
+    if (count < monitorCount()) {
+        std::vector<WindowId> orphans;
+        for (int m = count; m < monitorCount(); ++m) {
+            for (WindowId window : m_monitors[m].order) orphans.push_back(window);
+        }
+        for (WindowId window : orphans) removeWindow(window);
+        m_monitors.resize(count);
+        if (count > 0) {
+            for (WindowId window : orphans) addWindow(window, 0);
+        }
+    }
+    if (count > monitorCount()) m_monitors.resize(count);
+
+    for (int m = 0; m < count; ++m) {
+        MonitorState& monitor = m_monitors[m];
+        const Rect& work = topology.monitor(m).workArea;
+        if (monitor.workArea == work) continue;
+        monitor.workArea = work;
+        monitor.dirtyAll = true;
+    }
+}
+
+void TilingEngine::setOptions(int monitorIndex, const TilingOptions& options) {
+    if (monitorIndex < 0 || monitorIndex >= monitorCount()) return;
+    MonitorState& monitor = m_monitors[monitorIndex];
+    const bool modeChanged = monitor.options.mode != options.mode;
+    monitor.options = options;
+    monitor.options.masterRatio = clampRatio(options.masterRatio);
+    monitor.options.masterCount = std::max(1, options.masterCount);
+    if (modeChanged) rebuild(monitorIndex);
+    monitor.dirtyAll = true;
+}
+
+int TilingEngine::monitorOf(WindowId window) const {
+    auto it = m_index.find(window);
+    return it != m_index.end() ? m_windows[it->second].monitor : -1;
+}
+
+bool TilingEngine::targetOf(WindowId window, Rect& out) const {
+    auto it = m_index.find(window);
+    if (it == m_index.end()) return false;
+    out = m_windows[it->second].target;
+    return true;
+}
+
+int TilingEngine::allocNode() {
+    int node;
+    if (!m_freeNodes.empty()) {
+        node = m_freeNodes.back();
+        m_freeNodes.pop_back();
+        m_nodes[node] = Node();
+    } else {
+        node = static_cast<int>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+    return node;
+}
+
+void TilingEngine::freeNode(int node) {
+    m_nodes[node] = Node();
+    m_nodes[node].window = -2;  // 해제 표시 (더럽힘 목록에 남아 있어도 건너뜀)
+    m_freeNodes.push_back(node);
+}
+
+Rect TilingEngine::rootRect(const MonitorState& monitor) const {
+    return insetRect(monitor.workArea, monitor.options.gap / 2);
+}
+
+int TilingEngine::largestLeaf(const MonitorState& monitor) const {
+    int best = -1;
+    long long bestArea = -1;
+    std::vector<int> stack;
+    stack.push_back(monitor.root);
+    while (!stack.empty()) {
+        const int n = stack.back();
+        stack.pop_back();
+        const Node& node = m_nodes[n];
+        if (node.window >= 0) {
+            const long long area = static_cast<long long>(node.rect.width()) * node.rect.height();
+            if (area > bestArea) {
+                bestArea = area;
+                best = n;
+            }
+            continue;
+        }
+        stack.push_back(node.child[1]);
+        stack.push_back(node.child[0]);
+    }
+    return best;
+}
+
+void TilingEngine::markDirty(MonitorState& monitor, int node) {
+    monitor.dirtyNodes.push_back(node);
+}
+
+void TilingEngine::insertLeaf(MonitorState& monitor, int windowIndex, int splitLeaf) {
+    if (monitor.root < 0) {
+        const int leaf = allocNode();
+        m_nodes[leaf].window = windowIndex;
+        m_nodes[leaf].rect = rootRect(monitor);
+        monitor.root = leaf;
+        m_windows[windowIndex].leaf = leaf;
+        markDirty(monitor, leaf);
+        return;
+    }
+
+    // 나눌 타일을 고르려면 영역이 최신이어야 한다
+    settle(static_cast<int>(&monitor - m_monitors.data()));
+    if (splitLeaf < 0) splitLeaf = largestLeaf(monitor);
+
+    // 잎을 내부 노드로 바꾸고 기존 창과 새 창을 두 자식으로
+    const int first = allocNode();
+    const int second = allocNode();
+    Node& parent = m_nodes[splitLeaf];
+    m_nodes[first].parent = splitLeaf;
+    m_nodes[first].window = parent.window;
+    m_nodes[second].parent = splitLeaf;
+    m_nodes[second].window = windowIndex;
+    m_windows[parent.window].leaf = first;
+    m_windows[windowIndex].leaf = second;
+
+    parent.window = -1;
+    parent.child[0] = first;
+    parent.child[1] = second;
+    parent.ratio = 0.5f;
+    parent.vertical = parent.rect.width() >= parent.rect.height();
+    markDirty(monitor, splitLeaf);
+}
+
+void TilingEngine::removeLeaf(MonitorState& monitor, int leaf) {
+    const int parent = m_nodes[leaf].parent;
+    freeNode(leaf);
+    if (parent < 0) {
+        monitor.root = -1;
+        return;
+    }
+
+    // 형제가 부모 자리를 차지하고 부모 영역 전체를 쓴다
+    const int sibling = m_nodes[parent].child[0] == leaf ? m_nodes[parent].child[1] : m_nodes[parent].child[0];
+    const int grandparent = m_nodes[parent].parent;
+    m_nodes[sibling].parent = grandparent;
+    m_nodes[sibling].rect = m_nodes[parent].rect;
+    if (grandparent < 0) {
+        monitor.root = sibling;
+    } else {
+        Node& g = m_nodes[grandparent];
+        g.child[g.child[0] == parent ? 0 : 1] = sibling;
+    }
+    freeNode(parent);
+    markDirty(monitor, sibling);
+}
+
+void TilingEngine::rebuild(int monitorIndex) {
+    MonitorState& monitor = m_monitors[monitorIndex];
+
+    if (monitor.root >= 0) {
+        std::vector<int> stack;
+        stack.push_back(monitor.root);
+        while (!stack.empty()) {
+            const int n = stack.back();
+            stack.pop_back();
+            if (m_nodes[n].window == -1) {
+                stack.push_back(m_nodes[n].child[0]);
+                stack.push_back(m_nodes[n].child[1]);
+            }
+            freeNode(n);
+        }
+        monitor.root = -1;
+    }
+    monitor.dirtyNodes.clear();
+
+    for (WindowId window : monitor.order) {
+        const int index = m_index[window];
+        m_windows[index].leaf = -1;
+        if (monitor.options.mode == TilingMode::Bsp) insertLeaf(monitor, index, -1);
+    }
+}
+
+bool TilingEngine::addWindow(WindowId window, int monitorIndex, WindowId splitTarget) {
+    if (contains(window) || monitorIndex < 0 || monitorIndex >= monitorCount()) return false;
+
+    const int index = static_cast<int>(m_windows.size());
+    TiledWindow tiled;
+    tiled.window = window;
+    tiled.monitor = monitorIndex;
+    m_windows.push_back(tiled);
+    m_index.emplace(window, index);
+
+    MonitorState& monitor = m_monitors[monitorIndex];
+    monitor.order.push_back(window);
+    if (monitor.options.mode == TilingMode::Bsp) {
+        int splitLeaf = -1;
+        auto it = splitTarget ? m_index.find(splitTarget) : m_index.end();
+        if (it != m_index.end() && m_windows[it->second].monitor == monitorIndex) {
+            splitLeaf = m_windows[it->second].leaf;
+        }
+        insertLeaf(monitor, index, splitLeaf);
+    } else if (monitor.options.mode != TilingMode::Off) {
+        monitor.dirtyAll = true;
+    }
+    return true;
+}
+
+void TilingEngine::eraseWindow(int windowIndex) {
+    m_index.erase(m_windows[windowIndex].window);
+    const int last = static_cast<int>(m_windows.size()) - 1;
+    if (windowIndex != last) {
+        m_windows[windowIndex] = m_windows[last];
+        m_index[m_windows[windowIndex].window] = windowIndex;
+        if (m_windows[windowIndex].leaf >= 0) m_nodes[m_windows[windowIndex].leaf].window = windowIndex;
+    }
+    m_windows.pop_back();
+}
+
+bool TilingEngine::removeWindow(WindowId window) {
+    auto it = m_index.find(window);
+    if (it == m_index.end()) return false;
+    const int index = it->second;
+    MonitorState& monitor = m_monitors[m_windows[index].monitor];
+
+    monitor.order.erase(std::find(monitor.order.begin(), monitor.order.end(), window));
+    if (m_windows[index].leaf >= 0) {
+        removeLeaf(monitor, m_windows[index].leaf);
+    } else if (monitor.options.mode != TilingMode::Off) {
+        monitor.dirtyAll = true;
+    }
+    eraseWindow(index);
+    return true;
+}
+
+bool TilingEngine::resizeWindow(WindowId window, const Rect& actual) {
+    auto it = m_index.find(window);
+    if (it == m_index.end()) return false;
+    TiledWindow& tiled = m_windows[it->second];
+    MonitorState& monitor = m_monitors[tiled.monitor];
+    if (monitor.options.mode == TilingMode::Off) return false;
+
+    const Rect target = tiled.target;
+    tiled.placed = actual;
+    if (!tiled.changed) {
+        tiled.changed = true;
+        m_changed.push_back(window);
+    }
+    if (actual == target) return true;
+
+    const int inset = monitor.options.gap - monitor.options.gap / 2;
+
+    if (monitor.options.mode == TilingMode::Bsp) {
+        // 움직인 변과 맞닿은 가장 가까운 분할의 비율만 바꾼다
+        struct Edge { bool moved; bool vertical; int side; int position; };
+        const Edge edges[] = {
+            {actual.right != target.right, true, 0, actual.right + inset},
+            {actual.left != target.left, true, 1, actual.left - inset},
+            {actual.bottom != target.bottom, false, 0, actual.bottom + inset},
+            {actual.top != target.top, false, 1, actual.top - inset},
+        };
+        bool adjusted = false;
+        for (const Edge& edge : edges) {
+            if (!edge.moved) continue;
+            for (int node = tiled.leaf; m_nodes[node].parent >= 0; node = m_nodes[node].parent) {
+                Node& parent = m_nodes[m_nodes[node].parent];
+                if (parent.vertical != edge.vertical || parent.child[edge.side] != node) continue;
+                const int origin = edge.vertical ? parent.rect.left : parent.rect.top;
+                const int extent = edge.vertical ? parent.rect.width() : parent.rect.height();
+                if (extent > 0) parent.ratio = clampRatio(static_cast<float>(edge.position - origin) / extent);
+                markDirty(monitor, m_nodes[node].parent);
+                adjusted = true;
+                break;
+            }
+        }
+        // 바깥 변만 움직였으면 원래 타일로 되돌린다
+        if (!adjusted) markDirty(monitor, tiled.leaf);
+        return true;
+    }
+
+    if (monitor.options.mode == TilingMode::MasterStack) {
+        const int position = static_cast<int>(std::find(monitor.order.begin(), monitor.order.end(), window) -
+                                              monitor.order.begin());
+        const bool isMaster = position < monitor.options.masterCount;
+        const bool hasStack = static_cast<int>(monitor.order.size()) > monitor.options.masterCount;
+        const Rect area = rootRect(monitor);
+        if (hasStack && area.width() > 0) {
+            if (isMaster && actual.right != target.right) {
+                monitor.options.masterRatio = clampRatio(static_cast<float>(actual.right + inset - area.left) / area.width());
+            } else if (!isMaster && actual.left != target.left) {
+                monitor.options.masterRatio = clampRatio(static_cast<float>(actual.left - inset - area.left) / area.width());
+            }
+        }
+    }
+    // Columns 는 항상 같은 너비로 되돌린다
+    monitor.dirtyAll = true;
+    return true;
+}
+
+void TilingEngine::setTarget(int windowIndex, const Rect& tile, int gap) {
+    TiledWindow& tiled = m_windows[windowIndex];
+    ++m_stats.windowsLaidOut;
+    tiled.target = insetRect(tile, gap - gap / 2);
+    if (!tiled.changed) {
+        tiled.changed = true;
+        m_changed.push_back(tiled.window);
+    }
+}
+
+void TilingEngine::layoutSubtree(MonitorState& monitor, int start) {
+    const int gap = monitor.options.gap;
+    m_stack.clear();
+    m_stack.push_back(start);
+    while (!m_stack.empty()) {
+        const int n = m_stack.back();
+        m_stack.pop_back();
+        ++m_stats.nodesVisited;
+        const Node& node = m_nodes[n];
+        if (node.window >= 0) {
+            setTarget(node.window, node.rect, gap);
+            continue;
+        }
+
+        Rect a = node.rect, b = node.rect;
+        if (node.vertical) {
+            const int split = node.rect.left + static_cast<int>(std::lround(node.rect.width() * node.ratio));
+            a.right = split;
+            b.left = split;
+        } else {
+            const int split = node.rect.top + static_cast<int>(std::lround(node.rect.height() * node.ratio));
+            a.bottom = split;
+            b.top = split;
+        }
+        m_nodes[node.child[0]].rect = a;
+        m_nodes[node.child[1]].rect = b;
+        m_stack.push_back(node.child[1]);
+        m_stack.push_back(node.child[0]);
+    }
+}
+
+void TilingEngine::layoutLinear(int monitorIndex) {
+    MonitorState& monitor = m_monitors[monitorIndex];
+    const int count = static_cast<int>(monitor.order.size());
+    if (count == 0) return;
+    const Rect area = rootRect(monitor);
+    const int gap = monitor.options.gap;
+
+    // 정수 경계를 i * 길이 / n 으로 잡아 빈틈 없이 나눈다
+    auto column = [&](int i, int n, int left, int right) {
+        return left + static_cast<int>(static_cast<long long>(right - left) * i / n);
+    };
+    auto row = [&](int i, int n) {
+        return area.top + static_cast<int>(static_cast<long long>(area.height()) * i / n);
+    };
+
+    if (monitor.options.mode == TilingMode::Columns) {
+        for (int i = 0; i < count; ++i) {
+            ++m_stats.nodesVisited;
+            Rect tile = {column(i, count, area.left, area.right), area.top,
+                         column(i + 1, count, area.left, area.right), area.bottom};
+            setTarget(m_index[monitor.order[i]], tile, gap);
+        }
+        return;
+    }
+
+    const int masters = std::min(count, monitor.options.masterCount);
+    const int stack = count - masters;
+    const int split = stack > 0
+        ? area.left + static_cast<int>(std::lround(area.width() * monitor.options.masterRatio))
+        : area.right;
+    for (int i = 0; i < count; ++i) {
+        ++m_stats.nodesVisited;
+        const bool master = i < masters;
+        const int k = master ? i : i - masters;
+        const int n = master ? masters : stack;
+        Rect tile = {master ? area.left : split, row(k, n), master ? split : area.right, row(k + 1, n)};
+        setTarget(m_index[monitor.order[i]], tile, gap);
+    }
+}
+
+void TilingEngine::settle(int monitorIndex) {
+    MonitorState& monitor = m_monitors[monitorIndex];
+    const TilingMode mode = monitor.options.mode;
+
+    if (mode == TilingMode::Bsp) {
+        if (monitor.dirtyAll && monitor.root >= 0) {
+            m_nodes[monitor.root].rect = rootRect(monitor);
+            layoutSubtree(monitor, monitor.root);
+        } else {
+            for (int node : monitor.dirtyNodes) {
+                if (m_nodes[node].window != -2) layoutSubtree(monitor, node);
+            }
+        }
+    } else if (mode != TilingMode::Off && monitor.dirtyAll) {
+        layoutLinear(monitorIndex);
+    }
+    monitor.dirtyAll = false;
+    monitor.dirtyNodes.clear();
+}
+
+size_t TilingEngine::flush(std::vector<WindowMove>& out) {
+    for (int m = 0; m < monitorCount(); ++m) settle(m);
+
+    // 목표가 실제로 바뀐 창만 내보낸다
+    const size_t before = out.size();
+    for (WindowId window : m_changed) {
+        auto it = m_index.find(window);
+        if (it == m_index.end()) continue;
+        TiledWindow& tiled = m_windows[it->second];
+        tiled.changed = false;
+        if (m_monitors[tiled.monitor].options.mode == TilingMode::Off) continue;
+        if (tiled.target == tiled.placed) continue;
+        tiled.placed = tiled.target;
+        out.push_back({window, tiled.target});
+    }
+    m_changed.clear();
+    m_stats.movesEmitted += out.size() - before;
+    return out.size() - before;
+}
+
+size_t TilingEngine::flush(LayoutTransaction& transaction) {
+    m_moves.clear();
+    const size_t count = flush(m_moves);
+    for (const auto& move : m_moves) transaction.move(move.window, move.target);
+    return count;
+}
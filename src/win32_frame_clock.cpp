@@ -0,0 +1,24 @@
+#include "win32_frame_clock.h"
+#include <windows.h>
+#include <dwmapi.h>
+#include <chrono>
+
+#pragma comment(lib, "dwmapi.lib")
+
+Win32DwmFrameClock::Win32DwmFrameClock() {
+    // 주 모니터의 새로 고침 간격 (QPC 단위)
+    DWM_TIMING_INFO timing = {};
+    timing.cbSize = sizeof(timing);
+    LARGE_INTEGER frequency;
+    if (SUCCEEDED(DwmGetCompositionTimingInfo(NULL, &timing)) && timing.qpcRefreshPeriod &&
+        QueryPerformanceFrequency(&frequency)) {
+        m_intervalNs = static_cast<std::int64_t>(timing.qpcRefreshPeriod * 1'000'000'000ull / frequency.QuadPart);
+    }
+    m_fallback = SteadyFrameClock(m_intervalNs);
+}
+
+std::int64_t Win32DwmFrameClock::waitForFrame() {
+    if (FAILED(DwmFlush())) return m_fallback.waitForFrame();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
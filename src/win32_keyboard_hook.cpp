@@ -0,0 +1,61 @@
+#include "win32_keyboard_hook.h"
+
+// 메뉴 활성화를 막으려고 보내는 키에 붙이는 표식 (자기 입력은 다시 처리하지 않는다)
+static const ULONG_PTR kMaskTag = 0x574D4B48;  // 'WMKH'
+// 할당되지 않은 가상 키 (PowerToys 등과 같은 방식)
+static const WORD kMaskKey = 0xE8;
+
+Win32KeyboardHook& Win32KeyboardHook::getInstance() {
+    static Win32KeyboardHook instance;
+    return instance;
+}
+
+Win32KeyboardHook::~Win32KeyboardHook() {
+    uninstall();
+}
+
+bool Win32KeyboardHook::install(KeyInputPipeline& pipeline) {
+    if (m_hook) return true;
+
+    m_pipeline = &pipeline;
+    m_hook = SetWindowsHookExW(WH_KEYBOARD_LL, hookProc, GetModuleHandleW(NULL), 0);
+    if (!m_hook) {
+        m_pipeline = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void Win32KeyboardHook::uninstall() {
+    if (m_hook) {
+        UnhookWindowsHookEx(m_hook);
+        m_hook = NULL;
+    }
+    m_pipeline = nullptr;
+}
+
+void Win32KeyboardHook::maskMenu() {
+    // Win/Alt 단독 뗌으로 인식되지 않도록 사이에 의미 없는 키 입력을 끼운다
+    INPUT inputs[2] = {};
+    for (auto& input : inputs) {
+        input.type = INPUT_KEYBOARD;
+        input.ki.wVk = kMaskKey;
+        input.ki.dwExtraInfo = kMaskTag;
+    }
+    inputs[1].ki.dwFlags = KEYEVENTF_KEYUP;
+    SendInput(2, inputs, sizeof(INPUT));
+}
+
+LRESULT CALLBACK Win32KeyboardHook::hookProc(int code, WPARAM wParam, LPARAM lParam) {
+    auto& self = getInstance();
+    if (code == HC_ACTION && self.m_pipeline) {
+        const auto* info = reinterpret_cast<const KBDLLHOOKSTRUCT*>(lParam);
+        if (!((info->flags & LLKHF_INJECTED) && info->dwExtraInfo == kMaskTag) && info->vkCode < 256) {
+            const bool down = wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN;
+            const unsigned result = self.m_pipeline->onKey(static_cast<std::uint8_t>(info->vkCode), down);
+            if (result & KeyFilterMaskMenu) maskMenu();
+            if (result & KeyFilterSwallow) return 1;
+        }
+    }
+    return CallNextHookEx(NULL, code, wParam, lParam);
+}
@@ -0,0 +1,98 @@
+#include "win32_layered_surface.h"
+#include <cstring>
+
+#pragma comment(lib, "msimg32.lib")
+
+Win32LayeredSurface::~Win32LayeredSurface() {
+    if (m_memDC) {
+        SelectObject(m_memDC, m_oldBitmap);
+        DeleteDC(m_memDC);
+    }
+    if (m_bitmap) DeleteObject(m_bitmap);
+}
+
+bool Win32LayeredSurface::ensureBitmap(const ArgbBuffer& buffer) {
+    if (m_bitmap && m_width == buffer.width() && m_height == buffer.height()) return true;
+
+    if (!m_memDC) {
+        m_memDC = CreateCompatibleDC(NULL);
+        if (!m_memDC) return false;
+    }
+    if (m_bitmap) {
+        SelectObject(m_memDC, m_oldBitmap);
+        DeleteObject(m_bitmap);
+        m_bitmap = NULL;
+    }
+
+    // 32비트 top-down DIB - 메모리 배치가 ArgbBuffer 와 같다
+    BITMAPINFO bmi = {};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = buffer.width();
+    bmi.bmiHeader.biHeight = -buffer.height();
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    m_bitmap = CreateDIBSection(m_memDC, &bmi, DIB_RGB_COLORS, &m_bits, NULL, 0);
+    if (!m_bitmap) return false;
+    m_oldBitmap = SelectObject(m_memDC, m_bitmap);
+    m_width = buffer.width();
+    m_height = buffer.height();
+    return true;
+}
+
+bool Win32LayeredSurface::upload(HWND hwnd, const ArgbBuffer& buffer, Point screenPos) {
+    if (buffer.width() <= 0 || buffer.height() <= 0 || !ensureBitmap(buffer)) return false;
+    std::memcpy(m_bits, buffer.data(), buffer.byteSize());
+    GdiFlush();
+
+    // 불투명도는 픽셀 알파에 이미 들어있다
+    BLENDFUNCTION blend = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
+    POINT dstPos = {screenPos.x, screenPos.y};
+    SIZE size = {buffer.width(), buffer.height()};
+    POINT srcPos = {0, 0};
+    return UpdateLayeredWindow(hwnd, NULL, &dstPos, &size, m_memDC, &srcPos, 0, &blend, ULW_ALPHA) != FALSE;
+}
+
+bool Win32LayeredSurface::uploadDirty(HWND hwnd, const ArgbBuffer& buffer, Point screenPos, const Rect& dirty) {
+    // 크기가 바뀌어 DIB 를 새로 만들면 전체를 올린다
+    if (!m_bitmap || m_width != buffer.width() || m_height != buffer.height()) {
+        return upload(hwnd, buffer, screenPos);
+    }
+    if (dirty.empty()) return true;
+
+    auto* bits = static_cast<std::uint32_t*>(m_bits);
+    const size_t rowBytes = static_cast<size_t>(dirty.width()) * sizeof(std::uint32_t);
+    for (int y = dirty.top; y < dirty.bottom; ++y) {
+        const size_t offset = static_cast<size_t>(y) * buffer.width() + dirty.left;
+        std::memcpy(bits + offset, buffer.data() + offset, rowBytes);
+    }
+    GdiFlush();
+
+    BLENDFUNCTION blend = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
+    POINT dstPos = {screenPos.x, screenPos.y};
+    SIZE size = {buffer.width(), buffer.height()};
+    POINT srcPos = {0, 0};
+    RECT dirtyRect = toRECT(dirty);
+
+    UPDATELAYEREDWINDOWINFO info = {};
+    info.cbSize = sizeof(info);
+    info.pptDst = &dstPos;
+    info.psize = &size;
+    info.hdcSrc = m_memDC;
+    info.pptSrc = &srcPos;
+    info.pblend = &blend;
+    info.dwFlags = ULW_ALPHA;
+    info.prcDirty = &dirtyRect;
+    return UpdateLayeredWindowIndirect(hwnd, &info) != FALSE;
+}
+
+bool Win32LayeredSurface::blendTo(HDC hdc, const ArgbBuffer& buffer, Point pos) {
+    if (buffer.width() <= 0 || buffer.height() <= 0 || !ensureBitmap(buffer)) return false;
+    std::memcpy(m_bits, buffer.data(), buffer.byteSize());
+    GdiFlush();
+
+    BLENDFUNCTION blend = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
+    return AlphaBlend(hdc, pos.x, pos.y, buffer.width(), buffer.height(),
+                      m_memDC, 0, 0, buffer.width(), buffer.height(), blend) != FALSE;
+}
@@ -0,0 +1,34 @@
+#include "win32_monitor_backend.h"
+#include <shellscalingapi.h>
+
+#pragma comment(lib, "shcore.lib")
+
+void Win32MonitorBackend::enumerate(std::vector<MonitorInfo>& out) {
+    EnumDisplayMonitors(NULL, NULL,
+        [](HMONITOR hMonitor, HDC, LPRECT, LPARAM lParam) -> BOOL {
+            auto* monitors = reinterpret_cast<std::vector<MonitorInfo>*>(lParam);
+            MONITORINFOEXW mi = {};
+            mi.cbSize = sizeof(MONITORINFOEXW);
+            if (!GetMonitorInfoW(hMonitor, &mi)) return TRUE;
+
+            MonitorInfo info;
+            info.handle = reinterpret_cast<std::uintptr_t>(hMonitor);
+            info.bounds = toRect(mi.rcMonitor);
+            info.workArea = toRect(mi.rcWork);
+            info.primary = (mi.dwFlags & MONITORINFOF_PRIMARY) != 0;
+
+            UINT dpiX = 96, dpiY = 96;
+            if (SUCCEEDED(GetDpiForMonitor(hMonitor, MDT_EFFECTIVE_DPI, &dpiX, &dpiY))) {
+                info.dpi = dpiX;
+            }
+
+            DEVMODEW mode = {};
+            mode.dmSize = sizeof(DEVMODEW);
+            if (EnumDisplaySettingsW(mi.szDevice, ENUM_CURRENT_SETTINGS, &mode) && mode.dmDisplayFrequency > 1) {
+                info.refreshHz = mode.dmDisplayFrequency;
+            }
+            monitors->push_back(info);
+            return TRUE;
+        },
+        reinterpret_cast<LPARAM>(&out));
+}
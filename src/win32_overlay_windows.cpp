@@ -0,0 +1,70 @@
+#include "win32_overlay_windows.h"
+
+static const wchar_t kOverlayClass[] = L"WindowManagerGridOverlay";
+
+Win32OverlayWindows::~Win32OverlayWindows() {
+    destroy();
+}
+
+HWND Win32OverlayWindows::createWindow() {
+    HINSTANCE instance = GetModuleHandleW(NULL);
+    static bool registered = false;
+    if (!registered) {
+        WNDCLASSEXW wc = {0};
+        wc.cbSize = sizeof(WNDCLASSEXW);
+        wc.lpfnWndProc = DefWindowProcW;
+        wc.hInstance = instance;
+        wc.lpszClassName = kOverlayClass;
+        registered = RegisterClassExW(&wc) != 0;
+    }
+
+    return CreateWindowExW(
+        WS_EX_LAYERED | WS_EX_TRANSPARENT | WS_EX_TOOLWINDOW | WS_EX_NOACTIVATE,
+        kOverlayClass, L"", WS_POPUP,
+        0, 0, 0, 0, NULL, NULL, instance, NULL);
+}
+
+void Win32OverlayWindows::present(OverlaySurfaceSet& surfaces) {
+    while (static_cast<int>(m_windows.size()) > surfaces.size()) {
+        DestroyWindow(m_windows.back()->hwnd);
+        m_windows.pop_back();
+    }
+    while (static_cast<int>(m_windows.size()) < surfaces.size()) {
+        auto window = std::make_unique<OverlayWindow>();
+        window->hwnd = createWindow();
+        if (!window->hwnd) return;
+        m_windows.push_back(std::move(window));
+    }
+
+    for (int i = 0; i < surfaces.size(); ++i) {
+        OverlayWindow& window = *m_windows[i];
+        const OverlaySurface& surface = surfaces.surface(i);
+        const Point pos = {surface.bounds().left, surface.bounds().top};
+
+        Rect updated;
+        if (!surfaces.render(i, updated)) continue;
+
+        if (window.bounds != surface.bounds() ||
+            updated == Rect{0, 0, surface.buffer().width(), surface.buffer().height()}) {
+            window.surface.upload(window.hwnd, surface.buffer(), pos);
+            window.bounds = surface.bounds();
+        } else {
+            window.surface.uploadDirty(window.hwnd, surface.buffer(), pos, updated);
+        }
+        if (m_visible) ShowWindow(window.hwnd, SW_SHOWNOACTIVATE);
+    }
+}
+
+void Win32OverlayWindows::setVisible(bool visible) {
+    m_visible = visible;
+    for (auto& window : m_windows) {
+        ShowWindow(window->hwnd, visible ? SW_SHOWNOACTIVATE : SW_HIDE);
+    }
+}
+
+void Win32OverlayWindows::destroy() {
+    for (auto& window : m_windows) {
+        if (window->hwnd) DestroyWindow(window->hwnd);
+    }
+    m_windows.clear();
+}
@@ -0,0 +1,43 @@
+#include "win32_snap_preview.h"
+
+static const wchar_t kPreviewClass[] = L"WindowManagerSnapPreview";
+static const BYTE kPreviewAlpha = 80;
+
+Win32SnapPreview::~Win32SnapPreview() {
+    if (m_hwnd) DestroyWindow(m_hwnd);
+}
+
+bool Win32SnapPreview::create() {
+    if (m_hwnd) return true;
+
+    HINSTANCE instance = GetModuleHandleW(NULL);
+    WNDCLASSEXW wc = {0};
+    wc.cbSize = sizeof(WNDCLASSEXW);
+    wc.lpfnWndProc = DefWindowProcW;
+    wc.hInstance = instance;
+    wc.hbrBackground = CreateSolidBrush(RGB(0, 120, 215));
+    wc.lpszClassName = kPreviewClass;
+    RegisterClassExW(&wc);
+
+    m_hwnd = CreateWindowExW(
+        WS_EX_LAYERED | WS_EX_TRANSPARENT | WS_EX_TOOLWINDOW | WS_EX_NOACTIVATE | WS_EX_TOPMOST,
+        kPreviewClass, L"", WS_POPUP,
+        0, 0, 0, 0, NULL, NULL, instance, NULL);
+    if (!m_hwnd) return false;
+
+    SetLayeredWindowAttributes(m_hwnd, 0, kPreviewAlpha, LWA_ALPHA);
+    return true;
+}
+
+void Win32SnapPreview::show(const Rect& rect) {
+    if (!create()) return;
+    SetWindowPos(m_hwnd, HWND_TOPMOST, rect.left, rect.top, rect.width(), rect.height(),
+                 SWP_NOACTIVATE | SWP_SHOWWINDOW);
+    m_visible = true;
+}
+
+void Win32SnapPreview::hide() {
+    if (!m_hwnd || !m_visible) return;
+    ShowWindow(m_hwnd, SW_HIDE);
+    m_visible = false;
+}
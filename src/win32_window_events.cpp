@@ -0,0 +1,95 @@
+#include "win32_window_events.h"
+
+Win32WindowEvents& Win32WindowEvents::getInstance() {
+    static Win32WindowEvents instance;
+    return instance;
+}
+
+Win32WindowEvents::~Win32WindowEvents() {
+    uninstall();
+}
+
+bool Win32WindowEvents::install(WindowEventQueue& queue, void (*onPending)()) {
+    if (!m_hooks.empty()) return true;
+
+    m_queue = &queue;
+    m_onPending = onPending;
+
+    // 필요한 이벤트 구간만 등록 (전체 범위를 걸면 훅 호출이 크게 늘어난다)
+    const DWORD ranges[][2] = {
+        {EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND},
+        {EVENT_SYSTEM_MOVESIZEEND, EVENT_SYSTEM_MOVESIZEEND},
+        {EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND},
+        {EVENT_OBJECT_CREATE, EVENT_OBJECT_HIDE},
+        {EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE},
+        {EVENT_OBJECT_CLOAKED, EVENT_OBJECT_UNCLOAKED},
+    };
+    for (const auto& range : ranges) {
+        HWINEVENTHOOK hook = SetWinEventHook(range[0], range[1], NULL, eventProc, 0, 0,
+                                             WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+        if (!hook) {
+            uninstall();
+            return false;
+        }
+        m_hooks.push_back(hook);
+    }
+    return true;
+}
+
+void Win32WindowEvents::uninstall() {
+    for (HWINEVENTHOOK hook : m_hooks) {
+        UnhookWinEvent(hook);
+    }
+    m_hooks.clear();
+    m_queue = nullptr;
+    m_onPending = nullptr;
+}
+
+void CALLBACK Win32WindowEvents::eventProc(HWINEVENTHOOK, DWORD event, HWND hwnd,
+                                           LONG idObject, LONG idChild, DWORD, DWORD) {
+    auto& self = getInstance();
+    // 창 자체에 대한 이벤트만 (캐럿, 스크롤바 등 제외)
+    if (!self.m_queue || !hwnd || idObject != OBJID_WINDOW || idChild != CHILDID_SELF) return;
+
+    WindowEventType type;
+    switch (event) {
+        case EVENT_OBJECT_CREATE:         type = WindowEventType::Created; break;
+        case EVENT_OBJECT_DESTROY:        type = WindowEventType::Destroyed; break;
+        case EVENT_OBJECT_SHOW:           type = WindowEventType::Shown; break;
+        case EVENT_OBJECT_HIDE:           type = WindowEventType::Hidden; break;
+        case EVENT_OBJECT_LOCATIONCHANGE: type = WindowEventType::LocationChanged; break;
+        case EVENT_SYSTEM_MOVESIZEEND:    type = WindowEventType::MoveSizeEnd; break;
+        case EVENT_SYSTEM_FOREGROUND:     type = WindowEventType::Foreground; break;
+        case EVENT_SYSTEM_MINIMIZESTART:
+        case EVENT_SYSTEM_MINIMIZEEND:    type = WindowEventType::FrameChanged; break;
+        case EVENT_OBJECT_CLOAKED:        type = WindowEventType::Cloaked; break;
+        case EVENT_OBJECT_UNCLOAKED:      type = WindowEventType::Uncloaked; break;
+        default: return;
+    }
+
+    // 파괴 이벤트 외에는 최상위 창만 추적
+    if (type != WindowEventType::Destroyed && GetAncestor(hwnd, GA_ROOT) != hwnd) return;
+
+    bool wasEmpty = self.m_queue->empty();
+    self.m_queue->push(toWindowId(hwnd), type);
+    if (wasEmpty && self.m_onPending) self.m_onPending();
+}
+
+bool Win32WindowInfoSource::query(WindowId window, WindowSnapshot& out) {
+    HWND hwnd = toHWND(window);
+    WindowFrameInfo frame;
+    if (!m_frames.get(window, frame)) return false;
+    // DPI 가 다른 모니터로 옮겨지면 테두리 두께도 바뀐다
+    if (GetDpiForWindow(hwnd) != frame.dpi) {
+        m_frames.invalidate(window);
+        if (!m_frames.get(window, frame)) return false;
+    }
+
+    RECT rect;
+    if (!GetWindowRect(hwnd, &rect)) return false;
+    out.rect = visibleFromOuter(toRect(rect), frame.insets);
+    out.visible = IsWindowVisible(hwnd) != FALSE;
+    out.cloaked = frame.cloaked;
+    out.manageable = out.visible && frame.manageable;
+    return true;
+}
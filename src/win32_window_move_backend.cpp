@@ -0,0 +1,78 @@
+#include "win32_window_move_backend.h"
+#include <dwmapi.h>
+
+#pragma comment(lib, "dwmapi.lib")
+
+static const UINT kMoveFlags = SWP_NOZORDER | SWP_NOACTIVATE | SWP_NOOWNERZORDER;
+
+static UINT moveFlags(const WindowMove& move) {
+    UINT flags = kMoveFlags;
+    if (move.flags & MoveKeepRect) flags |= SWP_NOMOVE | SWP_NOSIZE;
+    if (move.flags & MoveShow) flags |= SWP_SHOWWINDOW;
+    if (move.flags & MoveHide) flags |= SWP_HIDEWINDOW;
+    if (move.flags & MoveAsync) flags |= SWP_ASYNCWINDOWPOS;
+    return flags;
+}
+
+bool Win32WindowMoveBackend::getWindowRect(WindowId window, Rect& out) {
+    HWND hwnd = toHWND(window);
+    RECT rect;
+    if (!IsWindow(hwnd) || !GetWindowRect(hwnd, &rect)) return false;
+    out = toRect(rect);
+    return true;
+}
+
+bool Win32WindowMoveBackend::applyBatch(const WindowMove* moves, size_t count) {
+    HDWP hdwp = BeginDeferWindowPos(static_cast<int>(count));
+    if (!hdwp) return false;
+
+    for (size_t i = 0; i < count; ++i) {
+        const Rect& r = moves[i].target;
+        // 실패하면 시스템이 hdwp 를 해제하므로 EndDeferWindowPos 를 부르지 않는다
+        hdwp = DeferWindowPos(hdwp, toHWND(moves[i].window), NULL,
+                              r.left, r.top, r.width(), r.height(), moveFlags(moves[i]));
+        if (!hdwp) return false;
+    }
+    return EndDeferWindowPos(hdwp) != FALSE;
+}
+
+bool Win32WindowMoveBackend::applyOne(const WindowMove& move) {
+    const Rect& r = move.target;
+    return SetWindowPos(toHWND(move.window), NULL,
+                        r.left, r.top, r.width(), r.height(), moveFlags(move)) != FALSE;
+}
+
+// 핸들이 재사용되면 소유 스레드/프로세스가 바뀌므로 이를 생성 스탬프로 사용
+std::uint32_t Win32WindowFrameSource::stamp(WindowId window) {
+    DWORD processId = 0;
+    DWORD threadId = GetWindowThreadProcessId(toHWND(window), &processId);
+    if (threadId == 0) return 0;
+    const std::uint32_t stamp = (processId * 0x9E3779B1u) ^ threadId;
+    return stamp ? stamp : 1;
+}
+
+bool Win32WindowFrameSource::query(WindowId window, WindowFrameInfo& out) {
+    HWND hwnd = toHWND(window);
+    RECT rect;
+    if (!GetWindowRect(hwnd, &rect)) return false;
+
+    LONG style = GetWindowLong(hwnd, GWL_STYLE);
+    LONG exStyle = GetWindowLong(hwnd, GWL_EXSTYLE);
+    out.manageable = !(style & WS_CHILD) && !(exStyle & WS_EX_TOOLWINDOW);
+
+    DWORD cloaked = 0;
+    out.cloaked = SUCCEEDED(DwmGetWindowAttribute(hwnd, DWMWA_CLOAKED, &cloaked, sizeof(cloaked))) && cloaked;
+    out.dpi = GetDpiForWindow(hwnd);
+
+    // 최소화된 창은 프레임 값이 의미 없으므로 간격 0 (복원 이벤트에서 다시 조회)
+    out.insets = FrameInsets();
+    RECT frame;
+    if (!IsIconic(hwnd) &&
+        SUCCEEDED(DwmGetWindowAttribute(hwnd, DWMWA_EXTENDED_FRAME_BOUNDS, &frame, sizeof(frame)))) {
+        out.insets.left = frame.left > rect.left ? frame.left - rect.left : 0;
+        out.insets.top = frame.top > rect.top ? frame.top - rect.top : 0;
+        out.insets.right = rect.right > frame.right ? rect.right - frame.right : 0;
+        out.insets.bottom = rect.bottom > frame.bottom ? rect.bottom - frame.bottom : 0;
+    }
+    return true;
+}
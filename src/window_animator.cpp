@@ -0,0 +1,218 @@
+#include "window_animator.h"
+#include <chrono>
+#include <cmath>
+
+static std::int64_t steadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::int64_t SteadyFrameClock::waitForFrame() {
+    const std::int64_t now = steadyNs();
+    if (m_nextNs < now) {
+        // 쉬고 난 첫 프레임이나 밀린 프레임은 기다리지 않는다
+        m_nextNs = now;
+    } else {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(m_nextNs - now));
+    }
+    m_nextNs += m_intervalNs;
+    return steadyNs();
+}
+
+double easeOutCubic(double t) {
+    if (t <= 0.0) return 0.0;
+    if (t >= 1.0) return 1.0;
+    const double u = 1.0 - t;
+    return 1.0 - u * u * u;
+}
+
+static int lerp(int a, int b, double t) {
+    return a + static_cast<int>(std::lround((b - a) * t));
+}
+
+Rect interpolateRect(const Rect& from, const Rect& to, double t) {
+    return {lerp(from.left, to.left, t), lerp(from.top, to.top, t), lerp(from.right, to.right, t),
+            lerp(from.bottom, to.bottom, t)};
+}
+
+AnimationSet::Animation* AnimationSet::find(WindowId window) {
+    for (auto& animation : m_animations) {
+        if (animation.window == window) return &animation;
+    }
+    return nullptr;
+}
+
+void AnimationSet::animate(WindowId window, const Rect& from, const Rect& to, std::int64_t durationNs,
+                           std::int64_t nowNs) {
+    if (Animation* running = find(window)) {
+        if (running->to == to) return;
+        // 대기열에 쌓지 않고 지금 보이는 위치에서 새 목표로
+        running->from = from;
+        running->to = to;
+        running->startNs = nowNs;
+        running->durationNs = durationNs;
+        running->lagFrames = 0;
+        ++m_stats.retargeted;
+        return;
+    }
+    if (from == to) return;
+
+    Animation animation;
+    animation.window = window;
+    animation.from = from;
+    animation.to = to;
+    animation.last = from;
+    animation.startNs = nowNs;
+    animation.durationNs = durationNs;
+    m_animations.push_back(animation);
+    ++m_stats.started;
+}
+
+bool AnimationSet::cancel(WindowId window) {
+    Animation* animation = find(window);
+    if (!animation) return false;
+    *animation = m_animations.back();
+    m_animations.pop_back();
+    return true;
+}
+
+void AnimationSet::step(std::int64_t nowNs, std::int64_t frameIntervalNs, WindowMoveBackend& backend) {
+    if (m_animations.empty()) return;
+    ++m_stats.frames;
+
+    const std::int64_t budgetNs = static_cast<std::int64_t>(frameIntervalNs * m_options.budgetFraction);
+    const bool finishAll = m_finishNext;
+    m_finishNext = false;
+    const std::int64_t begin = steadyNs();
+    bool overBudget = false;
+
+    for (size_t i = 0; i < m_animations.size();) {
+        Animation& animation = m_animations[i];
+        const std::int64_t elapsed = nowNs - animation.startNs;
+        bool done = finishAll || elapsed >= animation.durationNs;
+        if (done && elapsed < animation.durationNs) ++m_stats.finishedEarly;
+
+        if (!done && !overBudget && steadyNs() - begin > budgetNs) overBudget = true;
+        if (!done && overBudget) {
+            // 이번 프레임 예산을 다 썼다 - 남은 창은 다음 프레임에 목표로 보낸다
+            ++m_stats.droppedSteps;
+            ++i;
+            continue;
+        }
+
+        if (!done && animation.applied) {
+            Rect current;
+            if (!backend.getWindowRect(animation.window, current)) {
+                // 창이 사라졌다
+                animation = m_animations.back();
+                m_animations.pop_back();
+                continue;
+            }
+            if (current != animation.last) {
+                // 지난 프레임 위치를 아직 그리지 못한 창 - 기다리다 너무 오래면 목표로 바로
+                if (++animation.lagFrames <= m_options.maxLagFrames) {
+                    ++m_stats.droppedSteps;
+                    ++i;
+                    continue;
+                }
+                done = true;
+                ++m_stats.finishedEarly;
+            }
+        }
+        animation.lagFrames = 0;
+
+        const Rect rect = done ? animation.to
+                               : interpolateRect(animation.from, animation.to,
+                                                 easeOutCubic(static_cast<double>(elapsed) / animation.durationNs));
+        bool alive = true;
+        if (!animation.applied || rect != animation.last) {
+            alive = backend.applyOne({animation.window, rect, MoveAsync});
+            ++m_stats.steps;
+            animation.last = rect;
+            animation.applied = true;
+        }
+
+        if (done || !alive) {
+            if (alive) ++m_stats.completed;
+            animation = m_animations.back();
+            m_animations.pop_back();
+            continue;
+        }
+        ++i;
+    }
+
+    m_stepTimes.record(static_cast<std::uint64_t>(steadyNs() - begin));
+    if (overBudget) {
+        ++m_stats.overBudgetFrames;
+        m_finishNext = true;
+    }
+}
+
+WindowAnimator::WindowAnimator(WindowMoveBackend& backend, FrameClock& clock, const AnimationOptions& options)
+    : m_backend(backend), m_clock(clock), m_set(options) {
+    m_thread = std::thread([this] { run(); });
+}
+
+WindowAnimator::~WindowAnimator() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+}
+
+bool WindowAnimator::animate(WindowId window, const Rect& target, std::int64_t durationNs) {
+    // 현재 위치는 잠금 밖에서 읽는다 (스케줄러가 보내 둔 위치가 아니라 실제로 보이는 위치)
+    Rect current;
+    if (!m_backend.getWindowRect(window, current)) return false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_set.animate(window, current, target, durationNs, steadyNs());
+    }
+    m_wake.notify_one();
+    return true;
+}
+
+void WindowAnimator::cancel(WindowId window) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_set.cancel(window) && m_set.empty()) m_idle.notify_all();
+}
+
+bool WindowAnimator::waitIdle(std::int64_t timeoutNs) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_idle.wait_for(lock, std::chrono::nanoseconds(timeoutNs), [this] { return m_set.empty(); });
+}
+
+AnimationStats WindowAnimator::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    AnimationStats stats = m_set.stats();
+    stats.active = m_set.size();
+    return stats;
+}
+
+void WindowAnimator::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::int64_t lastFrameNs = 0;
+
+    while (true) {
+        m_wake.wait(lock, [this] { return m_stopping || !m_set.empty(); });
+        if (m_stopping) break;
+
+        lock.unlock();
+        const std::int64_t now = m_clock.waitForFrame();
+        lock.lock();
+        if (m_stopping) break;
+
+        if (lastFrameNs) m_frameTimes.record(static_cast<std::uint64_t>(now - lastFrameNs));
+        // 이동은 비동기 요청이라 짧다 - 그동안 animate() 는 잠시 기다린다
+        m_set.step(now, m_clock.frameIntervalNs(), m_backend);
+        if (m_set.empty()) {
+            // 쉬는 동안의 간격은 프레임 시간에 넣지 않는다
+            lastFrameNs = 0;
+            m_idle.notify_all();
+        } else {
+            lastFrameNs = now;
+        }
+    }
+}
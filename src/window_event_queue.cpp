@@ -0,0 +1,77 @@
+#include "window_event_queue.h"
+
+WindowEventQueue::WindowEventQueue() {
+    m_pending.reserve(256);
+    m_index.reserve(256);
+}
+
+void WindowEventQueue::push(WindowId window, WindowEventType type) {
+    ++m_pushed;
+
+    if (type == WindowEventType::Foreground) {
+        m_foreground = window;
+        m_foregroundChanged = true;
+        return;
+    }
+
+    auto [it, inserted] = m_index.try_emplace(window, static_cast<std::uint32_t>(m_pending.size()));
+    if (inserted) {
+        WindowUpdate update;
+        update.window = window;
+        m_pending.push_back(update);
+    }
+    WindowUpdate& update = m_pending[it->second];
+
+    switch (type) {
+        case WindowEventType::Created:
+            // 파괴 후 같은 핸들이 재사용되면 Destroyed|Created 로 둘 다 전달
+            update.flags |= ChangeCreated;
+            break;
+        case WindowEventType::Destroyed:
+            if (update.flags & ChangeCreated && !(update.flags & ChangeDestroyed)) {
+                // 이번 배치 안에서 생성되고 사라진 창은 아예 전달하지 않는다
+                update.flags = 0;
+            } else {
+                update.flags = ChangeDestroyed;
+            }
+            break;
+        case WindowEventType::Shown:
+        case WindowEventType::Hidden:
+            update.flags |= ChangeVisibility;
+            update.visible = type == WindowEventType::Shown;
+            break;
+        case WindowEventType::LocationChanged:
+            update.flags |= ChangeLocation;
+            break;
+        case WindowEventType::MoveSizeEnd:
+            update.flags |= ChangeLocation | ChangeMoveSizeEnd;
+            break;
+        case WindowEventType::Cloaked:
+        case WindowEventType::Uncloaked:
+            update.flags |= ChangeCloak;
+            update.cloaked = type == WindowEventType::Cloaked;
+            break;
+        case WindowEventType::FrameChanged:
+            update.flags |= ChangeFrame;
+            break;
+        case WindowEventType::Foreground:
+            break;
+    }
+}
+
+void WindowEventQueue::drain(std::vector<WindowUpdate>& out) {
+    out.clear();
+    for (const auto& update : m_pending) {
+        if (update.flags) out.push_back(update);
+    }
+    m_delivered += out.size();
+    m_pending.clear();
+    m_index.clear();
+}
+
+bool WindowEventQueue::takeForeground(WindowId& window) {
+    if (!m_foregroundChanged) return false;
+    window = m_foreground;
+    m_foregroundChanged = false;
+    return true;
+}
@@ -0,0 +1,85 @@
+#include "window_frame_cache.h"
+
+bool WindowFrameCache::get(WindowId window, WindowFrameInfo& out) {
+    const std::uint32_t stamp = m_source.stamp(window);
+    if (stamp == 0) return false;
+    std::uint64_t epoch;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (const WindowFrameInfo* cached = m_table.find(window, stamp)) {
+            ++m_stats.hits;
+            out = *cached;
+            return true;
+        }
+        ++m_stats.misses;
+        epoch = m_epoch;
+    }
+
+    // 시스템 호출은 잠금 밖에서. 그 사이에 무효화가 있었으면 결과만 돌려주고 넣지 않는다
+    WindowFrameInfo info;
+    if (!m_source.query(window, info)) return false;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (epoch == m_epoch) m_table.insert(window, stamp, info);
+    out = info;
+    return true;
+}
+
+void WindowFrameCache::invalidate(WindowId window) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_epoch;
+    if (m_table.erase(window)) ++m_stats.invalidations;
+}
+
+void WindowFrameCache::invalidateAll() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_epoch;
+    m_stats.invalidations += m_table.size();
+    m_table.clear();
+}
+
+void WindowFrameCache::setCloaked(WindowId window, bool cloaked) {
+    const std::uint32_t stamp = m_source.stamp(window);
+    if (stamp == 0) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (WindowFrameInfo* cached = m_table.find(window, stamp)) cached->cloaked = cloaked;
+}
+
+void WindowFrameCache::erase(WindowId window) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_table.erase(window);
+}
+
+size_t WindowFrameCache::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_table.size();
+}
+
+WindowFrameCacheStats WindowFrameCache::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+bool FramedWindowMoveBackend::getWindowRect(WindowId window, Rect& out) {
+    WindowFrameInfo frame;
+    Rect outer;
+    if (!m_frames.get(window, frame) || !m_outer.getWindowRect(window, outer)) return false;
+    out = visibleFromOuter(outer, frame.insets);
+    return true;
+}
+
+WindowMove FramedWindowMoveBackend::toOuter(const WindowMove& move) {
+    // 속성을 모르는 창은 그대로 (창이 사라졌으면 감싼 백엔드가 실패를 알려준다)
+    WindowFrameInfo frame;
+    if ((move.flags & MoveKeepRect) || !m_frames.get(move.window, frame)) return move;
+    return {move.window, outerFromVisible(move.target, frame.insets), move.flags};
+}
+
+bool FramedWindowMoveBackend::applyBatch(const WindowMove* moves, size_t count) {
+    m_outerMoves.clear();
+    for (size_t i = 0; i < count; ++i) m_outerMoves.push_back(toOuter(moves[i]));
+    return m_outer.applyBatch(m_outerMoves.data(), m_outerMoves.size());
+}
+
+bool FramedWindowMoveBackend::applyOne(const WindowMove& move) {
+    return m_outer.applyOne(toOuter(move));
+}
@@ -1,226 +1,1106 @@
-#include "window_manager.h"
-#include <algorithm>
-#include <fstream>
-#include <sstream>
-
-WindowManager& WindowManager::getInstance() {
-    static WindowManager instance;
-    return instance;
-}
-
-WindowManager::WindowManager() : m_initialized(false) {
-    m_gridSettings.rows = 12;
-    m_gridSettings.cols = 12;
-    m_gridSettings.visible = false;
-    m_gridSettings.opacity = 0.5f;
-}
-
-WindowManager::~WindowManager() {
-    cleanup();
-}
-
-bool WindowManager::initialize() {
-    if (m_initialized) return true;
-    
-    updateMonitorInfo();
-    loadConfig();
-    m_initialized = true;
-    return true;
-}
-
-void WindowManager::cleanup() {
-    if (!m_initialized) return;
-    
-    saveConfig();
-    m_windowStates.clear();
-    m_savedLayouts.clear();
-    m_monitors.clear();
-    m_initialized = false;
-}
-
-void WindowManager::handleWindowDrag(HWND hwnd, POINT pt) {
-    if (!isWindowManageable(hwnd)) return;
-
-    // 현재 모니터 정보 가져오기
-    int monitorIndex = getCurrentMonitorIndex(hwnd);
-    if (monitorIndex < 0) return;
-
-    // 그리드에 스냅
-    if (m_gridSettings.visible) {
-        snapWindowToGrid(hwnd, pt);
-    }
-}
-
-void WindowManager::snapWindowToGrid(HWND hwnd, POINT pt) {
-    HMONITOR hMonitor = MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST);
-    MONITORINFO mi = { sizeof(MONITORINFO) };
-    if (!GetMonitorInfo(hMonitor, &mi)) return;
-
-    // 작업 영역 크기 계산
-    int workWidth = mi.rcWork.right - mi.rcWork.left;
-    int workHeight = mi.rcWork.bottom - mi.rcWork.top;
-
-    // 그리드 셀 크기 계산
-    int cellWidth = workWidth / m_gridSettings.cols;
-    int cellHeight = workHeight / m_gridSettings.rows;
-
-    // 가장 가까운 그리드 라인에 스냅
-    int gridX = ((pt.x - mi.rcWork.left + cellWidth / 2) / cellWidth) * cellWidth + mi.rcWork.left;
-    int gridY = ((pt.y - mi.rcWork.top + cellHeight / 2) / cellHeight) * cellHeight + mi.rcWork.top;
-
-    // 창 크기 조정
-    RECT windowRect;
-    GetWindowRect(hwnd, &windowRect);
-    int width = windowRect.right - windowRect.left;
-    int height = windowRect.bottom - windowRect.top;
-
-    SetWindowPos(hwnd, NULL, gridX, gridY, width, height, SWP_NOZORDER | SWP_NOSIZE);
-}
-
-void WindowManager::snapWindowToPosition(HWND hwnd, WindowPosition position) {
-    RECT windowRect = calculateWindowPosition(hwnd, position);
-    SetWindowPos(hwnd, NULL, 
-                windowRect.left, windowRect.top,
-                windowRect.right - windowRect.left,
-                windowRect.bottom - windowRect.top,
-                SWP_NOZORDER);
-}
-
-RECT WindowManager::calculateWindowPosition(HWND hwnd, WindowPosition position) {
-    HMONITOR hMonitor = MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST);
-    MONITORINFO mi = { sizeof(MONITORINFO) };
-    GetMonitorInfo(hMonitor, &mi);
-
-    RECT workArea = mi.rcWork;
-    int width = (workArea.right - workArea.left) / 2;
-    int height = (workArea.bottom - workArea.top) / 2;
-    RECT result = {0, 0, width, height};
-
-    switch (position) {
-        case WindowPosition::TopLeft:
-            result = {workArea.left, workArea.top, workArea.left + width, workArea.top + height};
-            break;
-        case WindowPosition::TopCenter:
-            result = {workArea.left + width/2, workArea.top, workArea.right - width/2, workArea.top + height};
-            break;
-        case WindowPosition::TopRight:
-            result = {workArea.right - width, workArea.top, workArea.right, workArea.top + height};
-            break;
-        case WindowPosition::CenterLeft:
-            result = {workArea.left, workArea.top + height/2, workArea.left + width, workArea.bottom - height/2};
-            break;
-        case WindowPosition::Center:
-            result = {workArea.left + width/2, workArea.top + height/2, 
-                     workArea.right - width/2, workArea.bottom - height/2};
-            break;
-        case WindowPosition::CenterRight:
-            result = {workArea.right - width, workArea.top + height/2, workArea.right, workArea.bottom - height/2};
-            break;
-        case WindowPosition::BottomLeft:
-            result = {workArea.left, workArea.bottom - height, workArea.left + width, workArea.bottom};
-            break;
-        case WindowPosition::BottomCenter:
-            result = {workArea.left + width/2, workArea.bottom - height, 
-                     workArea.right - width/2, workArea.bottom};
-            break;
-        case WindowPosition::BottomRight:
-            result = {workArea.right - width, workArea.bottom - height, workArea.right, workArea.bottom};
-            break;
-    }
-
-    return result;
-}
-
-void WindowManager::toggleGrid() {
-    m_gridSettings.visible = !m_gridSettings.visible;
-    // 화면 갱신 요청
-    InvalidateRect(NULL, NULL, TRUE);
-}
-
-void WindowManager::setGridSize(int rows, int cols) {
-    m_gridSettings.rows = rows;
-    m_gridSettings.cols = cols;
-    if (m_gridSettings.visible) {
-        InvalidateRect(NULL, NULL, TRUE);
-    }
-}
-
-void WindowManager::drawGrid(HDC hdc) {
-    if (!m_gridSettings.visible) return;
-
-    HMONITOR hMonitor = MonitorFromWindow(GetForegroundWindow(), MONITOR_DEFAULTTONEAREST);
-    MONITORINFO mi = { sizeof(MONITORINFO) };
-    if (!GetMonitorInfo(hMonitor, &mi)) return;
-
-    // 반투명 브러시 생성
-    BYTE alpha = static_cast<BYTE>(m_gridSettings.opacity * 255);
-    HBRUSH hBrush = CreateSolidBrush(RGB(200, 200, 200));
-    
-    int cellWidth = (mi.rcWork.right - mi.rcWork.left) / m_gridSettings.cols;
-    int cellHeight = (mi.rcWork.bottom - mi.rcWork.top) / m_gridSettings.rows;
-
-    // 수직선 그리기
-    for (int i = 1; i < m_gridSettings.cols; i++) {
-        int x = mi.rcWork.left + i * cellWidth;
-        MoveToEx(hdc, x, mi.rcWork.top, NULL);
-        LineTo(hdc, x, mi.rcWork.bottom);
-    }
-
-    // 수평선 그리기
-    for (int i = 1; i < m_gridSettings.rows; i++) {
-        int y = mi.rcWork.top + i * cellHeight;
-        MoveToEx(hdc, mi.rcWork.left, y, NULL);
-        LineTo(hdc, mi.rcWork.right, y);
-    }
-
-    DeleteObject(hBrush);
-}
-
-void WindowManager::updateMonitorInfo() {
-    m_monitors.clear();
-    EnumDisplayMonitors(NULL, NULL, 
-        [](HMONITOR hMonitor, HDC, LPRECT, LPARAM lParam) -> BOOL {
-            std::vector<HMONITOR>* monitors = reinterpret_cast<std::vector<HMONITOR>*>(lParam);
-            monitors->push_back(hMonitor);
-            return TRUE;
-        }, 
-        reinterpret_cast<LPARAM>(&m_monitors));
-}
-
-int WindowManager::getCurrentMonitorIndex(HWND hwnd) {
-    HMONITOR hMonitor = MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST);
-    auto it = std::find(m_monitors.begin(), m_monitors.end(), hMonitor);
-    return it != m_monitors.end() ? static_cast<int>(std::distance(m_monitors.begin(), it)) : -1;
-}
-
-bool WindowManager::isWindowManageable(HWND hwnd) {
-    if (!hwnd || !IsWindow(hwnd) || !IsWindowVisible(hwnd)) return false;
-    
-    // 시스템 창 제외
-    LONG style = GetWindowLong(hwnd, GWL_STYLE);
-    LONG exStyle = GetWindowLong(hwnd, GWL_EXSTYLE);
-    
-    if ((style & WS_CHILD) || (exStyle & WS_EX_TOOLWINDOW)) return false;
-    
-    return true;
-}
-
-void WindowManager::saveConfig() {
-    // 설정 파일에 현재 상태 저장
-    std::ofstream file("window_manager.config");
-    if (!file) return;
-
-    file << m_gridSettings.rows << " " << m_gridSettings.cols << " "
-         << m_gridSettings.opacity << std::endl;
-    
-    file.close();
-}
-
-void WindowManager::loadConfig() {
-    // 설정 파일에서 상태 로드
-    std::ifstream file("window_manager.config");
-    if (!file) return;
-
-    file >> m_gridSettings.rows >> m_gridSettings.cols >> m_gridSettings.opacity;
-    file.close();
-}
+#include "window_manager.h"
+#include "win32_monitor_backend.h"
+#include "win32_window_move_backend.h"
+#include "win32_window_events.h"
+#include "hotkey_manager.h"
+#include <algorithm>
+#include <chrono>
+#include <cwchar>
+#include <fstream>
+#include <sstream>
+
+// 이벤트 병합 타이머 - WM_TIMER 는 다른 메시지가 없을 때만 오므로
+// 이벤트 폭주가 끝난 뒤 한 번에 처리된다
+static void CALLBACK windowEventTimerProc(HWND, UINT, UINT_PTR id, DWORD) {
+    KillTimer(NULL, id);
+    WindowManager::getInstance().processWindowEvents();
+}
+
+static void scheduleWindowEvents() {
+    SetTimer(NULL, 0, USER_TIMER_MINIMUM, windowEventTimerProc);
+}
+
+// 작업 스레드와 미룬 초기화가 보내는 메시지를 받는 창 (HWND_MESSAGE)
+// 호스트의 메시지 루프는 DispatchMessage 만 하면 되고 따로 넘겨 줄 필요가 없다
+static const wchar_t kMessageWindowClass[] = L"WindowManagerMessages";
+
+static LRESULT CALLBACK messageWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+    WindowManager& manager = WindowManager::getInstance();
+    switch (msg) {
+        case WM_CONFIG_RELOADED:
+            manager.applyConfig();
+            return 0;
+        case WM_COMMANDS_PENDING:
+            manager.processCommands();
+            return 0;
+        case WM_DEFERRED_INIT:
+            manager.runDeferredInit();
+            return 0;
+    }
+    return DefWindowProcW(hwnd, msg, wParam, lParam);
+}
+
+WindowManager& WindowManager::getInstance() {
+    static WindowManager instance;
+    return instance;
+}
+
+WindowManager::WindowManager()
+    : m_frames(m_frameSource),
+      m_monitorBackend(std::make_unique<Win32MonitorBackend>()),
+      m_moveBackend(std::make_unique<FramedWindowMoveBackend>(m_win32Moves, m_frames)),
+      m_transaction(*m_moveBackend, &m_eventArena),
+      m_moveExecutor(std::make_unique<AsyncMoveExecutor>(*m_moveBackend)),
+      m_animator(std::make_unique<WindowAnimator>(*m_moveBackend, m_frameClock)),
+      m_windowInfo(std::make_unique<Win32WindowInfoSource>(m_frames)),
+      m_initialized(false) {
+    m_moveExecutor->setTracer(&m_latencyTracer);
+}
+
+WindowManager::~WindowManager() {
+    cleanup();
+}
+
+bool WindowManager::initialize() {
+    if (m_initialized) return true;
+    m_startup.mark(StartupStage::MainEntered);
+    // 미룬 초기화/설정 다시 읽기/명령 서버 알림은 이 창으로 받는다
+    HINSTANCE instance = GetModuleHandleW(NULL);
+    WNDCLASSEXW wc = {0};
+    wc.cbSize = sizeof(WNDCLASSEXW);
+    wc.lpfnWndProc = messageWindowProc;
+    wc.hInstance = instance;
+    wc.lpszClassName = kMessageWindowClass;
+    RegisterClassExW(&wc);
+    m_messageWindow = CreateWindowExW(0, kMessageWindowClass, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, instance, NULL);
+    if (!m_messageWindow) return false;
+
+    // 로그인 직후 다른 프로그램들과 같이 뜨므로 단축키부터 살린다 (settings.conf 의 바인딩은 읽힌 뒤 다시 등록)
+    HotkeyManager::getInstance().initialize();
+    m_startup.mark(StartupStage::HotkeysLive);
+    updateMonitorInfo();
+    m_startup.mark(StartupStage::MonitorsReady);
+
+    // 저장된 레이아웃은 메모리 매핑이라 바로 읽고, settings.conf 파싱/검사는 작업 스레드에서
+    // (끝나면 WM_CONFIG_RELOADED 로 applyConfig)
+    loadConfig();
+    m_config.setActions(HotkeyManager::configActions());
+    const std::filesystem::path settings = settingsPath();
+    std::error_code ec;
+    const bool hasSettings = std::filesystem::exists(settings, ec);
+    m_configReloader.start(m_config, settings, onConfigReloaded, this, hasSettings);
+    m_settingsLoaded = !hasSettings;
+    applyConfig();
+    if (!hasSettings) m_startup.mark(StartupStage::ConfigLoaded);
+
+    // 창 파괴 시 저장된 상태도 함께 제거
+    m_registry.setRemovedCallback([this](WindowId window) { onWindowDestroyed(toHWND(window)); });
+    m_deferredStage = 0;
+    PostMessageW(m_messageWindow, WM_DEFERRED_INIT, 0, 0);
+
+    m_initialized = true;
+    return true;
+}
+
+void WindowManager::runDeferredInit() {
+    if (!m_initialized) return;
+
+    // 한 번에 한 단계만 하고 다시 보내서 사이에 들어온 단축키가 먼저 처리되게 한다
+    switch (m_deferredStage++) {
+        case 0:
+            seedWindowRegistry();
+            for (const auto& record : m_registry.windows()) {
+                trackTiledWindow(record);
+                trackSpatialWindow(record);
+            }
+            Win32WindowEvents::getInstance().install(m_eventQueue, scheduleWindowEvents);
+            m_startup.mark(StartupStage::WindowsScanned);
+            break;
+        case 1:
+            // 다른 인스턴스가 이미 쓰고 있으면 명령 서버 없이 동작
+            m_commandServer.start(CommandServer::defaultEndpoint(), onCommandsPending, this);
+            m_startup.mark(StartupStage::CommandServerReady);
+            break;
+        default: {
+            m_startup.markIdle();
+            std::string report;
+            m_startup.format(report);
+            OutputDebugStringA(report.c_str());
+            return;
+        }
+    }
+    PostMessageW(m_messageWindow, WM_DEFERRED_INIT, 0, 0);
+}
+
+void WindowManager::cleanup() {
+    if (!m_initialized) return;
+    
+    // 기다리던 스크립트는 응답 없이 끊긴다
+    m_commandServer.stop();
+    Win32WindowEvents::getInstance().uninstall();
+    m_configReloader.stop();
+    m_overlayWindows.destroy();
+    // 작업 공간 전환으로 숨긴 창은 종료 전에 모두 다시 보인다
+    m_workspaceSwitcher.showHidden(m_transaction);
+    m_transaction.commit();
+    saveConfig();
+    m_windowStates.clear();
+    m_workspaces.clear();
+    DestroyWindow(m_messageWindow);
+    m_messageWindow = NULL;
+    m_initialized = false;
+}
+
+static std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 드래그 중 마지막 샘플이 프레임 간격 안에 들어와 처리되지 못한 경우를 마무리
+static void CALLBACK dragFrameTimerProc(HWND, UINT, UINT_PTR, DWORD) {
+    WindowManager::getInstance().flushWindowDrag();
+}
+
+void WindowManager::handleWindowDrag(HWND hwnd, POINT pt) {
+    EventArena::Scope scope(m_eventArena);
+    // 그리드에 스냅
+    ConfigReader config(m_config);
+    if (!config->gridVisible) return;
+    m_inputRecorder.dragMove(toWindowId(hwnd), toPoint(pt), InputRecorder::nowUs());
+
+    if (!m_dragSnapper.active() || m_dragSnapper.window() != toWindowId(hwnd)) {
+        if (!isWindowManageable(hwnd)) return;
+        Rect windowRect;
+        if (!m_moveBackend->getWindowRect(toWindowId(hwnd), windowRect)) return;
+
+        // 끌기 시작한 창의 애니메이션은 멈춘다 (사용자와 위치를 다투지 않도록)
+        m_animator->cancel(toWindowId(hwnd));
+        m_dragSnapper.configure(m_topology, config->rows, config->cols, m_monitorGrids);
+        m_dragSnapper.configureZones(config->zones, config->zoneGap, config->zoneSpan, config->version);
+        m_dragSnapper.begin(toWindowId(hwnd), windowRect, toPoint(pt), nowNs());
+
+        UINT intervalMs = static_cast<UINT>(m_dragSnapper.frameIntervalNs() / 1'000'000);
+        m_dragTimer = SetTimer(NULL, m_dragTimer, intervalMs < USER_TIMER_MINIMUM ? USER_TIMER_MINIMUM : intervalMs,
+                               dragFrameTimerProc);
+    } else if (!m_dragSnapper.addSample(toPoint(pt), nowNs())) {
+        return;
+    }
+
+    // 드래그 중에는 미리보기만 갱신하고 창은 움직이지 않는다
+    showDragPreview();
+}
+
+void WindowManager::flushWindowDrag() {
+    EventArena::Scope scope(m_eventArena);
+    if (m_dragSnapper.flush(nowNs())) {
+        showDragPreview();
+    }
+}
+
+void WindowManager::showDragPreview() {
+    const Rect& preview = m_dragSnapper.preview();
+    m_snapPreview.show(preview);
+
+    // 그리드 오버레이에서는 대상 셀 영역만 다시 그린다
+    const int monitorIndex = m_topology.monitorFromRect(preview);
+    for (int i = 0; i < m_overlaySurfaces.size(); ++i) {
+        if (i == monitorIndex) {
+            m_overlaySurfaces.setHighlight(i, preview);
+        } else {
+            m_overlaySurfaces.clearHighlight(i);
+        }
+    }
+    m_overlayWindows.present(m_overlaySurfaces);
+}
+
+void WindowManager::endWindowDrag(HWND hwnd) {
+    EventArena::Scope scope(m_eventArena);
+    if (!m_dragSnapper.active() || m_dragSnapper.window() != toWindowId(hwnd)) return;
+    m_inputRecorder.dragEnd(toWindowId(hwnd), InputRecorder::nowUs());
+
+    if (m_dragTimer) {
+        KillTimer(NULL, m_dragTimer);
+        m_dragTimer = 0;
+    }
+    m_snapPreview.hide();
+    m_overlaySurfaces.clearHighlights();
+    m_overlayWindows.present(m_overlaySurfaces);
+
+    // 놓을 때 한 번만 이동
+    Rect target;
+    if (m_dragSnapper.end(target)) {
+        m_moveExecutor->submit(toWindowId(hwnd), target);
+    }
+}
+
+void WindowManager::snapWindowToGrid(HWND hwnd, POINT pt) {
+    EventArena::Scope scope(m_eventArena);
+    Rect windowRect;
+    if (!m_moveBackend->getWindowRect(toWindowId(hwnd), windowRect)) return;
+
+    // 미리 만든 모니터별 그리드 선 표에서 조회
+    {
+        ConfigReader config(m_config);
+        // 끌기 시작한 창의 애니메이션은 멈춘다 (사용자와 위치를 다투지 않도록)
+        m_animator->cancel(toWindowId(hwnd));
+        m_dragSnapper.configure(m_topology, config->rows, config->cols, m_monitorGrids);
+        m_dragSnapper.configureZones(config->zones, config->zoneGap, config->zoneSpan, config->version);
+    }
+    Rect target;
+    if (!m_dragSnapper.snapRect(windowRect, toPoint(pt), target)) return;
+
+    m_moveExecutor->submit(toWindowId(hwnd), target);
+}
+
+void WindowManager::snapWindowToPosition(HWND hwnd, WindowPosition position, std::uint32_t traceSpan) {
+    // 캐시 조회 한 번 (바탕 화면/작업 표시줄 같은 창은 옮기지 않는다)
+    if (!isWindowManageable(hwnd)) return;
+    RECT windowRect = calculateWindowPosition(hwnd, position);
+    if (windowRect.right <= windowRect.left || windowRect.bottom <= windowRect.top) return;
+    m_latencyTracer.mark(traceSpan, TraceStage::GeometryComputed);
+
+    // 애니메이션: 진행 중이면 새 목표로 바꾼다. 응답 없는 창은 실행기로 (돌아오면 최신 목표로 이동)
+    const WindowId window = toWindowId(hwnd);
+    int animationMs;
+    {
+        ConfigReader config(m_config);
+        animationMs = config->animationMs;
+    }
+    if (animationMs > 0 && !m_moveExecutor->isHung(window) &&
+        m_animator->animate(window, toRect(windowRect), animationMs * 1'000'000ll)) {
+        return;
+    }
+    m_animator->cancel(window);
+    // 대상 앱이 응답하지 않아도 메시지 루프가 멈추지 않도록 작업 스레드에서 이동
+    m_moveExecutor->submit(window, toRect(windowRect), traceSpan);
+}
+
+RECT WindowManager::calculateWindowPosition(HWND hwnd, WindowPosition position) {
+    int monitorIndex = getCurrentMonitorIndex(hwnd);
+    if (monitorIndex < 0) return RECT{0, 0, 0, 0};
+
+    return toRECT(calculateSnapRect(m_topology.monitor(monitorIndex).workArea, position));
+}
+
+// 그리드 설정 변경도 새 스냅샷으로 게시 (읽는 쪽은 메시지 루프 스레드뿐이라 바로 해제된다)
+void WindowManager::toggleGrid() {
+    m_config.modify([](ConfigSnapshot& config) { config.gridVisible = !config.gridVisible; });
+    m_config.reclaim();
+    // 전체 화면 무효화 대신 모니터별 오버레이 창만 표시/숨김
+    refreshGridOverlay();
+}
+
+void WindowManager::setGridSize(int rows, int cols) {
+    m_config.modify([rows, cols](ConfigSnapshot& config) {
+        config.rows = rows;
+        config.cols = cols;
+    });
+    m_config.reclaim();
+    m_inputRecorder.gridSize(rows, cols, InputRecorder::nowUs());
+    refreshGridOverlay();
+}
+
+void WindowManager::setGridOpacity(float opacity) {
+    m_config.modify([opacity](ConfigSnapshot& config) { config.opacity = opacity; });
+    m_config.reclaim();
+    refreshGridOverlay();
+}
+
+void WindowManager::refreshGridOverlay() {
+    ConfigReader config(m_config);
+    if (!config->gridVisible) {
+        m_overlayWindows.setVisible(false);
+        return;
+    }
+
+    OverlayStyle style;
+    style.rows = config->rows;
+    style.cols = config->cols;
+    style.monitorGrids = m_monitorGrids;
+    style.opacity = config->opacity;
+    style.visible = true;
+    m_overlaySurfaces.sync(m_topology, style);
+    m_overlayWindows.present(m_overlaySurfaces);
+    m_overlayWindows.setVisible(true);
+}
+
+void WindowManager::drawGrid(HDC hdc) {
+    ConfigReader config(m_config);
+    if (!config->gridVisible) return;
+
+    int monitorIndex = getCurrentMonitorIndex(GetForegroundWindow());
+    if (monitorIndex < 0) return;
+    const Rect& work = m_topology.monitor(monitorIndex).workArea;
+
+    // 작업 영역 크기 버퍼에 래스터라이즈한 뒤 한 번에 알파 합성
+    m_gridBuffer.resize(work.width(), work.height());
+    int rows = config->rows, cols = config->cols;
+    monitorGridSize(m_monitorGrids, monitorIndex, rows, cols);
+    m_overlayLines.build({0, 0, work.width(), work.height()}, rows, cols);
+
+    GridStyle style;
+    style.lineColor = premultiply(200, 200, 200, static_cast<std::uint8_t>(config->opacity * 255));
+    rasterizeGrid(m_gridBuffer, m_overlayLines.xs(), m_overlayLines.ys(), style);
+
+    m_gridSurface.blendTo(hdc, m_gridBuffer, {work.left, work.top});
+}
+
+void WindowManager::saveWorkspace(const std::string& name) {
+    // 레지스트리의 보이는 관리 대상 창 (전체 재열거 없음)
+    auto& windows = m_workspaces[name];
+    windows.clear();
+    std::vector<WindowId> members;
+    for (const auto& record : m_registry.windows()) {
+        if (!record.state.manageable || record.state.cloaked) continue;
+        HWND hwnd = toHWND(record.window);
+        WindowLayout layout;
+        if (!captureWindowLayout(hwnd, layout)) continue;
+
+        WorkspaceWindow window;
+        window.identity = windowIdentity(hwnd);
+        window.position = toRect(layout.position);
+        window.monitorIndex = layout.monitorIndex;
+        window.flags = layout.isMaximized ? WorkspaceMaximized : 0;
+        windows.push_back(window);
+        members.push_back(record.window);
+    }
+    m_workspaceSwitcher.setMembers(members.data(), members.size());
+    m_activeWorkspace = name;
+}
+
+bool WindowManager::switchWorkspace(const std::string& name) {
+    if (!planWorkspace(name)) return false;
+    m_lastCommitStats = m_transaction.commit();
+    for (WindowId window : m_workspaceSwitcher.toMaximize()) ShowWindow(toHWND(window), SW_MAXIMIZE);
+    return true;
+}
+
+bool WindowManager::planWorkspace(const std::string& name) {
+    auto it = m_workspaces.find(name);
+    if (it == m_workspaces.end()) return false;
+
+    // 후보: 보이는 관리 대상 창 + 전환으로 숨긴 창
+    // 응답 없는 창은 배치 전체를 붙잡으므로 뺀다
+    m_workspaceCandidates.clear();
+    for (const auto& record : m_registry.windows()) {
+        const bool hidden = m_workspaceSwitcher.isHidden(record.window);
+        if (!hidden && (!record.state.manageable || record.state.cloaked)) continue;
+        if (m_moveExecutor->isHung(record.window)) continue;
+        HWND hwnd = toHWND(record.window);
+        if (!hidden && (windowRules(hwnd).action & RuleIgnore)) continue;
+        m_workspaceCandidates.push_back({record.window, windowIdentity(hwnd), !hidden, IsZoomed(hwnd) != FALSE});
+    }
+
+    m_workspaceStats = m_workspaceSwitcher.plan(it->second.data(), it->second.size(), m_workspaceCandidates.data(),
+                                                m_workspaceCandidates.size(), m_transaction);
+    for (WindowId window : m_workspaceSwitcher.toRestore()) ShowWindow(toHWND(window), SW_SHOWNOACTIVATE);
+    m_activeWorkspace = name;
+    return true;
+}
+
+void WindowManager::saveWindowState(HWND hwnd) {
+    WindowLayout layout;
+    if (captureWindowLayout(hwnd, layout)) {
+        m_windowStates.insert(toWindowId(hwnd), m_frameSource.stamp(toWindowId(hwnd)), layout);
+    }
+}
+
+void WindowManager::restoreWindowState(HWND hwnd) {
+    const WindowLayout* layout = m_windowStates.find(toWindowId(hwnd), m_frameSource.stamp(toWindowId(hwnd)));
+    if (!layout) return;
+    commitLayout({*layout});
+}
+
+void WindowManager::onWindowDestroyed(HWND hwnd) {
+    m_windowStates.erase(toWindowId(hwnd));
+    m_ruleResults.erase(toWindowId(hwnd));
+    m_frames.erase(toWindowId(hwnd));
+    m_appKeys.erase(toWindowId(hwnd));
+    m_workspaceSwitcher.forget(toWindowId(hwnd));
+    m_spatialIndex.remove(toWindowId(hwnd));
+}
+
+bool WindowManager::captureWindowLayout(HWND hwnd, WindowLayout& layout) {
+    if (!isWindowManageable(hwnd) || IsIconic(hwnd)) return false;
+
+    // 복원할 때 같은 기준으로 옮기도록 보이는 프레임 사각형으로 저장
+    Rect rect;
+    if (!m_moveBackend->getWindowRect(toWindowId(hwnd), rect)) return false;
+
+    layout.hwnd = hwnd;
+    layout.position = toRECT(rect);
+    layout.isMaximized = IsZoomed(hwnd) != FALSE;
+    layout.monitorIndex = m_topology.monitorFromRect(rect);
+    return true;
+}
+
+void WindowManager::commitLayout(const std::vector<WindowLayout>& layouts) {
+    // 최대화 창은 배치 이동 대상이 아니므로 커밋 후 따로 처리
+    std::vector<HWND> toMaximize;
+
+    for (const auto& layout : layouts) {
+        if (!IsWindow(layout.hwnd)) continue;
+
+        // 응답 없는 창은 배치 전체를 붙잡으므로 비동기 실행기로 넘긴다 (돌아오면 최신 목표로 이동)
+        if (m_moveExecutor->isHung(toWindowId(layout.hwnd))) {
+            if (!layout.isMaximized) m_moveExecutor->submit(toWindowId(layout.hwnd), toRect(layout.position));
+            continue;
+        }
+
+        if (layout.isMaximized) {
+            if (!IsZoomed(layout.hwnd)) toMaximize.push_back(layout.hwnd);
+            continue;
+        }
+        if (IsZoomed(layout.hwnd)) {
+            ShowWindow(layout.hwnd, SW_RESTORE);
+        }
+        m_transaction.move(toWindowId(layout.hwnd), toRect(layout.position));
+    }
+
+    // 한 번의 DeferWindowPos 배치로 적용 (변화 없는 창은 건너뜀)
+    m_lastCommitStats = m_transaction.commit();
+
+    for (HWND hwnd : toMaximize) {
+        ShowWindow(hwnd, SW_MAXIMIZE);
+    }
+}
+
+void WindowManager::seedWindowRegistry() {
+    // 시작 시 한 번만 전체 열거, 이후에는 이벤트로 갱신
+    EnumWindows([](HWND hwnd, LPARAM lParam) -> BOOL {
+            auto* self = reinterpret_cast<WindowManager*>(lParam);
+            self->m_registry.seed(toWindowId(hwnd), *self->m_windowInfo);
+            return TRUE;
+        },
+        reinterpret_cast<LPARAM>(this));
+    m_registry.setForeground(toWindowId(GetForegroundWindow()));
+}
+
+void WindowManager::processWindowEvents() {
+    m_eventQueue.drain(m_windowUpdates);
+    // 새로 보이거나 최소화/복원된 창만 스타일/프레임을 다시 읽고, 가림은 이벤트 값으로 바로 고친다
+    for (const auto& update : m_windowUpdates) {
+        if (update.flags & (ChangeCreated | ChangeVisibility | ChangeFrame)) m_frames.invalidate(update.window);
+        if (update.flags & ChangeCloak) m_frames.setCloaked(update.window, update.cloaked);
+    }
+    m_registry.apply(m_windowUpdates, *m_windowInfo);
+    updateTiling(m_windowUpdates);
+    // 바뀐 창만 색인 칸을 옮긴다 (사라진 창은 onWindowDestroyed 에서)
+    for (const auto& update : m_windowUpdates) {
+        if (const WindowRecord* record = m_registry.find(update.window)) trackSpatialWindow(*record);
+    }
+
+    if (m_inputRecorder.active()) {
+        // 사용자가 직접 옮긴 창은 재생 쪽에 위치를 알려준다
+        const std::int64_t now = InputRecorder::nowUs();
+        for (const auto& update : m_windowUpdates) {
+            if (!(update.flags & (ChangeCreated | ChangeMoveSizeEnd))) continue;
+            if (const WindowRecord* record = m_registry.find(update.window)) {
+                m_inputRecorder.windowRect(update.window, record->state.rect, now);
+            }
+        }
+    }
+
+    WindowId foreground;
+    if (m_eventQueue.takeForeground(foreground)) {
+        m_registry.setForeground(foreground);
+        m_inputRecorder.foreground(foreground, InputRecorder::nowUs());
+    }
+}
+
+void WindowManager::trackTiledWindow(const WindowRecord& record) {
+    const WindowSnapshot& state = record.state;
+    if (!state.visible || state.cloaked || !state.manageable || m_topology.empty() ||
+        (windowRules(toHWND(record.window)).action & (RuleIgnore | RuleFloat))) {
+        m_tiling.removeWindow(record.window);
+        return;
+    }
+
+    const int monitor = m_topology.monitorFromRect(state.rect);
+    if (!m_tiling.contains(record.window)) {
+        // 새 창은 포커스된 창의 타일을 나눈다
+        m_tiling.addWindow(record.window, monitor, m_registry.foreground());
+    } else if (m_tiling.monitorOf(record.window) != monitor) {
+        m_tiling.removeWindow(record.window);
+        m_tiling.addWindow(record.window, monitor, m_registry.foreground());
+    } else {
+        m_tiling.resizeWindow(record.window, state.rect);
+    }
+}
+
+void WindowManager::trackSpatialWindow(const WindowRecord& record) {
+    const WindowSnapshot& state = record.state;
+    // 최소화된 창은 화면 밖 좌표라 방향 이동 대상에서 뺀다
+    if (!state.visible || state.cloaked || !state.manageable || IsIconic(toHWND(record.window)) ||
+        (windowRules(toHWND(record.window)).action & RuleIgnore)) {
+        m_spatialIndex.remove(record.window);
+        return;
+    }
+    m_spatialIndex.update(record.window, state.rect);
+}
+
+WindowId WindowManager::neighborInDirection(HWND hwnd, Direction direction, Rect& from) {
+    const WindowId window = toWindowId(hwnd);
+    if (const Rect* indexed = m_spatialIndex.rectOf(window)) {
+        from = *indexed;
+    } else if (!m_moveBackend->getWindowRect(window, from)) {
+        return 0;
+    }
+    return m_spatialIndex.nearest(from, direction, window);
+}
+
+void WindowManager::focusWindowInDirection(HWND hwnd, Direction direction) {
+    Rect from;
+    const WindowId neighbor = neighborInDirection(hwnd, direction, from);
+    if (!neighbor) return;
+    // 단축키를 받은 프로세스라 전경 전환이 허용된다
+    if (SetForegroundWindow(toHWND(neighbor))) m_registry.setForeground(neighbor);
+}
+
+void WindowManager::swapWindowInDirection(HWND hwnd, Direction direction) {
+    if (!isWindowManageable(hwnd)) return;
+    Rect from;
+    const WindowId neighbor = neighborInDirection(hwnd, direction, from);
+    const Rect* to = m_spatialIndex.rectOf(neighbor);
+    if (!neighbor || !to) return;
+    const WindowId window = toWindowId(hwnd);
+    if (m_moveExecutor->isHung(window) || m_moveExecutor->isHung(neighbor)) return;
+
+    const Rect target = *to;
+    for (WindowId id : {window, neighbor}) {
+        m_animator->cancel(id);
+        if (IsZoomed(toHWND(id))) ShowWindow(toHWND(id), SW_RESTORE);
+    }
+    // 두 창을 한 배치로 (이벤트를 기다리지 않고 색인도 바로 고친다)
+    m_transaction.move(window, target);
+    m_transaction.move(neighbor, from);
+    m_lastCommitStats = m_transaction.commit();
+    m_spatialIndex.update(window, target);
+    m_spatialIndex.update(neighbor, from);
+}
+
+void WindowManager::pushWindowInDirection(HWND hwnd, Direction direction) {
+    if (!isWindowManageable(hwnd) || IsZoomed(hwnd)) return;
+    const WindowId window = toWindowId(hwnd);
+    Rect from;
+    if (const Rect* indexed = m_spatialIndex.rectOf(window)) {
+        from = *indexed;
+    } else if (!m_moveBackend->getWindowRect(window, from)) {
+        return;
+    }
+    const int monitor = m_topology.monitorFromRect(from);
+    if (monitor < 0) return;
+
+    // 점수가 가장 좋은 이웃이 아니라 실제로 가로막는 창 (수직 방향으로 겹치는 창 중 모서리가 가장 가까운 창)
+    const WindowId obstacle = m_spatialIndex.blocking(from, direction, window);
+    const Rect target = pushRect(from, direction, m_spatialIndex.rectOf(obstacle), m_topology.monitor(monitor).workArea);
+    if (target == from) return;
+    m_animator->cancel(window);
+    m_moveExecutor->submit(window, target);
+    m_spatialIndex.update(window, target);
+}
+
+void WindowManager::updateTiling(const std::vector<WindowUpdate>& updates) {
+    for (const auto& update : updates) {
+        const WindowRecord* record = m_registry.find(update.window);
+        if (!record) {
+            m_tiling.removeWindow(update.window);
+            continue;
+        }
+        // 우리가 옮긴 결과로 오는 위치 변경은 무시하고, 사용자가 끈 경우만 반영
+        const std::uint32_t relevant = ChangeCreated | ChangeVisibility | ChangeCloak | ChangeMoveSizeEnd;
+        if ((update.flags & relevant) || !m_tiling.contains(update.window)) {
+            trackTiledWindow(*record);
+        }
+        if (update.flags & ChangeCreated) queueWindowRule(*record);
+    }
+    applyWindowRules();
+    commitTiling();
+}
+
+// 타일 이동과 규칙으로 정한 새 창 위치를 한 배치로 커밋
+void WindowManager::commitTiling() {
+    m_tiling.flush(m_transaction);
+    if (m_transaction.empty()) return;
+    m_lastCommitStats = m_transaction.commit();
+}
+
+void WindowManager::setTilingOptions(int monitor, const TilingOptions& options) {
+    m_tiling.setOptions(monitor, options);
+    commitTiling();
+}
+
+TilingOptions WindowManager::getTilingOptions(int monitor) const {
+    if (monitor < 0 || monitor >= m_tiling.monitorCount()) return TilingOptions();
+    return m_tiling.options(monitor);
+}
+
+void WindowManager::updateMonitorInfo() {
+    m_topology.rebuild(*m_monitorBackend);
+    // 배율이 바뀌면 모든 창의 테두리 두께가 바뀔 수 있다
+    m_frames.invalidateAll();
+    m_inputRecorder.displayChange(m_topology, InputRecorder::nowUs());
+    // 작업 영역이 바뀐 모니터만 다시 타일링 (새로 생긴 모니터에는 설정의 방식을 적용)
+    m_tiling.syncTopology(m_topology);
+    applyTilingConfig();
+    std::vector<Rect> workAreas;
+    for (const auto& monitor : m_topology.monitors()) workAreas.push_back(monitor.workArea);
+    m_spatialIndex.setMonitors(workAreas);
+    applyMonitorGrids();
+    // DPI/작업 영역이 바뀐 모니터의 오버레이만 다시 그린다 (숨김 상태면 아무것도 하지 않음)
+    refreshGridOverlay();
+}
+
+int WindowManager::getCurrentMonitorIndex(HWND hwnd) {
+    // 캐시된 토폴로지에서 조회 (모니터 시스템 호출 없음)
+    RECT windowRect;
+    if (!GetWindowRect(hwnd, &windowRect)) return -1;
+    return m_topology.monitorFromRect(toRect(windowRect));
+}
+
+bool WindowManager::isWindowManageable(HWND hwnd) {
+    // 시스템 창(자식/도구 창)과 가려진 창 제외 - 스타일/가림은 창별 캐시에서
+    WindowFrameInfo frame;
+    if (!hwnd || !m_frames.get(toWindowId(hwnd), frame) || !frame.manageable || frame.cloaked) return false;
+
+    // 추적 중인 창은 이벤트로 갱신된 표시 상태를 쓴다
+    const WindowRecord* record = m_registry.find(toWindowId(hwnd));
+    if (record ? !record->state.visible : !IsWindowVisible(hwnd)) return false;
+
+    return !(windowRules(hwnd).action & RuleIgnore);
+}
+
+static void appendUtf8(std::string& out, const wchar_t* text, int length) {
+    out.clear();
+    if (length <= 0) return;
+    const int bytes = WideCharToMultiByte(CP_UTF8, 0, text, length, nullptr, 0, nullptr, nullptr);
+    if (bytes <= 0) return;
+    out.resize(bytes);
+    WideCharToMultiByte(CP_UTF8, 0, text, length, &out[0], bytes, nullptr, nullptr);
+}
+
+// 규칙/식별 값과 비교할 문자열은 UTF-8 (실행 파일은 경로 없이 이름만)
+static void readClassName(HWND hwnd, std::string& out) {
+    wchar_t buffer[MAX_PATH];
+    appendUtf8(out, buffer, GetClassNameW(hwnd, buffer, MAX_PATH));
+}
+
+static void readTitle(HWND hwnd, std::string& out) {
+    wchar_t buffer[MAX_PATH];
+    appendUtf8(out, buffer, GetWindowTextW(hwnd, buffer, MAX_PATH));
+}
+
+static void readExecutable(HWND hwnd, std::string& out) {
+    out.clear();
+    DWORD processId = 0;
+    GetWindowThreadProcessId(hwnd, &processId);
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, processId);
+    if (!process) return;
+    wchar_t buffer[MAX_PATH];
+    DWORD length = MAX_PATH;
+    if (QueryFullProcessImageNameW(process, 0, buffer, &length)) {
+        const wchar_t* name = buffer;
+        for (DWORD i = 0; i < length; ++i) {
+            if (buffer[i] == L'\\' || buffer[i] == L'/') name = buffer + i + 1;
+        }
+        appendUtf8(out, name, static_cast<int>(buffer + length - name));
+    }
+    CloseHandle(process);
+}
+
+WindowRuleResult WindowManager::windowRules(HWND hwnd) {
+    const WindowId window = toWindowId(hwnd);
+    const std::uint32_t stamp = m_frameSource.stamp(window);
+    if (const WindowRuleResult* cached = m_ruleResults.find(window, stamp)) return *cached;
+
+    WindowRuleResult result;
+    {
+        ConfigReader config(m_config);
+        if (config->ruleMatcher && config->ruleMatcher->ruleCount()) {
+            std::string className, title, executable;
+            readClassName(hwnd, className);
+            readTitle(hwnd, title);
+            readExecutable(hwnd, executable);
+            result = config->ruleMatcher->match({className, title, executable}, m_ruleScratch);
+        }
+    }
+    m_ruleResults.insert(window, stamp, result);
+    return result;
+}
+
+WindowIdentity WindowManager::windowIdentity(HWND hwnd) {
+    const WindowId window = toWindowId(hwnd);
+    const std::uint32_t stamp = m_frameSource.stamp(window);
+    std::string text;
+    WindowIdentity identity;
+    if (const std::uint64_t* app = m_appKeys.find(window, stamp)) {
+        identity.app = *app;
+    } else {
+        std::string executable;
+        readExecutable(hwnd, executable);
+        readClassName(hwnd, text);
+        identity.app = windowAppKey(executable, text);
+        m_appKeys.insert(window, stamp, identity.app);
+    }
+    readTitle(hwnd, text);
+    identity.title = windowTitleKey(text);
+    return identity;
+}
+
+void WindowManager::queueWindowRule(const WindowRecord& record) {
+    if (m_tiling.contains(record.window)) return;
+    const WindowRuleResult rules = windowRules(toHWND(record.window));
+    if (!rules.matched() || (rules.action & RuleIgnore)) return;
+
+    RulePlacement placement;
+    placement.window = record.window;
+    placement.rule = rules;
+    placement.current = record.state.rect;
+    m_rulePlacements.push_back(placement);
+}
+
+void WindowManager::applyWindowRules() {
+    if (m_rulePlacements.empty()) return;
+    windowRuleTargets(m_rulePlacements, m_topology, m_ruleSlots);
+    for (const RulePlacement& placement : m_rulePlacements) {
+        if (placement.move) m_transaction.move(placement.window, placement.target);
+    }
+    m_rulePlacements.clear();
+}
+
+// %LOCALAPPDATA%\WindowManager\window_manager.layout
+std::filesystem::path WindowManager::configPath() const {
+    wchar_t base[MAX_PATH];
+    DWORD length = GetEnvironmentVariableW(L"LOCALAPPDATA", base, MAX_PATH);
+    std::filesystem::path dir = (length > 0 && length < MAX_PATH)
+        ? std::filesystem::path(base) / L"WindowManager"
+        : std::filesystem::current_path();
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    return dir / L"window_manager.layout";
+}
+
+std::filesystem::path WindowManager::settingsPath() const {
+    return configPath().parent_path() / L"settings.conf";
+}
+
+bool WindowManager::dumpLatencyTrace() {
+    return m_latencyTracer.writeChromeTrace(configPath().parent_path() / L"latency_trace.json");
+}
+
+void WindowManager::startInputRecording() {
+    // 시작 시점의 모니터/그리드/창 위치를 먼저 남겨 재생이 같은 상태에서 출발하게 한다
+    const std::int64_t now = InputRecorder::nowUs();
+    m_inputRecorder.start(now);
+    m_inputRecorder.displayChange(m_topology, now);
+    {
+        ConfigReader config(m_config);
+        m_inputRecorder.gridSize(config->rows, config->cols, now);
+    }
+    for (const auto& record : m_registry.windows()) {
+        if (record.state.visible && record.state.manageable) {
+            m_inputRecorder.windowRect(record.window, record.state.rect, now);
+        }
+    }
+    m_inputRecorder.foreground(m_registry.foreground(), now);
+}
+
+bool WindowManager::stopInputRecording() {
+    if (!m_inputRecorder.active()) return false;
+    m_inputRecorder.stop();
+    return m_inputRecorder.save(configPath().parent_path() / L"input_trace.wmit");
+}
+
+void WindowManager::recordHotkey(int id, HWND foreground) {
+    if (!m_inputRecorder.active()) return;
+    // 단축키 직전 위치를 함께 남긴다 (키보드/다른 앱이 옮긴 경우 대비)
+    const std::int64_t now = InputRecorder::nowUs();
+    RECT windowRect;
+    if (GetWindowRect(foreground, &windowRect)) {
+        m_inputRecorder.windowRect(toWindowId(foreground), toRect(windowRect), now);
+    }
+    m_inputRecorder.foreground(toWindowId(foreground), now);
+    m_inputRecorder.hotkey(id, now);
+}
+
+void WindowManager::saveConfig() {
+    // 설정 파일에 현재 상태 저장 (임시 파일에 쓴 뒤 교체)
+    LayoutSnapshotWriter writer;
+    {
+        ConfigReader config(m_config);
+        writer.setGrid(config->rows, config->cols, config->opacity, config->gridVisible);
+    }
+
+    std::vector<layout_format::StoredWindowLayout> windows;
+    std::vector<std::uint64_t> titles;
+    for (const auto& [name, workspace] : m_workspaces) {
+        windows.clear();
+        titles.clear();
+        for (const auto& window : workspace) {
+            layout_format::StoredWindowLayout stored = {};
+            stored.windowKey = window.identity.app;
+            stored.position = window.position;
+            stored.monitorIndex = window.monitorIndex;
+            stored.flags = (window.flags & WorkspaceMaximized) ? layout_format::WindowMaximized : 0;
+            windows.push_back(stored);
+            titles.push_back(window.identity.title);
+        }
+        writer.addLayout(name, windows, titles);
+    }
+    for (const auto& rule : m_windowRules) writer.addRule(rule);
+    for (const auto& config : m_monitorConfigs) writer.addMonitorConfig(config);
+
+    writer.writeAtomic(configPath());
+}
+
+void WindowManager::loadConfig() {
+    // 설정 파일에서 상태 로드 (메모리 매핑, 파싱 없음)
+    LayoutSnapshot snapshot;
+    if (!snapshot.open(configPath())) {
+        loadLegacyConfig();
+        return;
+    }
+
+    // 제목 해시가 없는 이전 파일은 창 핸들을 저장했으므로 다시 쓸 수 없다
+    m_workspaces.clear();
+    for (size_t i = 0; i < snapshot.layoutCount(); ++i) {
+        LayoutSnapshot::LayoutView view = snapshot.layout(i);
+        if (!view.titleHashes) continue;
+        auto& workspace = m_workspaces[std::string(view.name)];
+        workspace.reserve(view.windowCount);
+        for (size_t w = 0; w < view.windowCount; ++w) {
+            const auto& stored = view.windows[w];
+            WorkspaceWindow window;
+            window.identity = {stored.windowKey, view.titleHashes[w]};
+            window.position = stored.position;
+            window.monitorIndex = stored.monitorIndex;
+            window.flags = (stored.flags & layout_format::WindowMaximized) ? WorkspaceMaximized : 0;
+            workspace.push_back(window);
+        }
+    }
+
+    m_windowRules.clear();
+    for (size_t i = 0; i < snapshot.ruleCount(); ++i) {
+        m_windowRules.push_back(snapshot.ruleConfig(i));
+    }
+    const layout_format::StoredGrid* grid = snapshot.grid();
+    setConfigDefaults(grid->rows, grid->cols, grid->opacity);
+
+    // 범위를 벗어난 항목은 버린다 (다음 저장 때 빠진다)
+    m_monitorConfigs.clear();
+    for (size_t i = 0; i < snapshot.monitorConfigCount(); ++i) {
+        const auto& stored = snapshot.monitorConfig(i);
+        const MonitorGridConfig config = {stored.topologyKey, stored.monitorIndex, stored.rows, stored.cols};
+        if (config.valid()) m_monitorConfigs.push_back(config);
+    }
+    applyMonitorGrids();
+}
+
+void WindowManager::loadLegacyConfig() {
+    // 이전 버전의 텍스트 설정 (rows cols opacity)
+    std::ifstream file("window_manager.config", std::ios::binary);
+    if (!file) return;
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    // 깨진 파일이면 기본값 유지
+    LegacyGridConfig config;
+    if (!parseLegacyGridConfig(text, config)) return;
+    setConfigDefaults(config.rows, config.cols, config.opacity);
+}
+
+// 저장된 그리드와 창 규칙을 settings.conf 의 기본값으로 쓴다 (파일의 규칙은 그 뒤에 붙는다)
+void WindowManager::setConfigDefaults(int rows, int cols, float opacity) {
+    ConfigSnapshot defaults;
+    defaults.rows = rows;
+    defaults.cols = cols;
+    defaults.opacity = opacity;
+    defaults.rules = m_windowRules;
+    m_config.setDefaults(defaults);
+    m_config.publish(defaults);
+}
+
+static bool sameBindings(const std::vector<KeyBinding>& a, const std::vector<KeyBinding>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].id != b[i].id || a[i].first != b[i].first || a[i].second != b[i].second || a[i].taps != b[i].taps) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool sameTilingOptions(const TilingOptions& a, const TilingOptions& b) {
+    return a.mode == b.mode && a.gap == b.gap && a.masterRatio == b.masterRatio && a.masterCount == b.masterCount;
+}
+
+static bool sameTiling(const std::vector<TilingConfig>& a, const std::vector<TilingConfig>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].monitor != b[i].monitor || !sameTilingOptions(a[i].options, b[i].options)) return false;
+    }
+    return true;
+}
+
+void WindowManager::applyTilingConfig() {
+    // settings.conf 의 tiling 항목 (적지 않은 모니터는 끔). 방식이 바뀐 모니터만 다시 배치
+    for (int monitor = 0; monitor < m_tiling.monitorCount(); ++monitor) {
+        TilingOptions options;
+        for (const auto& tiling : m_appliedTiling) {
+            if (tiling.monitor == monitor) options = tiling.options;
+        }
+        if (!sameTilingOptions(options, m_tiling.options(monitor))) m_tiling.setOptions(monitor, options);
+    }
+    commitTiling();
+}
+
+void WindowManager::applyMonitorGrids() {
+    const std::uint64_t key = m_topology.key();
+    if (m_settingsLoaded) {
+        // 다른 모니터 구성의 항목은 그 구성으로 돌아올 때를 위해 남긴다
+        m_monitorConfigs.erase(std::remove_if(m_monitorConfigs.begin(), m_monitorConfigs.end(),
+                                              [key](const MonitorGridConfig& config) {
+                                                  return config.topologyKey == key;
+                                              }),
+                               m_monitorConfigs.end());
+        ConfigReader config(m_config);
+        for (MonitorGridConfig grid : config->monitorGrids) {
+            grid.topologyKey = key;
+            m_monitorConfigs.push_back(grid);
+        }
+    }
+
+    m_monitorGrids.clear();
+    for (const auto& config : m_monitorConfigs) {
+        if (config.topologyKey == key && config.monitorIndex < m_topology.size()) m_monitorGrids.push_back(config);
+    }
+}
+
+void WindowManager::applyConfig() {
+    const ConfigError error = m_config.lastError();
+    if (!error.message.empty()) {
+        // 오류 메시지는 UTF-8
+        wchar_t message[256];
+        int length = MultiByteToWideChar(CP_UTF8, 0, error.message.c_str(), -1, message, 256);
+        wchar_t line[320];
+        std::swprintf(line, 320, L"settings.conf 오류 (줄 %d): %ls - 이전 설정 유지\n", error.line,
+                      length ? message : L"?");
+        OutputDebugStringW(line);
+    }
+
+    bool bindingsChanged, rulesChanged, tilingChanged;
+    {
+        ConfigReader config(m_config);
+        if (config->version == m_appliedConfig) return;
+        m_appliedConfig = config->version;
+        bindingsChanged = !sameBindings(config->bindings, m_appliedBindings);
+        if (bindingsChanged) m_appliedBindings = config->bindings;
+        rulesChanged = config->ruleMatcher != m_appliedRules;
+        m_appliedRules = config->ruleMatcher;
+        tilingChanged = !sameTiling(config->tiling, m_appliedTiling);
+        if (tilingChanged) m_appliedTiling = config->tiling;
+    }
+
+    // initialize 뒤의 호출은 작업 스레드가 settings.conf 를 읽고 보낸 것
+    if (m_initialized && error.message.empty()) m_settingsLoaded = true;
+    applyMonitorGrids();
+    refreshGridOverlay();
+    if (rulesChanged) {
+        // 규칙이 바뀌면 창마다 다시 조회해 무시/플로팅 여부를 타일링에 반영
+        m_ruleResults.clear();
+        if (m_initialized) {
+            for (const auto& record : m_registry.windows()) trackTiledWindow(record);
+            commitTiling();
+        }
+    }
+    if (tilingChanged) applyTilingConfig();
+    // 핫키 재등록은 시스템 호출이 많아 읽기 구간 밖에서
+    if (bindingsChanged) HotkeyManager::getInstance().applyBindings(m_appliedBindings);
+}
+
+void WindowManager::processCommands() {
+    m_commandServer.processPending(*this);
+}
+
+void WindowManager::execute(CommandBatch& batch) {
+    // 이동은 모두 트랜잭션에 쌓았다가 배치 끝에 한 번 커밋 (질의는 커밋 전 상태)
+    m_commandMaximize.clear();
+    for (const Command& command : batch.commands) {
+        switch (command.op) {
+            case CommandOp::Snap:
+            case CommandOp::Move: {
+                HWND hwnd = toHWND(command.window);
+                if (!IsWindow(hwnd) || !isWindowManageable(hwnd)) {
+                    batch.addResult(CommandStatus::UnknownWindow);
+                    break;
+                }
+                const Rect target = command.op == CommandOp::Snap
+                                        ? toRect(calculateWindowPosition(hwnd, command.position))
+                                        : command.rect;
+                if (target.right <= target.left || target.bottom <= target.top) {
+                    batch.addResult(CommandStatus::Invalid);
+                    break;
+                }
+                m_animator->cancel(command.window);
+                if (m_moveExecutor->isHung(command.window)) {
+                    m_moveExecutor->submit(command.window, target);
+                } else {
+                    if (IsZoomed(hwnd)) ShowWindow(hwnd, SW_RESTORE);
+                    m_transaction.move(command.window, target);
+                }
+                batch.addResult(CommandStatus::Ok);
+                break;
+            }
+            case CommandOp::ApplyLayout:
+                if (!planWorkspace(command.name)) {
+                    batch.addResult(CommandStatus::UnknownLayout);
+                    break;
+                }
+                for (WindowId window : m_workspaceSwitcher.toMaximize()) m_commandMaximize.push_back(toHWND(window));
+                batch.addResult(CommandStatus::Ok);
+                break;
+            case CommandOp::Query: {
+                CommandResult result{CommandStatus::Ok, static_cast<std::uint32_t>(batch.states.size()), 0};
+                if (command.window) {
+                    const WindowRecord* record = m_registry.find(command.window);
+                    if (!record) {
+                        batch.addResult(CommandStatus::UnknownWindow);
+                        break;
+                    }
+                    queryWindow(*record, batch);
+                } else {
+                    for (const auto& record : m_registry.windows()) {
+                        if (record.state.manageable || m_workspaceSwitcher.isHidden(record.window)) {
+                            queryWindow(record, batch);
+                        }
+                    }
+                }
+                result.stateCount = static_cast<std::uint32_t>(batch.states.size()) - result.firstState;
+                batch.results.push_back(result);
+                break;
+            }
+            default:
+                batch.addResult(CommandStatus::Invalid);
+                break;
+        }
+    }
+
+    if (!m_transaction.empty()) m_lastCommitStats = m_transaction.commit();
+    for (HWND hwnd : m_commandMaximize) ShowWindow(hwnd, SW_MAXIMIZE);
+}
+
+void WindowManager::queryWindow(const WindowRecord& record, CommandBatch& batch) {
+    const bool visible = record.state.visible && !record.state.cloaked && !m_workspaceSwitcher.isHidden(record.window);
+    batch.states.push_back({record.window, record.state.rect, visible});
+}
+
+void WindowManager::onCommandsPending(void* context) {
+    auto* self = static_cast<WindowManager*>(context);
+    PostMessageW(self->m_messageWindow, WM_COMMANDS_PENDING, 0, 0);
+}
+
+void WindowManager::onConfigReloaded(bool ok, void* context) {
+    auto* self = static_cast<WindowManager*>(context);
+    self->m_startup.mark(StartupStage::ConfigLoaded);
+    PostMessageW(self->m_messageWindow, WM_CONFIG_RELOADED, ok ? 1 : 0, 0);
+}
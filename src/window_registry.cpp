@@ -0,0 +1,53 @@
+#include "window_registry.h"
+
+void WindowRegistry::seed(WindowId window, WindowInfoSource& source) {
+    refresh(window, source);
+}
+
+void WindowRegistry::apply(const std::vector<WindowUpdate>& updates, WindowInfoSource& source) {
+    for (const auto& update : updates) {
+        if (update.flags & ChangeDestroyed) {
+            remove(update.window);
+            // 같은 핸들로 새 창이 생긴 경우만 계속 진행
+            if (!(update.flags & ChangeCreated)) continue;
+        }
+        refresh(update.window, source);
+    }
+}
+
+const WindowRecord* WindowRegistry::find(WindowId window) const {
+    auto it = m_index.find(window);
+    return it != m_index.end() ? &m_records[it->second] : nullptr;
+}
+
+void WindowRegistry::refresh(WindowId window, WindowInfoSource& source) {
+    WindowSnapshot state;
+    if (!source.query(window, state)) {
+        remove(window);
+        return;
+    }
+
+    auto it = m_index.find(window);
+    if (it != m_index.end()) {
+        m_records[it->second].state = state;
+        return;
+    }
+    m_index.emplace(window, m_records.size());
+    m_records.push_back({window, state});
+}
+
+void WindowRegistry::remove(WindowId window) {
+    auto it = m_index.find(window);
+    if (it == m_index.end()) return;
+
+    size_t index = it->second;
+    m_index.erase(it);
+    if (index + 1 != m_records.size()) {
+        m_records[index] = m_records.back();
+        m_index[m_records[index].window] = index;
+    }
+    m_records.pop_back();
+
+    if (m_foreground == window) m_foreground = 0;
+    if (m_onRemoved) m_onRemoved(window);
+}
@@ -0,0 +1,440 @@
+#include "window_rules.h"
+#include "snap_geometry.h"
+#include <algorithm>
+
+static char lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+static std::string toLower(std::string_view text) {
+    std::string out(text);
+    for (char& c : out) c = lower(c);
+    return out;
+}
+
+// '*' 만 지원하는 glob. 마지막 '*' 위치로만 되돌아가므로 선형에 가깝다
+bool globMatch(std::string_view pattern, std::string_view text) {
+    size_t p = 0, t = 0;
+    size_t star = std::string_view::npos, resume = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            resume = t;
+        } else if (p < pattern.size() && lower(pattern[p]) == lower(text[t])) {
+            ++p;
+            ++t;
+        } else if (star != std::string_view::npos) {
+            p = star + 1;
+            t = ++resume;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+static bool fieldMatches(const std::string& pattern, std::string_view text) {
+    return pattern.empty() || globMatch(pattern, text);
+}
+
+static void combineRule(WindowRuleResult& result, const WindowRuleConfig& rule, int index) {
+    if (result.rule < 0) result.rule = index;
+    result.action |= rule.action;
+    if (result.slot < 0) result.slot = rule.slot;
+    if (result.monitor < 0) result.monitor = rule.monitor;
+    result.minWidth = std::max(result.minWidth, rule.minWidth);
+    result.minHeight = std::max(result.minHeight, rule.minHeight);
+}
+
+WindowRuleResult matchWindowRulesLinear(const std::vector<WindowRuleConfig>& rules, const WindowDescriptor& window) {
+    WindowRuleResult result;
+    for (size_t i = 0; i < rules.size(); ++i) {
+        const WindowRuleConfig& rule = rules[i];
+        if (fieldMatches(rule.className, window.className) && fieldMatches(rule.titlePattern, window.title) &&
+            fieldMatches(rule.executable, window.executable)) {
+            combineRule(result, rule, static_cast<int>(i));
+        }
+    }
+    return result;
+}
+
+// 작업 영역 안으로 밀어 넣는다 (작업 영역보다 크면 왼쪽/위에 맞춘다)
+static void clampInto(Rect& rect, const Rect& area) {
+    if (rect.right > area.right) {
+        rect.left -= rect.right - area.right;
+        rect.right = area.right;
+    }
+    if (rect.bottom > area.bottom) {
+        rect.top -= rect.bottom - area.bottom;
+        rect.bottom = area.bottom;
+    }
+    if (rect.left < area.left) {
+        rect.right += area.left - rect.left;
+        rect.left = area.left;
+    }
+    if (rect.top < area.top) {
+        rect.bottom += area.top - rect.top;
+        rect.top = area.top;
+    }
+}
+
+static bool hasSlot(const WindowRuleResult& rule) {
+    return rule.slot >= 0 && rule.slot <= static_cast<int>(WindowPosition::BottomRight);
+}
+
+// 규칙이 옮길 모니터 (from 은 지금 모니터). 위치 규칙이 없거나 모니터를 모르면 false
+static bool ruleMonitors(const WindowRuleResult& rule, const MonitorTopology& topology, const Rect& current, int& from,
+                         int& to) {
+    if (rule.slot < 0 && rule.monitor < 0 && rule.minWidth <= 0 && rule.minHeight <= 0) return false;
+    from = topology.monitorFromRect(current);
+    to = (rule.monitor >= 0 && rule.monitor < topology.size()) ? rule.monitor : from;
+    return to >= 0;
+}
+
+// 슬롯이 없을 때의 출발 위치: 다른 모니터로 옮길 때는 작업 영역 기준 상대 위치를 유지
+static Rect unslottedTarget(const MonitorTopology& topology, int from, int to, const Rect& current) {
+    if (from < 0 || from == to) return current;
+    const Rect& area = topology.monitor(to).workArea;
+    const Rect& fromArea = topology.monitor(from).workArea;
+    const int dx = area.left - fromArea.left, dy = area.top - fromArea.top;
+    return {current.left + dx, current.top + dy, current.right + dx, current.bottom + dy};
+}
+
+// 최소 크기와 작업 영역을 반영한 최종 위치. 옮길 필요가 없으면 false
+static bool finishTarget(const WindowRuleResult& rule, const Rect& area, int from, int to, const Rect& current,
+                         Rect target, Rect& out) {
+    // 최소 크기는 작업 영역을 넘지 않게 늘린다
+    const int width = std::min(std::max(target.width(), rule.minWidth), area.width());
+    const int height = std::min(std::max(target.height(), rule.minHeight), area.height());
+    target.right = target.left + std::max(width, target.width());
+    target.bottom = target.top + std::max(height, target.height());
+    if (target.width() != current.width() || target.height() != current.height() || from != to) {
+        clampInto(target, area);
+    }
+
+    if (target.left == current.left && target.top == current.top && target.right == current.right &&
+        target.bottom == current.bottom) {
+        return false;
+    }
+    out = target;
+    return true;
+}
+
+bool windowRuleTarget(const WindowRuleResult& rule, const MonitorTopology& topology, const Rect& current, Rect& out) {
+    int from, to;
+    if (!ruleMonitors(rule, topology, current, from, to)) return false;
+    const Rect& area = topology.monitor(to).workArea;
+    const Rect target = hasSlot(rule) ? calculateSnapRect(area, static_cast<WindowPosition>(rule.slot))
+                                      : unslottedTarget(topology, from, to, current);
+    return finishTarget(rule, area, from, to, current, target, out);
+}
+
+void windowRuleTargets(std::vector<RulePlacement>& placements, const MonitorTopology& topology, SlotBatch& batch) {
+    // 슬롯 규칙은 모아 두었다가 배열 구조체 커널로 한 번에 계산
+    batch.resize(placements.size());
+    size_t slotted = 0;
+    for (RulePlacement& placement : placements) {
+        placement.move = ruleMonitors(placement.rule, topology, placement.current, placement.from, placement.to);
+        if (placement.move && hasSlot(placement.rule)) {
+            const WindowPosition position = static_cast<WindowPosition>(placement.rule.slot);
+            batch.set(slotted++, topology.monitor(placement.to).workArea, positionSlot(position));
+        }
+    }
+    batch.resize(slotted);
+    computeSlotRects(batch);
+
+    slotted = 0;
+    for (RulePlacement& placement : placements) {
+        if (!placement.move) continue;
+        const Rect target = hasSlot(placement.rule)
+            ? batch.rect(slotted++)
+            : unslottedTarget(topology, placement.from, placement.to, placement.current);
+        placement.move = finishTarget(placement.rule, topology.monitor(placement.to).workArea, placement.from,
+                                      placement.to, placement.current, target, placement.target);
+    }
+}
+
+// ---- 해시 표 ----
+
+static std::uint64_t hashLower(std::string_view text) {
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(lower(c));
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+void CompiledWindowRules::ExactTable::build(const std::vector<std::pair<std::string, std::uint32_t>>& entries) {
+    std::vector<std::pair<std::string, std::uint32_t>> sorted = entries;
+    std::sort(sorted.begin(), sorted.end());
+
+    size_t keys = 0;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        if (i == 0 || sorted[i].first != sorted[i - 1].first) ++keys;
+    }
+    size_t capacity = 8;
+    while (capacity < keys * 2) capacity <<= 1;
+    m_slots.assign(capacity, Slot());
+    m_mask = capacity - 1;
+    m_keys.clear();
+    m_rules.clear();
+
+    for (size_t i = 0; i < sorted.size();) {
+        const std::string& key = sorted[i].first;
+        Slot slot;
+        slot.hash = hashLower(key);
+        slot.keyOffset = static_cast<std::uint32_t>(m_keys.size());
+        slot.keyLength = static_cast<std::uint32_t>(key.size());
+        slot.rulesBegin = static_cast<std::uint32_t>(m_rules.size());
+        m_keys.insert(m_keys.end(), key.begin(), key.end());
+        for (; i < sorted.size() && sorted[i].first == key; ++i) m_rules.push_back(sorted[i].second);
+        slot.rulesEnd = static_cast<std::uint32_t>(m_rules.size());
+
+        size_t index = static_cast<size_t>(slot.hash) & m_mask;
+        while (m_slots[index].rulesEnd != m_slots[index].rulesBegin) index = (index + 1) & m_mask;
+        m_slots[index] = slot;
+    }
+}
+
+bool CompiledWindowRules::ExactTable::find(std::string_view text, const std::uint32_t*& begin,
+                                           const std::uint32_t*& end) const {
+    if (m_rules.empty()) return false;
+    const std::uint64_t hash = hashLower(text);
+    for (size_t index = static_cast<size_t>(hash) & m_mask;; index = (index + 1) & m_mask) {
+        const Slot& slot = m_slots[index];
+        if (slot.rulesEnd == slot.rulesBegin) return false;
+        if (slot.hash != hash || slot.keyLength != text.size()) continue;
+
+        const char* key = m_keys.data() + slot.keyOffset;
+        size_t i = 0;
+        while (i < text.size() && key[i] == lower(text[i])) ++i;
+        if (i != text.size()) continue;
+        begin = m_rules.data() + slot.rulesBegin;
+        end = m_rules.data() + slot.rulesEnd;
+        return true;
+    }
+}
+
+size_t CompiledWindowRules::ExactTable::memoryBytes() const {
+    return m_slots.size() * sizeof(Slot) + m_keys.size() + m_rules.size() * sizeof(std::uint32_t);
+}
+
+// ---- 컴파일 ----
+
+// 사전 항목 값: 규칙 id 와 그 규칙 안에서의 조각 번호 (규칙마다 최대 32 조각)
+static constexpr std::uint32_t kPieceBits = 5;
+static constexpr std::uint32_t kMaxPieces = 1u << kPieceBits;
+
+void CompiledWindowRules::compile(const std::vector<WindowRuleConfig>& rules) {
+    m_rules = rules;
+    m_required.assign(rules.size(), 0);
+    m_verify.assign(rules.size(), 0);
+    m_always.clear();
+
+    using Entries = std::vector<std::pair<std::string, std::uint32_t>>;
+    Entries classes, executables, titles, classAnchors, executableAnchors, titleAnchors;
+    std::vector<std::string> fieldPieces;
+    std::uint32_t pieceCount = 0;
+
+    auto addPiece = [&](std::uint32_t rule, std::uint8_t field, std::string piece, Entries& entries) {
+        // 한 필드 안의 같은 조각은 한 번만. 조각이 너무 많으면 나머지는 glob 확인에 맡긴다
+        for (const std::string& existing : fieldPieces) {
+            if (existing == piece) return;
+        }
+        if (pieceCount >= kMaxPieces) {
+            m_verify[rule] |= field;
+            return;
+        }
+        fieldPieces.push_back(piece);
+        m_required[rule] |= 1u << pieceCount;
+        entries.push_back({std::move(piece), (rule << kPieceBits) | pieceCount});
+        ++pieceCount;
+    };
+    auto addField = [&](std::uint32_t rule, std::uint8_t field, const std::string& pattern, Entries& exact,
+                        Entries& anchors) {
+        if (pattern.empty() || pattern.find_first_not_of('*') == std::string::npos) return;
+        fieldPieces.clear();
+        if (pattern.find('*') == std::string::npos) {
+            addPiece(rule, field, toLower(pattern), exact);
+            return;
+        }
+        // '*' 사이의 조각이 모두 들어 있는 창만 후보. "*조각*" 꼴이 아니면 순서/양 끝은 glob 으로 확인
+        size_t start = 0, segments = 0;
+        while (start <= pattern.size()) {
+            size_t star = pattern.find('*', start);
+            if (star == std::string::npos) star = pattern.size();
+            if (star > start) {
+                addPiece(rule, field, toLower(std::string_view(pattern).substr(start, star - start)), anchors);
+                ++segments;
+            }
+            start = star + 1;
+        }
+        if (segments != 1 || pattern.front() != '*' || pattern.back() != '*') m_verify[rule] |= field;
+    };
+
+    for (std::uint32_t i = 0; i < rules.size(); ++i) {
+        pieceCount = 0;
+        addField(i, FieldClass, rules[i].className, classes, classAnchors);
+        addField(i, FieldTitle, rules[i].titlePattern, titles, titleAnchors);
+        addField(i, FieldExecutable, rules[i].executable, executables, executableAnchors);
+        if (m_required[i] == 0) m_always.push_back(i);
+    }
+
+    m_classes.build(classes);
+    m_executables.build(executables);
+    m_titles.build(titles);
+    m_classGlobs.build(classAnchors);
+    m_executableGlobs.build(executableAnchors);
+    m_titleGlobs.build(titleAnchors);
+}
+
+void CompiledWindowRules::SubstringAutomaton::build(const std::vector<std::pair<std::string, std::uint32_t>>& anchors) {
+    // 조각은 소문자라 대문자 26 개를 뺀 230 개 + 0 번이면 uint8 에 들어간다
+    std::fill(std::begin(m_byteClass), std::end(m_byteClass), 0);
+    m_classCount = 1;
+    for (const auto& [anchor, value] : anchors) {
+        for (char c : anchor) {
+            const unsigned char b = static_cast<unsigned char>(c);
+            if (m_byteClass[b] == 0) m_byteClass[b] = static_cast<std::uint8_t>(m_classCount++);
+        }
+    }
+    for (int c = 'A'; c <= 'Z'; ++c) m_byteClass[c] = m_byteClass[c - 'A' + 'a'];
+
+    m_next.clear();
+    m_outputs.clear();
+    m_outputBegin.clear();
+    m_stateCount = 0;
+    if (anchors.empty()) return;
+
+    const int classes = m_classCount;
+    std::vector<std::vector<std::uint32_t>> stateRules(1);
+    m_next.assign(classes, -1);
+    for (const auto& [anchor, value] : anchors) {
+        std::int32_t state = 0;
+        for (char c : anchor) {
+            std::int32_t& next = m_next[static_cast<size_t>(state) * classes + m_byteClass[static_cast<unsigned char>(c)]];
+            if (next < 0) {
+                next = static_cast<std::int32_t>(stateRules.size());
+                stateRules.emplace_back();
+                m_next.resize(m_next.size() + classes, -1);
+            }
+            // resize 로 참조가 무효화될 수 있어 다시 읽는다
+            state = m_next[static_cast<size_t>(state) * classes + m_byteClass[static_cast<unsigned char>(c)]];
+        }
+        stateRules[state].push_back(value);
+    }
+    m_stateCount = stateRules.size();
+
+    // BFS 로 실패 링크를 구하고 전이를 펼친다. 출력은 실패 상태의 출력을 이어 붙인다
+    std::vector<std::int32_t> fail(m_stateCount, 0);
+    std::vector<std::int32_t> order;
+    order.reserve(m_stateCount);
+    for (int c = 0; c < classes; ++c) {
+        std::int32_t& next = m_next[c];
+        if (next < 0) {
+            next = 0;
+        } else {
+            fail[next] = 0;
+            order.push_back(next);
+        }
+    }
+    for (size_t head = 0; head < order.size(); ++head) {
+        const std::int32_t state = order[head];
+        for (int c = 0; c < classes; ++c) {
+            std::int32_t& next = m_next[static_cast<size_t>(state) * classes + c];
+            const std::int32_t fallback = m_next[static_cast<size_t>(fail[state]) * classes + c];
+            if (next < 0) {
+                next = fallback;
+            } else {
+                fail[next] = fallback;
+                order.push_back(next);
+            }
+        }
+    }
+
+    std::vector<std::vector<std::uint32_t>> outputs(m_stateCount);
+    outputs[0] = stateRules[0];
+    for (std::int32_t state : order) {
+        outputs[state] = stateRules[state];
+        const auto& inherited = outputs[fail[state]];
+        outputs[state].insert(outputs[state].end(), inherited.begin(), inherited.end());
+    }
+    m_outputBegin.resize(m_stateCount + 1);
+    for (size_t s = 0; s < m_stateCount; ++s) {
+        m_outputBegin[s] = static_cast<std::uint32_t>(m_outputs.size());
+        m_outputs.insert(m_outputs.end(), outputs[s].begin(), outputs[s].end());
+    }
+    m_outputBegin[m_stateCount] = static_cast<std::uint32_t>(m_outputs.size());
+}
+
+size_t CompiledWindowRules::SubstringAutomaton::memoryBytes() const {
+    return sizeof(m_byteClass) + m_next.size() * sizeof(std::int32_t) +
+           (m_outputBegin.size() + m_outputs.size()) * sizeof(std::uint32_t);
+}
+
+size_t CompiledWindowRules::memoryBytes() const {
+    return m_classes.memoryBytes() + m_executables.memoryBytes() + m_titles.memoryBytes() +
+           m_classGlobs.memoryBytes() + m_executableGlobs.memoryBytes() + m_titleGlobs.memoryBytes() +
+           m_rules.size() * (sizeof(WindowRuleConfig) + 2);
+}
+
+// ---- 조회 ----
+
+bool CompiledWindowRules::verify(std::uint32_t rule, const WindowDescriptor& window) const {
+    const std::uint8_t fields = m_verify[rule];
+    const WindowRuleConfig& config = m_rules[rule];
+    if ((fields & FieldClass) && !globMatch(config.className, window.className)) return false;
+    if ((fields & FieldTitle) && !globMatch(config.titlePattern, window.title)) return false;
+    if ((fields & FieldExecutable) && !globMatch(config.executable, window.executable)) return false;
+    return true;
+}
+
+WindowRuleResult CompiledWindowRules::match(const WindowDescriptor& window, RuleMatchScratch& scratch) const {
+    const size_t count = m_rules.size();
+    if (scratch.stamps.size() < count) {
+        scratch.stamps.resize(count, 0);
+        scratch.hits.resize(count, 0);
+        scratch.matched.reserve(count);
+    }
+    if (++scratch.generation == 0) {
+        std::fill(scratch.stamps.begin(), scratch.stamps.end(), 0);
+        scratch.generation = 1;
+    }
+    const std::uint32_t generation = scratch.generation;
+    scratch.matched.clear();
+
+    // 사전 항목(정확한 값 또는 glob 조각)이 맞을 때마다 비트를 채우고, 모두 맞으면 후보
+    auto hitRange = [&](const std::uint32_t* begin, const std::uint32_t* end) {
+        for (const std::uint32_t* it = begin; it != end; ++it) {
+            const std::uint32_t rule = *it >> kPieceBits;
+            const std::uint32_t bit = 1u << (*it & (kMaxPieces - 1));
+            if (scratch.stamps[rule] != generation) {
+                scratch.stamps[rule] = generation;
+                scratch.hits[rule] = 0;
+            }
+            if (scratch.hits[rule] & bit) continue;
+            scratch.hits[rule] |= bit;
+            if (scratch.hits[rule] == m_required[rule]) scratch.matched.push_back(rule);
+        }
+    };
+
+    const std::uint32_t* begin;
+    const std::uint32_t* end;
+    if (m_classes.find(window.className, begin, end)) hitRange(begin, end);
+    if (m_executables.find(window.executable, begin, end)) hitRange(begin, end);
+    if (m_titles.find(window.title, begin, end)) hitRange(begin, end);
+    m_classGlobs.scan(window.className, hitRange);
+    m_executableGlobs.scan(window.executable, hitRange);
+    m_titleGlobs.scan(window.title, hitRange);
+    scratch.matched.insert(scratch.matched.end(), m_always.begin(), m_always.end());
+
+    // 적힌 순서대로 합친다
+    std::sort(scratch.matched.begin(), scratch.matched.end());
+    WindowRuleResult result;
+    for (std::uint32_t rule : scratch.matched) {
+        if (verify(rule, window)) combineRule(result, m_rules[rule], static_cast<int>(rule));
+    }
+    return result;
+}
@@ -0,0 +1,367 @@
+#include "window_spatial_index.h"
+#include <algorithm>
+
+static bool isHorizontal(Direction direction) {
+    return direction == Direction::Left || direction == Direction::Right;
+}
+
+static bool isForward(Direction direction) {
+    return direction == Direction::Right || direction == Direction::Down;
+}
+
+// 두 구간 사이 간격 (겹치면 0)
+static std::int64_t rangeGap(int a0, int a1, int b0, int b1) {
+    return std::max<std::int64_t>(0, std::max(b0 - a1, a0 - b1));
+}
+
+std::int64_t directionalScore(const Rect& from, const Rect& to, Direction direction) {
+    std::int64_t primary;
+    std::int64_t gap;
+    if (isHorizontal(direction)) {
+        primary = static_cast<std::int64_t>(to.left) + to.right - from.left - from.right;
+        gap = rangeGap(from.top, from.bottom, to.top, to.bottom);
+    } else {
+        primary = static_cast<std::int64_t>(to.top) + to.bottom - from.top - from.bottom;
+        gap = rangeGap(from.left, from.right, to.left, to.right);
+    }
+    if (!isForward(direction)) primary = -primary;
+    if (primary <= 0) return -1;
+    return primary + 4 * gap;
+}
+
+static std::int64_t crossDistance(const Rect& from, const Rect& to, Direction direction) {
+    const std::int64_t d = isHorizontal(direction)
+                               ? static_cast<std::int64_t>(to.top) + to.bottom - from.top - from.bottom
+                               : static_cast<std::int64_t>(to.left) + to.right - from.left - from.right;
+    return d < 0 ? -d : d;
+}
+
+bool directionalBetter(const Rect& from, std::int64_t score, const Rect& rect, WindowId window,
+                       std::int64_t bestScore, const Rect& bestRect, WindowId best, Direction direction) {
+    if (best == 0 || score < bestScore) return true;
+    if (score > bestScore) return false;
+    const std::int64_t cross = crossDistance(from, rect, direction);
+    const std::int64_t bestCross = crossDistance(from, bestRect, direction);
+    if (cross != bestCross) return cross < bestCross;
+    return window < best;
+}
+
+// from 의 진행 방향 모서리에서 to 의 가까운 모서리까지 (수직 방향으로 겹치지 않거나 뒤에 있으면 -1)
+static std::int64_t blockingLead(const Rect& from, const Rect& to, Direction direction) {
+    std::int64_t lead;
+    switch (direction) {
+        case Direction::Right: lead = static_cast<std::int64_t>(to.left) - from.right; break;
+        case Direction::Left: lead = static_cast<std::int64_t>(from.left) - to.right; break;
+        case Direction::Down: lead = static_cast<std::int64_t>(to.top) - from.bottom; break;
+        default: lead = static_cast<std::int64_t>(from.top) - to.bottom; break;
+    }
+    const bool overlaps = isHorizontal(direction) ? (to.top < from.bottom && to.bottom > from.top)
+                                                  : (to.left < from.right && to.right > from.left);
+    return overlaps && lead >= 0 ? lead : -1;
+}
+
+Rect pushRect(const Rect& window, Direction direction, const Rect* obstacle, const Rect& workArea) {
+    // 수직 방향으로 겹치지 않는 창은 가로막지 않는다
+    if (obstacle && (isHorizontal(direction)
+                         ? (obstacle->bottom <= window.top || obstacle->top >= window.bottom)
+                         : (obstacle->right <= window.left || obstacle->left >= window.right))) {
+        obstacle = nullptr;
+    }
+
+    int dx = 0;
+    int dy = 0;
+    switch (direction) {
+        case Direction::Right: {
+            int edge = workArea.right;
+            if (obstacle && obstacle->left >= window.right) edge = std::min(edge, obstacle->left);
+            dx = edge - window.right;
+            break;
+        }
+        case Direction::Left: {
+            int edge = workArea.left;
+            if (obstacle && obstacle->right <= window.left) edge = std::max(edge, obstacle->right);
+            dx = edge - window.left;
+            break;
+        }
+        case Direction::Down: {
+            int edge = workArea.bottom;
+            if (obstacle && obstacle->top >= window.bottom) edge = std::min(edge, obstacle->top);
+            dy = edge - window.bottom;
+            break;
+        }
+        case Direction::Up: {
+            int edge = workArea.top;
+            if (obstacle && obstacle->bottom <= window.top) edge = std::max(edge, obstacle->bottom);
+            dy = edge - window.top;
+            break;
+        }
+    }
+    // 이미 끝에 닿았으면 그대로 (반대쪽으로 끌어오지 않는다)
+    if (isForward(direction) ? (dx < 0 || dy < 0) : (dx > 0 || dy > 0)) return window;
+    return {window.left + dx, window.top + dy, window.right + dx, window.bottom + dy};
+}
+
+// ---- 색인 ----
+
+const Rect* WindowSpatialIndex::rectOf(WindowId window) const {
+    auto it = m_index.find(window);
+    return it != m_index.end() ? &m_entries[it->second].rect : nullptr;
+}
+
+void WindowSpatialIndex::setMonitors(const std::vector<Rect>& workAreas) {
+    m_grids.clear();
+    m_stray.clear();
+    m_maxWidth = 0;
+    m_maxHeight = 0;
+    for (const Rect& area : workAreas) {
+        if (area.empty()) continue;
+        Grid grid;
+        grid.area = area;
+        grid.cols = (area.width() + m_cellSize - 1) / m_cellSize;
+        grid.rows = (area.height() + m_cellSize - 1) / m_cellSize;
+        grid.cells.resize(static_cast<size_t>(grid.cols) * grid.rows);
+        m_grids.push_back(std::move(grid));
+    }
+    for (std::uint32_t i = 0; i < m_entries.size(); ++i) place(i);
+}
+
+void WindowSpatialIndex::clear() {
+    for (Grid& grid : m_grids) {
+        for (auto& cell : grid.cells) cell.clear();
+    }
+    m_stray.clear();
+    m_entries.clear();
+    m_maxWidth = 0;
+    m_maxHeight = 0;
+    m_index.clear();
+}
+
+void WindowSpatialIndex::update(WindowId window, const Rect& rect) {
+    auto it = m_index.find(window);
+    if (it != m_index.end()) {
+        Entry& entry = m_entries[it->second];
+        if (entry.rect == rect) return;
+        unplace(it->second);
+        entry.rect = rect;
+        place(it->second);
+        return;
+    }
+    const std::uint32_t index = static_cast<std::uint32_t>(m_entries.size());
+    Entry entry;
+    entry.window = window;
+    entry.rect = rect;
+    m_entries.push_back(entry);
+    m_index.emplace(window, index);
+    place(index);
+}
+
+void WindowSpatialIndex::remove(WindowId window) {
+    auto it = m_index.find(window);
+    if (it == m_index.end()) return;
+    const std::uint32_t index = it->second;
+    m_index.erase(it);
+    unplace(index);
+
+    // 마지막 항목을 빈자리로 옮기고 칸의 참조를 고친다
+    const std::uint32_t last = static_cast<std::uint32_t>(m_entries.size() - 1);
+    if (index != last) {
+        m_entries[index] = m_entries[last];
+        bucketOf(m_entries[index])[m_entries[index].slot] = index;
+        m_index[m_entries[index].window] = index;
+    }
+    m_entries.pop_back();
+}
+
+std::vector<std::uint32_t>& WindowSpatialIndex::bucketOf(const Entry& entry) {
+    return entry.grid < 0 ? m_stray : m_grids[entry.grid].cells[entry.cell];
+}
+
+void WindowSpatialIndex::place(std::uint32_t index) {
+    Entry& entry = m_entries[index];
+    // 중심 (반 픽셀 단위)
+    const std::int64_t cx = static_cast<std::int64_t>(entry.rect.left) + entry.rect.right;
+    const std::int64_t cy = static_cast<std::int64_t>(entry.rect.top) + entry.rect.bottom;
+
+    m_maxWidth = std::max(m_maxWidth, entry.rect.width());
+    m_maxHeight = std::max(m_maxHeight, entry.rect.height());
+
+    entry.grid = -1;
+    for (size_t g = 0; g < m_grids.size(); ++g) {
+        const Grid& grid = m_grids[g];
+        const Rect& area = grid.area;
+        if (cx < 2ll * area.left || cx >= 2ll * area.right || cy < 2ll * area.top || cy >= 2ll * area.bottom) continue;
+        const int col = static_cast<int>((cx - 2ll * area.left) / (2ll * m_cellSize));
+        const int row = static_cast<int>((cy - 2ll * area.top) / (2ll * m_cellSize));
+        entry.grid = static_cast<int>(g);
+        entry.cell = static_cast<std::uint32_t>(row * grid.cols + col);
+        break;
+    }
+    std::vector<std::uint32_t>& bucket = bucketOf(entry);
+    entry.slot = static_cast<std::uint32_t>(bucket.size());
+    bucket.push_back(index);
+}
+
+void WindowSpatialIndex::unplace(std::uint32_t index) {
+    const Entry& entry = m_entries[index];
+    std::vector<std::uint32_t>& bucket = bucketOf(entry);
+    const std::uint32_t moved = bucket.back();
+    bucket[entry.slot] = moved;
+    m_entries[moved].slot = entry.slot;
+    bucket.pop_back();
+}
+
+void WindowSpatialIndex::consider(std::uint32_t index, const Rect& from, Direction direction, WindowId exclude,
+                                  std::int64_t& bestScore, std::uint32_t& best) const {
+    const Entry& entry = m_entries[index];
+    if (entry.window == exclude) return;
+    const std::int64_t score = directionalScore(from, entry.rect, direction);
+    if (score < 0) return;
+    const bool none = best == UINT32_MAX;
+    if (directionalBetter(from, score, entry.rect, entry.window, bestScore, none ? entry.rect : m_entries[best].rect,
+                          none ? 0 : m_entries[best].window, direction)) {
+        bestScore = score;
+        best = index;
+    }
+}
+
+void WindowSpatialIndex::searchGrid(const Grid& grid, const Rect& from, Direction direction, WindowId exclude,
+                                    std::int64_t& bestScore, std::uint32_t& best, SpatialQueryStats* stats) const {
+    const bool horizontal = isHorizontal(direction);
+    // 진행 방향 축: 가로면 열, 세로면 행
+    const std::int64_t origin = horizontal ? static_cast<std::int64_t>(from.left) + from.right
+                                           : static_cast<std::int64_t>(from.top) + from.bottom;
+    const int areaStart = horizontal ? grid.area.left : grid.area.top;
+    const int areaEnd = horizontal ? grid.area.right : grid.area.bottom;
+    const int lines = horizontal ? grid.cols : grid.rows;
+    const int across = horizontal ? grid.rows : grid.cols;
+    const std::int64_t cell2 = 2ll * m_cellSize;
+
+    // 칸 안 창의 수직 방향 구간은 중심 범위를 가장 큰 창 크기의 절반만큼 넓힌 범위 안에 있다
+    const int crossStart = horizontal ? grid.area.top : grid.area.left;
+    const int fromCross0 = horizontal ? from.top : from.left;
+    const int fromCross1 = horizontal ? from.bottom : from.right;
+    const int maxHalf = ((horizontal ? m_maxHeight : m_maxWidth) + 1) / 2;
+
+    auto scanLine = [&](int line, std::int64_t bound) {
+        for (int i = 0; i < across; ++i) {
+            const auto& bucket = grid.cells[horizontal ? i * grid.cols + line : line * grid.cols + i];
+            if (bucket.empty()) continue;
+            if (best != UINT32_MAX) {
+                const int cell0 = crossStart + i * m_cellSize;
+                const std::int64_t gap = rangeGap(fromCross0, fromCross1, cell0 - maxHalf, cell0 + m_cellSize + maxHalf);
+                if (bound + 4 * gap > bestScore) continue;
+            }
+            if (stats) ++stats->cellsVisited;
+            for (std::uint32_t index : bucket) consider(index, from, direction, exclude, bestScore, best);
+            if (stats) stats->candidatesScored += bucket.size();
+        }
+    };
+
+    if (isForward(direction)) {
+        if (2ll * areaEnd <= origin) return;
+        int line = origin <= 2ll * areaStart
+                       ? 0
+                       : static_cast<int>(std::min<std::int64_t>(lines - 1, (origin - 2ll * areaStart) / cell2));
+        for (; line < lines; ++line) {
+            // 이 열의 중심은 모두 열 시작 이후 - 그 거리가 최선보다 멀면 더 볼 필요 없다
+            const std::int64_t bound = 2ll * (areaStart + static_cast<std::int64_t>(line) * m_cellSize) - origin;
+            if (best != UINT32_MAX && bound > bestScore) break;
+            scanLine(line, std::max<std::int64_t>(bound, 0));
+        }
+    } else {
+        if (2ll * areaStart >= origin) return;
+        int line = origin >= 2ll * areaEnd ? lines - 1 : static_cast<int>((origin - 2ll * areaStart) / cell2);
+        for (; line >= 0; --line) {
+            const std::int64_t lineEnd =
+                std::min<std::int64_t>(areaEnd, areaStart + static_cast<std::int64_t>(line + 1) * m_cellSize);
+            const std::int64_t bound = origin - 2 * lineEnd;
+            if (best != UINT32_MAX && bound > bestScore) break;
+            scanLine(line, std::max<std::int64_t>(bound, 0));
+        }
+    }
+}
+
+WindowId WindowSpatialIndex::nearest(const Rect& from, Direction direction, WindowId exclude,
+                                     SpatialQueryStats* stats) const {
+    std::int64_t bestScore = 0;
+    std::uint32_t best = UINT32_MAX;
+    for (const Grid& grid : m_grids) searchGrid(grid, from, direction, exclude, bestScore, best, stats);
+    for (std::uint32_t index : m_stray) consider(index, from, direction, exclude, bestScore, best);
+    if (stats) stats->candidatesScored += m_stray.size();
+    return best == UINT32_MAX ? 0 : m_entries[best].window;
+}
+
+void WindowSpatialIndex::considerBlocking(std::uint32_t index, const Rect& from, Direction direction,
+                                          WindowId exclude, std::int64_t& bestLead, std::uint32_t& best) const {
+    const Entry& entry = m_entries[index];
+    if (entry.window == exclude) return;
+    const std::int64_t lead = blockingLead(from, entry.rect, direction);
+    if (lead < 0) return;
+    if (best == UINT32_MAX || lead < bestLead || (lead == bestLead && entry.window < m_entries[best].window)) {
+        bestLead = lead;
+        best = index;
+    }
+}
+
+void WindowSpatialIndex::searchBlocking(const Grid& grid, const Rect& from, Direction direction, WindowId exclude,
+                                        std::int64_t& bestLead, std::uint32_t& best,
+                                        SpatialQueryStats* stats) const {
+    const bool horizontal = isHorizontal(direction);
+    const bool forward = isForward(direction);
+    // 앞에 있는 창은 중심도 from 의 진행 방향 모서리 너머에 있다
+    const std::int64_t edge = horizontal ? (forward ? from.right : from.left) : (forward ? from.bottom : from.top);
+    const int areaStart = horizontal ? grid.area.left : grid.area.top;
+    const int areaEnd = horizontal ? grid.area.right : grid.area.bottom;
+    const int lines = horizontal ? grid.cols : grid.rows;
+    const int across = horizontal ? grid.rows : grid.cols;
+    const int maxHalf = ((horizontal ? m_maxWidth : m_maxHeight) + 1) / 2;
+
+    // 수직 방향으로 from 과 겹칠 수 있는 칸 범위 (중심 범위를 가장 큰 창 크기의 절반만큼 넓혀서)
+    const int crossStart = horizontal ? grid.area.top : grid.area.left;
+    const int crossHalf = ((horizontal ? m_maxHeight : m_maxWidth) + 1) / 2;
+    const int fromCross0 = horizontal ? from.top : from.left;
+    const int fromCross1 = horizontal ? from.bottom : from.right;
+    const int first = std::max(0, (fromCross0 - crossHalf - crossStart) / m_cellSize - 1);
+    const int last = std::min(across - 1, (fromCross1 + crossHalf - crossStart) / m_cellSize + 1);
+
+    auto scanLine = [&](int line) {
+        for (int i = first; i <= last; ++i) {
+            const auto& bucket = grid.cells[horizontal ? i * grid.cols + line : line * grid.cols + i];
+            if (bucket.empty()) continue;
+            if (stats) ++stats->cellsVisited;
+            for (std::uint32_t index : bucket) considerBlocking(index, from, direction, exclude, bestLead, best);
+            if (stats) stats->candidatesScored += bucket.size();
+        }
+    };
+
+    if (forward) {
+        if (edge >= areaEnd) return;
+        int line = edge <= areaStart ? 0 : static_cast<int>((edge - areaStart) / m_cellSize);
+        for (; line < lines; ++line) {
+            // 이 열 창의 가까운 모서리는 열 시작에서 최대 반 창 크기만큼 앞
+            const std::int64_t bound = areaStart + static_cast<std::int64_t>(line) * m_cellSize - maxHalf - edge;
+            if (best != UINT32_MAX && bound > bestLead) break;
+            scanLine(line);
+        }
+    } else {
+        if (edge <= areaStart) return;
+        int line = edge >= areaEnd ? lines - 1 : static_cast<int>((edge - areaStart) / m_cellSize);
+        for (; line >= 0; --line) {
+            const std::int64_t lineEnd =
+                std::min<std::int64_t>(areaEnd, areaStart + static_cast<std::int64_t>(line + 1) * m_cellSize);
+            const std::int64_t bound = edge - lineEnd - maxHalf;
+            if (best != UINT32_MAX && bound > bestLead) break;
+            scanLine(line);
+        }
+    }
+}
+
+WindowId WindowSpatialIndex::blocking(const Rect& from, Direction direction, WindowId exclude,
+                                      SpatialQueryStats* stats) const {
+    std::int64_t bestLead = 0;
+    std::uint32_t best = UINT32_MAX;
+    for (const Grid& grid : m_grids) searchBlocking(grid, from, direction, exclude, bestLead, best, stats);
+    for (std::uint32_t index : m_stray) considerBlocking(index, from, direction, exclude, bestLead, best);
+    if (stats) stats->candidatesScored += m_stray.size();
+    return best == UINT32_MAX ? 0 : m_entries[best].window;
+}
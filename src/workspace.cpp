@@ -0,0 +1,151 @@
+#include "workspace.h"
+
+static std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+static std::uint64_t fnv1a(std::uint64_t hash, std::string_view text, bool foldCase) {
+    for (unsigned char c : text) {
+        if (foldCase && c >= 'A' && c <= 'Z') c = static_cast<unsigned char>(c - 'A' + 'a');
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    return hash;
+}
+
+std::uint64_t windowAppKey(std::string_view executable, std::string_view className) {
+    // 실행 파일 이름과 클래스 이름은 Windows 에서 대소문자를 구분하지 않는다
+    std::uint64_t hash = fnv1a(14695981039346656037ull, executable, true);
+    hash = (hash ^ '|') * 1099511628211ull;
+    return mix(fnv1a(hash, className, true));
+}
+
+std::uint64_t windowTitleKey(std::string_view title) {
+    return mix(fnv1a(14695981039346656037ull, title, false));
+}
+
+static std::uint64_t exactKey(const WindowIdentity& identity) {
+    return mix(identity.app ^ (identity.title * 0x9E3779B97F4A7C15ull));
+}
+
+void WindowIdentityIndex::build(const std::uint64_t* keys, size_t count) {
+    size_t capacity = 16;
+    while (capacity < count * 2) capacity <<= 1;
+    m_keys.assign(capacity, 0);
+    m_used.assign(capacity, 0);
+    m_heads.assign(capacity, -1);
+    m_next.assign(count, -1);
+    m_mask = capacity - 1;
+
+    // 뒤에서부터 넣어 목록이 후보 순서를 따르게 한다
+    for (size_t i = count; i-- > 0;) {
+        size_t slot = static_cast<size_t>(keys[i]) & m_mask;
+        while (m_used[slot] && m_keys[slot] != keys[i]) slot = (slot + 1) & m_mask;
+        m_used[slot] = 1;
+        m_keys[slot] = keys[i];
+        m_next[i] = m_heads[slot];
+        m_heads[slot] = static_cast<std::int32_t>(i);
+    }
+}
+
+int WindowIdentityIndex::take(std::uint64_t key, const std::vector<std::uint8_t>& claimed) {
+    size_t slot = static_cast<size_t>(key) & m_mask;
+    while (m_used[slot] && m_keys[slot] != key) slot = (slot + 1) & m_mask;
+    if (!m_used[slot]) return -1;
+
+    // 이미 가져간 후보는 머리에서 버린다 (후보마다 한 번씩만 지나가므로 전체 O(n))
+    // 목록이 비어도 슬롯은 사용 중으로 남아 뒤로 밀려난 키의 탐색이 끊기지 않는다
+    std::int32_t head = m_heads[slot];
+    while (head >= 0 && claimed[head]) head = m_next[head];
+    m_heads[slot] = head;
+    return head;
+}
+
+void WorkspaceSwitcher::setMembers(const WindowId* windows, size_t count) {
+    m_members.clear();
+    m_members.insert(windows, windows + count);
+}
+
+WorkspaceSwitchStats WorkspaceSwitcher::plan(const WorkspaceWindow* saved, size_t savedCount,
+                                             const WorkspaceCandidate* live, size_t liveCount,
+                                             LayoutTransaction& transaction) {
+    WorkspaceSwitchStats stats;
+    m_toRestore.clear();
+    m_toMaximize.clear();
+    m_claimed.assign(liveCount, 0);
+    m_assigned.assign(savedCount, -1);
+
+    m_keys.resize(liveCount);
+    for (size_t i = 0; i < liveCount; ++i) m_keys[i] = exactKey(live[i].identity);
+    m_exact.build(m_keys.data(), liveCount);
+    for (size_t i = 0; i < liveCount; ++i) m_keys[i] = live[i].identity.app;
+    m_app.build(m_keys.data(), liveCount);
+
+    // 제목까지 같은 창을 먼저 모두 찾고, 남은 항목만 실행 파일 + 클래스로 찾는다
+    for (size_t i = 0; i < savedCount; ++i) {
+        const int j = m_exact.take(exactKey(saved[i].identity), m_claimed);
+        if (j < 0) continue;
+        m_claimed[j] = 1;
+        m_assigned[i] = j;
+        ++stats.matched;
+    }
+    for (size_t i = 0; i < savedCount; ++i) {
+        if (m_assigned[i] >= 0) continue;
+        const int j = m_app.take(saved[i].identity.app, m_claimed);
+        if (j < 0) {
+            ++stats.missing;
+            continue;
+        }
+        m_claimed[j] = 1;
+        m_assigned[i] = j;
+        ++stats.appMatched;
+    }
+
+    // 이전 작업 공간의 창 중 대상에서 찾지 못한 창만 숨긴다
+    for (size_t j = 0; j < liveCount; ++j) {
+        const WorkspaceCandidate& window = live[j];
+        if (m_claimed[j] || !window.visible || !m_members.count(window.window)) continue;
+        transaction.hide(window.window);
+        m_hidden.insert(window.window);
+        ++stats.hidden;
+    }
+
+    m_members.clear();
+    for (size_t i = 0; i < savedCount; ++i) {
+        if (m_assigned[i] < 0) continue;
+        const WorkspaceWindow& target = saved[i];
+        const WorkspaceCandidate& window = live[m_assigned[i]];
+        m_members.insert(window.window);
+
+        const bool maximize = (target.flags & WorkspaceMaximized) != 0;
+        if (maximize && window.maximized) {
+            // 이미 최대화된 창은 보이기만
+            if (!window.visible) transaction.show(window.window);
+        } else if (!window.visible) {
+            transaction.show(window.window, target.position);
+        } else {
+            transaction.move(window.window, target.position);
+        }
+        if (!window.visible) {
+            m_hidden.erase(window.window);
+            ++stats.shown;
+        }
+        if (maximize && !window.maximized) m_toMaximize.push_back(window.window);
+        if (!maximize && window.maximized) m_toRestore.push_back(window.window);
+    }
+    return stats;
+}
+
+void WorkspaceSwitcher::showHidden(LayoutTransaction& transaction) {
+    for (WindowId window : m_hidden) transaction.show(window);
+    m_hidden.clear();
+}
+
+void WorkspaceSwitcher::forget(WindowId window) {
+    m_members.erase(window);
+    m_hidden.erase(window);
+}
@@ -0,0 +1,160 @@
+#include "zone_layout.h"
+#include <algorithm>
+
+static Rect boundingRect(const Rect& a, const Rect& b) {
+    return {std::min(a.left, b.left), std::min(a.top, b.top), std::max(a.right, b.right), std::max(a.bottom, b.bottom)};
+}
+
+static long long area(const Rect& r) {
+    return static_cast<long long>(r.width()) * r.height();
+}
+
+void ZoneLayout::clear() {
+    m_targets.clear();
+    m_regions.clear();
+    m_xs.clear();
+    m_slabs.clear();
+    m_ys.clear();
+    m_ids.clear();
+}
+
+void ZoneLayout::build(const std::vector<ZoneConfig>& zones, int monitorIndex, const Rect& workArea, unsigned dpi,
+                       int gapDip, int spanDip) {
+    clear();
+
+    // 이 모니터의 zone 을 천분율 그대로 모으고, 합친 zone 은 앞선 zone 들의 외곽 사각형으로
+    std::vector<Rect> normalized;
+    std::vector<bool> hidden;
+    for (const auto& zone : zones) {
+        if (zone.monitor != monitorIndex) continue;
+        Rect rect = zone.rect;
+        if (!zone.merge.empty()) {
+            bool first = true;
+            for (int member : zone.merge) {
+                if (member < 0 || member >= static_cast<int>(normalized.size())) continue;
+                rect = first ? normalized[member] : boundingRect(rect, normalized[member]);
+                hidden[member] = true;
+                first = false;
+            }
+            if (first) continue;
+        }
+        normalized.push_back(rect);
+        hidden.push_back(false);
+    }
+
+    const long long width = workArea.width();
+    const long long height = workArea.height();
+    auto toX = [&](int permille) { return workArea.left + static_cast<int>(width * permille / 1000); };
+    auto toY = [&](int permille) { return workArea.top + static_cast<int>(height * permille / 1000); };
+    const int gap = static_cast<int>(static_cast<long long>(std::max(gapDip, 0)) * dpi / 96);
+    const int margin = static_cast<int>(static_cast<long long>(std::max(spanDip, 0)) * dpi / 96);
+
+    // 보이는 zone: 잡히는 영역은 간격 없이 (틈이 생기지 않도록), 목표는 간격을 뺀 것
+    // 작업 영역 가장자리는 간격 전체, 안쪽 경계는 이웃과 반씩 나눈다
+    std::vector<int> visible;
+    std::vector<Rect> pixels;
+    for (size_t i = 0; i < normalized.size(); ++i) {
+        if (hidden[i]) continue;
+        const Rect& n = normalized[i];
+        const Rect pixel{toX(n.left), toY(n.top), toX(n.right), toY(n.bottom)};
+        if (pixel.empty()) continue;
+        Rect target{pixel.left + (n.left == 0 ? gap : gap / 2), pixel.top + (n.top == 0 ? gap : gap / 2),
+                    pixel.right - (n.right == 1000 ? gap : gap - gap / 2),
+                    pixel.bottom - (n.bottom == 1000 ? gap : gap - gap / 2)};
+        if (target.empty()) target = pixel;
+
+        m_regions.push_back({pixel, static_cast<int>(m_targets.size()), false});
+        m_targets.push_back(target);
+        visible.push_back(static_cast<int>(i));
+        pixels.push_back(pixel);
+    }
+
+    // 맞닿은 두 zone 의 경계를 따라 폭 2*margin 의 띠: 두 zone 을 함께 덮는다
+    // 맞닿음은 천분율에서 판정한다 (픽셀 반올림과 무관하게)
+    const size_t baseCount = visible.size();
+    for (size_t a = 0; margin > 0 && a < baseCount; ++a) {
+        for (size_t b = 0; b < baseCount; ++b) {
+            if (a == b) continue;
+            const Rect& na = normalized[visible[a]];
+            const Rect& nb = normalized[visible[b]];
+            const Rect& pa = pixels[a];
+            const Rect& pb = pixels[b];
+            Rect hit;
+            if (na.right == nb.left && std::max(na.top, nb.top) < std::min(na.bottom, nb.bottom)) {
+                hit = {std::max(pa.right - margin, pa.left), std::max(pa.top, pb.top),
+                       std::min(pb.left + margin, pb.right), std::min(pa.bottom, pb.bottom)};
+            } else if (na.bottom == nb.top && std::max(na.left, nb.left) < std::min(na.right, nb.right)) {
+                hit = {std::max(pa.left, pb.left), std::max(pa.bottom - margin, pa.top),
+                       std::min(pa.right, pb.right), std::min(pb.top + margin, pb.bottom)};
+            } else {
+                continue;
+            }
+            if (hit.empty()) continue;
+            m_regions.push_back({hit, static_cast<int>(m_targets.size()), true});
+            m_targets.push_back(boundingRect(m_targets[a], m_targets[b]));
+        }
+    }
+
+    // 우선순위: 경계 띠 > 작은 zone > 먼저 선언한 것
+    std::stable_sort(m_regions.begin(), m_regions.end(), [](const ZoneRegion& x, const ZoneRegion& y) {
+        if (x.span != y.span) return x.span;
+        return area(x.hit) < area(y.hit);
+    });
+
+    for (const auto& region : m_regions) {
+        m_xs.push_back(region.hit.left);
+        m_xs.push_back(region.hit.right);
+    }
+    std::sort(m_xs.begin(), m_xs.end());
+    m_xs.erase(std::unique(m_xs.begin(), m_xs.end()), m_xs.end());
+
+    // 띠마다 그 띠를 덮는 영역의 y 경계로 나누고, 각 구간에서 가장 앞선 영역을 고른다
+    std::vector<const ZoneRegion*> covering;
+    std::vector<int> ys;
+    for (size_t i = 0; i + 1 < m_xs.size(); ++i) {
+        m_slabs.push_back(static_cast<std::uint32_t>(m_ys.size()));
+        covering.clear();
+        ys.clear();
+        for (const auto& region : m_regions) {
+            if (region.hit.left <= m_xs[i] && region.hit.right >= m_xs[i + 1]) {
+                covering.push_back(&region);
+                ys.push_back(region.hit.top);
+                ys.push_back(region.hit.bottom);
+            }
+        }
+        std::sort(ys.begin(), ys.end());
+        ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+        int previous = -1;
+        for (size_t k = 0; k + 1 < ys.size(); ++k) {
+            int id = -1;
+            for (const ZoneRegion* region : covering) {
+                if (region->hit.top <= ys[k] && region->hit.bottom >= ys[k + 1]) {
+                    id = region->target;
+                    break;
+                }
+            }
+            // 같은 목표가 이어지면 경계를 하나로 합친다
+            if (id == previous && m_slabs.back() < m_ys.size()) continue;
+            m_ys.push_back(ys[k]);
+            m_ids.push_back(id);
+            previous = id;
+        }
+        if (!ys.empty()) {
+            m_ys.push_back(ys.back());
+            m_ids.push_back(-1);
+        }
+    }
+    m_slabs.push_back(static_cast<std::uint32_t>(m_ys.size()));
+}
+
+int ZoneLayout::hitTest(Point pt) const {
+    if (m_xs.size() < 2 || pt.x < m_xs.front() || pt.x >= m_xs.back()) return -1;
+    const size_t slab = std::upper_bound(m_xs.begin(), m_xs.end(), pt.x) - m_xs.begin() - 1;
+
+    const auto first = m_ys.begin() + m_slabs[slab];
+    const auto last = m_ys.begin() + m_slabs[slab + 1];
+    const auto it = std::upper_bound(first, last, pt.y);
+    if (it == first) return -1;
+    return m_ids[(it - m_ys.begin()) - 1];
+}